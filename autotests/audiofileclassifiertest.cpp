@@ -0,0 +1,147 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "abstractfile/audiofileclassifier.h"
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+#include <QDir>
+#include <QTemporaryDir>
+
+#include <QtTest>
+
+class AudioFileClassifierTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    AudioFileClassifierTest(QObject *parent = nullptr) : QObject(parent)
+    {
+    }
+
+private:
+
+    static QString createFile(const QString &directoryName, const QString &fileName, const QByteArray &content)
+    {
+        const auto fullFileName = directoryName + QStringLiteral("/") + fileName;
+
+        QFile newFile(fullFileName);
+        newFile.open(QIODevice::WriteOnly);
+        newFile.write(content);
+
+        return fullFileName;
+    }
+
+private Q_SLOTS:
+
+    void classifyFromSuffix()
+    {
+        QCOMPARE(AudioFileClassifier::kindFromSuffix(QStringLiteral("flac")), AudioFileClassifier::FileKind::Audio);
+        QCOMPARE(AudioFileClassifier::kindFromSuffix(QStringLiteral("mp3")), AudioFileClassifier::FileKind::Audio);
+        QCOMPARE(AudioFileClassifier::kindFromSuffix(QStringLiteral("jpg")), AudioFileClassifier::FileKind::NotAudio);
+        QCOMPARE(AudioFileClassifier::kindFromSuffix(QStringLiteral("cue")), AudioFileClassifier::FileKind::NotAudio);
+        QCOMPARE(AudioFileClassifier::kindFromSuffix(QStringLiteral("nfo")), AudioFileClassifier::FileKind::NotAudio);
+        QCOMPARE(AudioFileClassifier::kindFromSuffix(QStringLiteral("bak")), AudioFileClassifier::FileKind::Unknown);
+        QCOMPARE(AudioFileClassifier::kindFromSuffix(QString()), AudioFileClassifier::FileKind::Unknown);
+    }
+
+    void classifyFromHeader()
+    {
+        QCOMPARE(AudioFileClassifier::kindFromHeader(QByteArray("ID3\x04\x00", 5)), AudioFileClassifier::FileKind::Audio);
+        QCOMPARE(AudioFileClassifier::kindFromHeader(QByteArray("fLaC\x00\x00\x00\x22", 8)), AudioFileClassifier::FileKind::Audio);
+        QCOMPARE(AudioFileClassifier::kindFromHeader(QByteArray("OggS\x00\x02", 6)), AudioFileClassifier::FileKind::Audio);
+        QCOMPARE(AudioFileClassifier::kindFromHeader(QByteArray("RIFF\x24\x08\x00\x00WAVEfmt ", 16)), AudioFileClassifier::FileKind::Audio);
+        QCOMPARE(AudioFileClassifier::kindFromHeader(QByteArray("\x00\x00\x00\x20" "ftypM4A ", 12)), AudioFileClassifier::FileKind::Audio);
+        QCOMPARE(AudioFileClassifier::kindFromHeader(QByteArray("\xFF\xFB\x90\x00", 4)), AudioFileClassifier::FileKind::Audio);
+        QCOMPARE(AudioFileClassifier::kindFromHeader(QByteArray("\xFF\xF3\x64\xC4", 4)), AudioFileClassifier::FileKind::Audio);
+        QCOMPARE(AudioFileClassifier::kindFromHeader(QByteArray("\xFF\xF1\x50\x80", 4)), AudioFileClassifier::FileKind::Audio);
+        QCOMPARE(AudioFileClassifier::kindFromHeader(QByteArray("\xFF\xFE#\x00" "E\x00" "X\x00", 8)), AudioFileClassifier::FileKind::Unknown);
+        QCOMPARE(AudioFileClassifier::kindFromHeader(QByteArray("\xFF\xFE<\x00" "?\x00" "x\x00", 8)), AudioFileClassifier::FileKind::Unknown);
+        QCOMPARE(AudioFileClassifier::kindFromHeader(QByteArray("\xFF\xFB\xF0\x00", 4)), AudioFileClassifier::FileKind::Unknown);
+        QCOMPARE(AudioFileClassifier::kindFromHeader(QByteArray("\xFF\xEB\x90\x00", 4)), AudioFileClassifier::FileKind::Unknown);
+        QCOMPARE(AudioFileClassifier::kindFromHeader(QByteArray("\xFF\xD8\xFF\xE0", 4)), AudioFileClassifier::FileKind::NotAudio);
+        QCOMPARE(AudioFileClassifier::kindFromHeader(QByteArray("\x89PNG\r\n", 6)), AudioFileClassifier::FileKind::NotAudio);
+        QCOMPARE(AudioFileClassifier::kindFromHeader(QByteArray("RIFF\x24\x08\x00\x00" "AVI LIST", 16)), AudioFileClassifier::FileKind::Unknown);
+        QCOMPARE(AudioFileClassifier::kindFromHeader(QByteArray("plain text")), AudioFileClassifier::FileKind::Unknown);
+    }
+
+    void knownSuffixesNeedNoContentCheck()
+    {
+        QTemporaryDir rootDirectory;
+        QVERIFY(rootDirectory.isValid());
+
+        const auto audioFile = createFile(rootDirectory.path(), QStringLiteral("track.flac"), QByteArray("not really flac"));
+        const auto coverFile = createFile(rootDirectory.path(), QStringLiteral("cover.jpg"), QByteArray("fLaC"));
+        const auto cueFile = createFile(rootDirectory.path(), QStringLiteral("album.CUE"), QByteArray("FILE \"track.flac\" WAVE"));
+
+        AudioFileClassifier myClassifier;
+
+        QVERIFY(myClassifier.isAudioFile(audioFile));
+        QVERIFY(!myClassifier.isAudioFile(coverFile));
+        QVERIFY(!myClassifier.isAudioFile(cueFile));
+        QCOMPARE(myClassifier.contentChecksCount(), 0);
+    }
+
+    void unknownSuffixesAreCheckedOncePerDirectory()
+    {
+        QTemporaryDir rootDirectory;
+        QVERIFY(rootDirectory.isValid());
+
+        QDir(rootDirectory.path()).mkpath(QStringLiteral("first"));
+        QDir(rootDirectory.path()).mkpath(QStringLiteral("second"));
+
+        const auto firstDirectory = rootDirectory.path() + QStringLiteral("/first");
+        const auto secondDirectory = rootDirectory.path() + QStringLiteral("/second");
+
+        const auto firstTrack = createFile(firstDirectory, QStringLiteral("01.audio"), QByteArray("fLaC\x00\x00\x00\x22", 8));
+        const auto secondTrack = createFile(firstDirectory, QStringLiteral("02.audio"), QByteArray("fLaC\x00\x00\x00\x22", 8));
+        const auto firstImage = createFile(secondDirectory, QStringLiteral("front.audio"), QByteArray("\x89PNG\r\n\x1a\n", 8));
+
+        AudioFileClassifier myClassifier;
+
+        QVERIFY(myClassifier.isAudioFile(firstTrack));
+        QVERIFY(myClassifier.isAudioFile(secondTrack));
+        QCOMPARE(myClassifier.contentChecksCount(), 1);
+
+        QVERIFY(!myClassifier.isAudioFile(firstImage));
+        QCOMPARE(myClassifier.contentChecksCount(), 2);
+    }
+
+    void filesWithoutSuffixAreAlwaysChecked()
+    {
+        QTemporaryDir rootDirectory;
+        QVERIFY(rootDirectory.isValid());
+
+        const auto firstTrack = createFile(rootDirectory.path(), QStringLiteral("track"), QByteArray("OggS\x00\x02", 6));
+        const auto firstImage = createFile(rootDirectory.path(), QStringLiteral("cover"), QByteArray("\xFF\xD8\xFF\xE0", 4));
+
+        AudioFileClassifier myClassifier;
+
+        QVERIFY(myClassifier.isAudioFile(firstTrack));
+        QVERIFY(!myClassifier.isAudioFile(firstImage));
+        QCOMPARE(myClassifier.contentChecksCount(), 2);
+    }
+
+};
+
+QTEST_GUILESS_MAIN(AudioFileClassifierTest)
+
+
+#include "audiofileclassifiertest.moc"
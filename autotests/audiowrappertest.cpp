@@ -0,0 +1,161 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "audiowrapper.h"
+
+#include "generatedaudiofiles.h"
+
+#include <QObject>
+#include <QString>
+#include <QUrl>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+
+#include <QtTest>
+
+class AudioWrapperTests: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    AudioWrapperTests(QObject *parent = nullptr) : QObject(parent)
+    {
+    }
+
+private:
+
+    static const int mTrackDuration = 2000;
+
+    QTemporaryDir mFilesDirectory;
+
+    QUrl mFirstTrack;
+
+    QUrl mSecondTrack;
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        QVERIFY(mFilesDirectory.isValid());
+
+        const auto firstFileName = mFilesDirectory.filePath(QStringLiteral("first.wav"));
+        const auto secondFileName = mFilesDirectory.filePath(QStringLiteral("second.wav"));
+
+        QVERIFY(GeneratedAudioFiles::writeWaveFile(firstFileName, mTrackDuration, 440.));
+        QVERIFY(GeneratedAudioFiles::writeWaveFile(secondFileName, mTrackDuration, 660.));
+
+        mFirstTrack = QUrl::fromLocalFile(firstFileName);
+        mSecondTrack = QUrl::fromLocalFile(secondFileName);
+    }
+
+    void transitionWithoutPreload()
+    {
+        if (!GeneratedAudioFiles::hasAudioOutput()) {
+            QSKIP("no audio output device available");
+        }
+
+        AudioWrapper myPlayer;
+
+        QSignalSpy playingSpy(&myPlayer, &AudioWrapper::playing);
+        QSignalSpy statusChangedSpy(&myPlayer, &AudioWrapper::statusChanged);
+
+        QElapsedTimer playbackTimer;
+        qint64 secondTrackStarted = -1;
+
+        connect(&myPlayer, &AudioWrapper::statusChanged, this, [&](QMediaPlayer::MediaStatus status) {
+            if (status == QMediaPlayer::EndOfMedia && myPlayer.source() != mSecondTrack) {
+                myPlayer.setSource(mSecondTrack);
+                myPlayer.play();
+            }
+        });
+        connect(&myPlayer, &AudioWrapper::playing, this, [&]() {
+            if (!playbackTimer.isValid()) {
+                playbackTimer.start();
+            } else if (secondTrackStarted == -1) {
+                secondTrackStarted = playbackTimer.elapsed();
+            }
+        });
+
+        myPlayer.setSource(mFirstTrack);
+        myPlayer.play();
+
+        QVERIFY(playingSpy.wait());
+        QTRY_VERIFY_WITH_TIMEOUT(secondTrackStarted != -1, 4 * mTrackDuration);
+
+        qInfo() << "transition latency without preload" << secondTrackStarted - mTrackDuration << "ms";
+
+        QCOMPARE(myPlayer.source(), mSecondTrack);
+
+        myPlayer.stop();
+    }
+
+    void gaplessTransition()
+    {
+        if (!GeneratedAudioFiles::hasAudioOutput()) {
+            QSKIP("no audio output device available");
+        }
+
+        AudioWrapper myPlayer;
+
+        QSignalSpy playingSpy(&myPlayer, &AudioWrapper::playing);
+        QSignalSpy stoppedSpy(&myPlayer, &AudioWrapper::stopped);
+        QSignalSpy nextSourceStartedSpy(&myPlayer, &AudioWrapper::nextSourceStarted);
+        QSignalSpy nextSourceChangedSpy(&myPlayer, &AudioWrapper::nextSourceChanged);
+
+        QElapsedTimer playbackTimer;
+        qint64 secondTrackStarted = -1;
+
+        connect(&myPlayer, &AudioWrapper::playing, this, [&]() {
+            if (!playbackTimer.isValid()) {
+                playbackTimer.start();
+            }
+        });
+        connect(&myPlayer, &AudioWrapper::nextSourceStarted, this, [&]() {
+            secondTrackStarted = playbackTimer.elapsed();
+        });
+
+        myPlayer.setSource(mFirstTrack);
+        myPlayer.setNextSource(mSecondTrack);
+
+        QCOMPARE(nextSourceChangedSpy.count(), 1);
+        QCOMPARE(myPlayer.nextSource(), mSecondTrack);
+
+        myPlayer.play();
+
+        QVERIFY(playingSpy.wait());
+        stoppedSpy.clear();
+
+        QVERIFY(nextSourceStartedSpy.wait(4 * mTrackDuration));
+
+        qInfo() << "transition latency with preload" << secondTrackStarted - mTrackDuration << "ms";
+
+        QCOMPARE(nextSourceStartedSpy.count(), 1);
+        QCOMPARE(nextSourceStartedSpy.at(0).at(0).toUrl(), mSecondTrack);
+        QCOMPARE(nextSourceChangedSpy.count(), 2);
+        QCOMPARE(myPlayer.nextSource(), QUrl());
+        QCOMPARE(myPlayer.source(), mSecondTrack);
+        QCOMPARE(stoppedSpy.count(), 0);
+
+        myPlayer.stop();
+    }
+};
+
+QTEST_GUILESS_MAIN(AudioWrapperTests)
+
+
+#include "audiowrappertest.moc"
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "coverthumbnailcache.h"
+
+#include <QObject>
+#include <QString>
+#include <QImage>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QTemporaryDir>
+
+#include <QtTest>
+
+class CoverThumbnailCacheTests: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    CoverThumbnailCacheTests(QObject *parent = nullptr) : QObject(parent)
+    {
+    }
+
+private:
+
+    static QString createCoverFile(const QTemporaryDir &directory, int width, int height)
+    {
+        const auto fileName = directory.filePath(QStringLiteral("cover.png"));
+
+        QImage coverImage(width, height, QImage::Format_RGB32);
+        coverImage.fill(Qt::red);
+        coverImage.save(fileName, "PNG");
+
+        return fileName;
+    }
+
+private Q_SLOTS:
+
+    void readCoverScaled()
+    {
+        QTemporaryDir sourceDirectory;
+        QVERIFY(sourceDirectory.isValid());
+
+        const auto coverFileName = createCoverFile(sourceDirectory, 1000, 500);
+
+        auto coverImage = CoverThumbnailCache::readCover(coverFileName, {100, 100});
+        QCOMPARE(coverImage.size(), QSize(100, 50));
+
+        coverImage = CoverThumbnailCache::readCover(coverFileName, {2000, 2000});
+        QCOMPARE(coverImage.size(), QSize(1000, 500));
+
+        coverImage = CoverThumbnailCache::readCover(coverFileName, {});
+        QCOMPARE(coverImage.size(), QSize(1000, 500));
+    }
+
+    void createAndReadThumbnails()
+    {
+        QTemporaryDir sourceDirectory;
+        QTemporaryDir cacheDirectory;
+        QVERIFY(sourceDirectory.isValid());
+        QVERIFY(cacheDirectory.isValid());
+
+        const auto coverFileName = createCoverFile(sourceDirectory, 1000, 1000);
+
+        CoverThumbnailCache thumbnailCache(cacheDirectory.path());
+
+        QVERIFY(!thumbnailCache.hasThumbnails(coverFileName));
+        QVERIFY(thumbnailCache.thumbnail(coverFileName, {32, 32}).isNull());
+
+        QVERIFY(thumbnailCache.createThumbnails(coverFileName));
+        QVERIFY(thumbnailCache.hasThumbnails(coverFileName));
+
+        QCOMPARE(QDir(cacheDirectory.path()).entryList(QDir::Files).size(), CoverThumbnailCache::thumbnailSizes().size());
+
+        for (auto oneSize : CoverThumbnailCache::thumbnailSizes()) {
+            const auto thumbnailImage = QImage(thumbnailCache.thumbnailFileName(coverFileName, oneSize));
+            QCOMPARE(thumbnailImage.size(), QSize(oneSize, oneSize));
+        }
+
+        QCOMPARE(thumbnailCache.thumbnail(coverFileName, {32, 32}).size(), QSize(32, 32));
+        QCOMPARE(thumbnailCache.thumbnail(coverFileName, {200, 200}).size(), QSize(200, 200));
+        QVERIFY(thumbnailCache.thumbnail(coverFileName, {800, 800}).isNull());
+        QVERIFY(thumbnailCache.thumbnail(coverFileName, {}).isNull());
+    }
+
+    void staleThumbnailsAreReplaced()
+    {
+        QTemporaryDir sourceDirectory;
+        QTemporaryDir cacheDirectory;
+        QVERIFY(sourceDirectory.isValid());
+        QVERIFY(cacheDirectory.isValid());
+
+        const auto coverFileName = createCoverFile(sourceDirectory, 400, 400);
+
+        CoverThumbnailCache thumbnailCache(cacheDirectory.path());
+
+        QVERIFY(thumbnailCache.createThumbnails(coverFileName));
+
+        QFile coverFile(coverFileName);
+        QVERIFY(coverFile.open(QIODevice::ReadWrite));
+        QVERIFY(coverFile.setFileTime(QFileInfo(coverFileName).lastModified().addSecs(60), QFileDevice::FileModificationTime));
+        coverFile.close();
+
+        QVERIFY(!thumbnailCache.hasThumbnails(coverFileName));
+        QVERIFY(thumbnailCache.thumbnail(coverFileName, {32, 32}).isNull());
+
+        QVERIFY(thumbnailCache.createThumbnails(coverFileName));
+        QVERIFY(thumbnailCache.hasThumbnails(coverFileName));
+
+        QCOMPARE(QDir(cacheDirectory.path()).entryList(QDir::Files).size(), CoverThumbnailCache::thumbnailSizes().size());
+    }
+
+    void trimCacheRemovesOldestThumbnails()
+    {
+        QTemporaryDir sourceDirectory;
+        QTemporaryDir cacheDirectory;
+        QVERIFY(sourceDirectory.isValid());
+        QVERIFY(cacheDirectory.isValid());
+
+        const auto oldCoverFileName = createCoverFile(sourceDirectory, 400, 400);
+        const auto newCoverFileName = sourceDirectory.filePath(QStringLiteral("new-cover.png"));
+        QVERIFY(QFile::copy(oldCoverFileName, newCoverFileName));
+
+        CoverThumbnailCache thumbnailCache(cacheDirectory.path());
+
+        QVERIFY(thumbnailCache.createThumbnails(oldCoverFileName));
+        QVERIFY(thumbnailCache.createThumbnails(newCoverFileName));
+
+        auto oldThumbnailFileNames = QStringList{};
+        for (auto oneSize : CoverThumbnailCache::thumbnailSizes()) {
+            oldThumbnailFileNames.push_back(QFileInfo(thumbnailCache.thumbnailFileName(oldCoverFileName, oneSize)).absoluteFilePath());
+        }
+
+        const auto allThumbnails = QDir(cacheDirectory.path()).entryInfoList(QDir::Files);
+        auto newThumbnailsSize = qint64(0);
+        for (const auto &oneThumbnail : allThumbnails) {
+            if (oldThumbnailFileNames.contains(oneThumbnail.absoluteFilePath())) {
+                QFile thumbnailFile(oneThumbnail.absoluteFilePath());
+                QVERIFY(thumbnailFile.open(QIODevice::ReadWrite));
+                QVERIFY(thumbnailFile.setFileTime(oneThumbnail.lastModified().addSecs(-3600), QFileDevice::FileModificationTime));
+            } else {
+                newThumbnailsSize += oneThumbnail.size();
+            }
+        }
+
+        thumbnailCache.trimCache(newThumbnailsSize);
+
+        QVERIFY(!thumbnailCache.hasThumbnails(oldCoverFileName));
+        QVERIFY(thumbnailCache.hasThumbnails(newCoverFileName));
+
+        thumbnailCache.trimCache(0);
+
+        QCOMPARE(QDir(cacheDirectory.path()).entryList(QDir::Files).size(), 0);
+    }
+};
+
+QTEST_GUILESS_MAIN(CoverThumbnailCacheTests)
+
+
+#include "coverthumbnailcachetest.moc"
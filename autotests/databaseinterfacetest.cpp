@@ -18,6 +18,8 @@
 #include "databasetestdata.h"
 
 #include "databaseinterface.h"
+#include "databasestatistics.h"
+#include "loudnessanalyzer.h"
 #include "musicaudiotrack.h"
 
 #include <QObject>
@@ -31,6 +33,11 @@
 #include <QDir>
 #include <QFile>
 #include <QTemporaryFile>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlRecord>
 
 #include <QDebug>
 
@@ -44,6 +51,60 @@ class DatabaseInterfaceTests: public QObject, public DatabaseTestData
 
 private:
 
+    /* a version 9 database holding one track, extraQueries damage it or replay part of an upgrade */
+    static bool createVersion9Database(const QString &databaseFileName, const QStringList &extraQueries)
+    {
+        auto result = true;
+
+        {
+            auto oldDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), QStringLiteral("oldDatabase"));
+            oldDatabase.setDatabaseName(databaseFileName);
+            result = oldDatabase.open();
+
+            auto oldSchema = QStringList{
+                    QStringLiteral("CREATE TABLE `DatabaseVersionV9` (`Version` INTEGER PRIMARY KEY NOT NULL)"),
+                    QStringLiteral("CREATE TABLE `DiscoverSource` (`ID` INTEGER PRIMARY KEY NOT NULL, `Name` VARCHAR(55) NOT NULL, UNIQUE (`Name`))"),
+                    QStringLiteral("CREATE TABLE `Artists` (`ID` INTEGER PRIMARY KEY NOT NULL, `Name` VARCHAR(55) NOT NULL, UNIQUE (`Name`))"),
+                    QStringLiteral("CREATE TABLE `Composer` (`ID` INTEGER PRIMARY KEY NOT NULL, `Name` VARCHAR(55) NOT NULL, UNIQUE (`Name`))"),
+                    QStringLiteral("CREATE TABLE `Genre` (`ID` INTEGER PRIMARY KEY NOT NULL, `Name` VARCHAR(85) NOT NULL, UNIQUE (`Name`))"),
+                    QStringLiteral("CREATE TABLE `Lyricist` (`ID` INTEGER PRIMARY KEY NOT NULL, `Name` VARCHAR(55) NOT NULL, UNIQUE (`Name`))"),
+                    QStringLiteral("CREATE TABLE `Albums` (`ID` INTEGER PRIMARY KEY NOT NULL, `Title` VARCHAR(55) NOT NULL, "
+                                   "`ArtistName` VARCHAR(55), `AlbumPath` VARCHAR(255) NOT NULL, `CoverFileName` VARCHAR(255) NOT NULL, "
+                                   "`AlbumInternalID` VARCHAR(55), UNIQUE (`Title`, `ArtistName`, `AlbumPath`))"),
+                    QStringLiteral("CREATE TABLE `Tracks` (`ID` INTEGER PRIMARY KEY NOT NULL, `Title` VARCHAR(85) NOT NULL, "
+                                   "`ArtistName` VARCHAR(55), `AlbumTitle` VARCHAR(55), `AlbumArtistName` VARCHAR(55), "
+                                   "`AlbumPath` VARCHAR(255), `TrackNumber` INTEGER DEFAULT -1, `DiscNumber` INTEGER DEFAULT -1, "
+                                   "`Duration` INTEGER NOT NULL, `Rating` INTEGER NOT NULL DEFAULT 0, `Genre` VARCHAR(55), "
+                                   "`Composer` VARCHAR(55), `Lyricist` VARCHAR(55), `Comment` VARCHAR(255) DEFAULT '', "
+                                   "`Year` INTEGER DEFAULT 0, `Channels` INTEGER DEFAULT -1, `BitRate` INTEGER DEFAULT -1, "
+                                   "`SampleRate` INTEGER DEFAULT -1, `HasEmbeddedCover` BOOLEAN NOT NULL, `ImportDate` INTEGER NOT NULL, "
+                                   "`FirstPlayDate` INTEGER, `LastPlayDate` INTEGER, `PlayCounter` INTEGER NOT NULL)"),
+                    QStringLiteral("CREATE TABLE `TracksMapping` (`TrackID` INTEGER NULL, `DiscoverID` INTEGER NOT NULL, "
+                                   "`FileName` VARCHAR(255) NOT NULL, `Priority` INTEGER NOT NULL, "
+                                   "`FileModifiedTime` DATETIME NOT NULL, PRIMARY KEY (`FileName`))"),
+                    QStringLiteral("INSERT INTO `DiscoverSource` VALUES (1, 'autoTest')"),
+                    QStringLiteral("INSERT INTO `Artists` VALUES (1, 'artist1')"),
+                    QStringLiteral("INSERT INTO `Genre` VALUES (1, 'genre1')"),
+                    QStringLiteral("INSERT INTO `Albums` VALUES (1, 'album1', 'artist1', '/old/', 'file://image$1', NULL)"),
+                    QStringLiteral("INSERT INTO `Tracks` (`ID`, `Title`, `ArtistName`, `AlbumTitle`, `AlbumArtistName`, `AlbumPath`, "
+                                   "`TrackNumber`, `DiscNumber`, `Duration`, `Genre`, `HasEmbeddedCover`, `ImportDate`, `PlayCounter`) "
+                                   "VALUES (1, 'track1', 'artist1', 'album1', 'artist1', '/old/', 1, 1, 1000, 'genre1', 0, 0, 0)"),
+                    QStringLiteral("INSERT INTO `TracksMapping` VALUES (1, 1, '/old/$1', 1, 0)"),};
+
+            oldSchema += extraQueries;
+
+            for (const auto &oneQuery : oldSchema) {
+                QSqlQuery createQuery(oldDatabase);
+                result = result && createQuery.exec(oneQuery);
+            }
+
+            oldDatabase.close();
+        }
+        QSqlDatabase::removeDatabase(QStringLiteral("oldDatabase"));
+
+        return result;
+    }
+
 private Q_SLOTS:
 
     void initTestCase()
@@ -4700,6 +4761,593 @@ private Q_SLOTS:
         QCOMPARE(musicDbTrackModifiedSpy.count(), 0);
         QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
     }
+
+    void collectStatistics()
+    {
+        DatabaseStatistics statistics;
+        DatabaseInterface musicDb;
+
+        QCOMPARE(statistics.slowQueryThreshold(), int(DatabaseStatistics::defaultSlowQueryThreshold));
+        statistics.setSlowQueryThreshold(0);
+        QCOMPARE(statistics.slowQueryThreshold(), 1);
+        statistics.setSlowQueryThreshold(200);
+        QCOMPARE(statistics.slowQueryThreshold(), 200);
+
+        musicDb.setStatistics(&statistics);
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDb.allTracksData().count(), 22);
+        QCOMPARE(musicDbTrackAddedSpy.count(), 1);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        const auto &statisticsData = statistics.toJson();
+
+        const auto &allTransactions = statisticsData[QStringLiteral("transactions")].toObject();
+        QCOMPARE(allTransactions.count(), 1);
+
+        const auto &insertTransaction = allTransactions[QStringLiteral("insertTracksList")].toObject();
+        QCOMPARE(insertTransaction[QStringLiteral("count")].toInt(), 1);
+        QCOMPARE(insertTransaction[QStringLiteral("tracks")].toInt(), mNewTracks.count());
+
+        const auto &allQueries = statisticsData[QStringLiteral("queries")].toArray();
+        QVERIFY(!allQueries.isEmpty());
+
+        auto rowsCount = 0;
+        for (const auto &oneQuery : allQueries) {
+            rowsCount += oneQuery.toObject()[QStringLiteral("rows")].toInt();
+        }
+        QVERIFY(rowsCount >= 22);
+
+        statistics.clear();
+
+        QVERIFY(statistics.toJson()[QStringLiteral("queries")].toArray().isEmpty());
+    }
+
+    void namesCacheAndRollBack()
+    {
+        using InsertName = qulonglong (DatabaseInterface::*)(const QString &);
+
+        DatabaseStatistics statistics;
+        DatabaseInterface musicDb;
+
+        musicDb.setStatistics(&statistics);
+        musicDb.init(QStringLiteral("testDb"));
+
+        auto executedQueries = [&statistics]() {
+            auto result = 0;
+            for (const auto &oneQuery : statistics.toJson()[QStringLiteral("queries")].toArray()) {
+                result += oneQuery.toObject()[QStringLiteral("count")].toInt();
+            }
+            return result;
+        };
+
+        auto namesCount = [](const QString &tableName, const QString &name) {
+            QSqlQuery countQuery(QSqlDatabase::database(QStringLiteral("testDb")));
+            countQuery.prepare(QStringLiteral("SELECT COUNT(*) FROM `") + tableName + QStringLiteral("` WHERE `Name` = :name"));
+            countQuery.bindValue(QStringLiteral(":name"), name);
+            countQuery.exec();
+            return countQuery.next() ? countQuery.value(0).toInt() : -1;
+        };
+
+        const QList<QPair<QString, InsertName>> allNameTables = {
+            {QStringLiteral("Artists"), &DatabaseInterface::insertArtist},
+            {QStringLiteral("Composer"), &DatabaseInterface::insertComposer},
+            {QStringLiteral("Lyricist"), &DatabaseInterface::insertLyricist},
+            {QStringLiteral("Genre"), &DatabaseInterface::insertGenre},
+        };
+
+        for (const auto &oneNameTable : allNameTables) {
+            const auto &tableName = oneNameTable.first;
+            const auto insertName = oneNameTable.second;
+
+            QVERIFY(musicDb.startTransaction());
+            const auto keptId = (musicDb.*insertName)(QStringLiteral("kept"));
+            QVERIFY(keptId != 0);
+
+            // a cache hit does not run any query
+            auto queriesBefore = executedQueries();
+            QCOMPARE((musicDb.*insertName)(QStringLiteral("kept")), keptId);
+            QCOMPARE(executedQueries(), queriesBefore);
+            QVERIFY(musicDb.finishTransaction());
+
+            QVERIFY(musicDb.startTransaction());
+            const auto rolledBackId = (musicDb.*insertName)(QStringLiteral("rolledBack"));
+            QVERIFY(rolledBackId != 0);
+            QVERIFY(musicDb.rollBackTransaction());
+
+            QCOMPARE(namesCount(tableName, QStringLiteral("rolledBack")), 0);
+
+            // the cache is cleared: committed names are read again, rolled back ones are inserted again
+            QVERIFY(musicDb.startTransaction());
+            queriesBefore = executedQueries();
+            QCOMPARE((musicDb.*insertName)(QStringLiteral("kept")), keptId);
+            QVERIFY(executedQueries() > queriesBefore);
+
+            const auto reinsertedId = (musicDb.*insertName)(QStringLiteral("rolledBack"));
+            QVERIFY(reinsertedId != 0);
+            QVERIFY(reinsertedId != keptId);
+            QVERIFY(musicDb.finishTransaction());
+
+            QCOMPARE(namesCount(tableName, QStringLiteral("kept")), 1);
+            QCOMPARE(namesCount(tableName, QStringLiteral("rolledBack")), 1);
+
+            QVERIFY(musicDb.startTransaction());
+            queriesBefore = executedQueries();
+            QCOMPARE((musicDb.*insertName)(QStringLiteral("rolledBack")), reinsertedId);
+            QCOMPARE(executedQueries(), queriesBefore);
+            QVERIFY(musicDb.finishTransaction());
+        }
+    }
+
+    void upgradeDatabaseFromVersion9()
+    {
+        QTemporaryFile myTempDatabase;
+        myTempDatabase.open();
+
+        QVERIFY(createVersion9Database(myTempDatabase.fileName(), {}));
+
+        DatabaseInterface musicDb;
+
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.init(QStringLiteral("testDb"), myTempDatabase.fileName());
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        QCOMPARE(musicDb.allAlbumsData().count(), 1);
+        QCOMPARE(musicDb.allArtistsData().count(), 1);
+        QCOMPARE(musicDb.allGenresData().count(), 1);
+
+        auto albumId = musicDb.albumIdFromTitleAndArtist(QStringLiteral("album1"), QStringLiteral("artist1"));
+        QCOMPARE(musicDb.albumData(albumId).count(), 1);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+        QCOMPARE(musicDb.albumData(albumId).count(), 1);
+        QCOMPARE(musicDb.allAlbumsData().count(), 6);
+    }
+
+    void upgradeDatabaseFromHalfUpgradedVersion9()
+    {
+        QTemporaryFile myTempDatabase;
+        myTempDatabase.open();
+
+        QVERIFY(createVersion9Database(myTempDatabase.fileName(),
+                                       {QStringLiteral("ALTER TABLE `Tracks` ADD COLUMN `ArtistID` INTEGER REFERENCES `Artists`(`ID`)")}));
+
+        DatabaseInterface musicDb;
+
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.init(QStringLiteral("testDb"), myTempDatabase.fileName());
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        auto albumId = musicDb.albumIdFromTitleAndArtist(QStringLiteral("album1"), QStringLiteral("artist1"));
+        QCOMPARE(musicDb.albumData(albumId).count(), 1);
+    }
+
+    void upgradeDatabaseFromVersion9WithoutAlbumArtist()
+    {
+        QTemporaryFile myTempDatabase;
+        myTempDatabase.open();
+
+        /* a track without album artist matches both albums: the one without artist must win, whatever the row order */
+        QVERIFY(createVersion9Database(myTempDatabase.fileName(),
+                                       {QStringLiteral("INSERT INTO `Albums` VALUES (2, 'album2', 'artist1', '/old/', '', NULL)"),
+                                        QStringLiteral("INSERT INTO `Albums` VALUES (3, 'album2', NULL, '/old/', '', NULL)"),
+                                        QStringLiteral("INSERT INTO `Tracks` (`ID`, `Title`, `ArtistName`, `AlbumTitle`, `AlbumArtistName`, `AlbumPath`, "
+                                                       "`TrackNumber`, `DiscNumber`, `Duration`, `Genre`, `HasEmbeddedCover`, `ImportDate`, `PlayCounter`) "
+                                                       "VALUES (2, 'track2', 'artist1', 'album2', NULL, '/old/', 1, 1, 1000, 'genre1', 0, 0, 0)")}));
+
+        {
+            DatabaseInterface musicDb;
+
+            QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+            musicDb.init(QStringLiteral("testDb"), myTempDatabase.fileName());
+
+            QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+        }
+
+        {
+            auto checkDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), QStringLiteral("checkDatabase"));
+            checkDatabase.setDatabaseName(myTempDatabase.fileName());
+            QVERIFY(checkDatabase.open());
+
+            QSqlQuery albumIdQuery(checkDatabase);
+            QVERIFY(albumIdQuery.exec(QStringLiteral("SELECT `ID`, `AlbumID` FROM `Tracks` ORDER BY `ID`")));
+
+            QVERIFY(albumIdQuery.next());
+            QCOMPARE(albumIdQuery.value(1).toInt(), 1);
+            QVERIFY(albumIdQuery.next());
+            QCOMPARE(albumIdQuery.value(1).toInt(), 3);
+
+            albumIdQuery.finish();
+
+            QVERIFY(checkDatabase.tables().contains(QStringLiteral("DatabaseVersionV12")));
+            QVERIFY(checkDatabase.record(QStringLiteral("TracksMapping")).contains(QStringLiteral("FileSize")));
+
+            checkDatabase.close();
+        }
+        QSqlDatabase::removeDatabase(QStringLiteral("checkDatabase"));
+    }
+
+    void failedUpgradeFromVersion9()
+    {
+        QTemporaryFile myTempDatabase;
+        myTempDatabase.open();
+
+        /* filling AlbumID needs the Albums table */
+        QVERIFY(createVersion9Database(myTempDatabase.fileName(), {QStringLiteral("DROP TABLE `Albums`")}));
+
+        {
+            DatabaseInterface musicDb;
+
+            QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+            musicDb.init(QStringLiteral("testDb"), myTempDatabase.fileName());
+
+            QVERIFY(musicDbDatabaseErrorSpy.count() > 0);
+        }
+
+        {
+            auto checkDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), QStringLiteral("checkDatabase"));
+            checkDatabase.setDatabaseName(myTempDatabase.fileName());
+            QVERIFY(checkDatabase.open());
+
+            const auto allTables = checkDatabase.tables();
+            QVERIFY(allTables.contains(QStringLiteral("DatabaseVersionV9")));
+            QVERIFY(!allTables.contains(QStringLiteral("DatabaseVersionV10")));
+            QVERIFY(!allTables.contains(QStringLiteral("DatabaseVersionV11")));
+            QVERIFY(!allTables.contains(QStringLiteral("DatabaseVersionV12")));
+
+            QCOMPARE(checkDatabase.record(QStringLiteral("Tracks")).contains(QStringLiteral("ArtistID")), false);
+
+            checkDatabase.close();
+        }
+        QSqlDatabase::removeDatabase(QStringLiteral("checkDatabase"));
+    }
+
+    void updateTracksLoudness()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbTracksWithoutLoudnessSpy(&musicDb, &DatabaseInterface::tracksWithoutLoudness);
+        QSignalSpy musicDbTrackModifiedSpy(&musicDb, &DatabaseInterface::trackModified);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        musicDb.askTracksWithoutLoudness();
+
+        QCOMPARE(musicDbTracksWithoutLoudnessSpy.count(), 1);
+
+        const auto allTracksCount = musicDb.allTracksData().count();
+        QCOMPARE(musicDbTracksWithoutLoudnessSpy.at(0).at(0).value<DatabaseInterface::ListTrackDataType>().count(), allTracksCount);
+
+        auto albumId = musicDb.albumIdFromTitleAndArtist(QStringLiteral("album1"), QStringLiteral("Various Artists"));
+        auto albumTracks = musicDb.albumData(albumId);
+
+        QVERIFY(albumTracks.count() > 1);
+        QVERIFY(albumTracks.at(0)[DatabaseInterface::TrackGainRole].isNull());
+
+        musicDb.updateTracksLoudness({{{DatabaseInterface::DatabaseIdRole, albumTracks.at(0).databaseId()},
+                                       {DatabaseInterface::AlbumIdRole, albumId},
+                                       {DatabaseInterface::TrackGainRole, -3.},
+                                       {DatabaseInterface::TrackPeakRole, 0.5}}});
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+        QCOMPARE(musicDbTrackModifiedSpy.count(), 1);
+
+        albumTracks = musicDb.albumData(albumId);
+
+        QCOMPARE(albumTracks.at(0)[DatabaseInterface::TrackGainRole].toDouble(), -3.);
+        QCOMPARE(albumTracks.at(0)[DatabaseInterface::TrackPeakRole].toDouble(), 0.5);
+        QVERIFY(albumTracks.at(0)[DatabaseInterface::AlbumGainRole].isNull());
+
+        auto analyzedTracks = DatabaseInterface::ListTrackDataType{};
+        for (int i = 1; i < albumTracks.count(); ++i) {
+            analyzedTracks.push_back({{DatabaseInterface::DatabaseIdRole, albumTracks.at(i).databaseId()},
+                                      {DatabaseInterface::AlbumIdRole, albumId},
+                                      {DatabaseInterface::TrackGainRole, -3.},
+                                      {DatabaseInterface::TrackPeakRole, (i == 1 ? 0.8 : 0.5)}});
+        }
+
+        musicDbTrackModifiedSpy.clear();
+
+        musicDb.updateTracksLoudness(analyzedTracks);
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+        QCOMPARE(musicDbTrackModifiedSpy.count(), albumTracks.count());
+
+        albumTracks = musicDb.albumData(albumId);
+
+        for (const auto &oneTrack : albumTracks) {
+            QVERIFY(qAbs(oneTrack[DatabaseInterface::AlbumGainRole].toDouble() - (-3.)) < 0.001);
+            QCOMPARE(oneTrack[DatabaseInterface::AlbumPeakRole].toDouble(), 0.8);
+        }
+
+        musicDb.askTracksWithoutLoudness();
+
+        QCOMPARE(musicDbTracksWithoutLoudnessSpy.count(), 2);
+        QCOMPARE(musicDbTracksWithoutLoudnessSpy.at(1).at(0).value<DatabaseInterface::ListTrackDataType>().count(),
+                 allTracksCount - albumTracks.count());
+    }
+
+    void failedTrackLoudness()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbTracksWithoutLoudnessSpy(&musicDb, &DatabaseInterface::tracksWithoutLoudness);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        const auto allTracksCount = musicDb.allTracksData().count();
+
+        auto albumId = musicDb.albumIdFromTitleAndArtist(QStringLiteral("album1"), QStringLiteral("Various Artists"));
+        auto albumTracks = musicDb.albumData(albumId);
+
+        QVERIFY(albumTracks.count() > 1);
+
+        auto analyzedTracks = DatabaseInterface::ListTrackDataType{};
+        analyzedTracks.push_back({{DatabaseInterface::DatabaseIdRole, albumTracks.at(0).databaseId()},
+                                  {DatabaseInterface::AlbumIdRole, albumId},
+                                  {DatabaseInterface::TrackGainRole, QVariant{}},
+                                  {DatabaseInterface::TrackPeakRole, LoudnessAnalyzer::failedAnalysisPeak()}});
+        for (int i = 1; i < albumTracks.count(); ++i) {
+            analyzedTracks.push_back({{DatabaseInterface::DatabaseIdRole, albumTracks.at(i).databaseId()},
+                                      {DatabaseInterface::AlbumIdRole, albumId},
+                                      {DatabaseInterface::TrackGainRole, -3.},
+                                      {DatabaseInterface::TrackPeakRole, 0.5}});
+        }
+
+        musicDb.updateTracksLoudness(analyzedTracks);
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        albumTracks = musicDb.albumData(albumId);
+
+        QVERIFY(albumTracks.at(0)[DatabaseInterface::TrackGainRole].isNull());
+        for (const auto &oneTrack : albumTracks) {
+            QVERIFY(qAbs(oneTrack[DatabaseInterface::AlbumGainRole].toDouble() - (-3.)) < 0.001);
+        }
+
+        musicDb.askTracksWithoutLoudness();
+
+        QCOMPARE(musicDbTracksWithoutLoudnessSpy.count(), 1);
+        QCOMPARE(musicDbTracksWithoutLoudnessSpy.at(0).at(0).value<DatabaseInterface::ListTrackDataType>().count(),
+                 allTracksCount - albumTracks.count());
+    }
+
+    void renameOneTrack()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbTrackRemovedSpy(&musicDb, &DatabaseInterface::trackRemoved);
+        QSignalSpy musicDbAlbumRemovedSpy(&musicDb, &DatabaseInterface::albumRemoved);
+        QSignalSpy musicDbTrackModifiedSpy(&musicDb, &DatabaseInterface::trackModified);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        const auto allTracksCount = musicDb.allTracksData().count();
+
+        auto trackId = musicDb.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track1"), QStringLiteral("artist1"),
+                                                                    QStringLiteral("album1"), 1, 1);
+
+        QVERIFY2(trackId != 0, "trackId should be different from 0");
+
+        const auto oldFileName = musicDb.trackDataFromDatabaseId(trackId).resourceURI();
+        const auto newFileName = QUrl::fromLocalFile(QStringLiteral("/moved/$1"));
+
+        musicDb.trackHasStartedPlaying(oldFileName, QDateTime::currentDateTime());
+
+        QCOMPARE(musicDb.trackDataFromDatabaseId(trackId)[DatabaseInterface::PlayCounter].toInt(), 1);
+
+        musicDbTrackModifiedSpy.clear();
+
+        musicDb.renameTracksList({{oldFileName, newFileName},
+                                  {QUrl::fromLocalFile(QStringLiteral("/unknown")), QUrl::fromLocalFile(QStringLiteral("/unknown2"))}}, {});
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+        QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
+        QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
+        QCOMPARE(musicDbTrackModifiedSpy.count(), 1);
+        QCOMPARE(musicDb.allTracksData().count(), allTracksCount);
+
+        QCOMPARE(musicDb.trackIdFromFileName(oldFileName), qulonglong(0));
+        QCOMPARE(musicDb.trackIdFromFileName(newFileName), trackId);
+
+        const auto renamedTrack = musicDb.trackDataFromDatabaseId(trackId);
+
+        QCOMPARE(renamedTrack.resourceURI(), newFileName);
+        QCOMPARE(renamedTrack[DatabaseInterface::PlayCounter].toInt(), 1);
+    }
+
+    void renameAlbumToOtherDirectory()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbAlbumAddedSpy(&musicDb, &DatabaseInterface::albumsAdded);
+        QSignalSpy musicDbAlbumRemovedSpy(&musicDb, &DatabaseInterface::albumRemoved);
+        QSignalSpy musicDbTrackModifiedSpy(&musicDb, &DatabaseInterface::trackModified);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        const auto allTracksCount = musicDb.allTracksData().count();
+
+        auto trackId = musicDb.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track1"), QStringLiteral("artist2"),
+                                                                    QStringLiteral("album3"), 1, 1);
+
+        QVERIFY2(trackId != 0, "trackId should be different from 0");
+
+        const auto oldAlbumId = musicDb.albumIdFromTitleAndArtist(QStringLiteral("album3"), QStringLiteral("artist2"));
+        const auto newCover = QUrl::fromLocalFile(QStringLiteral("/moved/cover.jpg"));
+
+        QCOMPARE(musicDb.albumData(oldAlbumId).count(), 3);
+
+        musicDb.trackHasStartedPlaying(QUrl::fromLocalFile(QStringLiteral("/$11")), QDateTime::currentDateTime());
+
+        musicDbAlbumAddedSpy.clear();
+        musicDbTrackModifiedSpy.clear();
+
+        // all the tracks of the album leave their directory for another one
+        auto renamedTracks = QHash<QUrl, QUrl>{};
+        auto newCovers = QHash<QString, QUrl>{};
+        for (const auto &oneFileName : {QStringLiteral("$11"), QStringLiteral("$12"), QStringLiteral("$13")}) {
+            const auto newFileName = QUrl::fromLocalFile(QStringLiteral("/moved/") + oneFileName);
+
+            renamedTracks[QUrl::fromLocalFile(QStringLiteral("/") + oneFileName)] = newFileName;
+            newCovers[newFileName.toString()] = newCover;
+        }
+
+        musicDb.renameTracksList(renamedTracks, newCovers);
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+        QCOMPARE(musicDbAlbumAddedSpy.count(), 1);
+        QCOMPARE(musicDbAlbumRemovedSpy.count(), 1);
+        QCOMPARE(musicDbAlbumRemovedSpy.at(0).at(0).toULongLong(), oldAlbumId);
+        QCOMPARE(musicDbTrackModifiedSpy.count(), 3);
+        QCOMPARE(musicDb.allTracksData().count(), allTracksCount);
+
+        const auto renamedTrack = musicDb.trackDataFromDatabaseId(trackId);
+
+        QCOMPARE(renamedTrack.resourceURI(), QUrl::fromLocalFile(QStringLiteral("/moved/$11")));
+        QCOMPARE(renamedTrack[DatabaseInterface::PlayCounter].toInt(), 1);
+
+        const auto newAlbumId = renamedTrack[DatabaseInterface::AlbumIdRole].toULongLong();
+
+        QVERIFY(newAlbumId != 0);
+        QVERIFY(newAlbumId != oldAlbumId);
+        QCOMPARE(musicDb.albumIdFromTitleAndArtist(QStringLiteral("album3"), QStringLiteral("artist2")), newAlbumId);
+
+        const auto newAlbum = musicDb.albumDataFromDatabaseId(newAlbumId);
+
+        QCOMPARE(newAlbum.title(), QStringLiteral("album3"));
+        QCOMPARE(newAlbum.albumArtURI(), newCover);
+        QCOMPARE(musicDb.albumData(newAlbumId).count(), 3);
+    }
+
+    void setTracksEmbeddedCover()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbTrackModifiedSpy(&musicDb, &DatabaseInterface::trackModified);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        auto trackId = musicDb.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track1"), QStringLiteral("artist2"),
+                                                                    QStringLiteral("album3"), 1, 1);
+
+        QVERIFY2(trackId != 0, "trackId should be different from 0");
+
+        const auto trackFileName = musicDb.trackDataFromDatabaseId(trackId).resourceURI();
+
+        QCOMPARE(musicDb.trackDataFromDatabaseId(trackId).hasEmbeddedCover(), false);
+
+        musicDbTrackModifiedSpy.clear();
+
+        musicDb.setTracksEmbeddedCover({trackFileName, QUrl::fromLocalFile(QStringLiteral("/unknown"))});
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+        QCOMPARE(musicDbTrackModifiedSpy.count(), 1);
+        QCOMPARE(musicDb.trackDataFromDatabaseId(trackId).hasEmbeddedCover(), true);
+        QCOMPARE(musicDb.trackDataFromDatabaseId(trackId).title(), QStringLiteral("track1"));
+
+        // a rescan of the unchanged file without its picture is a modification too
+        auto modifiedTrack = *std::find_if(mNewTracks.begin(), mNewTracks.end(), [&trackFileName](const MusicAudioTrack &oneTrack) {
+            return oneTrack.resourceURI() == trackFileName;
+        });
+        QCOMPARE(modifiedTrack.hasEmbeddedCover(), false);
+
+        musicDb.modifyTracksList({modifiedTrack}, mNewCovers, QStringLiteral("autoTest"));
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+        QCOMPARE(musicDb.trackDataFromDatabaseId(trackId).hasEmbeddedCover(), false);
+    }
+
+    void removePreferredCopyOfDuplicateTrack()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbTrackRemovedSpy(&musicDb, &DatabaseInterface::trackRemoved);
+        QSignalSpy musicDbTrackModifiedSpy(&musicDb, &DatabaseInterface::trackModified);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        auto firstCopy = MusicAudioTrack{true, QStringLiteral("$23"), QStringLiteral("0"), QStringLiteral("track6"),
+                QStringLiteral("artist2"), QStringLiteral("album3"), QStringLiteral("artist2"),
+                6, 1, QTime::fromMSecsSinceStartOfDay(23), {QUrl::fromLocalFile(QStringLiteral("/$23"))},
+                QDateTime::fromMSecsSinceEpoch(23),
+        {QUrl::fromLocalFile(QStringLiteral("album3"))}, 5, true,
+                QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false};
+        auto secondCopy = firstCopy;
+        secondCopy.setResourceURI(QUrl::fromLocalFile(QStringLiteral("/$23.flac")));
+        auto thirdCopy = firstCopy;
+        thirdCopy.setResourceURI(QUrl::fromLocalFile(QStringLiteral("/$23.ogg")));
+
+        musicDb.insertTracksList({firstCopy, secondCopy}, mNewCovers, QStringLiteral("autoTest"));
+        musicDb.insertTracksList({thirdCopy}, mNewCovers, QStringLiteral("autoTest"));
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+        QCOMPARE(musicDb.allTracksData().count(), 1);
+
+        const auto trackId = musicDb.trackIdFromFileName(firstCopy.resourceURI());
+
+        QVERIFY2(trackId != 0, "trackId should be different from 0");
+        QCOMPARE(musicDb.trackIdFromFileName(secondCopy.resourceURI()), trackId);
+        QCOMPARE(musicDb.trackIdFromFileName(thirdCopy.resourceURI()), trackId);
+        QCOMPARE(musicDb.trackDataFromDatabaseId(trackId).resourceURI(), firstCopy.resourceURI());
+
+        musicDbTrackModifiedSpy.clear();
+
+        musicDb.removeTracksList({secondCopy.resourceURI()});
+
+        QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
+        QCOMPARE(musicDbTrackModifiedSpy.count(), 0);
+        QCOMPARE(musicDb.trackDataFromDatabaseId(trackId).resourceURI(), firstCopy.resourceURI());
+
+        musicDb.removeTracksList({firstCopy.resourceURI()});
+
+        QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
+        QCOMPARE(musicDbTrackModifiedSpy.count(), 1);
+        QCOMPARE(musicDb.allTracksData().count(), 1);
+        QCOMPARE(musicDb.trackDataFromDatabaseId(trackId).resourceURI(), thirdCopy.resourceURI());
+
+        musicDb.insertTracksList({secondCopy}, mNewCovers, QStringLiteral("autoTest"));
+
+        QCOMPARE(musicDb.trackIdFromFileName(secondCopy.resourceURI()), trackId);
+        QCOMPARE(musicDb.trackDataFromDatabaseId(trackId).resourceURI(), thirdCopy.resourceURI());
+
+        musicDb.removeTracksList({thirdCopy.resourceURI(), secondCopy.resourceURI()});
+
+        QCOMPARE(musicDbTrackRemovedSpy.count(), 1);
+        QCOMPARE(musicDb.allTracksData().count(), 0);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
 };
 
 QTEST_GUILESS_MAIN(DatabaseInterfaceTests)
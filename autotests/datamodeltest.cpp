@@ -19,6 +19,7 @@
 
 #include "musicaudiotrack.h"
 #include "databaseinterface.h"
+#include "datablock.h"
 #include "models/datamodel.h"
 #include "qabstractitemmodeltester.h"
 
@@ -1220,6 +1221,127 @@ private Q_SLOTS:
         QCOMPARE(endRemoveRowsSpy.count(), 0);
         QCOMPARE(dataChangedSpy.count(), 0);
     }
+
+    void removeOneAlbumFromDataBlockAllAlbums()
+    {
+        DatabaseInterface musicDb;
+        DataModel albumsModel;
+        QAbstractItemModelTester testModel(&albumsModel);
+
+        connect(&musicDb, &DatabaseInterface::albumModified,
+                &albumsModel, &DataModel::albumModified);
+        connect(&musicDb, &DatabaseInterface::albumRemoved,
+                &albumsModel, &DataModel::albumRemoved);
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        QSignalSpy beginInsertRowsSpy(&albumsModel, &DataModel::rowsAboutToBeInserted);
+        QSignalSpy endInsertRowsSpy(&albumsModel, &DataModel::rowsInserted);
+        QSignalSpy beginRemoveRowsSpy(&albumsModel, &DataModel::rowsAboutToBeRemoved);
+        QSignalSpy endRemoveRowsSpy(&albumsModel, &DataModel::rowsRemoved);
+        QSignalSpy dataChangedSpy(&albumsModel, &DataModel::dataChanged);
+
+        albumsModel.initialize(nullptr, ElisaUtils::Album);
+
+        const auto allAlbums = musicDb.allAlbumsData();
+        const auto allAlbumsBlock = musicDb.allAlbumsDataBlock();
+
+        QCOMPARE(allAlbumsBlock->rowCount(), allAlbums.count());
+        QCOMPARE(allAlbumsBlock->toList<DatabaseInterface::ListAlbumDataType>(), allAlbums);
+
+        albumsModel.dataBlockAdded(allAlbumsBlock);
+
+        QCOMPARE(albumsModel.rowCount(), 5);
+        QCOMPARE(beginInsertRowsSpy.count(), 1);
+        QCOMPARE(endInsertRowsSpy.count(), 1);
+        QCOMPARE(beginRemoveRowsSpy.count(), 0);
+        QCOMPARE(endRemoveRowsSpy.count(), 0);
+        QCOMPARE(dataChangedSpy.count(), 0);
+
+        for (int row = 0; row < allAlbums.count(); ++row) {
+            QCOMPARE(albumsModel.data(albumsModel.index(row, 0), DatabaseInterface::TitleRole), QVariant(allAlbums[row].title()));
+            QCOMPARE(albumsModel.data(albumsModel.index(row, 0), DatabaseInterface::DatabaseIdRole).toULongLong(), allAlbums[row].databaseId());
+        }
+
+        auto firstTrackId = musicDb.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track1"), QStringLiteral("artist2"),
+                                                                         QStringLiteral("album3"), 1, 1);
+        auto firstTrack = musicDb.trackDataFromDatabaseId(firstTrackId);
+        auto secondTrackId = musicDb.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track2"), QStringLiteral("artist2"),
+                                                                          QStringLiteral("album3"), 2, 1);
+        auto secondTrack = musicDb.trackDataFromDatabaseId(secondTrackId);
+        auto thirdTrackId = musicDb.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track3"), QStringLiteral("artist2"),
+                                                                         QStringLiteral("album3"), 3, 1);
+        auto thirdTrack = musicDb.trackDataFromDatabaseId(thirdTrackId);
+
+        musicDb.removeTracksList({firstTrack[DatabaseInterface::ResourceRole].toUrl(),
+                                  secondTrack[DatabaseInterface::ResourceRole].toUrl(),
+                                  thirdTrack[DatabaseInterface::ResourceRole].toUrl()});
+
+        QCOMPARE(albumsModel.rowCount(), 4);
+        QCOMPARE(beginInsertRowsSpy.count(), 1);
+        QCOMPARE(endInsertRowsSpy.count(), 1);
+        QCOMPARE(beginRemoveRowsSpy.count(), 1);
+        QCOMPARE(endRemoveRowsSpy.count(), 1);
+        QCOMPARE(dataChangedSpy.count(), 0);
+    }
+
+    void streamDataBlocksAllTracks()
+    {
+        DatabaseInterface musicDb;
+        DataModel tracksModel;
+        QAbstractItemModelTester testModel(&tracksModel);
+
+        connect(&musicDb, &DatabaseInterface::trackRemoved,
+                &tracksModel, &DataModel::trackRemoved);
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+        QSignalSpy beginInsertRowsSpy(&tracksModel, &DataModel::rowsAboutToBeInserted);
+        QSignalSpy endInsertRowsSpy(&tracksModel, &DataModel::rowsInserted);
+        QSignalSpy beginRemoveRowsSpy(&tracksModel, &DataModel::rowsAboutToBeRemoved);
+        QSignalSpy endRemoveRowsSpy(&tracksModel, &DataModel::rowsRemoved);
+
+        tracksModel.initialize(nullptr, ElisaUtils::Track);
+
+        const auto allTracks = musicDb.allTracksData();
+
+        auto streamedBlocksCount = 0;
+        auto stream = DataBlockStream{4, [&tracksModel, &streamedBlocksCount](const DataBlockPointer &dataBlock) {
+            ++streamedBlocksCount;
+            tracksModel.dataBlockAdded(dataBlock);
+        }};
+
+        musicDb.allTracksDataBlock(stream);
+
+        QCOMPARE(stream.rowCount(), allTracks.count());
+        QCOMPARE(streamedBlocksCount, (allTracks.count() + 3) / 4);
+        QCOMPARE(tracksModel.rowCount(), allTracks.count());
+        QCOMPARE(beginInsertRowsSpy.count(), streamedBlocksCount);
+        QCOMPARE(endInsertRowsSpy.count(), streamedBlocksCount);
+
+        for (int row = 0; row < allTracks.count(); ++row) {
+            QCOMPARE(tracksModel.data(tracksModel.index(row, 0), DatabaseInterface::TitleRole), QVariant(allTracks[row].title()));
+            QCOMPARE(tracksModel.data(tracksModel.index(row, 0), DatabaseInterface::DatabaseIdRole).toULongLong(), allTracks[row].databaseId());
+        }
+
+        for (int row = 1; row < allTracks.count(); ++row) {
+            QVERIFY(QString::compare(allTracks[row - 1].title(), allTracks[row].title(), Qt::CaseInsensitive) <= 0);
+        }
+
+        auto firstTrackId = musicDb.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track1"), QStringLiteral("artist2"),
+                                                                         QStringLiteral("album3"), 1, 1);
+        auto firstTrack = musicDb.trackDataFromDatabaseId(firstTrackId);
+
+        musicDb.removeTracksList({firstTrack[DatabaseInterface::ResourceRole].toUrl()});
+
+        QCOMPARE(tracksModel.rowCount(), allTracks.count() - 1);
+        QCOMPARE(beginRemoveRowsSpy.count(), 1);
+        QCOMPARE(endRemoveRowsSpy.count(), 1);
+    }
 };
 
 QTEST_GUILESS_MAIN(DataModelTests)
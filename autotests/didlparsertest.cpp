@@ -0,0 +1,305 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "upnp/didlparser.h"
+#include "upnp/upnppagingscheduler.h"
+
+#include "musicaudiotrack.h"
+
+#include <QObject>
+#include <QString>
+#include <QSet>
+#include <QHash>
+#include <QTimer>
+#include <QElapsedTimer>
+
+#include <QtTest>
+
+#include <functional>
+
+class MockContentDirectoryServer : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    using AnswerCallback = std::function<void(const UpnpPageRequest &request, const QString &result, int numberReturned, int totalMatches, bool success)>;
+
+    MockContentDirectoryServer(int itemsCount, QObject *parent = nullptr) : QObject(parent), mItemsCount(itemsCount)
+    {
+    }
+
+    /* answers like a Search on object.item.audioItem.musicTrack after the configured latency */
+    void search(const UpnpPageRequest &request, const AnswerCallback &answer)
+    {
+        ++mRequestsCount;
+        ++mOutstandingRequests;
+        mMaximumOutstandingRequests = std::max(mMaximumOutstandingRequests, mOutstandingRequests);
+
+        QTimer::singleShot(mLatency, this, [this, request, answer]() {
+            --mOutstandingRequests;
+
+            auto &failuresCount = mFailuresCount[request.mStartIndex];
+            if (mFailingStartIndexes.contains(request.mStartIndex) && failuresCount < mFailuresPerRequest) {
+                ++failuresCount;
+                answer(request, {}, 0, 0, false);
+                return;
+            }
+
+            auto requestedCount = (request.mRequestedCount == 0 ? mItemsCount : request.mRequestedCount);
+            if (mPageSizeLimit > 0) {
+                requestedCount = std::min(requestedCount, mPageSizeLimit);
+            }
+
+            const auto firstItem = std::min(request.mStartIndex, mItemsCount);
+            const auto lastItem = std::min(request.mStartIndex + requestedCount, mItemsCount);
+
+            auto result = QStringLiteral("<DIDL-Lite xmlns:dc=\"http://purl.org/dc/elements/1.1/\" "
+                                         "xmlns:upnp=\"urn:schemas-upnp-org:metadata-1-0/upnp/\" "
+                                         "xmlns=\"urn:schemas-upnp-org:metadata-1-0/DIDL-Lite/\">");
+            for (auto itemIndex = firstItem; itemIndex < lastItem; ++itemIndex) {
+                result += QStringLiteral("<item id=\"64$%1\" parentID=\"64\" restricted=\"1\">"
+                                         "<dc:title>Track %1</dc:title>"
+                                         "<upnp:class>object.item.audioItem.musicTrack</upnp:class>"
+                                         "<upnp:album>Album %2</upnp:album>"
+                                         "<res duration=\"0:03:25.000\">http://127.0.0.1:8200/MediaItems/%1.mp3</res>"
+                                         "</item>").arg(itemIndex).arg(itemIndex / 12);
+            }
+            result += QStringLiteral("</DIDL-Lite>");
+
+            answer(request, result, lastItem - firstItem, (mReportsTotalMatches ? mItemsCount : 0), true);
+        });
+    }
+
+    int mItemsCount = 0;
+
+    int mLatency = 5;
+
+    int mPageSizeLimit = 0;
+
+    bool mReportsTotalMatches = true;
+
+    QSet<int> mFailingStartIndexes;
+
+    int mFailuresPerRequest = 1;
+
+    QHash<int, int> mFailuresCount;
+
+    int mRequestsCount = 0;
+
+    int mOutstandingRequests = 0;
+
+    int mMaximumOutstandingRequests = 0;
+
+};
+
+/* a DidlParser whose Browse and Search pages are answered by MockContentDirectoryServer */
+class TestDidlParser : public DidlParser
+{
+    Q_OBJECT
+
+public:
+
+    TestDidlParser(MockContentDirectoryServer *server, QObject *parent = nullptr)
+        : DidlParser(parent), mServer(server)
+    {
+        connect(this, &DidlParser::isDataValidChanged, this, [this]() {
+            ++mFinishedCount;
+        });
+    }
+
+    QSet<QString> receivedIds() const
+    {
+        QSet<QString> result;
+
+        for (const auto &oneTrack : newMusicTracks()) {
+            result.insert(oneTrack.id());
+        }
+
+        return result;
+    }
+
+    int mFinishedCount = 0;
+
+protected:
+
+    void sendPageRequest(const UpnpPageRequest &request, int pagingGeneration) override
+    {
+        QElapsedTimer roundTripTimer;
+        roundTripTimer.start();
+
+        mServer->search(request, [this, pagingGeneration, roundTripTimer](const UpnpPageRequest &request, const QString &result, int numberReturned, int totalMatches, bool success) {
+            pageAnswered(request, pagingGeneration, success, numberReturned, totalMatches, result, roundTripTimer.elapsed());
+        });
+    }
+
+private:
+
+    MockContentDirectoryServer *mServer = nullptr;
+
+};
+
+class DidlParserTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    DidlParserTest(QObject *parent = nullptr) : QObject(parent)
+    {
+    }
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        qRegisterMetaType<QList<MusicAudioTrack>>("QList<MusicAudioTrack>");
+        qRegisterMetaType<QHash<QString,QUrl>>("QHash<QString,QUrl>");
+    }
+
+    void pipelinedSearch()
+    {
+        MockContentDirectoryServer myServer(3000);
+        TestDidlParser myParser(&myServer);
+
+        QSignalSpy tracksBatchSpy(&myParser, &DidlParser::newMusicTracksBatch);
+
+        myParser.search();
+
+        QTRY_COMPARE_WITH_TIMEOUT(myParser.mFinishedCount, 1, 10000);
+
+        QVERIFY(myParser.isDataValid());
+        QCOMPARE(myParser.newMusicTracks().size(), 3000);
+        QCOMPARE(myParser.receivedIds().size(), 3000);
+        QCOMPARE(myServer.mMaximumOutstandingRequests, 4);
+
+        auto batchedTracksCount = 0;
+        for (const auto &oneBatch : tracksBatchSpy) {
+            batchedTracksCount += oneBatch.at(1).value<QList<MusicAudioTrack>>().size();
+        }
+        QCOMPARE(batchedTracksCount, 3000);
+    }
+
+    void serverPageSizeLimit()
+    {
+        MockContentDirectoryServer myServer(1000);
+        myServer.mPageSizeLimit = 30;
+
+        TestDidlParser myParser(&myServer);
+
+        myParser.search();
+
+        QTRY_COMPARE_WITH_TIMEOUT(myParser.mFinishedCount, 1, 10000);
+
+        QVERIFY(myParser.isDataValid());
+        QCOMPARE(myParser.newMusicTracks().size(), 1000);
+        QCOMPARE(myParser.receivedIds().size(), 1000);
+    }
+
+    void unknownTotalMatches()
+    {
+        MockContentDirectoryServer myServer(550);
+        myServer.mReportsTotalMatches = false;
+
+        TestDidlParser myParser(&myServer);
+
+        myParser.search();
+
+        QTRY_COMPARE_WITH_TIMEOUT(myParser.mFinishedCount, 1, 10000);
+
+        QVERIFY(myParser.isDataValid());
+        QCOMPARE(myParser.newMusicTracks().size(), 550);
+        QCOMPARE(myParser.receivedIds().size(), 550);
+        QCOMPARE(myServer.mMaximumOutstandingRequests, 1);
+    }
+
+    void failedPagesAreRetried()
+    {
+        MockContentDirectoryServer myServer(1000);
+        myServer.mFailingStartIndexes = {0, 300};
+
+        TestDidlParser myParser(&myServer);
+
+        myParser.search();
+
+        QTRY_COMPARE_WITH_TIMEOUT(myParser.mFinishedCount, 1, 10000);
+
+        QVERIFY(myParser.isDataValid());
+        QCOMPARE(myParser.newMusicTracks().size(), 1000);
+        QCOMPARE(myParser.receivedIds().size(), 1000);
+    }
+
+    void failedPagesStopPaging()
+    {
+        MockContentDirectoryServer myServer(1000);
+        myServer.mFailingStartIndexes = {100};
+        myServer.mFailuresPerRequest = 10;
+
+        TestDidlParser myParser(&myServer);
+
+        myParser.search();
+
+        QTRY_COMPARE_WITH_TIMEOUT(myParser.mFinishedCount, 1, 10000);
+
+        QVERIFY(!myParser.isDataValid());
+        QCOMPARE(myServer.mOutstandingRequests, 0);
+        QVERIFY(myParser.newMusicTracks().size() < 1000);
+    }
+
+    void emptyServer()
+    {
+        MockContentDirectoryServer myServer(0);
+        TestDidlParser myParser(&myServer);
+
+        myParser.search();
+
+        QTRY_COMPARE_WITH_TIMEOUT(myParser.mFinishedCount, 1, 10000);
+
+        QVERIFY(myParser.isDataValid());
+        QVERIFY(myParser.newMusicTracks().isEmpty());
+        QCOMPARE(myServer.mRequestsCount, 1);
+    }
+
+    void restartedSearchDropsStaleAnswers()
+    {
+        MockContentDirectoryServer myServer(3000);
+        myServer.mLatency = 50;
+
+        TestDidlParser myParser(&myServer);
+
+        myParser.search();
+
+        // the first page is answered and the next pages are in flight when the search restarts
+        QTRY_VERIFY_WITH_TIMEOUT(myServer.mRequestsCount > 1, 10000);
+        QVERIFY(myServer.mOutstandingRequests > 0);
+
+        myParser.search();
+
+        QTRY_COMPARE_WITH_TIMEOUT(myParser.mFinishedCount, 1, 10000);
+        QTRY_COMPARE_WITH_TIMEOUT(myServer.mOutstandingRequests, 0, 10000);
+
+        QCOMPARE(myParser.mFinishedCount, 1);
+        QVERIFY(myParser.isDataValid());
+        QCOMPARE(myParser.newMusicTracks().size(), 3000);
+        QCOMPARE(myParser.receivedIds().size(), 3000);
+    }
+};
+
+QTEST_GUILESS_MAIN(DidlParserTest)
+
+
+#include "didlparsertest.moc"
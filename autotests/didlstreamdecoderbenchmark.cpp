@@ -0,0 +1,188 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "upnp/didlstreamdecoder.h"
+
+#include <QObject>
+#include <QString>
+
+#include <QtTest>
+
+class DidlStreamDecoderBenchmark: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    DidlStreamDecoderBenchmark(QObject *parent = nullptr) : QObject(parent)
+    {
+    }
+
+private:
+
+    static const int mItemsCount = 5000;
+
+    static const int mAlbumTracksCount = 12;
+
+    QString mLargePage;
+
+    /* item layout recorded from a MiniDLNA answer to a Search on object.item.audioItem.musicTrack */
+    static QString didlItem(int index)
+    {
+        return QStringLiteral("<item id=\"64$%1$%2\" parentID=\"64$%1\" restricted=\"1\">"
+                              "<dc:title>Track %2 &amp; Friends</dc:title>"
+                              "<upnp:class>object.item.audioItem.musicTrack</upnp:class>"
+                              "<dc:creator>Artist %1</dc:creator>"
+                              "<dc:date>2018-01-01</dc:date>"
+                              "<upnp:artist>Album Artist %1</upnp:artist>"
+                              "<upnp:album>Album %1</upnp:album>"
+                              "<upnp:genre>Rock</upnp:genre>"
+                              "<upnp:originalTrackNumber>%2</upnp:originalTrackNumber>"
+                              "<upnp:albumArtURI dlna:profileID=\"JPEG_TN\">http://192.168.1.2:8200/AlbumArt/%1-%3.jpg</upnp:albumArtURI>"
+                              "<res size=\"8230154\" duration=\"0:03:25.000\" bitrate=\"40000\" sampleFrequency=\"44100\" nrAudioChannels=\"2\" "
+                              "protocolInfo=\"http-get:*:audio/mpeg:DLNA.ORG_PN=MP3;DLNA.ORG_OP=01;DLNA.ORG_CI=0;DLNA.ORG_FLAGS=01700000000000000000000000000000\">"
+                              "http://192.168.1.2:8200/MediaItems/%3.mp3</res>"
+                              "</item>")
+                .arg(index / mAlbumTracksCount)
+                .arg(index % mAlbumTracksCount + 1)
+                .arg(index);
+    }
+
+    static QString didlPage(int itemsCount)
+    {
+        auto result = QStringLiteral("<DIDL-Lite xmlns:dc=\"http://purl.org/dc/elements/1.1/\" "
+                                     "xmlns:upnp=\"urn:schemas-upnp-org:metadata-1-0/upnp/\" "
+                                     "xmlns=\"urn:schemas-upnp-org:metadata-1-0/DIDL-Lite/\" "
+                                     "xmlns:dlna=\"urn:schemas-dlna-org:metadata-1-0/\">");
+
+        for (int i = 0; i < itemsCount; ++i) {
+            result += didlItem(i);
+        }
+
+        result += QStringLiteral("</DIDL-Lite>");
+
+        return result;
+    }
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        mLargePage = didlPage(mItemsCount);
+    }
+
+    void decodeItems()
+    {
+        DidlStreamDecoder myDecoder;
+
+        QVERIFY(myDecoder.decode(didlPage(2)));
+
+        QCOMPARE(myDecoder.newMusicTrackIds().count(), 2);
+        QCOMPARE(myDecoder.newMusicTracks().count(), 2);
+
+        const auto &firstTrack = myDecoder.newMusicTracks()[QStringLiteral("64$0$1")];
+
+        QCOMPARE(firstTrack.id(), QStringLiteral("64$0$1"));
+        QCOMPARE(firstTrack.parentId(), QStringLiteral("64$0"));
+        QCOMPARE(firstTrack.title(), QStringLiteral("Track 1 & Friends"));
+        QCOMPARE(firstTrack.artist(), QStringLiteral("Artist 0"));
+        QCOMPARE(firstTrack.albumArtist(), QStringLiteral("Album Artist 0"));
+        QCOMPARE(firstTrack.albumName(), QStringLiteral("Album 0"));
+        QCOMPARE(firstTrack.trackNumber(), 1);
+        QCOMPARE(firstTrack.duration(), QTime(0, 3, 25));
+        QCOMPARE(firstTrack.resourceURI(), QUrl(QStringLiteral("http://192.168.1.2:8200/MediaItems/0.mp3")));
+
+        QCOMPARE(myDecoder.covers().count(), 1);
+        QCOMPARE(myDecoder.covers()[QStringLiteral("Album 0")], QUrl(QStringLiteral("http://192.168.1.2:8200/AlbumArt/0-1.jpg")));
+    }
+
+    void decodeContainers()
+    {
+        DidlStreamDecoder myDecoder;
+
+        QVERIFY(myDecoder.decode(QStringLiteral("<DIDL-Lite>"
+                                                "<container id=\"7\" parentID=\"1\" childCount=\"12\" restricted=\"1\">"
+                                                "<dc:title>Album 0</dc:title>"
+                                                "<upnp:artist>Album Artist 0</upnp:artist>"
+                                                "<upnp:class>object.container.album.musicAlbum</upnp:class>"
+                                                "<upnp:albumArtURI>http://192.168.1.2:8200/AlbumArt/7.jpg</upnp:albumArtURI>"
+                                                "</container>"
+                                                "</DIDL-Lite>")));
+
+        QCOMPARE(myDecoder.newContainerIds(), QVector<QString>{QStringLiteral("7")});
+
+        const auto &oneContainer = myDecoder.newContainers()[QStringLiteral("7")];
+
+        QCOMPARE(oneContainer.mParentId, QStringLiteral("1"));
+        QCOMPARE(oneContainer.mChildCount, 12);
+        QCOMPARE(oneContainer.mTitle, QStringLiteral("Album 0"));
+        QCOMPARE(oneContainer.mArtist, QStringLiteral("Album Artist 0"));
+        QCOMPARE(oneContainer.mAlbumArtURI, QUrl(QStringLiteral("http://192.168.1.2:8200/AlbumArt/7.jpg")));
+    }
+
+    void decodeDuration()
+    {
+        QCOMPARE(DidlStreamDecoder::decodeDuration(QStringLiteral("0:03:25.000")), QTime(0, 3, 25));
+        QCOMPARE(DidlStreamDecoder::decodeDuration(QStringLiteral("1:03:25")), QTime(1, 3, 25));
+    }
+
+    void accumulatePages()
+    {
+        DidlStreamDecoder myDecoder;
+
+        QVERIFY(myDecoder.decode(didlPage(3)));
+        QVERIFY(myDecoder.decode(didlPage(3)));
+
+        QCOMPARE(myDecoder.newMusicTrackIds().count(), 6);
+        QCOMPARE(myDecoder.newMusicTracks().count(), 3);
+
+        myDecoder.clear();
+
+        QVERIFY(myDecoder.newMusicTrackIds().isEmpty());
+        QVERIFY(myDecoder.newMusicTracks().isEmpty());
+        QVERIFY(myDecoder.covers().isEmpty());
+    }
+
+    void invalidContent()
+    {
+        DidlStreamDecoder myDecoder;
+
+        QVERIFY(!myDecoder.decode(QStringLiteral("<DIDL-Lite><item id=\"1\"><dc:title>truncated")));
+    }
+
+    void benchmarkLargePage()
+    {
+        qint64 decodedTracksCount = 0;
+
+        QBENCHMARK {
+            DidlStreamDecoder myDecoder;
+
+            myDecoder.decode(mLargePage);
+
+            decodedTracksCount = myDecoder.newMusicTracks().count();
+        }
+
+        QCOMPARE(decodedTracksCount, static_cast<qint64>(mItemsCount));
+
+        qInfo() << "decoded" << mItemsCount << "items from" << mLargePage.size() * 2 / 1024 << "KiB of DIDL-Lite";
+    }
+};
+
+QTEST_GUILESS_MAIN(DidlStreamDecoderBenchmark)
+
+
+#include "didlstreamdecoderbenchmark.moc"
@@ -0,0 +1,210 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "abstractfile/directoryscanorder.h"
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QTemporaryDir>
+#include <QStringList>
+
+#if defined Q_OS_UNIX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <QtTest>
+
+Q_DECLARE_METATYPE(DirectoryScanOrder::Mode)
+
+/* cold cache scan of a music like tree: put TMPDIR on the storage to measure, a tmpfs has no cold cache */
+class DirectoryScanOrderBenchmark: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    DirectoryScanOrderBenchmark(QObject *parent = nullptr) : QObject(parent)
+    {
+    }
+
+private:
+
+    static const int mDirectoriesCount = 16;
+
+    static const int mFilesPerDirectory = 16;
+
+    static const int mFileSize = 192 * 1024;
+
+    static const int mHeadReadSize = 64 * 1024;
+
+    static const int mTailReadSize = 128;
+
+    QTemporaryDir mRootDirectory;
+
+    QStringList mAllFiles;
+
+    static void dropCachedPages(const QString &fileName)
+    {
+#if defined Q_OS_LINUX || defined Q_OS_FREEBSD
+        const auto fileDescriptor = ::open(QFile::encodeName(fileName).constData(), O_RDONLY | O_CLOEXEC);
+        if (fileDescriptor < 0) {
+            return;
+        }
+
+        ::fdatasync(fileDescriptor);
+        ::posix_fadvise(fileDescriptor, 0, 0, POSIX_FADV_DONTNEED);
+
+        ::close(fileDescriptor);
+#else
+        Q_UNUSED(fileName);
+#endif
+    }
+
+    void dropAllCachedPages()
+    {
+        for (const auto &oneFile : qAsConst(mAllFiles)) {
+            dropCachedPages(oneFile);
+        }
+    }
+
+    /* reads what a tag reader reads: the start and the end of each file */
+    static int scanDirectoryTree(const QString &directoryPath, DirectoryScanOrder::Mode mode, bool prefetch)
+    {
+        auto scannedFiles = 0;
+
+        const auto allEntries = DirectoryScanOrder::entryInfoList(directoryPath, mode);
+
+        if (prefetch) {
+            for (const auto &oneEntry : allEntries) {
+                if (oneEntry.isFile()) {
+                    DirectoryScanOrder::prefetchTagRegions(oneEntry.filePath());
+                }
+            }
+        }
+
+        for (const auto &oneEntry : allEntries) {
+            if (oneEntry.isDir()) {
+                scannedFiles += scanDirectoryTree(oneEntry.filePath(), mode, prefetch);
+                continue;
+            }
+
+            QFile oneFile(oneEntry.filePath());
+            if (!oneFile.open(QIODevice::ReadOnly)) {
+                continue;
+            }
+
+            const auto head = oneFile.read(mHeadReadSize);
+            oneFile.seek(oneFile.size() - mTailReadSize);
+            const auto tail = oneFile.read(mTailReadSize);
+
+            if (head.size() == mHeadReadSize && tail.size() == mTailReadSize) {
+                ++scannedFiles;
+            }
+        }
+
+        return scannedFiles;
+    }
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        QVERIFY(mRootDirectory.isValid());
+
+        auto fileContent = QByteArray(mFileSize, '\0');
+        for (int i = 0; i < fileContent.size(); ++i) {
+            fileContent[i] = static_cast<char>((i * 7919) & 0xFF);
+        }
+        fileContent.replace(0, 3, "ID3");
+
+        // files are created interleaved between directories, like a library filled album after album by several tools
+        for (int fileIndex = 0; fileIndex < mFilesPerDirectory; ++fileIndex) {
+            for (int directoryIndex = 0; directoryIndex < mDirectoriesCount; ++directoryIndex) {
+                const auto directoryPath = mRootDirectory.path() + QStringLiteral("/artist%1/album").arg(directoryIndex);
+
+                QDir().mkpath(directoryPath);
+
+                const auto fileName = directoryPath + QStringLiteral("/%1 - track.mp3").arg(mFilesPerDirectory - fileIndex, 2, 10, QLatin1Char('0'));
+
+                QFile newFile(fileName);
+                QVERIFY(newFile.open(QIODevice::WriteOnly));
+                QCOMPARE(newFile.write(fileContent), qint64(fileContent.size()));
+
+                mAllFiles.push_back(fileName);
+            }
+        }
+    }
+
+    void sameEntriesInAllOrders()
+    {
+        const auto directoryPath = mRootDirectory.path() + QStringLiteral("/artist0/album");
+
+        auto listingOrderNames = QStringList();
+        for (const auto &oneEntry : DirectoryScanOrder::entryInfoList(directoryPath, DirectoryScanOrder::Mode::ListingOrder)) {
+            listingOrderNames.push_back(oneEntry.fileName());
+        }
+
+        auto inodeOrderNames = QStringList();
+        for (const auto &oneEntry : DirectoryScanOrder::entryInfoList(directoryPath, DirectoryScanOrder::Mode::InodeOrder)) {
+            inodeOrderNames.push_back(oneEntry.fileName());
+        }
+
+        QCOMPARE(inodeOrderNames.size(), int(mFilesPerDirectory));
+
+        listingOrderNames.sort();
+        inodeOrderNames.sort();
+
+        QCOMPARE(inodeOrderNames, listingOrderNames);
+    }
+
+    void coldCacheScan_data()
+    {
+        QTest::addColumn<DirectoryScanOrder::Mode>("mode");
+        QTest::addColumn<bool>("prefetch");
+
+        QTest::newRow("listing order") << DirectoryScanOrder::Mode::ListingOrder << false;
+        QTest::newRow("inode order") << DirectoryScanOrder::Mode::InodeOrder << false;
+        QTest::newRow("inode order and readahead") << DirectoryScanOrder::Mode::InodeOrder << true;
+    }
+
+    void coldCacheScan()
+    {
+        QFETCH(DirectoryScanOrder::Mode, mode);
+        QFETCH(bool, prefetch);
+
+        dropAllCachedPages();
+
+        auto scannedFiles = 0;
+
+        QBENCHMARK_ONCE {
+            scannedFiles = scanDirectoryTree(mRootDirectory.path(), mode, prefetch);
+        }
+
+        QCOMPARE(scannedFiles, mDirectoriesCount * mFilesPerDirectory);
+    }
+
+};
+
+QTEST_GUILESS_MAIN(DirectoryScanOrderBenchmark)
+
+
+#include "directoryscanorderbenchmark.moc"
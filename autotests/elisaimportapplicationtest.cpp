@@ -0,0 +1,112 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "elisaimportapplication.h"
+#include "databaseinterface.h"
+#include "musicaudiotrack.h"
+
+#include "config-upnp-qt.h"
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QUrl>
+#include <QDir>
+#include <QFile>
+#include <QTimer>
+#include <QTemporaryDir>
+
+#include <QtTest>
+
+class ElisaImportApplicationTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    ElisaImportApplicationTest(QObject *parent = nullptr) : QObject(parent)
+    {
+    }
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        qRegisterMetaType<QHash<QString,QUrl>>("QHash<QString,QUrl>");
+        qRegisterMetaType<QHash<QUrl,QUrl>>("QHash<QUrl,QUrl>");
+        qRegisterMetaType<QList<MusicAudioTrack>>("QList<MusicAudioTrack>");
+        qRegisterMetaType<QVector<qulonglong>>("QVector<qulonglong>");
+        qRegisterMetaType<QHash<qulonglong,int>>("QHash<qulonglong,int>");
+        qRegisterMetaType<QList<QUrl>>("QList<QUrl>");
+        qRegisterMetaType<DatabaseInterface::ListTrackDataType>("DatabaseInterface::ListTrackDataType");
+    }
+
+    void importWaitsForAllRoots()
+    {
+        const auto tracksCount = 200;
+
+        QTemporaryDir workingDirectory;
+        QVERIFY(workingDirectory.isValid());
+
+        QDir rootDirectory(workingDirectory.path());
+        QVERIFY(rootDirectory.mkpath(QStringLiteral("small")));
+        QVERIFY(rootDirectory.mkpath(QStringLiteral("large")));
+
+        const auto smallRootPath = workingDirectory.path() + QStringLiteral("/small");
+        const auto largeRootPath = workingDirectory.path() + QStringLiteral("/large");
+        const auto sampleTrack = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music/test.ogg");
+
+        for (int trackIndex = 0; trackIndex < tracksCount; ++trackIndex) {
+            QVERIFY(QFile::copy(sampleTrack, largeRootPath + QStringLiteral("/track%1.ogg").arg(trackIndex)));
+        }
+
+        ElisaImportApplication myImport;
+        myImport.setRootPaths({smallRootPath, largeRootPath});
+        myImport.setDatabaseFileName(workingDirectory.path() + QStringLiteral("/database.sqlite"));
+
+        QSignalSpy importFinishedSpy(&myImport, &ElisaImportApplication::importFinished);
+
+        // each new file in the small root makes its listener report a finished indexing again
+        auto changedFilesCount = 0;
+        QTimer changeSmallRoot;
+        changeSmallRoot.setInterval(20);
+        connect(&changeSmallRoot, &QTimer::timeout, this, [&]() {
+            QFile::copy(sampleTrack, smallRootPath + QStringLiteral("/changed%1.ogg").arg(changedFilesCount++));
+        });
+
+        myImport.start();
+        changeSmallRoot.start();
+
+        QVERIFY(importFinishedSpy.wait(60000));
+
+        changeSmallRoot.stop();
+
+        const auto importReport = myImport.report();
+
+        QCOMPARE(importFinishedSpy.count(), 1);
+        QVERIFY(importReport[QStringLiteral("databaseTracks")].toInt() >= tracksCount);
+        QCOMPARE(importReport[QStringLiteral("importedTracks")].toInt(), importReport[QStringLiteral("databaseTracks")].toInt());
+
+        QCOMPARE(importFinishedSpy.wait(200), false);
+    }
+};
+
+QTEST_GUILESS_MAIN(ElisaImportApplicationTest)
+
+
+#include "elisaimportapplicationtest.moc"
@@ -0,0 +1,199 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "abstractfile/embeddedcoverprobe.h"
+
+#include "generatedtagdata.h"
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QBuffer>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <QtTest>
+
+class EmbeddedCoverProbeTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    EmbeddedCoverProbeTest(QObject *parent = nullptr) : QObject(parent)
+    {
+    }
+
+private:
+
+    /* the tag is followed by padding and an MPEG audio frame */
+    static QByteArray id3v2File(int majorVersion, const QByteArray &frames)
+    {
+        return GeneratedTagData::id3v2Tag(majorVersion, frames + QByteArray(20, '\0')) + QByteArray("\xff\xfb\x90\x00", 4);
+    }
+
+    static QByteArray attachedPicture(int pictureType)
+    {
+        return QByteArray("\0image/jpeg\0", 12) + static_cast<char>(pictureType) + QByteArray("description\0", 12) + QByteArray(300, 'p');
+    }
+
+    static QByteArray mp4File(const QByteArray &ilstContent)
+    {
+        const auto metaAtom = GeneratedTagData::mp4Atom("meta", QByteArray(4, '\0') + GeneratedTagData::mp4Atom("hdlr", QByteArray(25, '\0')) +
+                                                        GeneratedTagData::mp4Atom("ilst", ilstContent));
+
+        return GeneratedTagData::mp4Atom("ftyp", QByteArray("M4A ") + QByteArray(4, '\0')) +
+                GeneratedTagData::mp4Atom("mdat", QByteArray(5000, 'm')) +
+                GeneratedTagData::mp4Atom("moov", GeneratedTagData::mp4Atom("mvhd", QByteArray(100, '\0')) +
+                                          GeneratedTagData::mp4Atom("udta", metaAtom));
+    }
+
+    static QByteArray vorbisComments(const QByteArray &magic, int pictureType)
+    {
+        const auto pictureBlock = GeneratedTagData::bigEndian32(static_cast<quint32>(pictureType)) + GeneratedTagData::bigEndian32(10) +
+                QByteArray("image/jpeg") + GeneratedTagData::bigEndian32(0) + QByteArray(16, '\0') + GeneratedTagData::bigEndian32(2000) +
+                QByteArray(2000, 'p');
+
+        return magic + GeneratedTagData::vorbisComments({"TITLE=Title", QByteArray("METADATA_BLOCK_PICTURE=") + pictureBlock.toBase64()});
+    }
+
+    static EmbeddedCoverProbe::Presence probeData(QByteArray data)
+    {
+        QBuffer audioData(&data);
+        audioData.open(QIODevice::ReadOnly);
+
+        return EmbeddedCoverProbe::probe(audioData);
+    }
+
+private Q_SLOTS:
+
+    void probeId3v2()
+    {
+        const auto title = QByteArray("\0Title", 6);
+
+        const auto titleFrame = GeneratedTagData::id3v2Frame(3, "TIT2", title);
+
+        QCOMPARE(probeData(id3v2File(3, titleFrame + GeneratedTagData::id3v2Frame(3, "APIC", attachedPicture(3)))),
+                 EmbeddedCoverProbe::Presence::Present);
+        QCOMPARE(probeData(id3v2File(3, titleFrame + GeneratedTagData::id3v2Frame(3, "APIC", attachedPicture(0)))),
+                 EmbeddedCoverProbe::Presence::Absent);
+        QCOMPARE(probeData(id3v2File(4, GeneratedTagData::id3v2Frame(4, "TIT2", QByteArray(200, 'a')) +
+                                     GeneratedTagData::id3v2Frame(4, "APIC", attachedPicture(3)))),
+                 EmbeddedCoverProbe::Presence::Present);
+        QCOMPARE(probeData(id3v2File(4, GeneratedTagData::id3v2Frame(4, "TIT2", title))), EmbeddedCoverProbe::Presence::Absent);
+
+        QCOMPARE(probeData(id3v2File(3, GeneratedTagData::id3v2Frame(3, "APIC", attachedPicture(3))).left(15)),
+                 EmbeddedCoverProbe::Presence::Unknown);
+    }
+
+    void probeFlac()
+    {
+        const auto streamInfo = GeneratedTagData::flacBlock(0, false, QByteArray(34, '\0'));
+
+        QCOMPARE(probeData("fLaC" + streamInfo + GeneratedTagData::flacBlock(6, true, GeneratedTagData::bigEndian32(3) + QByteArray(100, 'p'))),
+                 EmbeddedCoverProbe::Presence::Present);
+        QCOMPARE(probeData("fLaC" + streamInfo + GeneratedTagData::flacBlock(6, true, GeneratedTagData::bigEndian32(4) + QByteArray(100, 'p'))),
+                 EmbeddedCoverProbe::Presence::Absent);
+        QCOMPARE(probeData("fLaC" + GeneratedTagData::flacBlock(0, true, QByteArray(34, '\0')) + QByteArray(1000, 'a')),
+                 EmbeddedCoverProbe::Presence::Absent);
+
+        const auto id3v2Prefix = id3v2File(3, GeneratedTagData::id3v2Frame(3, "TIT2", QByteArray("\0Title", 6)));
+        QCOMPARE(probeData(id3v2Prefix.left(id3v2Prefix.size() - 4) + "fLaC" + streamInfo +
+                           GeneratedTagData::flacBlock(6, true, GeneratedTagData::bigEndian32(3))),
+                 EmbeddedCoverProbe::Presence::Present);
+    }
+
+    void probeMp4()
+    {
+        const auto titleAtom = GeneratedTagData::mp4Atom("\xa9nam", GeneratedTagData::mp4Atom("data", GeneratedTagData::bigEndian32(1) +
+                                                                                              GeneratedTagData::bigEndian32(0) + "Title"));
+        const auto coverAtom = GeneratedTagData::mp4Atom("covr", GeneratedTagData::mp4Atom("data", GeneratedTagData::bigEndian32(13) +
+                                                                                           GeneratedTagData::bigEndian32(0) + QByteArray(50, 'p')));
+
+        QCOMPARE(probeData(mp4File(titleAtom + coverAtom)), EmbeddedCoverProbe::Presence::Present);
+        QCOMPARE(probeData(mp4File(titleAtom)), EmbeddedCoverProbe::Presence::Absent);
+        QCOMPARE(probeData(GeneratedTagData::mp4Atom("ftyp", QByteArray("M4A ") + QByteArray(4, '\0')) +
+                           GeneratedTagData::mp4Atom("mdat", QByteArray(50, 'm'))),
+                 EmbeddedCoverProbe::Presence::Unknown);
+    }
+
+    void probeMp4LargeAtomSizes()
+    {
+        const auto fileType = GeneratedTagData::mp4Atom("ftyp", QByteArray("M4A ") + QByteArray(4, '\0'));
+        const auto movie = GeneratedTagData::mp4Atom("moov", GeneratedTagData::mp4Atom("mvhd", QByteArray(100, '\0')));
+
+        // 64 bits sizes just below the largest position, with the top bit set, and past the end of the file
+        for (const auto &largeSize : {QByteArray("\x7f\xff\xff\xff\xff\xff\xff\xf0", 8), QByteArray("\xff\xff\xff\xff\xff\xff\xff\xf0", 8),
+                                      QByteArray("\x00\x00\x00\x00\x00\x01\x00\x00", 8)}) {
+            QCOMPARE(probeData(fileType + GeneratedTagData::bigEndian32(1) + "mdat" + largeSize + QByteArray(50, 'm') + movie),
+                     EmbeddedCoverProbe::Presence::Unknown);
+        }
+    }
+
+    void probeOgg()
+    {
+        const auto vorbisIdentification = QByteArray("\x01vorbis", 7) + QByteArray(23, '\0');
+        const auto vorbisComment = vorbisComments(QByteArray("\x03vorbis", 7), 3);
+
+        // the comment header spans several pages, interleaved with another logical stream
+        QCOMPARE(probeData(GeneratedTagData::oggPage(7, 0, vorbisIdentification) + GeneratedTagData::oggPage(7, 1, vorbisComment.left(1000)) +
+                           GeneratedTagData::oggPage(9, 0, QByteArray(300, 'z')) + GeneratedTagData::oggPage(7, 2, vorbisComment.mid(1000, 1000)) +
+                           GeneratedTagData::oggPage(7, 3, vorbisComment.mid(2000))),
+                 EmbeddedCoverProbe::Presence::Present);
+
+        const auto opusIdentification = QByteArray("OpusHead") + QByteArray(11, '\0');
+        const auto opusComment = vorbisComments(QByteArray("OpusTags"), 0);
+
+        QCOMPARE(probeData(GeneratedTagData::oggPage(1, 0, opusIdentification) + GeneratedTagData::oggPage(1, 1, opusComment.left(600)) +
+                           GeneratedTagData::oggPage(1, 2, opusComment.mid(600))),
+                 EmbeddedCoverProbe::Presence::Absent);
+
+        QCOMPARE(probeData(GeneratedTagData::oggPage(1, 0, QByteArray("\x7f""FLAC") + QByteArray(11, '\0'))),
+                 EmbeddedCoverProbe::Presence::Unknown);
+    }
+
+    void probeOtherFormats()
+    {
+        QCOMPARE(probeData(QByteArray("\xff\xfb\x90\x00", 4) + QByteArray(100, '\0')), EmbeddedCoverProbe::Presence::Absent);
+        QCOMPARE(probeData(QByteArray("RIFF") + GeneratedTagData::littleEndian32(100) + QByteArray("WAVEfmt ")),
+                 EmbeddedCoverProbe::Presence::Unknown);
+        QCOMPARE(probeData(QByteArray("ab")), EmbeddedCoverProbe::Presence::Unknown);
+    }
+
+    void probeFile()
+    {
+        QTemporaryDir rootDirectory;
+        QVERIFY(rootDirectory.isValid());
+
+        const auto fileName = rootDirectory.path() + QStringLiteral("/track.flac");
+
+        QFile audioFile(fileName);
+        QVERIFY(audioFile.open(QIODevice::WriteOnly));
+        audioFile.write("fLaC" + GeneratedTagData::flacBlock(0, false, QByteArray(34, '\0')) +
+                        GeneratedTagData::flacBlock(6, true, GeneratedTagData::bigEndian32(3) + QByteArray(100, 'p')));
+        audioFile.close();
+
+        QCOMPARE(EmbeddedCoverProbe::probe(fileName), EmbeddedCoverProbe::Presence::Present);
+        QCOMPARE(EmbeddedCoverProbe::probe(rootDirectory.path() + QStringLiteral("/missing.flac")), EmbeddedCoverProbe::Presence::Unknown);
+    }
+
+};
+
+QTEST_GUILESS_MAIN(EmbeddedCoverProbeTest)
+
+
+#include "embeddedcoverprobetest.moc"
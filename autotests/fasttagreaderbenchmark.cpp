@@ -0,0 +1,237 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "fasttagreader.h"
+#include "filescanner.h"
+#include "musicaudiotrack.h"
+
+#include "config-upnp-qt.h"
+
+#include "generatedtagdata.h"
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+#include <QUrl>
+#include <QMimeDatabase>
+#include <QTemporaryDir>
+#include <QDateTime>
+#include <QtEndian>
+
+#include <QtTest>
+
+/* the same files scanned with the KFileMetaData extractors and with the built-in reader, one row per format */
+class FastTagReaderBenchmark: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    FastTagReaderBenchmark(QObject *parent = nullptr) : QObject(parent)
+    {
+    }
+
+private:
+
+    static const int mFilesPerRound = 50;
+
+    QTemporaryDir mSampleDirectory;
+
+    QMimeDatabase mMimeDb;
+
+    /* a one second 44.1 kHz stereo stream with the tags of the other sample files */
+    static QByteArray flacFileContent()
+    {
+        const auto sampleRate = 44100;
+        const auto channels = 2;
+
+        auto streamInfo = QByteArray(34, '\0');
+        streamInfo[10] = static_cast<char>((sampleRate >> 12) & 0xff);
+        streamInfo[11] = static_cast<char>((sampleRate >> 4) & 0xff);
+        streamInfo[12] = static_cast<char>(((sampleRate & 0x0f) << 4) | ((channels - 1) << 1));
+        qToBigEndian(quint32(sampleRate), reinterpret_cast<uchar*>(streamInfo.data() + 14));
+
+        const QList<QByteArray> allComments = {"TITLE=Title", "ARTIST=Artist", "ALBUMARTIST=Album Artist", "ALBUM=Test",
+                                               "DATE=2015", "TRACKNUMBER=01", "GENRE=Genre", "COMPOSER=Composer",
+                                               "DESCRIPTION=Comment"};
+
+        return QByteArray("fLaC") + GeneratedTagData::flacBlock(0, false, streamInfo) +
+                GeneratedTagData::flacBlock(4, true, GeneratedTagData::vorbisComments(allComments)) + QByteArray(64 * 1024, '\x55');
+    }
+
+    QString sampleFileName(const QString &format) const
+    {
+        return mSampleDirectory.path() + QStringLiteral("/test.") + format;
+    }
+
+    /* the reader refuses files modified during the last minute, like a fresh checkout */
+    static bool writeSampleFile(const QString &fileName, const QByteArray &content)
+    {
+        QFile sampleFile(fileName);
+        if (!sampleFile.open(QIODevice::ReadWrite)) {
+            return false;
+        }
+
+        return sampleFile.write(content) == content.size() &&
+                sampleFile.setFileTime(QDateTime::currentDateTime().addSecs(-3600), QFileDevice::FileModificationTime);
+    }
+
+    void addFormatRows()
+    {
+        QTest::addColumn<QString>("format");
+
+        QTest::newRow("flac") << QStringLiteral("flac");
+        QTest::newRow("mp3") << QStringLiteral("mp3");
+        QTest::newRow("m4a") << QStringLiteral("m4a");
+        QTest::newRow("ogg") << QStringLiteral("ogg");
+    }
+
+    MusicAudioTrack scanFiles(const QString &fileName, bool useFastTagReader)
+    {
+        FileScanner scanner;
+        scanner.setUseFastTagReader(useFastTagReader);
+
+        const auto fileUrl = QUrl::fromLocalFile(fileName);
+
+        auto result = MusicAudioTrack();
+        for (int fileIndex = 0; fileIndex < mFilesPerRound; ++fileIndex) {
+            result = scanner.scanOneFile(fileUrl, mMimeDb);
+        }
+
+        return result;
+    }
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        QVERIFY(mSampleDirectory.isValid());
+
+        QVERIFY(writeSampleFile(sampleFileName(QStringLiteral("flac")), flacFileContent()));
+
+        for (const auto &oneFormat : {QStringLiteral("mp3"), QStringLiteral("m4a"), QStringLiteral("ogg")}) {
+            QFile sampleFile(QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music/test.") + oneFormat);
+            QVERIFY(sampleFile.open(QIODevice::ReadOnly));
+
+            QVERIFY(writeSampleFile(sampleFileName(oneFormat), sampleFile.readAll()));
+        }
+    }
+
+    void sameTracks_data()
+    {
+        addFormatRows();
+    }
+
+    void sameTracks()
+    {
+        QFETCH(QString, format);
+
+        const auto fileName = sampleFileName(format);
+
+        auto fastTrack = MusicAudioTrack();
+        QVERIFY(FastTagReader::readTags(fileName, fastTrack));
+
+        const auto extractedTrack = scanFiles(fileName, false);
+        if (!extractedTrack.isValid()) {
+            QSKIP("no KFileMetaData extractor for this format");
+        }
+
+        const auto scannedTrack = scanFiles(fileName, true);
+
+        QCOMPARE(scannedTrack.isValid(), true);
+        QCOMPARE(scannedTrack.title(), extractedTrack.title());
+        QCOMPARE(scannedTrack.artist(), extractedTrack.artist());
+        QCOMPARE(scannedTrack.albumName(), extractedTrack.albumName());
+        QCOMPARE(scannedTrack.albumArtist(), extractedTrack.albumArtist());
+        QCOMPARE(scannedTrack.trackNumber(), extractedTrack.trackNumber());
+        QCOMPARE(scannedTrack.discNumber(), extractedTrack.discNumber());
+        QCOMPARE(scannedTrack.year(), extractedTrack.year());
+        QCOMPARE(scannedTrack.genre(), extractedTrack.genre());
+        QCOMPARE(scannedTrack.composer(), extractedTrack.composer());
+        QCOMPARE(scannedTrack.comment(), extractedTrack.comment());
+        QCOMPARE(scannedTrack.channels(), extractedTrack.channels());
+        QCOMPARE(scannedTrack.sampleRate(), extractedTrack.sampleRate());
+        QCOMPARE(scannedTrack.bitRate(), extractedTrack.bitRate());
+        QCOMPARE(scannedTrack.duration(), extractedTrack.duration());
+    }
+
+    void extractorScan_data()
+    {
+        addFormatRows();
+    }
+
+    void extractorScan()
+    {
+        QFETCH(QString, format);
+
+        const auto fileName = sampleFileName(format);
+
+        QBENCHMARK {
+            scanFiles(fileName, false);
+        }
+    }
+
+    void fastTagReaderScan_data()
+    {
+        addFormatRows();
+    }
+
+    void fastTagReaderScan()
+    {
+        QFETCH(QString, format);
+
+        const auto fileName = sampleFileName(format);
+
+        auto scannedTrack = MusicAudioTrack();
+        QBENCHMARK {
+            scannedTrack = scanFiles(fileName, true);
+        }
+
+#if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
+        QCOMPARE(scannedTrack.isValid(), true);
+#endif
+    }
+
+    void readTagsOnly_data()
+    {
+        addFormatRows();
+    }
+
+    void readTagsOnly()
+    {
+        QFETCH(QString, format);
+
+        const auto fileName = sampleFileName(format);
+
+        auto isRead = true;
+        QBENCHMARK {
+            for (int fileIndex = 0; fileIndex < mFilesPerRound; ++fileIndex) {
+                auto oneTrack = MusicAudioTrack();
+                isRead = FastTagReader::readTags(fileName, oneTrack) && isRead;
+            }
+        }
+
+        QVERIFY(isRead);
+    }
+
+};
+
+QTEST_GUILESS_MAIN(FastTagReaderBenchmark)
+
+
+#include "fasttagreaderbenchmark.moc"
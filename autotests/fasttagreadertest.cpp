@@ -0,0 +1,291 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "fasttagreader.h"
+#include "musicaudiotrack.h"
+
+#include "generatedtagdata.h"
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+#include <QUrl>
+#include <QDateTime>
+#include <QTemporaryDir>
+#include <QtEndian>
+
+#include <QtTest>
+
+class FastTagReaderTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    FastTagReaderTest(QObject *parent = nullptr) : QObject(parent)
+    {
+    }
+
+private:
+
+    QTemporaryDir mFilesDirectory;
+
+    int mFilesCount = 0;
+
+    static QByteArray vorbisComments()
+    {
+        return GeneratedTagData::vorbisComments({"TITLE=Title"});
+    }
+
+    /* one second at 44.1 kHz */
+    static QByteArray flacStreamInfo()
+    {
+        auto streamInfo = QByteArray(34, '\0');
+        streamInfo[10] = static_cast<char>(0x0a);
+        streamInfo[11] = static_cast<char>(0xc4);
+        streamInfo[12] = static_cast<char>(0x42);
+        qToBigEndian(quint32(44100), reinterpret_cast<uchar*>(streamInfo.data() + 14));
+        return streamInfo;
+    }
+
+    static QByteArray flacFile()
+    {
+        return "fLaC" + GeneratedTagData::flacBlock(0, false, flacStreamInfo()) + GeneratedTagData::flacBlock(4, true, vorbisComments()) +
+                QByteArray(4000, 'a');
+    }
+
+    /* an ID3v2.3 tag followed by a second of 128 kbit/s MPEG 1 layer III */
+    static QByteArray mpegFile(const QByteArray &otherFrames = {})
+    {
+        const auto frames = GeneratedTagData::id3v2Frame(3, "TIT2", QByteArray("\0Title", 6)) + otherFrames + QByteArray(20, '\0');
+
+        return GeneratedTagData::id3v2Tag(3, frames) + QByteArray("\xff\xfb\x90\x00", 4) + QByteArray(15996, 'U');
+    }
+
+    static QByteArray mp4Movie(const QByteArray &firstChild)
+    {
+        // version and flags, creation and modification times, then the time scale and the duration
+        const auto mediaHeader = GeneratedTagData::mp4Atom("mdhd", QByteArray(12, '\0') + GeneratedTagData::bigEndian32(1000) +
+                                                           GeneratedTagData::bigEndian32(1000) + QByteArray(4, '\0'));
+        const auto sampleEntry = GeneratedTagData::mp4Atom("mp4a", QByteArray(16, '\0') + QByteArray("\x00\x02\x00\x10", 4) + QByteArray(4, '\0') +
+                                                           GeneratedTagData::bigEndian32(44100u << 16));
+        const auto sampleTable = GeneratedTagData::mp4Atom("stbl", GeneratedTagData::mp4Atom("stsd", QByteArray(4, '\0') +
+                                                                                             GeneratedTagData::bigEndian32(1) + sampleEntry));
+        const auto track = GeneratedTagData::mp4Atom("trak", GeneratedTagData::mp4Atom("mdia", mediaHeader +
+                                                                                      GeneratedTagData::mp4Atom("minf", sampleTable)));
+        const auto title = GeneratedTagData::mp4Atom("\xa9nam", GeneratedTagData::mp4Atom("data", GeneratedTagData::bigEndian32(1) +
+                                                                                          GeneratedTagData::bigEndian32(0) + "Title"));
+        const auto userData = GeneratedTagData::mp4Atom("udta", GeneratedTagData::mp4Atom("meta", QByteArray(4, '\0') +
+                                                                                         GeneratedTagData::mp4Atom("ilst", title)));
+
+        return GeneratedTagData::mp4Atom("moov", firstChild + track + userData);
+    }
+
+    static QByteArray mp4FileType()
+    {
+        return GeneratedTagData::mp4Atom("ftyp", QByteArray("M4A ") + QByteArray(4, '\0'));
+    }
+
+    static QByteArray mp4MediaData()
+    {
+        return GeneratedTagData::mp4Atom("mdat", QByteArray(16000, 'm'));
+    }
+
+    static QByteArray mp4File()
+    {
+        return mp4FileType() + mp4Movie({}) + mp4MediaData();
+    }
+
+    static QByteArray oggHeaderPages()
+    {
+        const auto identification = QByteArray("\x01vorbis", 7) + GeneratedTagData::littleEndian32(0) + '\x02' +
+                GeneratedTagData::littleEndian32(44100) + QByteArray(15, '\0');
+
+        return GeneratedTagData::oggPage(7, 0, identification) + GeneratedTagData::oggPage(7, 1, QByteArray("\x03vorbis", 7) + vorbisComments());
+    }
+
+    static QByteArray oggFile()
+    {
+        return oggHeaderPages() + GeneratedTagData::oggPage(7, 2, QByteArray(4000, 'o'), 44100);
+    }
+
+    /* the reader refuses files modified during the last minute */
+    QString writeFile(const QByteArray &content, const QDateTime &modificationTime = QDateTime::currentDateTime().addSecs(-3600))
+    {
+        const auto fileName = mFilesDirectory.path() + QStringLiteral("/track") + QString::number(++mFilesCount);
+
+        QFile audioFile(fileName);
+        if (!audioFile.open(QIODevice::ReadWrite) || audioFile.write(content) != content.size() ||
+                !audioFile.setFileTime(modificationTime, QFileDevice::FileModificationTime)) {
+            return {};
+        }
+
+        return fileName;
+    }
+
+    static MusicAudioTrack untouchedTrack()
+    {
+        auto result = MusicAudioTrack();
+
+        result.setTitle(QStringLiteral("Untouched"));
+        result.setResourceURI(QUrl::fromLocalFile(QStringLiteral("/untouched.flac")));
+
+        return result;
+    }
+
+    void verifyRefused(const QByteArray &content)
+    {
+        const auto fileName = writeFile(content);
+        QVERIFY(!fileName.isEmpty());
+
+        auto track = untouchedTrack();
+
+        QCOMPARE(FastTagReader::readTags(fileName, track), false);
+        QCOMPARE(track, untouchedTrack());
+    }
+
+    void verifyRead(const QByteArray &content)
+    {
+        const auto fileName = writeFile(content);
+        QVERIFY(!fileName.isEmpty());
+
+        auto track = MusicAudioTrack();
+
+        QCOMPARE(FastTagReader::readTags(fileName, track), true);
+        QCOMPARE(track.title(), QStringLiteral("Title"));
+        QCOMPARE(track.duration(), QTime::fromMSecsSinceStartOfDay(1000));
+    }
+
+    void verifyEmbeddedCover(const QByteArray &content, bool hasEmbeddedCover)
+    {
+        const auto fileName = writeFile(content);
+        QVERIFY(!fileName.isEmpty());
+
+        auto track = MusicAudioTrack();
+
+        QCOMPARE(FastTagReader::readTags(fileName, track), true);
+        QCOMPARE(track.hasEmbeddedCover(), hasEmbeddedCover);
+    }
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        QVERIFY(mFilesDirectory.isValid());
+    }
+
+    void readWellFormedFiles()
+    {
+        verifyRead(flacFile());
+        verifyRead(mpegFile());
+        verifyRead(mp4File());
+        verifyRead(oggFile());
+    }
+
+    void readEmbeddedCover()
+    {
+        for (const auto pictureType : {3, 4}) {
+            const auto flacPicture = GeneratedTagData::flacBlock(6, true, GeneratedTagData::bigEndian32(static_cast<quint32>(pictureType)) +
+                                                                 QByteArray(100, 'p'));
+
+            verifyEmbeddedCover("fLaC" + GeneratedTagData::flacBlock(0, false, flacStreamInfo()) +
+                                GeneratedTagData::flacBlock(4, false, vorbisComments()) + flacPicture + QByteArray(4000, 'a'), pictureType == 3);
+
+            const auto attachedPicture = QByteArray("\0image/jpeg\0", 12) + static_cast<char>(pictureType) + QByteArray("\0", 1) +
+                    QByteArray(100, 'p');
+
+            verifyEmbeddedCover(mpegFile(GeneratedTagData::id3v2Frame(3, "APIC", attachedPicture)), pictureType == 3);
+        }
+
+        verifyEmbeddedCover(flacFile(), false);
+        verifyEmbeddedCover(mpegFile(), false);
+        verifyEmbeddedCover(mp4File(), false);
+        verifyEmbeddedCover(oggFile(), false);
+    }
+
+    void refuseRecentlyModifiedFile()
+    {
+        const auto fileName = writeFile(flacFile(), QDateTime::currentDateTime());
+        QVERIFY(!fileName.isEmpty());
+
+        auto track = untouchedTrack();
+
+        QCOMPARE(FastTagReader::readTags(fileName, track), false);
+        QCOMPARE(track, untouchedTrack());
+    }
+
+    void refuseTruncatedFiles()
+    {
+        verifyRefused(flacFile().left(50));
+        verifyRefused(mpegFile().left(20));
+        verifyRefused(mp4FileType() + mp4Movie({}).left(100));
+        verifyRefused(oggHeaderPages().left(60));
+    }
+
+    void refuseOversizedFlacBlocks()
+    {
+        const auto streamInfo = GeneratedTagData::flacBlock(0, false, flacStreamInfo());
+
+        verifyRefused("fLaC" + streamInfo + GeneratedTagData::flacBlock(4, true, vorbisComments(), 0xffffff) + QByteArray(100, 'a'));
+        verifyRefused("fLaC" + streamInfo + GeneratedTagData::flacBlock(4, false, vorbisComments()) +
+                      GeneratedTagData::flacBlock(6, true, QByteArray(100, 'p'), 0xffffff));
+    }
+
+    void refuseOversizedId3v2Frames()
+    {
+        const auto title = QByteArray("\0Title", 6);
+        const auto mpegAudio = QByteArray("\xff\xfb\x90\x00", 4) + QByteArray(1000, 'U');
+
+        verifyRefused(GeneratedTagData::id3v2Tag(3, GeneratedTagData::id3v2Frame(3, "TIT2", title, 0x7fffffff), 16) + mpegAudio);
+        verifyRefused(GeneratedTagData::id3v2Tag(3, GeneratedTagData::id3v2Frame(3, "TIT2", title), 0x0fffffff) + mpegAudio);
+
+        // an extended header larger than the whole tag
+        verifyRefused(GeneratedTagData::id3v2Tag(3, GeneratedTagData::bigEndian32(0x7ffffff0) + QByteArray(40, '\0'), 44, '\x40') + mpegAudio);
+    }
+
+    void refuseOversizedMp4Atoms()
+    {
+        verifyRefused(mp4FileType() + GeneratedTagData::bigEndian32(0x7ffffff0) + "moov" + mp4Movie({}).mid(8) + mp4MediaData());
+        verifyRefused(mp4FileType() + mp4Movie(GeneratedTagData::bigEndian32(0x7ffffff0) + "free") + mp4MediaData());
+    }
+
+    void refuseLargeMp4AtomSizes()
+    {
+        for (const auto &largeSize : {QByteArray("\xff\xff\xff\xff\xff\xff\xff\xf0", 8), QByteArray("\x7f\xff\xff\xff\xff\xff\xff\xf0", 8)}) {
+            verifyRefused(mp4FileType() + mp4Movie({}) + GeneratedTagData::bigEndian32(1) + "mdat" + largeSize + QByteArray(16000, 'm'));
+            verifyRefused(mp4FileType() + mp4Movie(GeneratedTagData::bigEndian32(1) + "free" + largeSize) + mp4MediaData());
+        }
+    }
+
+    void refuseZeroLengthMp4Atoms()
+    {
+        verifyRefused(mp4FileType() + mp4Movie(GeneratedTagData::bigEndian32(0) + "free") + mp4MediaData());
+        verifyRefused(mp4FileType() + mp4Movie({}) + GeneratedTagData::bigEndian32(0) + "mdat" + QByteArray(16000, 'm'));
+    }
+
+    void refuseOggWithoutTailPage()
+    {
+        verifyRefused(oggHeaderPages() + QByteArray(4000, 'o'));
+    }
+
+};
+
+QTEST_GUILESS_MAIN(FastTagReaderTest)
+
+
+#include "fasttagreadertest.moc"
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GENERATEDAUDIOFILES_H
+#define GENERATEDAUDIOFILES_H
+
+#include <QString>
+#include <QFile>
+#include <QDataStream>
+#include <QAudioDeviceInfo>
+
+#include <cmath>
+
+class GeneratedAudioFiles
+{
+
+public:
+
+    static const int SampleRate = 44100;
+
+    static bool writeWaveFile(const QString &fileName, int durationMs, double frequency)
+    {
+        QFile waveFile(fileName);
+        if (!waveFile.open(QIODevice::WriteOnly)) {
+            return false;
+        }
+
+        const quint16 channelsCount = 2;
+        const quint16 bitsPerSample = 16;
+        const quint16 blockAlign = channelsCount * bitsPerSample / 8;
+        const quint32 framesCount = static_cast<quint32>(qint64(SampleRate) * durationMs / 1000);
+        const quint32 dataSize = framesCount * blockAlign;
+
+        QDataStream waveStream(&waveFile);
+        waveStream.setByteOrder(QDataStream::LittleEndian);
+
+        waveStream.writeRawData("RIFF", 4);
+        waveStream << quint32(36 + dataSize);
+        waveStream.writeRawData("WAVE", 4);
+        waveStream.writeRawData("fmt ", 4);
+        waveStream << quint32(16) << quint16(1) << channelsCount << quint32(SampleRate)
+                   << quint32(SampleRate * blockAlign) << blockAlign << bitsPerSample;
+        waveStream.writeRawData("data", 4);
+        waveStream << dataSize;
+
+        for (quint32 frame = 0; frame < framesCount; ++frame) {
+            const auto sample = static_cast<qint16>(8000 * std::sin(2 * M_PI * frequency * frame / SampleRate));
+            waveStream << sample << sample;
+        }
+
+        return waveStream.status() == QDataStream::Ok;
+    }
+
+    static bool hasAudioOutput()
+    {
+        return !QAudioDeviceInfo::availableDevices(QAudio::AudioOutput).isEmpty();
+    }
+
+};
+
+#endif // GENERATEDAUDIOFILES_H
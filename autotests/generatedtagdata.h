@@ -0,0 +1,120 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GENERATEDTAGDATA_H
+#define GENERATEDTAGDATA_H
+
+#include <QByteArray>
+#include <QList>
+#include <QtEndian>
+
+/* builds the headers of FLAC, ID3v2, MP4 and Ogg files byte by byte */
+class GeneratedTagData
+{
+
+public:
+
+    static QByteArray bigEndian32(quint32 value)
+    {
+        auto result = QByteArray(4, '\0');
+        qToBigEndian(value, reinterpret_cast<uchar*>(result.data()));
+        return result;
+    }
+
+    static QByteArray littleEndian32(quint32 value)
+    {
+        auto result = QByteArray(4, '\0');
+        qToLittleEndian(value, reinterpret_cast<uchar*>(result.data()));
+        return result;
+    }
+
+    static QByteArray syncSafe32(quint32 value)
+    {
+        auto result = QByteArray(4, '\0');
+        for (int i = 0; i < 4; ++i) {
+            result[i] = static_cast<char>((value >> (21 - 7 * i)) & 0x7f);
+        }
+        return result;
+    }
+
+    /* blockSize may differ from the size of body to build corrupted files */
+    static QByteArray flacBlock(int blockType, bool isLastBlock, const QByteArray &body, quint32 blockSize)
+    {
+        return static_cast<char>(blockType | (isLastBlock ? 0x80 : 0)) + bigEndian32(blockSize).mid(1) + body;
+    }
+
+    static QByteArray flacBlock(int blockType, bool isLastBlock, const QByteArray &body)
+    {
+        return flacBlock(blockType, isLastBlock, body, static_cast<quint32>(body.size()));
+    }
+
+    /* a vendor string followed by KEY=value fields, shared by FLAC and Ogg */
+    static QByteArray vorbisComments(const QList<QByteArray> &comments)
+    {
+        auto result = littleEndian32(5) + QByteArray("Elisa") + littleEndian32(static_cast<quint32>(comments.size()));
+        for (const auto &oneComment : comments) {
+            result += littleEndian32(static_cast<quint32>(oneComment.size())) + oneComment;
+        }
+        return result;
+    }
+
+    static QByteArray id3v2Frame(int majorVersion, const QByteArray &frameId, const QByteArray &body, quint32 frameSize)
+    {
+        return frameId + (majorVersion == 3 ? bigEndian32(frameSize) : syncSafe32(frameSize)) + QByteArray(2, '\0') + body;
+    }
+
+    static QByteArray id3v2Frame(int majorVersion, const QByteArray &frameId, const QByteArray &body)
+    {
+        return id3v2Frame(majorVersion, frameId, body, static_cast<quint32>(body.size()));
+    }
+
+    static QByteArray id3v2Tag(int majorVersion, const QByteArray &frames, quint32 tagSize, char tagFlags = 0)
+    {
+        return QByteArray("ID3") + static_cast<char>(majorVersion) + '\0' + tagFlags + syncSafe32(tagSize) + frames;
+    }
+
+    static QByteArray id3v2Tag(int majorVersion, const QByteArray &frames)
+    {
+        return id3v2Tag(majorVersion, frames, static_cast<quint32>(frames.size()));
+    }
+
+    static QByteArray mp4Atom(const QByteArray &atomType, const QByteArray &body)
+    {
+        return bigEndian32(static_cast<quint32>(body.size() + 8)) + atomType + body;
+    }
+
+    static QByteArray oggPage(quint32 serialNumber, int sequenceNumber, const QByteArray &body, qint64 granulePosition = 0)
+    {
+        auto granule = QByteArray(8, '\0');
+        qToLittleEndian(granulePosition, reinterpret_cast<uchar*>(granule.data()));
+
+        auto segmentTable = QByteArray();
+        auto remainingSize = body.size();
+        while (remainingSize >= 255) {
+            segmentTable.append(static_cast<char>(255));
+            remainingSize -= 255;
+        }
+        segmentTable.append(static_cast<char>(remainingSize));
+
+        return QByteArray("OggS") + QByteArray(2, '\0') + granule + littleEndian32(serialNumber) +
+                littleEndian32(static_cast<quint32>(sequenceNumber)) + QByteArray(4, '\0') + static_cast<char>(segmentTable.size()) +
+                segmentTable + body;
+    }
+
+};
+
+#endif // GENERATEDTAGDATA_H
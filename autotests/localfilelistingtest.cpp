@@ -32,6 +32,7 @@
 #include <QStandardPaths>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 
 #include <QDebug>
 
@@ -60,6 +61,7 @@ private Q_SLOTS:
         qRegisterMetaType<QVector<qlonglong>>("QVector<qlonglong>");
         qRegisterMetaType<QHash<qlonglong,int>>("QHash<qlonglong,int>");
         qRegisterMetaType<QList<QUrl>>("QList<QUrl>");
+        qRegisterMetaType<QHash<QUrl,QUrl>>("QHash<QUrl,QUrl>");
         qRegisterMetaType<NotificationItem>("NotificationItem");
     }
 
@@ -505,6 +507,158 @@ private Q_SLOTS:
         QCOMPARE(newCoversLast.count(), 1);
     }
 
+    void addAndRenameTracks()
+    {
+        LocalFileListing myListing;
+
+        QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music2/data/innerData");
+
+        QString otherMusicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music2/data/otherData");
+
+        QString musicParentPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music2");
+        QDir musicParentDirectory(musicParentPath);
+        QDir rootDirectory(QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH));
+
+        musicParentDirectory.removeRecursively();
+        rootDirectory.mkpath(QStringLiteral("music2/data/innerData"));
+        rootDirectory.mkpath(QStringLiteral("music2/data/otherData"));
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+        QSignalSpy removedTracksListSpy(&myListing, &LocalFileListing::removedTracksList);
+        QSignalSpy renamedTracksListSpy(&myListing, &LocalFileListing::renamedTracksList);
+        QSignalSpy errorWatchingFilesSpy(&myListing, &LocalFileListing::errorWatchingFiles);
+
+        myListing.init();
+
+        myListing.setRootPath(musicParentPath);
+
+        myListing.refreshContent();
+
+        QCOMPARE(tracksListSpy.count(), 0);
+        QCOMPARE(removedTracksListSpy.count(), 0);
+        QCOMPARE(renamedTracksListSpy.count(), 0);
+
+        if (errorWatchingFilesSpy.count()) {
+            QEXPECT_FAIL("", "watching files for change is not working", Abort);
+        }
+        QCOMPARE(errorWatchingFilesSpy.count(), 0);
+
+        QFile myTrack(musicOriginPath + QStringLiteral("/test.ogg"));
+        myTrack.copy(musicPath + QStringLiteral("/test.ogg"));
+
+        QCOMPARE(tracksListSpy.wait(), true);
+
+        QCOMPARE(tracksListSpy.count(), 1);
+        QCOMPARE(tracksListSpy.at(0).at(0).value<QList<MusicAudioTrack>>().count(), 1);
+
+        QCOMPARE(QFile::rename(musicPath + QStringLiteral("/test.ogg"), otherMusicPath + QStringLiteral("/test.ogg")), true);
+
+        QCOMPARE(renamedTracksListSpy.wait(), true);
+
+        QCOMPARE(renamedTracksListSpy.count(), 1);
+
+        auto renamedTracks = renamedTracksListSpy.at(0).at(0).value<QHash<QUrl, QUrl>>();
+
+        QCOMPARE(renamedTracks.count(), 1);
+        QCOMPARE(renamedTracks.begin().key(), QUrl::fromLocalFile(QFileInfo(musicPath).canonicalFilePath() + QStringLiteral("/test.ogg")));
+        QCOMPARE(renamedTracks.begin().value(), QUrl::fromLocalFile(QFileInfo(otherMusicPath).canonicalFilePath() + QStringLiteral("/test.ogg")));
+
+        QCOMPARE(removedTracksListSpy.wait(1500), false);
+
+        QCOMPARE(tracksListSpy.count(), 1);
+        QCOMPARE(removedTracksListSpy.count(), 0);
+        QCOMPARE(errorWatchingFilesSpy.count(), 0);
+    }
+
+    void renameTracksWhileNotRunning()
+    {
+        LocalFileListing myListing;
+
+        QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music2/data/innerData");
+
+        QString otherMusicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music2/data/otherData");
+
+        QString musicParentPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music2");
+        QDir musicParentDirectory(musicParentPath);
+        QDir rootDirectory(QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH));
+
+        musicParentDirectory.removeRecursively();
+        rootDirectory.mkpath(QStringLiteral("music2/data/innerData"));
+        rootDirectory.mkpath(QStringLiteral("music2/data/otherData"));
+
+        QFile myTrack(musicOriginPath + QStringLiteral("/test.ogg"));
+        QCOMPARE(myTrack.copy(otherMusicPath + QStringLiteral("/test.ogg")), true);
+
+        const auto movedTrackInfo = QFileInfo(otherMusicPath + QStringLiteral("/test.ogg"));
+        const auto movedTrack = QUrl::fromLocalFile(movedTrackInfo.canonicalFilePath());
+        const auto oldTrack = QUrl::fromLocalFile(QFileInfo(musicPath).canonicalFilePath() + QStringLiteral("/test.ogg"));
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+        QSignalSpy removedTracksListSpy(&myListing, &LocalFileListing::removedTracksList);
+        QSignalSpy renamedTracksListSpy(&myListing, &LocalFileListing::renamedTracksList);
+
+        myListing.setRootPath(musicParentPath);
+
+        myListing.init();
+
+        // the database still knows the track by the name it had before the move
+        myListing.restoredFileSizes(musicParentPath, {{oldTrack, movedTrackInfo.size()}});
+        myListing.restoredTracks(musicParentPath, {{oldTrack, movedTrackInfo.fileTime(QFile::FileModificationTime)}});
+
+        QCOMPARE(tracksListSpy.count(), 0);
+        QCOMPARE(removedTracksListSpy.count(), 0);
+        QCOMPARE(renamedTracksListSpy.count(), 1);
+
+        auto renamedTracks = renamedTracksListSpy.at(0).at(0).value<QHash<QUrl, QUrl>>();
+
+        QCOMPARE(renamedTracks.count(), 1);
+        QCOMPARE(renamedTracks.begin().key(), oldTrack);
+        QCOMPARE(renamedTracks.begin().value(), movedTrack);
+    }
+
+    void sameNameAndTimeWithOtherSizeIsNotARename()
+    {
+        LocalFileListing myListing;
+
+        QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music2/data/innerData");
+
+        QString otherMusicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music2/data/otherData");
+
+        QString musicParentPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music2");
+        QDir musicParentDirectory(musicParentPath);
+        QDir rootDirectory(QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH));
+
+        musicParentDirectory.removeRecursively();
+        rootDirectory.mkpath(QStringLiteral("music2/data/innerData"));
+        rootDirectory.mkpath(QStringLiteral("music2/data/otherData"));
+
+        QFile myTrack(musicOriginPath + QStringLiteral("/test.ogg"));
+        QCOMPARE(myTrack.copy(otherMusicPath + QStringLiteral("/test.ogg")), true);
+
+        const auto newTrackInfo = QFileInfo(otherMusicPath + QStringLiteral("/test.ogg"));
+        const auto oldTrack = QUrl::fromLocalFile(QFileInfo(musicPath).canonicalFilePath() + QStringLiteral("/test.ogg"));
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+        QSignalSpy renamedTracksListSpy(&myListing, &LocalFileListing::renamedTracksList);
+
+        myListing.setRootPath(musicParentPath);
+
+        myListing.init();
+
+        // another recording copied at the same time under the same name
+        myListing.restoredFileSizes(musicParentPath, {{oldTrack, newTrackInfo.size() + 1}});
+        myListing.restoredTracks(musicParentPath, {{oldTrack, newTrackInfo.fileTime(QFile::FileModificationTime)}});
+
+        QCOMPARE(renamedTracksListSpy.count(), 0);
+        QCOMPARE(tracksListSpy.count(), 1);
+    }
+
     void restoreRemovedTracks()
     {
         LocalFileListing myListing;
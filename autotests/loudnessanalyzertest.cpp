@@ -0,0 +1,128 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "loudnessanalyzer.h"
+
+#include <QObject>
+#include <QVector>
+
+#include <QtTest>
+
+#include <cmath>
+#include <vector>
+
+class LoudnessAnalyzerTests: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    LoudnessAnalyzerTests(QObject *parent = nullptr) : QObject(parent)
+    {
+    }
+
+private:
+
+    static std::vector<float> sineWave(int sampleRate, int channelsCount, int durationMs, qreal frequency, qreal amplitude)
+    {
+        const auto framesCount = static_cast<size_t>(sampleRate) * static_cast<size_t>(durationMs) / 1000;
+        auto samples = std::vector<float>(framesCount * static_cast<size_t>(channelsCount));
+
+        for (size_t frame = 0; frame < framesCount; ++frame) {
+            const auto value = static_cast<float>(amplitude * std::sin(2. * M_PI * frequency * frame / sampleRate));
+
+            for (int channel = 0; channel < channelsCount; ++channel) {
+                samples[frame * static_cast<size_t>(channelsCount) + static_cast<size_t>(channel)] = value;
+            }
+        }
+
+        return samples;
+    }
+
+private Q_SLOTS:
+
+    void referenceSineLoudness()
+    {
+        const auto samples = sineWave(48000, 2, 20000, 1000., std::pow(10., -23. / 20.));
+
+        LoudnessAnalyzer myAnalyzer(48000, 2);
+
+        myAnalyzer.addSamples(samples.data(), static_cast<qint64>(samples.size() / 2));
+
+        QVERIFY(myAnalyzer.isValid());
+        QVERIFY(qAbs(myAnalyzer.integratedLoudness() - (-23.)) < 0.1);
+        QVERIFY(qAbs(myAnalyzer.gain() - 5.) < 0.1);
+        QVERIFY(qAbs(myAnalyzer.peak() - std::pow(10., -23. / 20.)) < 0.001);
+    }
+
+    void splitBuffersLoudness()
+    {
+        const auto samples = sineWave(44100, 2, 10000, 1000., std::pow(10., -23. / 20.));
+        const auto framesCount = static_cast<qint64>(samples.size() / 2);
+
+        LoudnessAnalyzer myAnalyzer(44100, 2);
+
+        for (qint64 frame = 0; frame < framesCount; frame += 1000) {
+            myAnalyzer.addSamples(samples.data() + 2 * frame, std::min<qint64>(1000, framesCount - frame));
+        }
+
+        QVERIFY(myAnalyzer.isValid());
+        QVERIFY(qAbs(myAnalyzer.integratedLoudness() - (-23.)) < 0.1);
+    }
+
+    void silenceIsInvalid()
+    {
+        const auto samples = std::vector<float>(48000 * 2 * 5, 0.f);
+
+        LoudnessAnalyzer myAnalyzer(48000, 2);
+
+        myAnalyzer.addSamples(samples.data(), static_cast<qint64>(samples.size() / 2));
+
+        QVERIFY(!myAnalyzer.isValid());
+        QCOMPARE(myAnalyzer.peak(), 0.);
+    }
+
+    void tooShortIsInvalid()
+    {
+        const auto samples = sineWave(48000, 2, 300, 1000., 0.5);
+
+        LoudnessAnalyzer myAnalyzer(48000, 2);
+
+        myAnalyzer.addSamples(samples.data(), static_cast<qint64>(samples.size() / 2));
+
+        QVERIFY(!myAnalyzer.isValid());
+    }
+
+    void combinedLoudness()
+    {
+        QVERIFY(qAbs(LoudnessAnalyzer::combinedLoudness({-20., -20., -20.}, {1., 2., 3.}) - (-20.)) < 0.001);
+        QVERIFY(qAbs(LoudnessAnalyzer::combinedLoudness({-20., -30.}, {1., 0.}) - (-20.) - 10. * std::log10(1.1 / 2.)) < 0.001);
+        QVERIFY(LoudnessAnalyzer::combinedLoudness({-10., -30.}, {1., 1.}) < -10.);
+        QVERIFY(LoudnessAnalyzer::combinedLoudness({-10., -30.}, {1., 1.}) > -30.);
+    }
+
+    void gainConversion()
+    {
+        QCOMPARE(LoudnessAnalyzer::gainFromLoudness(-18.), 0.);
+        QCOMPARE(LoudnessAnalyzer::loudnessFromGain(LoudnessAnalyzer::gainFromLoudness(-9.)), -9.);
+    }
+};
+
+QTEST_GUILESS_MAIN(LoudnessAnalyzerTests)
+
+
+#include "loudnessanalyzertest.moc"
@@ -18,6 +18,7 @@
 #include "manageaudioplayertest.h"
 
 #include "manageaudioplayer.h"
+#include "mediaplaylist.h"
 
 #include <QtTest>
 #include <QStandardItemModel>
@@ -8932,6 +8933,170 @@ void ManageAudioPlayerTest::testRestorePlayListAndSettingsAutomaticPlay()
     QCOMPARE(skipNextTrackSpy.wait(300), true);
 }
 
+void ManageAudioPlayerTest::gaplessSkipNextTrack()
+{
+    ManageAudioPlayer myPlayer;
+    QStandardItemModel myPlayList;
+
+    QSignalSpy currentTrackChangedSpy(&myPlayer, &ManageAudioPlayer::currentTrackChanged);
+    QSignalSpy nextTrackChangedSpy(&myPlayer, &ManageAudioPlayer::nextTrackChanged);
+    QSignalSpy playerSourceChangedSpy(&myPlayer, &ManageAudioPlayer::playerSourceChanged);
+    QSignalSpy playerNextSourceChangedSpy(&myPlayer, &ManageAudioPlayer::playerNextSourceChanged);
+    QSignalSpy playerPlaySpy(&myPlayer, &ManageAudioPlayer::playerPlay);
+    QSignalSpy playerStopSpy(&myPlayer, &ManageAudioPlayer::playerStop);
+    QSignalSpy skipNextTrackSpy(&myPlayer, &ManageAudioPlayer::skipNextTrack);
+    QSignalSpy startedPlayingTrackSpy(&myPlayer, &ManageAudioPlayer::startedPlayingTrack);
+
+    myPlayList.appendRow(new QStandardItem);
+    myPlayList.appendRow(new QStandardItem);
+
+    myPlayList.item(0, 0)->setData(QUrl::fromUserInput(QStringLiteral("file:///1.mp3")), ManageAudioPlayerTest::ResourceRole);
+    myPlayList.item(1, 0)->setData(QUrl::fromUserInput(QStringLiteral("file:///2.mp3")), ManageAudioPlayerTest::ResourceRole);
+
+    myPlayer.setUrlRole(ManageAudioPlayerTest::ResourceRole);
+    myPlayer.setIsPlayingRole(ManageAudioPlayerTest::IsPlayingRole);
+    myPlayer.setPlayListModel(&myPlayList);
+
+    myPlayer.setCurrentTrack(myPlayList.index(0, 0));
+
+    QCOMPARE(currentTrackChangedSpy.count(), 1);
+    QCOMPARE(playerSourceChangedSpy.count(), 1);
+    QCOMPARE(playerSourceChangedSpy.at(0).at(0).toUrl(), QUrl::fromUserInput(QStringLiteral("file:///1.mp3")));
+
+    myPlayer.setNextTrack(myPlayList.index(1, 0));
+
+    QCOMPARE(nextTrackChangedSpy.count(), 1);
+    QCOMPARE(playerNextSourceChangedSpy.count(), 1);
+    QCOMPARE(playerNextSourceChangedSpy.at(0).at(0).toUrl(), QUrl::fromUserInput(QStringLiteral("file:///2.mp3")));
+    QCOMPARE(myPlayer.nextTrack(), QPersistentModelIndex(myPlayList.index(1, 0)));
+
+    myPlayer.setPlayerStatus(QMediaPlayer::LoadedMedia);
+    myPlayer.ensurePlay();
+
+    QCOMPARE(playerPlaySpy.wait(), true);
+    QCOMPARE(playerPlaySpy.count(), 1);
+
+    myPlayer.setPlayerPlaybackState(QMediaPlayer::PlayingState);
+
+    QCOMPARE(startedPlayingTrackSpy.count(), 1);
+    QCOMPARE(myPlayList.data(myPlayList.index(0, 0), ManageAudioPlayerTest::IsPlayingRole).toInt(), static_cast<int>(MediaPlayList::IsPlaying));
+
+    myPlayer.playerNextSourceStarted(QUrl::fromUserInput(QStringLiteral("file:///2.mp3")));
+
+    QCOMPARE(skipNextTrackSpy.wait(), true);
+    QCOMPARE(skipNextTrackSpy.count(), 1);
+
+    myPlayer.setCurrentTrack(myPlayList.index(1, 0));
+
+    QCOMPARE(currentTrackChangedSpy.count(), 2);
+    QCOMPARE(playerSourceChangedSpy.count(), 2);
+    QCOMPARE(playerSourceChangedSpy.at(1).at(0).toUrl(), QUrl::fromUserInput(QStringLiteral("file:///2.mp3")));
+    QCOMPARE(startedPlayingTrackSpy.count(), 2);
+    QCOMPARE(startedPlayingTrackSpy.at(1).at(0).toUrl(), QUrl::fromUserInput(QStringLiteral("file:///2.mp3")));
+    QCOMPARE(myPlayList.data(myPlayList.index(0, 0), ManageAudioPlayerTest::IsPlayingRole).toInt(), static_cast<int>(MediaPlayList::NotPlaying));
+    QCOMPARE(myPlayList.data(myPlayList.index(1, 0), ManageAudioPlayerTest::IsPlayingRole).toInt(), static_cast<int>(MediaPlayList::IsPlaying));
+    QCOMPARE(myPlayer.playerSource(), QUrl::fromUserInput(QStringLiteral("file:///2.mp3")));
+
+    QCOMPARE(playerStopSpy.wait(100), false);
+    QCOMPARE(playerStopSpy.count(), 0);
+    QCOMPARE(playerPlaySpy.count(), 1);
+
+    myPlayer.setNextTrack({});
+
+    QCOMPARE(nextTrackChangedSpy.count(), 2);
+    QCOMPARE(playerNextSourceChangedSpy.count(), 2);
+    QCOMPARE(playerNextSourceChangedSpy.at(1).at(0).toUrl(), QUrl());
+}
+
+void ManageAudioPlayerTest::skipBetweenTracksWithSameUrl()
+{
+    ManageAudioPlayer myPlayer;
+    QStandardItemModel myPlayList;
+
+    QSignalSpy playerSourceChangedSpy(&myPlayer, &ManageAudioPlayer::playerSourceChanged);
+    QSignalSpy playerLoadSourceSpy(&myPlayer, &ManageAudioPlayer::playerLoadSource);
+    QSignalSpy playerPlaySpy(&myPlayer, &ManageAudioPlayer::playerPlay);
+    QSignalSpy playerStopSpy(&myPlayer, &ManageAudioPlayer::playerStop);
+
+    myPlayList.appendRow(new QStandardItem);
+    myPlayList.appendRow(new QStandardItem);
+
+    myPlayList.item(0, 0)->setData(QUrl::fromUserInput(QStringLiteral("file:///1.mp3")), ManageAudioPlayerTest::ResourceRole);
+    myPlayList.item(1, 0)->setData(QUrl::fromUserInput(QStringLiteral("file:///1.mp3")), ManageAudioPlayerTest::ResourceRole);
+
+    myPlayer.setUrlRole(ManageAudioPlayerTest::ResourceRole);
+    myPlayer.setIsPlayingRole(ManageAudioPlayerTest::IsPlayingRole);
+    myPlayer.setPlayListModel(&myPlayList);
+
+    myPlayer.setCurrentTrack(myPlayList.index(0, 0));
+
+    QCOMPARE(playerLoadSourceSpy.count(), 1);
+    QCOMPARE(playerLoadSourceSpy.at(0).at(0).toUrl(), QUrl::fromUserInput(QStringLiteral("file:///1.mp3")));
+    QCOMPARE(playerLoadSourceSpy.at(0).at(1).toBool(), false);
+
+    myPlayer.setPlayerStatus(QMediaPlayer::LoadedMedia);
+    myPlayer.ensurePlay();
+
+    QCOMPARE(playerPlaySpy.wait(), true);
+
+    myPlayer.setPlayerPlaybackState(QMediaPlayer::PlayingState);
+    myPlayer.setPlayerStatus(QMediaPlayer::BufferedMedia);
+
+    myPlayer.setCurrentTrack(myPlayList.index(1, 0));
+
+    QCOMPARE(playerStopSpy.wait(), true);
+    QCOMPARE(playerLoadSourceSpy.count(), 1);
+
+    myPlayer.setPlayerPlaybackState(QMediaPlayer::StoppedState);
+
+    QCOMPARE(playerSourceChangedSpy.count(), 2);
+    QCOMPARE(playerLoadSourceSpy.count(), 2);
+    QCOMPARE(playerLoadSourceSpy.at(1).at(0).toUrl(), QUrl::fromUserInput(QStringLiteral("file:///1.mp3")));
+    QCOMPARE(playerLoadSourceSpy.at(1).at(1).toBool(), true);
+    QCOMPARE(myPlayer.currentTrack(), QPersistentModelIndex(myPlayList.index(1, 0)));
+
+    myPlayer.setPlayerStatus(QMediaPlayer::LoadedMedia);
+
+    QCOMPARE(playerPlaySpy.wait(), true);
+    QCOMPARE(playerPlaySpy.count(), 2);
+}
+
+void ManageAudioPlayerTest::playerBuffering()
+{
+    ManageAudioPlayer myPlayer;
+
+    QSignalSpy playerBufferingChangedSpy(&myPlayer, &ManageAudioPlayer::playerBufferingChanged);
+
+    QCOMPARE(myPlayer.playerIsBuffering(), false);
+
+    myPlayer.setPlayerStatus(QMediaPlayer::LoadingMedia);
+
+    QCOMPARE(myPlayer.playerIsBuffering(), true);
+    QCOMPARE(playerBufferingChangedSpy.count(), 1);
+    QCOMPARE(playerBufferingChangedSpy.at(0).at(0).toBool(), true);
+
+    myPlayer.setPlayerStatus(QMediaPlayer::BufferingMedia);
+
+    QCOMPARE(playerBufferingChangedSpy.count(), 1);
+
+    myPlayer.setPlayerStatus(QMediaPlayer::StalledMedia);
+
+    QCOMPARE(myPlayer.playerIsBuffering(), false);
+    QCOMPARE(playerBufferingChangedSpy.count(), 2);
+    QCOMPARE(playerBufferingChangedSpy.at(1).at(0).toBool(), false);
+
+    myPlayer.setPlayerStatus(QMediaPlayer::BufferingMedia);
+
+    QCOMPARE(myPlayer.playerIsBuffering(), true);
+    QCOMPARE(playerBufferingChangedSpy.count(), 3);
+
+    myPlayer.setPlayerStatus(QMediaPlayer::BufferedMedia);
+
+    QCOMPARE(myPlayer.playerIsBuffering(), false);
+    QCOMPARE(playerBufferingChangedSpy.count(), 4);
+    QCOMPARE(playerBufferingChangedSpy.at(3).at(0).toBool(), false);
+}
+
 QTEST_GUILESS_MAIN(ManageAudioPlayerTest)
 
 
@@ -91,6 +91,12 @@ private Q_SLOTS:
 
     void playSingleAndClearPlayListTrack();
 
+    void gaplessSkipNextTrack();
+
+    void skipBetweenTracksWithSameUrl();
+
+    void playerBuffering();
+
 };
 
 #endif // MANAGEAUDIOPLAYERTEST_H
@@ -6594,6 +6594,76 @@ void MediaPlayListTest::testEmptyEnqueue()
     QCOMPARE(newEntryInListSpy.count(), 0);
 }
 
+void MediaPlayListTest::nextTrackPlayList()
+{
+    MediaPlayList myPlayList;
+    QAbstractItemModelTester testModel(&myPlayList);
+    DatabaseInterface myDatabaseContent;
+    TracksListener myListener(&myDatabaseContent);
+
+    QSignalSpy currentTrackChangedSpy(&myPlayList, &MediaPlayList::currentTrackChanged);
+    QSignalSpy nextTrackChangedSpy(&myPlayList, &MediaPlayList::nextTrackChanged);
+
+    myDatabaseContent.init(QStringLiteral("testDbDirectContent"));
+
+    connect(&myListener, &TracksListener::trackHasChanged,
+            &myPlayList, &MediaPlayList::trackChanged,
+            Qt::QueuedConnection);
+    connect(&myListener, &TracksListener::tracksListAdded,
+            &myPlayList, &MediaPlayList::tracksListAdded,
+            Qt::QueuedConnection);
+    connect(&myPlayList, &MediaPlayList::newTrackByNameInList,
+            &myListener, &TracksListener::trackByNameInList,
+            Qt::QueuedConnection);
+    connect(&myPlayList, &MediaPlayList::newEntryInList,
+            &myListener, &TracksListener::newEntryInList,
+            Qt::QueuedConnection);
+    connect(&myDatabaseContent, &DatabaseInterface::tracksAdded,
+            &myListener, &TracksListener::tracksAdded);
+
+    myDatabaseContent.insertTracksList(mNewTracks, mNewCovers, QStringLiteral("autoTest"));
+
+    myPlayList.enqueue({myDatabaseContent.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track1"), QStringLiteral("artist1"), QStringLiteral("album2"), 1, 1),
+                        QStringLiteral("track1")},
+                       ElisaUtils::Track);
+    myPlayList.enqueue({myDatabaseContent.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track3"), QStringLiteral("artist3"), QStringLiteral("album1"), 3, 3),
+                        QStringLiteral("track3")},
+                       ElisaUtils::Track);
+    myPlayList.enqueue({myDatabaseContent.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track5"), QStringLiteral("artist1"), QStringLiteral("album2"), 5, 1),
+                        QStringLiteral("track5")},
+                       ElisaUtils::Track);
+
+    QCOMPARE(nextTrackChangedSpy.count(), 0);
+    QCOMPARE(myPlayList.nextTrack(), QPersistentModelIndex());
+
+    QCOMPARE(currentTrackChangedSpy.wait(), true);
+
+    QCOMPARE(myPlayList.currentTrack(), QPersistentModelIndex(myPlayList.index(0, 0)));
+    QTRY_COMPARE(myPlayList.nextTrack(), QPersistentModelIndex(myPlayList.index(1, 0)));
+    QCOMPARE(nextTrackChangedSpy.last().at(0).value<QPersistentModelIndex>(), QPersistentModelIndex(myPlayList.index(1, 0)));
+
+    myPlayList.skipNextTrack();
+
+    QCOMPARE(myPlayList.currentTrack(), QPersistentModelIndex(myPlayList.index(1, 0)));
+    QTRY_COMPARE(myPlayList.nextTrack(), QPersistentModelIndex(myPlayList.index(2, 0)));
+
+    myPlayList.skipNextTrack();
+
+    QCOMPARE(myPlayList.currentTrack(), QPersistentModelIndex(myPlayList.index(2, 0)));
+    QCOMPARE(myPlayList.nextTrack(), QPersistentModelIndex());
+    QCOMPARE(nextTrackChangedSpy.last().at(0).value<QPersistentModelIndex>(), QPersistentModelIndex());
+
+    myPlayList.setRepeatPlay(true);
+
+    QCOMPARE(myPlayList.nextTrack(), QPersistentModelIndex(myPlayList.index(0, 0)));
+    QCOMPARE(nextTrackChangedSpy.last().at(0).value<QPersistentModelIndex>(), QPersistentModelIndex(myPlayList.index(0, 0)));
+
+    myPlayList.setRandomPlay(true);
+
+    QCOMPARE(myPlayList.nextTrack(), QPersistentModelIndex());
+    QCOMPARE(nextTrackChangedSpy.last().at(0).value<QPersistentModelIndex>(), QPersistentModelIndex());
+}
+
 QTEST_GUILESS_MAIN(MediaPlayListTest)
 
 
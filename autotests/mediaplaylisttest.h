@@ -137,6 +137,8 @@ private Q_SLOTS:
 
     void clearPlayListCase();
 
+    void nextTrackPlayList();
+
 };
 
 class MediaPlayList;
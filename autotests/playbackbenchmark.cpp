@@ -0,0 +1,247 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "audiowrapper.h"
+#include "manageaudioplayer.h"
+
+#include "generatedaudiofiles.h"
+
+#include <QObject>
+#include <QString>
+#include <QUrl>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <QStandardItemModel>
+#include <QStandardItem>
+#include <QAbstractEventDispatcher>
+
+#include <QtTest>
+
+#include <ctime>
+#include <memory>
+
+class PlaybackBenchmark: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    enum ColumnsRoles {
+        ResourceRole = Qt::UserRole + 1,
+        IsPlayingRole = ResourceRole + 1,
+    };
+
+    PlaybackBenchmark(QObject *parent = nullptr) : QObject(parent)
+    {
+    }
+
+private:
+
+    static const int mTracksCount = 8;
+
+    static const int mTrackDuration = 20000;
+
+    static const int mSkipsCount = 5;
+
+    static const int mSteadyPlaybackDuration = 5000;
+
+    QTemporaryDir mCorpusDirectory;
+
+    QStandardItemModel mPlayList;
+
+    std::unique_ptr<AudioWrapper> mAudioWrapper;
+
+    std::unique_ptr<ManageAudioPlayer> mAudioControl;
+
+    void createPlayer()
+    {
+        mAudioWrapper = std::make_unique<AudioWrapper>();
+        mAudioControl = std::make_unique<ManageAudioPlayer>();
+
+        mAudioControl->setUrlRole(ResourceRole);
+        mAudioControl->setIsPlayingRole(IsPlayingRole);
+        mAudioControl->setPlayListModel(&mPlayList);
+
+        connect(mAudioControl.get(), &ManageAudioPlayer::playerPlay, mAudioWrapper.get(), &AudioWrapper::play);
+        connect(mAudioControl.get(), &ManageAudioPlayer::playerPause, mAudioWrapper.get(), &AudioWrapper::pause);
+        connect(mAudioControl.get(), &ManageAudioPlayer::playerStop, mAudioWrapper.get(), &AudioWrapper::stop);
+        connect(mAudioControl.get(), &ManageAudioPlayer::seek, mAudioWrapper.get(), &AudioWrapper::seek);
+        connect(mAudioControl.get(), &ManageAudioPlayer::playerSourceChanged, mAudioWrapper.get(), &AudioWrapper::setSource);
+        connect(mAudioControl.get(), &ManageAudioPlayer::playerNextSourceChanged, mAudioWrapper.get(), &AudioWrapper::setNextSource);
+
+        connect(mAudioWrapper.get(), &AudioWrapper::playbackStateChanged, mAudioControl.get(), &ManageAudioPlayer::setPlayerPlaybackState);
+        connect(mAudioWrapper.get(), &AudioWrapper::statusChanged, mAudioControl.get(), &ManageAudioPlayer::setPlayerStatus);
+        connect(mAudioWrapper.get(), &AudioWrapper::errorChanged, mAudioControl.get(), &ManageAudioPlayer::setPlayerError);
+        connect(mAudioWrapper.get(), &AudioWrapper::durationChanged, mAudioControl.get(), &ManageAudioPlayer::setAudioDuration);
+        connect(mAudioWrapper.get(), &AudioWrapper::seekableChanged, mAudioControl.get(), &ManageAudioPlayer::setPlayerIsSeekable);
+        connect(mAudioWrapper.get(), &AudioWrapper::positionChanged, mAudioControl.get(), &ManageAudioPlayer::setPlayerPosition);
+        connect(mAudioWrapper.get(), &AudioWrapper::nextSourceStarted, mAudioControl.get(), &ManageAudioPlayer::playerNextSourceStarted);
+    }
+
+    void destroyPlayer()
+    {
+        if (mAudioWrapper) {
+            mAudioWrapper->stop();
+        }
+
+        mAudioControl.reset();
+        mAudioWrapper.reset();
+    }
+
+    void playTrack(int row)
+    {
+        mAudioControl->setCurrentTrack(mPlayList.index(row, 0));
+        mAudioControl->setNextTrack(row + 1 < mPlayList.rowCount() ? mPlayList.index(row + 1, 0) : QModelIndex());
+    }
+
+    bool waitForPlayingSource(const QUrl &source, int timeout)
+    {
+        QElapsedTimer timeoutTimer;
+        timeoutTimer.start();
+
+        while (timeoutTimer.elapsed() < timeout) {
+            if (mAudioWrapper->playbackState() == QMediaPlayer::PlayingState && mAudioWrapper->source() == source) {
+                return true;
+            }
+
+            QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents, 5);
+        }
+
+        return false;
+    }
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        QVERIFY(mCorpusDirectory.isValid());
+
+        for (int i = 0; i < mTracksCount; ++i) {
+            const auto fileName = mCorpusDirectory.filePath(QStringLiteral("track%1.wav").arg(i));
+
+            QVERIFY(GeneratedAudioFiles::writeWaveFile(fileName, mTrackDuration, 220. + 55. * i));
+
+            auto newItem = new QStandardItem;
+            newItem->setData(QUrl::fromLocalFile(fileName), ResourceRole);
+            mPlayList.appendRow(newItem);
+        }
+    }
+
+    void init()
+    {
+        if (!GeneratedAudioFiles::hasAudioOutput()) {
+            QSKIP("no audio output device available");
+        }
+
+        createPlayer();
+    }
+
+    void cleanup()
+    {
+        destroyPlayer();
+    }
+
+    void timeToFirstAudio()
+    {
+        QElapsedTimer latencyTimer;
+        latencyTimer.start();
+
+        playTrack(0);
+        mAudioControl->ensurePlay();
+
+        QVERIFY(waitForPlayingSource(mPlayList.index(0, 0).data(ResourceRole).toUrl(), 10000));
+
+        QTest::setBenchmarkResult(latencyTimer.elapsed(), QTest::WalltimeMilliseconds);
+    }
+
+    void skipNextLatency()
+    {
+        playTrack(0);
+        mAudioControl->ensurePlay();
+
+        QVERIFY(waitForPlayingSource(mPlayList.index(0, 0).data(ResourceRole).toUrl(), 10000));
+
+        qint64 totalLatency = 0;
+
+        for (int row = 1; row <= mSkipsCount; ++row) {
+            QElapsedTimer latencyTimer;
+            latencyTimer.start();
+
+            playTrack(row);
+
+            QVERIFY(waitForPlayingSource(mPlayList.index(row, 0).data(ResourceRole).toUrl(), 10000));
+
+            totalLatency += latencyTimer.elapsed();
+        }
+
+        QTest::setBenchmarkResult(static_cast<qreal>(totalLatency) / mSkipsCount, QTest::WalltimeMilliseconds);
+    }
+
+    void seekLatency()
+    {
+        playTrack(0);
+        mAudioControl->ensurePlay();
+
+        QVERIFY(waitForPlayingSource(mPlayList.index(0, 0).data(ResourceRole).toUrl(), 10000));
+        QTRY_VERIFY_WITH_TIMEOUT(mAudioWrapper->seekable() && mAudioWrapper->duration() > 0, 10000);
+
+        const qint64 targetPosition = mTrackDuration / 2;
+
+        QElapsedTimer latencyTimer;
+        latencyTimer.start();
+
+        mAudioControl->playerSeek(static_cast<int>(targetPosition));
+
+        QTRY_VERIFY_WITH_TIMEOUT(qAbs(mAudioWrapper->position() - targetPosition) < 1000, 10000);
+
+        QTest::setBenchmarkResult(latencyTimer.elapsed(), QTest::WalltimeMilliseconds);
+    }
+
+    void steadyPlaybackWakeups()
+    {
+        playTrack(0);
+        mAudioControl->ensurePlay();
+
+        QVERIFY(waitForPlayingSource(mPlayList.index(0, 0).data(ResourceRole).toUrl(), 10000));
+
+        int wakeupsCount = 0;
+        auto dispatcher = QAbstractEventDispatcher::instance();
+        auto wakeupConnection = connect(dispatcher, &QAbstractEventDispatcher::awake, this, [&wakeupsCount]() {++wakeupsCount;});
+
+        QElapsedTimer playbackTimer;
+        playbackTimer.start();
+        const auto startCpuTime = std::clock();
+
+        while (playbackTimer.elapsed() < mSteadyPlaybackDuration) {
+            QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents, mSteadyPlaybackDuration);
+        }
+
+        const auto cpuTime = 1000. * (std::clock() - startCpuTime) / CLOCKS_PER_SEC;
+        const auto elapsedTime = playbackTimer.elapsed();
+
+        disconnect(wakeupConnection);
+
+        qInfo() << "CPU time per hour of playback" << cpuTime * 3600000. / elapsedTime / 1000. << "s";
+
+        QTest::setBenchmarkResult(1000. * wakeupsCount / elapsedTime, QTest::Events);
+    }
+};
+
+QTEST_GUILESS_MAIN(PlaybackBenchmark)
+
+
+#include "playbackbenchmark.moc"
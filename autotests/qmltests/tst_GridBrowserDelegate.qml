@@ -43,6 +43,10 @@ FocusScope {
 
         Item {
             id: elisaTheme
+
+            function coverImageSource(imageUrl) {
+                return imageUrl
+            }
         }
     }
 
@@ -53,6 +53,10 @@ Item {
             property int layoutHorizontalMargin: 8
             property int smallDelegateToolButtonSize: 20
             property int ratingStarSize: 15
+
+            function coverImageSource(imageUrl) {
+                return imageUrl
+            }
         }
     }
 
@@ -0,0 +1,298 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "abstractfile/scanscheduler.h"
+
+#include <QObject>
+#include <QString>
+#include <QDir>
+#include <QTemporaryDir>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QtConcurrentRun>
+
+#include <QtTest>
+
+class ScanSchedulerTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    ScanSchedulerTest(QObject *parent = nullptr) : QObject(parent)
+    {
+    }
+
+private Q_SLOTS:
+
+    void sameDeviceForSameFileSystem()
+    {
+        QTemporaryDir rootDirectory;
+        QVERIFY(rootDirectory.isValid());
+
+        QDir(rootDirectory.path()).mkpath(QStringLiteral("first/album"));
+        QDir(rootDirectory.path()).mkpath(QStringLiteral("second"));
+
+        ScanScheduler myScheduler;
+
+        const auto firstDevice = myScheduler.deviceId(rootDirectory.path() + QStringLiteral("/first/album"));
+        const auto secondDevice = myScheduler.deviceId(rootDirectory.path() + QStringLiteral("/second"));
+
+        QCOMPARE(firstDevice, secondDevice);
+        QCOMPARE(myScheduler.deviceId(rootDirectory.path() + QStringLiteral("/doesNotExist")), quint64(0));
+    }
+
+    void unknownDevice()
+    {
+        QCOMPARE(ScanScheduler::detectStorageKind(0), ScanScheduler::StorageKind::Unknown);
+
+        ScanScheduler myScheduler;
+
+        QCOMPARE(myScheduler.deviceConcurrency(0), 2);
+    }
+
+    void concurrencyLimit()
+    {
+        ScanScheduler myScheduler;
+
+        myScheduler.setDeviceConcurrency(42, 3);
+
+        myScheduler.acquire(42);
+        QCOMPARE(myScheduler.busyWorkers(42), 1);
+
+        QCOMPARE(myScheduler.tryAcquire(42, 5), 2);
+        QCOMPARE(myScheduler.busyWorkers(42), 3);
+        QCOMPARE(myScheduler.tryAcquire(42, 1), 0);
+
+        myScheduler.release(42, 2);
+        QCOMPARE(myScheduler.tryAcquire(42, 1), 1);
+
+        myScheduler.release(42, 2);
+        QCOMPARE(myScheduler.busyWorkers(42), 0);
+
+        QCOMPARE(myScheduler.busyWorkers(43), 0);
+    }
+
+    void blockingAcquire()
+    {
+        ScanScheduler myScheduler;
+
+        myScheduler.setDeviceConcurrency(42, 1);
+        myScheduler.setDeviceConcurrency(43, 1);
+
+        myScheduler.acquire(42);
+
+        QThreadPool otherThreads;
+        auto otherDeviceAcquire = QtConcurrent::run(&otherThreads, [&myScheduler]() {
+            myScheduler.acquire(43);
+            myScheduler.release(43, 1);
+        });
+        auto sameDeviceAcquire = QtConcurrent::run(&otherThreads, [&myScheduler]() {
+            myScheduler.acquire(42);
+        });
+
+        otherDeviceAcquire.waitForFinished();
+
+        QTest::qWait(50);
+        QVERIFY(!sameDeviceAcquire.isFinished());
+
+        myScheduler.release(42, 1);
+
+        sameDeviceAcquire.waitForFinished();
+        QCOMPARE(myScheduler.busyWorkers(42), 1);
+
+        myScheduler.release(42, 1);
+    }
+
+    void deviceSlot()
+    {
+        QTemporaryDir rootDirectory;
+        QVERIFY(rootDirectory.isValid());
+
+        ScanScheduler myScheduler;
+
+        const auto rootDevice = myScheduler.deviceId(rootDirectory.path());
+        myScheduler.setDeviceConcurrency(rootDevice, 3);
+
+        {
+            ScanScheduler::DeviceSlot mySlot(&myScheduler, rootDirectory.path());
+
+            QCOMPARE(myScheduler.busyWorkers(rootDevice), 1);
+            QCOMPARE(mySlot.threadPool(), &myScheduler.threadPool());
+
+            QCOMPARE(mySlot.acquireExtraWorkers(10), 2);
+            QCOMPARE(myScheduler.busyWorkers(rootDevice), 3);
+
+            mySlot.releaseExtraWorkers();
+            QCOMPARE(myScheduler.busyWorkers(rootDevice), 1);
+
+            QCOMPARE(mySlot.acquireExtraWorkers(1), 1);
+        }
+
+        QCOMPARE(myScheduler.busyWorkers(rootDevice), 0);
+
+        ScanScheduler::DeviceSlot noSchedulerSlot(nullptr, rootDirectory.path());
+
+        QCOMPARE(noSchedulerSlot.acquireExtraWorkers(4), 0);
+        QVERIFY(!noSchedulerSlot.threadPool());
+    }
+
+    void filesPerSecondBudget()
+    {
+        ScanScheduler myScheduler;
+        QAtomicInt stopRequest = 0;
+
+        myScheduler.setFilesPerSecondBudget(20);
+
+        QElapsedTimer budgetTimer;
+        budgetTimer.start();
+
+        for (int i = 0; i < 5; ++i) {
+            myScheduler.waitForBudget(0, stopRequest);
+        }
+
+        QVERIFY(budgetTimer.elapsed() >= 190);
+
+        myScheduler.setFilesPerSecondBudget(0);
+        budgetTimer.restart();
+
+        for (int i = 0; i < 100; ++i) {
+            myScheduler.waitForBudget(0, stopRequest);
+        }
+
+        QVERIFY(budgetTimer.elapsed() < 100);
+    }
+
+    void cpuPercentBudget()
+    {
+        ScanScheduler myScheduler;
+        QAtomicInt stopRequest = 0;
+
+        myScheduler.setCpuPercentBudget(0);
+        QCOMPARE(myScheduler.cpuPercentBudget(), 1);
+
+        myScheduler.setCpuPercentBudget(25);
+
+        QElapsedTimer budgetTimer;
+        budgetTimer.start();
+
+        // 50ms of work at 25% means 150ms of rest
+        myScheduler.waitForBudget(50000000, stopRequest);
+
+        QVERIFY(budgetTimer.elapsed() >= 145);
+    }
+
+    void sharedCpuPercentBudget()
+    {
+        ScanScheduler myScheduler;
+        QAtomicInt stopRequest = 0;
+
+        myScheduler.setCpuPercentBudget(25);
+
+        QElapsedTimer budgetTimer;
+        budgetTimer.start();
+
+        // two workers each reporting 50ms of work at 25% share 400ms of time, not 200ms each
+        QThreadPool otherThreads;
+        otherThreads.setMaxThreadCount(2);
+
+        auto firstWorker = QtConcurrent::run(&otherThreads, [&myScheduler, &stopRequest]() {
+            myScheduler.waitForBudget(50000000, stopRequest);
+        });
+        auto secondWorker = QtConcurrent::run(&otherThreads, [&myScheduler, &stopRequest]() {
+            myScheduler.waitForBudget(50000000, stopRequest);
+        });
+
+        firstWorker.waitForFinished();
+        secondWorker.waitForFinished();
+
+        QVERIFY(budgetTimer.elapsed() >= 295);
+    }
+
+    void pauseAndResume()
+    {
+        ScanScheduler myScheduler;
+        QAtomicInt stopRequest = 0;
+
+        myScheduler.setPaused(true);
+        QVERIFY(myScheduler.isPaused());
+
+        QThreadPool otherThreads;
+        auto pausedWorker = QtConcurrent::run(&otherThreads, [&myScheduler, &stopRequest]() {
+            myScheduler.waitForBudget(0, stopRequest);
+        });
+
+        QTest::qWait(150);
+        QVERIFY(!pausedWorker.isFinished());
+
+        myScheduler.setPaused(false);
+
+        pausedWorker.waitForFinished();
+
+        myScheduler.setPaused(true);
+
+        auto stoppedWorker = QtConcurrent::run(&otherThreads, [&myScheduler, &stopRequest]() {
+            myScheduler.waitForBudget(0, stopRequest);
+        });
+
+        QTest::qWait(50);
+        QVERIFY(!stoppedWorker.isFinished());
+
+        stopRequest = 1;
+
+        stoppedWorker.waitForFinished();
+        QVERIFY(myScheduler.isPaused());
+    }
+
+    void waitWhilePaused()
+    {
+        ScanScheduler myScheduler;
+        QAtomicInt stopRequest = 0;
+
+        myScheduler.setFilesPerSecondBudget(1);
+
+        QElapsedTimer budgetTimer;
+        budgetTimer.start();
+
+        for (int i = 0; i < 3; ++i) {
+            myScheduler.waitWhilePaused(stopRequest);
+        }
+
+        QVERIFY(budgetTimer.elapsed() < 500);
+
+        myScheduler.setPaused(true);
+
+        QThreadPool otherThreads;
+        auto pausedWorker = QtConcurrent::run(&otherThreads, [&myScheduler, &stopRequest]() {
+            myScheduler.waitWhilePaused(stopRequest);
+        });
+
+        QTest::qWait(150);
+        QVERIFY(!pausedWorker.isFinished());
+
+        myScheduler.setPaused(false);
+
+        pausedWorker.waitForFinished();
+    }
+};
+
+QTEST_GUILESS_MAIN(ScanSchedulerTest)
+
+
+#include "scanschedulertest.moc"
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "upnp/upnppagingscheduler.h"
+
+#include <QObject>
+#include <QString>
+
+#include <QtTest>
+
+class UpnpPagingSchedulerTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    UpnpPagingSchedulerTest(QObject *parent = nullptr) : QObject(parent)
+    {
+    }
+
+private Q_SLOTS:
+
+    void firstPageAlone()
+    {
+        UpnpPagingScheduler myScheduler(4, 100, 2000);
+
+        auto firstRequests = myScheduler.nextRequests();
+
+        QCOMPARE(firstRequests.size(), 1);
+        QCOMPARE(firstRequests[0].mStartIndex, 0);
+        QCOMPARE(firstRequests[0].mRequestedCount, 100);
+        QVERIFY(myScheduler.nextRequests().isEmpty());
+
+        myScheduler.pageReceived(firstRequests[0], 100, 1000, 600);
+
+        auto nextRequests = myScheduler.nextRequests();
+
+        QCOMPARE(nextRequests.size(), 4);
+        QCOMPARE(myScheduler.outstandingRequestsCount(), 4);
+        QCOMPARE(nextRequests[0].mStartIndex, 100);
+        QCOMPARE(nextRequests[1].mStartIndex, 200);
+        QCOMPARE(nextRequests[3].mStartIndex, 400);
+        QVERIFY(!myScheduler.isFinished());
+    }
+
+    void pageSizeAdapts()
+    {
+        UpnpPagingScheduler myScheduler(1, 100, 400);
+
+        auto oneRequest = myScheduler.nextRequests().first();
+        myScheduler.pageReceived(oneRequest, 100, 100000, 10);
+        QCOMPARE(myScheduler.pageSize(), 200);
+
+        oneRequest = myScheduler.nextRequests().first();
+        QCOMPARE(oneRequest.mRequestedCount, 200);
+        myScheduler.pageReceived(oneRequest, 200, 100000, 10);
+        QCOMPARE(myScheduler.pageSize(), 400);
+
+        oneRequest = myScheduler.nextRequests().first();
+        myScheduler.pageReceived(oneRequest, 400, 100000, 10);
+        QCOMPARE(myScheduler.pageSize(), 400);
+
+        oneRequest = myScheduler.nextRequests().first();
+        myScheduler.pageReceived(oneRequest, 400, 100000, 5000);
+        QCOMPARE(myScheduler.pageSize(), 200);
+    }
+
+    void failedPageIsRequestedAgain()
+    {
+        UpnpPagingScheduler myScheduler(4, 100, 2000);
+
+        auto firstRequest = myScheduler.nextRequests().first();
+        myScheduler.pageFailed(firstRequest);
+
+        QVERIFY(!myScheduler.hasFailed());
+
+        auto retriedRequests = myScheduler.nextRequests();
+        QCOMPARE(retriedRequests.size(), 1);
+        QCOMPARE(retriedRequests[0].mStartIndex, 0);
+
+        myScheduler.pageFailed(retriedRequests[0]);
+        myScheduler.pageFailed(myScheduler.nextRequests().first());
+
+        QVERIFY(myScheduler.hasFailed());
+        QVERIFY(myScheduler.isFinished());
+        QVERIFY(myScheduler.nextRequests().isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(UpnpPagingSchedulerTest)
+
+
+#include "upnppagingschedulertest.moc"
@@ -0,0 +1,262 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "upnp/upnpsyncstate.h"
+
+#include "musicaudiotrack.h"
+
+#include <QObject>
+#include <QString>
+#include <QUrl>
+
+#include <QtTest>
+
+class UpnpSyncStateTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    UpnpSyncStateTest(QObject *parent = nullptr) : QObject(parent)
+    {
+    }
+
+private:
+
+    static MusicAudioTrack newTrack(const QString &containerId, int index, const QString &title = {})
+    {
+        MusicAudioTrack result;
+
+        result.setId(QStringLiteral("%1$%2").arg(containerId).arg(index));
+        result.setParentId(containerId);
+        result.setTitle(title.isEmpty() ? QStringLiteral("Track %1").arg(index) : title);
+        result.setArtist(QStringLiteral("Artist %1").arg(containerId));
+        result.setAlbumName(QStringLiteral("Album %1").arg(containerId));
+        result.setTrackNumber(index);
+        result.setDuration(QTime::fromMSecsSinceStartOfDay(205000));
+        result.setResourceURI(QUrl(QStringLiteral("http://127.0.0.1:8200/MediaItems/%1-%2.mp3").arg(containerId).arg(index)));
+
+        return result;
+    }
+
+    static QList<MusicAudioTrack> containerTracks(const QString &containerId, int tracksCount)
+    {
+        QList<MusicAudioTrack> result;
+
+        for (int i = 1; i <= tracksCount; ++i) {
+            result.push_back(newTrack(containerId, i));
+        }
+
+        return result;
+    }
+
+    /* two albums of three tracks synchronized with SystemUpdateID 10 */
+    static void initialSync(UpnpSyncState &syncState)
+    {
+        syncState.beginResync({});
+        syncState.tracksDecoded(containerTracks(QStringLiteral("64$1"), 3));
+        syncState.tracksDecoded(containerTracks(QStringLiteral("64$2"), 3));
+        syncState.endResync(10);
+    }
+
+private Q_SLOTS:
+
+    void firstSyncIsFull()
+    {
+        UpnpSyncState syncState;
+
+        QVERIFY(syncState.isEmpty());
+        QVERIFY(syncState.knownTracks().isEmpty());
+        QCOMPARE(syncState.resyncKind(10), UpnpSyncState::ResyncKind::FullResync);
+
+        syncState.beginResync({});
+
+        const auto &firstDelta = syncState.tracksDecoded(containerTracks(QStringLiteral("64$1"), 3));
+        QCOMPARE(firstDelta.mNewTracks.size(), 3);
+        QVERIFY(firstDelta.mModifiedTracks.isEmpty());
+
+        const auto &endDelta = syncState.endResync(10);
+        QVERIFY(endDelta.mRemovedTracks.isEmpty());
+
+        QVERIFY(!syncState.isEmpty());
+        QCOMPARE(syncState.knownTracks().size(), 3);
+        QVERIFY(syncState.knownTracks().contains(QUrl(QStringLiteral("http://127.0.0.1:8200/MediaItems/64$1-2.mp3"))));
+        QVERIFY(!syncState.isResyncRunning());
+        QCOMPARE(syncState.systemUpdateId(), 10);
+        QCOMPARE(syncState.resyncKind(10), UpnpSyncState::ResyncKind::NoResync);
+    }
+
+    void fullResyncSendsOnlyDeltas()
+    {
+        UpnpSyncState syncState;
+        initialSync(syncState);
+
+        QCOMPARE(syncState.resyncKind(11), UpnpSyncState::ResyncKind::FullResync);
+
+        syncState.beginResync({});
+
+        auto firstAlbum = containerTracks(QStringLiteral("64$1"), 4);
+        firstAlbum[1].setTitle(QStringLiteral("Renamed"));
+
+        const auto &firstDelta = syncState.tracksDecoded(firstAlbum);
+        QCOMPARE(firstDelta.mNewTracks.size(), 1);
+        QCOMPARE(firstDelta.mNewTracks.first().trackNumber(), 4);
+        QCOMPARE(firstDelta.mModifiedTracks.size(), 1);
+        QCOMPARE(firstDelta.mModifiedTracks.first().title(), QStringLiteral("Renamed"));
+
+        const auto &secondDelta = syncState.tracksDecoded(containerTracks(QStringLiteral("64$2"), 2));
+        QVERIFY(secondDelta.mNewTracks.isEmpty());
+        QVERIFY(secondDelta.mModifiedTracks.isEmpty());
+
+        const auto &endDelta = syncState.endResync(11);
+        QCOMPARE(endDelta.mRemovedTracks, QList<QUrl>{newTrack(QStringLiteral("64$2"), 3).resourceURI()});
+        QCOMPARE(syncState.systemUpdateId(), 11);
+    }
+
+    void containerUpdateIdsSelectContainers()
+    {
+        UpnpSyncState syncState;
+        initialSync(syncState);
+
+        syncState.containerUpdateIdsChanged(QStringLiteral("64$2,4"));
+
+        QCOMPARE(syncState.resyncKind(11), UpnpSyncState::ResyncKind::ContainersResync);
+        QCOMPARE(syncState.changedContainers(), QVector<QString>{QStringLiteral("64$2")});
+
+        syncState.beginResync(syncState.changedContainers());
+
+        auto secondAlbum = containerTracks(QStringLiteral("64$2"), 2);
+        secondAlbum.push_back(newTrack(QStringLiteral("64$2"), 5));
+
+        const auto &decodedDelta = syncState.tracksDecoded(secondAlbum);
+        QCOMPARE(decodedDelta.mNewTracks.size(), 1);
+        QVERIFY(decodedDelta.mModifiedTracks.isEmpty());
+
+        const auto &endDelta = syncState.endResync(11);
+        QCOMPARE(endDelta.mRemovedTracks, QList<QUrl>{newTrack(QStringLiteral("64$2"), 3).resourceURI()});
+
+        QVERIFY(syncState.changedContainers().isEmpty());
+        QCOMPARE(syncState.resyncKind(11), UpnpSyncState::ResyncKind::NoResync);
+
+        syncState.containerUpdateIdsChanged(QStringLiteral("64$2,4"));
+        QVERIFY(syncState.changedContainers().isEmpty());
+    }
+
+    void unknownContainerNeedsFullResync()
+    {
+        UpnpSyncState syncState;
+        initialSync(syncState);
+
+        syncState.containerUpdateIdsChanged(QStringLiteral("64$1,3,64,12"));
+
+        QCOMPARE(syncState.resyncKind(11), UpnpSyncState::ResyncKind::FullResync);
+    }
+
+    void missingEventsNeedFullResync()
+    {
+        UpnpSyncState syncState;
+        initialSync(syncState);
+
+        QCOMPARE(syncState.resyncKind(15), UpnpSyncState::ResyncKind::FullResync);
+    }
+
+    void invalidContainerUpdateIds()
+    {
+        UpnpSyncState syncState;
+        initialSync(syncState);
+
+        syncState.containerUpdateIdsChanged(QStringLiteral("64$1,notanumber,64$2"));
+
+        QVERIFY(syncState.changedContainers().isEmpty());
+    }
+
+    void sharedTracksAreKept()
+    {
+        UpnpSyncState syncState;
+        initialSync(syncState);
+
+        syncState.beginResync({});
+        auto sharedTrack = newTrack(QStringLiteral("64$1"), 1);
+        sharedTrack.setParentId(QStringLiteral("64$3"));
+        syncState.tracksDecoded(containerTracks(QStringLiteral("64$1"), 3) + containerTracks(QStringLiteral("64$2"), 3) + QList<MusicAudioTrack>{sharedTrack});
+        syncState.endResync(11);
+
+        syncState.containerUpdateIdsChanged(QStringLiteral("64$3,2"));
+        QCOMPARE(syncState.resyncKind(12), UpnpSyncState::ResyncKind::ContainersResync);
+
+        syncState.beginResync(syncState.changedContainers());
+        const auto &endDelta = syncState.endResync(12);
+
+        QVERIFY(endDelta.mRemovedTracks.isEmpty());
+    }
+
+    void abortedResyncKeepsState()
+    {
+        UpnpSyncState syncState;
+        initialSync(syncState);
+
+        syncState.beginResync({});
+        syncState.tracksDecoded(containerTracks(QStringLiteral("64$1"), 1));
+        syncState.abortResync();
+
+        QVERIFY(!syncState.isResyncRunning());
+        QCOMPARE(syncState.systemUpdateId(), 10);
+
+        syncState.beginResync({});
+        syncState.tracksDecoded(containerTracks(QStringLiteral("64$1"), 3) + containerTracks(QStringLiteral("64$2"), 3));
+        const auto &endDelta = syncState.endResync(11);
+
+        QVERIFY(endDelta.mRemovedTracks.isEmpty());
+    }
+
+    void saveAndLoad()
+    {
+        UpnpSyncState syncState;
+        initialSync(syncState);
+
+        syncState.containerUpdateIdsChanged(QStringLiteral("64$1,7"));
+        syncState.beginResync(syncState.changedContainers());
+        syncState.tracksDecoded(containerTracks(QStringLiteral("64$1"), 3));
+        syncState.endResync(11);
+
+        UpnpSyncState restoredState;
+        QVERIFY(restoredState.load(syncState.save()));
+
+        QCOMPARE(restoredState.systemUpdateId(), 11);
+        QCOMPARE(restoredState.resyncKind(11), UpnpSyncState::ResyncKind::NoResync);
+
+        restoredState.containerUpdateIdsChanged(QStringLiteral("64$1,7"));
+        QVERIFY(restoredState.changedContainers().isEmpty());
+
+        restoredState.beginResync({});
+        const auto &decodedDelta = restoredState.tracksDecoded(containerTracks(QStringLiteral("64$1"), 3));
+        QVERIFY(decodedDelta.mNewTracks.isEmpty());
+        QVERIFY(decodedDelta.mModifiedTracks.isEmpty());
+
+        const auto &endDelta = restoredState.endResync(12);
+        QCOMPARE(endDelta.mRemovedTracks.size(), 3);
+
+        UpnpSyncState invalidState;
+        QVERIFY(!invalidState.load(QByteArray("garbage")));
+        QVERIFY(invalidState.isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(UpnpSyncStateTest)
+
+
+#include "upnpsyncstatetest.moc"
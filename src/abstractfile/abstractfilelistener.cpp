@@ -55,9 +55,13 @@ void AbstractFileListener::setDatabaseInterface(DatabaseInterface *model)
         connect(this, &AbstractFileListener::newTrackFile, d->mFileListing, &AbstractFileListing::newTrackFile);
         connect(d->mFileListing, &AbstractFileListing::tracksList, model, &DatabaseInterface::insertTracksList);
         connect(d->mFileListing, &AbstractFileListing::removedTracksList, model, &DatabaseInterface::removeTracksList);
+        connect(d->mFileListing, &AbstractFileListing::renamedTracksList, model, &DatabaseInterface::renameTracksList);
+        connect(d->mFileListing, &AbstractFileListing::embeddedCoverTracksList, model, &DatabaseInterface::setTracksEmbeddedCover);
         connect(d->mFileListing, &AbstractFileListing::modifyTracksList, model, &DatabaseInterface::modifyTracksList);
         connect(d->mFileListing, &AbstractFileListing::askRestoredTracks,
                 model, &DatabaseInterface::askRestoredTracks);
+        connect(model, &DatabaseInterface::restoredFileSizes,
+                d->mFileListing, &AbstractFileListing::restoredFileSizes);
         connect(model, &DatabaseInterface::restoredTracks,
                 d->mFileListing, &AbstractFileListing::restoredTracks);
 
@@ -102,5 +106,10 @@ AbstractFileListing *AbstractFileListener::fileListing() const
     return d->mFileListing;
 }
 
+void AbstractFileListener::setScanScheduler(ScanScheduler *scheduler)
+{
+    d->mFileListing->setScanScheduler(scheduler);
+}
+
 
 #include "moc_abstractfilelistener.cpp"
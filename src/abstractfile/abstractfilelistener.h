@@ -18,6 +18,8 @@
 #ifndef ABSTRACTFILELISTENER_H
 #define ABSTRACTFILELISTENER_H
 
+#include "elisaLib_export.h"
+
 #include "notificationitem.h"
 
 #include <QObject>
@@ -30,8 +32,9 @@ class AbstractFileListenerPrivate;
 class DatabaseInterface;
 class MusicAudioTrack;
 class AbstractFileListing;
+class ScanScheduler;
 
-class AbstractFileListener : public QObject
+class ELISALIB_EXPORT AbstractFileListener : public QObject
 {
     Q_OBJECT
 
@@ -49,6 +52,8 @@ public:
 
     AbstractFileListing* fileListing() const;
 
+    void setScanScheduler(ScanScheduler *scheduler);
+
 Q_SIGNALS:
 
     void databaseInterfaceChanged();
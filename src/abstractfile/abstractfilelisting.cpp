@@ -22,6 +22,11 @@
 #include "musicaudiotrack.h"
 #include "notificationitem.h"
 #include "filescanner.h"
+#include "coverthumbnailcache.h"
+#include "scanscheduler.h"
+#include "audiofileclassifier.h"
+#include "directoryscanorder.h"
+#include "embeddedcoverprobe.h"
 
 #if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
 #include <KFileMetaData/EmbeddedImageData>
@@ -37,13 +42,149 @@
 #include <QSet>
 #include <QPair>
 #include <QAtomicInt>
+#include <QThreadPool>
+#include <QThreadStorage>
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QtConcurrentRun>
+#include <QTimer>
 #include <QDebug>
 
 #include <QtGlobal>
 
+#if defined Q_OS_UNIX
+#include <sys/types.h>
+#include <sys/stat.h>
+#endif
+
 #include <algorithm>
 #include <utility>
 
+/* a file keeps its identity when it is renamed or moved inside the same file system */
+class FileIdentity
+{
+public:
+
+    bool isValid() const
+    {
+        return mInode != 0;
+    }
+
+    quint64 mDevice = 0;
+
+    quint64 mInode = 0;
+
+    qint64 mSize = -1;
+
+    qint64 mModificationTime = 0;
+
+};
+
+static bool operator==(const FileIdentity &first, const FileIdentity &second)
+{
+    return first.mDevice == second.mDevice && first.mInode == second.mInode &&
+            first.mSize == second.mSize && first.mModificationTime == second.mModificationTime;
+}
+
+static uint qHash(const FileIdentity &identity, uint seed = 0)
+{
+    return ::qHash(identity.mInode, seed) ^ ::qHash(identity.mDevice, seed);
+}
+
+static FileIdentity fileIdentity(const QString &localFileName)
+{
+    auto result = FileIdentity{};
+
+#if defined Q_OS_UNIX
+    struct stat fileInformation;
+
+    if (::stat(QFile::encodeName(localFileName).constData(), &fileInformation) == 0) {
+        result.mDevice = static_cast<quint64>(fileInformation.st_dev);
+        result.mInode = static_cast<quint64>(fileInformation.st_ino);
+        result.mSize = static_cast<qint64>(fileInformation.st_size);
+        result.mModificationTime = static_cast<qint64>(fileInformation.st_mtime);
+    }
+#else
+    Q_UNUSED(localFileName);
+#endif
+
+    return result;
+}
+
+#if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
+static bool hasFrontCoverImage(KFileMetaData::EmbeddedImageData &imageScanner, const QString &localFileName)
+{
+    // extracting the picture reads all of it: only do it for the formats the probe cannot walk
+    switch (EmbeddedCoverProbe::probe(localFileName))
+    {
+    case EmbeddedCoverProbe::Presence::Present:
+        return true;
+    case EmbeddedCoverProbe::Presence::Absent:
+        return false;
+    case EmbeddedCoverProbe::Presence::Unknown:
+        break;
+    }
+
+    auto imageData = imageScanner.imageData(localFileName);
+
+    if (imageData.contains(KFileMetaData::EmbeddedImageData::FrontCover)) {
+        if (!imageData[KFileMetaData::EmbeddedImageData::FrontCover].isEmpty()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+#endif
+
+class FileScanWorker
+{
+public:
+
+    MusicAudioTrack scanOneFile(const QUrl &scanFile)
+    {
+        auto newTrack = mFileScanner.scanOneFile(scanFile, mMimeDb);
+
+        if (newTrack.isValid() && !mFileScanner.embeddedCoverIsKnown()) {
+            newTrack.setHasEmbeddedCover(hasEmbeddedCover(scanFile.toLocalFile()));
+        }
+
+        return newTrack;
+    }
+
+    bool hasEmbeddedCover(const QString &localFileName)
+    {
+#if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
+        return hasFrontCoverImage(mImageScanner, localFileName);
+#else
+        Q_UNUSED(localFileName);
+
+        return false;
+#endif
+    }
+
+    FileScanner mFileScanner;
+
+    QMimeDatabase mMimeDb;
+
+#if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
+    KFileMetaData::EmbeddedImageData mImageScanner;
+#endif
+
+};
+
+/* the metadata extractors are not shared between threads: each scan thread gets its own */
+static FileScanWorker& threadFileScanWorker()
+{
+    static QThreadStorage<FileScanWorker*> allWorkers;
+
+    if (!allWorkers.hasLocalData()) {
+        allWorkers.setLocalData(new FileScanWorker);
+    }
+
+    return *allWorkers.localData();
+}
+
 class AbstractFileListingPrivate
 {
 public:
@@ -56,6 +197,8 @@ public:
 
     QHash<QString, QUrl> mAllAlbumCover;
 
+    QHash<QString, QString> mDirectoryCoverFiles;
+
     QHash<QUrl, QSet<QPair<QUrl, bool>>> mDiscoveredFiles;
 
     QString mSourceName;
@@ -64,12 +207,20 @@ public:
 
     QMimeDatabase mMimeDb;
 
+    AudioFileClassifier mAudioFileClassifier;
+
 #if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
     KFileMetaData::EmbeddedImageData mImageScanner;
 #endif
 
     QHash<QUrl, QDateTime> mAllFiles;
 
+    QSet<QString> mThumbnailCoverKeys;
+
+    CoverThumbnailCache mThumbnailCache;
+
+    QThreadPool mThumbnailThreadPool;
+
     QAtomicInt mStopRequest = 0;
 
     int mImportedTracksCount = 0;
@@ -80,6 +231,26 @@ public:
 
     bool mHandleNewFiles = true;
 
+    ScanScheduler *mScanScheduler = nullptr;
+
+    int mMinimumFilesPerWorker = 4;
+
+    QHash<QUrl, FileIdentity> mKnownFileIdentities;
+
+    QHash<FileIdentity, QUrl> mKnownFilesByIdentity;
+
+    QHash<QString, QList<QUrl>> mRestoredFilesByName;
+
+    QHash<QUrl, qint64> mRestoredFileSizes;
+
+    QHash<QUrl, QUrl> mRenamedFiles;
+
+    QList<QUrl> mPendingRemovedFiles;
+
+    bool mPendingRemovalScheduled = false;
+
+    int mRemovalDelay = 1000;
+
 };
 
 AbstractFileListing::AbstractFileListing(const QString &sourceName, QObject *parent) : QObject(parent), d(std::make_unique<AbstractFileListingPrivate>(sourceName))
@@ -88,10 +259,15 @@ AbstractFileListing::AbstractFileListing(const QString &sourceName, QObject *par
             this, &AbstractFileListing::directoryChanged);
     connect(&d->mFileSystemWatcher, &QFileSystemWatcher::fileChanged,
             this, &AbstractFileListing::fileChanged);
+
+    d->mThumbnailThreadPool.setMaxThreadCount(1);
 }
 
 AbstractFileListing::~AbstractFileListing()
-= default;
+{
+    d->mThumbnailThreadPool.clear();
+    d->mThumbnailThreadPool.waitForDone();
+}
 
 void AbstractFileListing::init()
 {
@@ -117,9 +293,17 @@ void AbstractFileListing::restoredTracks(const QString &musicSource, QHash<QUrl,
     }
 }
 
+void AbstractFileListing::restoredFileSizes(const QString &musicSource, QHash<QUrl, qint64> fileSizes)
+{
+    if (musicSource == sourceName()) {
+        d->mRestoredFileSizes = std::move(fileSizes);
+    }
+}
+
 void AbstractFileListing::applicationAboutToQuit()
 {
     d->mStopRequest = 1;
+    d->mThumbnailThreadPool.clear();
 }
 
 void AbstractFileListing::scanDirectory(QList<MusicAudioTrack> &newFiles, const QUrl &path)
@@ -128,6 +312,13 @@ void AbstractFileListing::scanDirectory(QList<MusicAudioTrack> &newFiles, const
         return;
     }
 
+    ScanScheduler::DeviceSlot deviceSlot(d->mScanScheduler, path.toLocalFile());
+
+    // the tracks are known by their canonical path, so are their directories covers
+    const auto canonicalDirectoryPath = QDir(path.toLocalFile()).canonicalPath();
+
+    d->mDirectoryCoverFiles.remove(canonicalDirectoryPath);
+
     QDir rootDirectory(path.toLocalFile());
     rootDirectory.refresh();
 
@@ -138,14 +329,21 @@ void AbstractFileListing::scanDirectory(QList<MusicAudioTrack> &newFiles, const
     auto &currentDirectoryListingFiles = d->mDiscoveredFiles[path];
 
     auto currentFilesList = QSet<QUrl>();
+    auto currentEntries = QList<QPair<QUrl, QFileInfo>>();
+
+    // on solid state storage the listing order costs nothing, elsewhere it means seeks or network round trips
+    const auto orderedScan = (deviceSlot.storageKind() != ScanScheduler::StorageKind::SolidState);
+    const auto scanOrder = (orderedScan ? DirectoryScanOrder::Mode::InodeOrder : DirectoryScanOrder::Mode::ListingOrder);
 
     rootDirectory.refresh();
-    const auto entryList = rootDirectory.entryInfoList(QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs);
+    const auto entryList = DirectoryScanOrder::entryInfoList(path.toLocalFile(), scanOrder);
     for (const auto &oneEntry : entryList) {
         auto newFilePath = QUrl::fromLocalFile(oneEntry.canonicalFilePath());
 
-        if (oneEntry.isDir() || oneEntry.isFile()) {
+        // symbolic links to the same target are only scanned once
+        if ((oneEntry.isDir() || oneEntry.isFile()) && !currentFilesList.contains(newFilePath)) {
             currentFilesList.insert(newFilePath);
+            currentEntries.push_back({newFilePath, oneEntry});
         }
     }
 
@@ -174,15 +372,19 @@ void AbstractFileListing::scanDirectory(QList<MusicAudioTrack> &newFiles, const
     }
 
     if (!allRemovedTracks.isEmpty()) {
-        Q_EMIT removedTracksList(allRemovedTracks);
+        delayRemovedFiles(allRemovedTracks);
     }
 
     if (!d->mHandleNewFiles) {
         return;
     }
 
-    for (const auto &newFilePath : currentFilesList) {
-        QFileInfo oneEntry(newFilePath.toLocalFile());
+    auto newDirectories = QList<QUrl>();
+    auto newTrackFiles = QList<QPair<QUrl, QFileInfo>>();
+
+    for (const auto &oneCurrentEntry : qAsConst(currentEntries)) {
+        const auto &newFilePath = oneCurrentEntry.first;
+        const auto &oneEntry = oneCurrentEntry.second;
 
         auto itFilePath = std::find(currentDirectoryListingFiles.begin(), currentDirectoryListingFiles.end(), QPair<QUrl, bool>{newFilePath, oneEntry.isFile()});
 
@@ -191,43 +393,157 @@ void AbstractFileListing::scanDirectory(QList<MusicAudioTrack> &newFiles, const
         }
 
         if (oneEntry.isDir()) {
-            addFileInDirectory(newFilePath, path);
-            scanDirectory(newFiles, newFilePath);
+            newDirectories.push_back(newFilePath);
+            continue;
+        }
+        if (!oneEntry.isFile()) {
+            continue;
+        }
 
-            if (d->mStopRequest == 1) {
-                break;
-            }
+        if (!d->mAudioFileClassifier.isAudioFile(newFilePath.toLocalFile())) {
+            continue;
+        }
+
+        const auto identity = fileIdentity(newFilePath.toLocalFile());
 
+        if (detectRenamedFile(newFilePath, identity, path)) {
             continue;
         }
-        if (!oneEntry.isFile()) {
+
+        rememberFileIdentity(newFilePath, identity);
+
+        if (isFileUpToDate(newFilePath, oneEntry)) {
+            addFileInDirectory(newFilePath, path);
             continue;
         }
 
-        auto newTrack = scanOneFile(newFilePath, oneEntry);
+        newTrackFiles.push_back({newFilePath, oneEntry});
+    }
+
+    if (orderedScan) {
+        for (const auto &oneTrackFile : qAsConst(newTrackFiles)) {
+            DirectoryScanOrder::prefetchTagRegions(oneTrackFile.first.toLocalFile());
+        }
+    }
 
-        if (newTrack.isValid() && d->mStopRequest == 0) {
-            addCover(newTrack);
+    auto extraWorkers = deviceSlot.acquireExtraWorkers(newTrackFiles.size() / d->mMinimumFilesPerWorker - 1);
 
-            addFileInDirectory(newTrack.resourceURI(), path);
-            newFiles.push_back(newTrack);
+    const auto &newTracks = scanTrackFiles(newTrackFiles, deviceSlot.threadPool(), extraWorkers);
 
-            ++d->mImportedTracksCount;
-            if (d->mImportedTracksCount % d->mNotificationUpdateInterval == 0) {
-                d->mNotificationUpdateInterval = std::min(50, 1 + d->mNotificationUpdateInterval * 2);
-            }
+    deviceSlot.release();
 
-            if (newFiles.size() > d->mNewFilesEmitInterval && d->mStopRequest == 0) {
-                d->mNewFilesEmitInterval = std::min(50, 1 + d->mNewFilesEmitInterval * d->mNewFilesEmitInterval);
-                emitNewFiles(newFiles);
-                newFiles.clear();
-            }
+    for (const auto &newTrack : newTracks) {
+        if (d->mStopRequest == 1) {
+            break;
+        }
+
+        addCover(newTrack);
+
+        addFileInDirectory(newTrack.resourceURI(), path);
+        newFiles.push_back(newTrack);
+
+        ++d->mImportedTracksCount;
+        if (d->mImportedTracksCount % d->mNotificationUpdateInterval == 0) {
+            d->mNotificationUpdateInterval = std::min(50, 1 + d->mNotificationUpdateInterval * 2);
         }
 
+        if (newFiles.size() > d->mNewFilesEmitInterval && d->mStopRequest == 0) {
+            d->mNewFilesEmitInterval = std::min(50, 1 + d->mNewFilesEmitInterval * d->mNewFilesEmitInterval);
+            emitNewFiles(newFiles);
+            newFiles.clear();
+        }
+    }
+
+    // the device is not held while walking sub-directories: other roots on the same device can progress
+    for (const auto &newDirectory : newDirectories) {
         if (d->mStopRequest == 1) {
             break;
         }
+
+        addFileInDirectory(newDirectory, path);
+        scanDirectory(newFiles, newDirectory);
+    }
+}
+
+QList<MusicAudioTrack> AbstractFileListing::scanTrackFiles(const QList<QPair<QUrl, QFileInfo>> &filesToScan, QThreadPool *threadPool, int extraWorkers)
+{
+    auto result = QList<MusicAudioTrack>();
+
+    if (filesToScan.isEmpty()) {
+        return result;
+    }
+
+    const auto &constFilesToScan = filesToScan;
+    const auto useFastTagReader = (d->mScanScheduler && d->mScanScheduler->fastTagReader());
+    auto scanFilesRange = [this, &constFilesToScan, useFastTagReader](int firstIndex, int lastIndex) {
+        auto scannedTracks = QList<MusicAudioTrack>();
+
+        QElapsedTimer extractionTimer;
+        extractionTimer.start();
+
+        auto lastFileDuration = qint64(0);
+        auto extractionTime = qint64(0);
+        auto &currentWorker = threadFileScanWorker();
+        currentWorker.mFileScanner.setUseFastTagReader(useFastTagReader);
+        for (int fileIndex = firstIndex; fileIndex < lastIndex; ++fileIndex) {
+            waitForScanBudget(lastFileDuration);
+
+            if (d->mStopRequest == 1) {
+                scannedTracks.push_back({});
+                continue;
+            }
+
+            const auto fileStart = extractionTimer.nsecsElapsed();
+            scannedTracks.push_back(currentWorker.scanOneFile(constFilesToScan.at(fileIndex).first));
+
+            lastFileDuration = extractionTimer.nsecsElapsed() - fileStart;
+            extractionTime += lastFileDuration;
+        }
+
+        if (d->mScanScheduler) {
+            d->mScanScheduler->recordExtraction(scannedTracks.size(), extractionTime);
+        }
+
+        return scannedTracks;
+    };
+
+    auto workersCount = (threadPool ? extraWorkers : 0) + 1;
+    auto filesPerWorker = (filesToScan.size() + workersCount - 1) / workersCount;
+
+    auto otherWorkersResults = QList<QFuture<QList<MusicAudioTrack>>>();
+    for (int workerIndex = 1; workerIndex < workersCount; ++workerIndex) {
+        auto firstIndex = std::min(workerIndex * filesPerWorker, filesToScan.size());
+        auto lastIndex = std::min(firstIndex + filesPerWorker, filesToScan.size());
+
+        otherWorkersResults.push_back(QtConcurrent::run(threadPool, [scanFilesRange, firstIndex, lastIndex] () {
+            return scanFilesRange(firstIndex, lastIndex);
+        }));
+    }
+
+    auto scannedTracks = scanFilesRange(0, std::min(filesPerWorker, filesToScan.size()));
+    for (auto &oneWorkerResult : otherWorkersResults) {
+        scannedTracks.append(oneWorkerResult.result());
+    }
+
+    for (int fileIndex = 0; fileIndex < scannedTracks.size(); ++fileIndex) {
+        auto &newTrack = scannedTracks[fileIndex];
+
+        if (!newTrack.isValid()) {
+            continue;
+        }
+
+        const auto &scanFileInfo = filesToScan.at(fileIndex).second;
+
+        newTrack.setFileModificationTime(scanFileInfo.fileTime(QFile::FileModificationTime));
+
+        if (scanFileInfo.exists()) {
+            watchPath(newTrack.resourceURI().toLocalFile());
+        }
+
+        result.push_back(newTrack);
     }
+
+    return result;
 }
 
 const QString &AbstractFileListing::sourceName() const
@@ -235,6 +551,21 @@ const QString &AbstractFileListing::sourceName() const
     return d->mSourceName;
 }
 
+void AbstractFileListing::setScanScheduler(ScanScheduler *scheduler)
+{
+    d->mScanScheduler = scheduler;
+}
+
+void AbstractFileListing::waitForScanBudget(qint64 lastFileNanoSeconds)
+{
+    if (!d->mScanScheduler) {
+        return;
+    }
+
+    d->mScanScheduler->prepareScanThread();
+    d->mScanScheduler->waitForBudget(lastFileNanoSeconds, d->mStopRequest);
+}
+
 void AbstractFileListing::directoryChanged(const QString &path)
 {
     const auto directoryEntry = d->mDiscoveredFiles.find(QUrl::fromLocalFile(path));
@@ -264,11 +595,28 @@ void AbstractFileListing::fileChanged(const QString &modifiedFileName)
 void AbstractFileListing::executeInit(QHash<QUrl, QDateTime> allFiles)
 {
     d->mAllFiles = std::move(allFiles);
+
+    d->mRestoredFilesByName.clear();
+    for (auto itFile = d->mAllFiles.cbegin(); itFile != d->mAllFiles.cend(); ++itFile) {
+        d->mRestoredFilesByName[itFile.key().fileName()].push_back(itFile.key());
+    }
 }
 
 void AbstractFileListing::triggerRefreshOfContent()
 {
     d->mImportedTracksCount = 0;
+    d->mDirectoryCoverFiles.clear();
+
+    // the thumbnail pool has a single thread: the cache is trimmed before this refresh adds new thumbnails
+    QtConcurrent::run(&d->mThumbnailThreadPool, [this] () {
+        QThread::currentThread()->setPriority(QThread::IdlePriority);
+
+        if (d->mStopRequest == 1) {
+            return;
+        }
+
+        d->mThumbnailCache.trimCache(CoverThumbnailCache::maximumCacheSize);
+    });
 }
 
 void AbstractFileListing::refreshContent()
@@ -280,35 +628,214 @@ MusicAudioTrack AbstractFileListing::scanOneFile(const QUrl &scanFile, const QFi
 {
     MusicAudioTrack newTrack;
 
+    if (!isTrackFileToScan(scanFile, scanFileInfo)) {
+        return newTrack;
+    }
+
     auto localFileName = scanFile.toLocalFile();
 
-    const auto &fileMimeType = d->mMimeDb.mimeTypeForFile(localFileName);
-    if (!fileMimeType.name().startsWith(QStringLiteral("audio/"))) {
-        return newTrack;
+    d->mFileScanner.setUseFastTagReader(d->mScanScheduler && d->mScanScheduler->fastTagReader());
+    newTrack = d->mFileScanner.scanOneFile(scanFile, d->mMimeDb);
+
+    if (newTrack.isValid()) {
+        if (!d->mFileScanner.embeddedCoverIsKnown()) {
+            newTrack.setHasEmbeddedCover(checkEmbeddedCoverImage(localFileName));
+        }
+
+        newTrack.setFileModificationTime(scanFileInfo.fileTime(QFile::FileModificationTime));
+
+        if (scanFileInfo.exists()) {
+            watchPath(scanFile.toLocalFile());
+        }
+    }
+
+    return newTrack;
+}
+
+bool AbstractFileListing::isTrackFileToScan(const QUrl &scanFile, const QFileInfo &scanFileInfo)
+{
+    if (!d->mAudioFileClassifier.isAudioFile(scanFile.toLocalFile())) {
+        return false;
     }
 
+    return !isFileUpToDate(scanFile, scanFileInfo);
+}
+
+bool AbstractFileListing::isFileUpToDate(const QUrl &scanFile, const QFileInfo &scanFileInfo)
+{
     if (scanFileInfo.exists()) {
         auto itExistingFile = d->mAllFiles.find(scanFile);
         if (itExistingFile != d->mAllFiles.end()) {
             if (*itExistingFile >= scanFileInfo.fileTime(QFile::FileModificationTime)) {
                 d->mAllFiles.erase(itExistingFile);
-                return newTrack;
+                return true;
             }
         }
     }
 
-    newTrack = d->mFileScanner.scanOneFile(scanFile, d->mMimeDb);
+    return false;
+}
 
-    if (newTrack.isValid()) {
-        newTrack.setHasEmbeddedCover(checkEmbeddedCoverImage(localFileName));
-        newTrack.setFileModificationTime(scanFileInfo.fileTime(QFile::FileModificationTime));
+void AbstractFileListing::rememberFileIdentity(const QUrl &trackFile, const FileIdentity &identity)
+{
+    if (!identity.isValid()) {
+        return;
+    }
 
-        if (scanFileInfo.exists()) {
-            watchPath(scanFile.toLocalFile());
+    d->mKnownFileIdentities[trackFile] = identity;
+    d->mKnownFilesByIdentity[identity] = trackFile;
+}
+
+void AbstractFileListing::forgetFileIdentity(const QUrl &trackFile)
+{
+    auto itIdentity = d->mKnownFileIdentities.find(trackFile);
+    if (itIdentity == d->mKnownFileIdentities.end()) {
+        return;
+    }
+
+    auto itFile = d->mKnownFilesByIdentity.find(*itIdentity);
+    if (itFile != d->mKnownFilesByIdentity.end() && *itFile == trackFile) {
+        d->mKnownFilesByIdentity.erase(itFile);
+    }
+
+    d->mKnownFileIdentities.erase(itIdentity);
+}
+
+bool AbstractFileListing::detectRenamedFile(const QUrl &newFile, const FileIdentity &identity, const QUrl &directoryName)
+{
+    if (!identity.isValid()) {
+        return false;
+    }
+
+    const auto itKnownFile = d->mKnownFilesByIdentity.constFind(identity);
+    const auto oldFile = (itKnownFile != d->mKnownFilesByIdentity.cend() ? *itKnownFile : missingRestoredFile(newFile, identity));
+
+    if (oldFile.isEmpty()) {
+        return false;
+    }
+
+    // a hard link or a file already listed elsewhere is not a move
+    if (oldFile == newFile || QFileInfo::exists(oldFile.toLocalFile())) {
+        return false;
+    }
+
+    renameFiles(QHash<QUrl, QUrl>{{oldFile, newFile}});
+
+    addFileInDirectory(newFile, directoryName);
+
+    return true;
+}
+
+QUrl AbstractFileListing::missingRestoredFile(const QUrl &newFile, const FileIdentity &identity) const
+{
+    // the inodes are not stored in the database: a file moved while Elisa was not running is recognized
+    // by its unchanged name, modification time and size, when exactly one missing track matches
+    auto result = QUrl{};
+
+    for (const auto &oneRestoredFile : d->mRestoredFilesByName.value(newFile.fileName())) {
+        const auto itRestoredFile = d->mAllFiles.constFind(oneRestoredFile);
+
+        if (itRestoredFile == d->mAllFiles.cend() || oneRestoredFile == newFile ||
+                itRestoredFile->toSecsSinceEpoch() != identity.mModificationTime ||
+                d->mRestoredFileSizes.value(oneRestoredFile, -1) != identity.mSize ||
+                QFileInfo::exists(oneRestoredFile.toLocalFile())) {
+            continue;
+        }
+
+        if (!result.isEmpty()) {
+            return {};
         }
+
+        result = oneRestoredFile;
     }
 
-    return newTrack;
+    return result;
+}
+
+void AbstractFileListing::renameFiles(const QHash<QUrl, QUrl> &renamedFiles)
+{
+    for (auto itRenamedFile = renamedFiles.begin(); itRenamedFile != renamedFiles.end(); ++itRenamedFile) {
+        const auto &oldFile = itRenamedFile.key();
+        const auto &newFile = itRenamedFile.value();
+
+        const auto oldDirectory = QUrl::fromLocalFile(QFileInfo(oldFile.toLocalFile()).absolutePath());
+        auto itOldDirectory = d->mDiscoveredFiles.find(oldDirectory);
+        if (itOldDirectory != d->mDiscoveredFiles.end()) {
+            itOldDirectory->remove({oldFile, true});
+        }
+
+        d->mPendingRemovedFiles.removeAll(oldFile);
+        d->mAllFiles.remove(oldFile);
+
+        forgetFileIdentity(oldFile);
+        rememberFileIdentity(newFile, fileIdentity(newFile.toLocalFile()));
+
+        // a file moved to another directory gets the cover of its new album
+        if (oldFile.adjusted(QUrl::RemoveFilename) != newFile.adjusted(QUrl::RemoveFilename)) {
+            auto movedTrack = MusicAudioTrack{};
+            movedTrack.setResourceURI(newFile);
+
+            addCover(movedTrack);
+        }
+
+        // a file moved twice before the database heard about the first move
+        auto originalFile = oldFile;
+        for (auto itPreviousRename = d->mRenamedFiles.begin(); itPreviousRename != d->mRenamedFiles.end(); ++itPreviousRename) {
+            if (itPreviousRename.value() == oldFile) {
+                originalFile = itPreviousRename.key();
+                d->mRenamedFiles.erase(itPreviousRename);
+                break;
+            }
+        }
+
+        d->mRenamedFiles[originalFile] = newFile;
+    }
+}
+
+void AbstractFileListing::emitRenamedFiles()
+{
+    if (d->mRenamedFiles.isEmpty()) {
+        return;
+    }
+
+    Q_EMIT renamedTracksList(d->mRenamedFiles, d->mAllAlbumCover);
+
+    d->mRenamedFiles.clear();
+}
+
+void AbstractFileListing::delayRemovedFiles(const QList<QUrl> &removedFiles)
+{
+    d->mPendingRemovedFiles.append(removedFiles);
+
+    if (d->mPendingRemovalScheduled) {
+        return;
+    }
+
+    d->mPendingRemovalScheduled = true;
+
+    // the new name of a moved file may only be seen when scanning another directory
+    QTimer::singleShot(d->mRemovalDelay, this, [this]() {
+        d->mPendingRemovalScheduled = false;
+
+        emitRemovedFiles();
+    });
+}
+
+void AbstractFileListing::emitRemovedFiles()
+{
+    emitRenamedFiles();
+
+    if (d->mPendingRemovedFiles.isEmpty()) {
+        return;
+    }
+
+    for (const auto &oneRemovedFile : qAsConst(d->mPendingRemovedFiles)) {
+        forgetFileIdentity(oneRemovedFile);
+    }
+
+    Q_EMIT removedTracksList(d->mPendingRemovedFiles);
+
+    d->mPendingRemovedFiles.clear();
 }
 
 void AbstractFileListing::watchPath(const QString &pathName)
@@ -320,6 +847,21 @@ void AbstractFileListing::watchPath(const QString &pathName)
     }
 }
 
+void AbstractFileListing::watchPaths(const QStringList &pathNames)
+{
+    if (pathNames.isEmpty()) {
+        return;
+    }
+
+    const auto failedPaths = d->mFileSystemWatcher.addPaths(pathNames);
+
+    if (!failedPaths.isEmpty()) {
+        Q_EMIT errorWatchingFiles();
+
+        qDebug() << "AbstractFileListing::watchPaths" << "fail for" << failedPaths;
+    }
+}
+
 void AbstractFileListing::addFileInDirectory(const QUrl &newFile, const QUrl &directoryName)
 {
     const auto directoryEntry = d->mDiscoveredFiles.find(directoryName);
@@ -352,6 +894,8 @@ void AbstractFileListing::scanDirectoryTree(const QString &path)
 
     scanDirectory(newFiles, QUrl::fromLocalFile(path));
 
+    emitRenamedFiles();
+
     if (!newFiles.isEmpty() && d->mStopRequest == 0) {
         emitNewFiles(newFiles);
     }
@@ -376,6 +920,27 @@ void AbstractFileListing::addCover(const MusicAudioTrack &newTrack)
 
     QFileInfo trackFilePath(newTrack.resourceURI().toLocalFile());
     QDir trackFileDir = trackFilePath.absoluteDir();
+
+    // embedded covers get their thumbnails when the view first asks for them: extracting them here would read every picture
+    const auto coverFile = directoryCoverFile(trackFileDir.absolutePath());
+    if (coverFile.isEmpty()) {
+        return;
+    }
+
+    d->mAllAlbumCover[newTrack.resourceURI().toString()] = QUrl::fromLocalFile(coverFile);
+
+    addCoverThumbnails(coverFile);
+}
+
+QString AbstractFileListing::directoryCoverFile(const QString &directoryPath)
+{
+    // all the tracks of a directory share its cover: only glob each directory once per scan
+    auto itDirectoryCover = d->mDirectoryCoverFiles.find(directoryPath);
+    if (itDirectoryCover != d->mDirectoryCoverFiles.end()) {
+        return *itDirectoryCover;
+    }
+
+    QDir trackFileDir(directoryPath);
     QString dirNamePattern = QStringLiteral("*") + trackFileDir.dirName() + QStringLiteral("*");
     QStringList filters;
     filters << QStringLiteral("*[Cc]over*.jpg") << QStringLiteral("*[Cc]over*.png")
@@ -388,11 +953,31 @@ void AbstractFileListing::addCover(const MusicAudioTrack &newTrack)
             << dirNamePattern.toLower() + QStringLiteral(".jpg") << dirNamePattern.toLower() + QStringLiteral(".png");
     trackFileDir.setNameFilters(filters);
     QFileInfoList coverFiles = trackFileDir.entryInfoList();
-    if (coverFiles.isEmpty()) {
+
+    const auto coverFile = (coverFiles.isEmpty() ? QString() : coverFiles.at(0).absoluteFilePath());
+
+    d->mDirectoryCoverFiles[directoryPath] = coverFile;
+
+    return coverFile;
+}
+
+void AbstractFileListing::addCoverThumbnails(const QString &coverSourceFile)
+{
+    if (d->mThumbnailCoverKeys.contains(coverSourceFile)) {
         return;
-    } else {
-        d->mAllAlbumCover[newTrack.resourceURI().toString()] = QUrl::fromLocalFile(coverFiles.at(0).absoluteFilePath());
     }
+
+    d->mThumbnailCoverKeys.insert(coverSourceFile);
+
+    QtConcurrent::run(&d->mThumbnailThreadPool, [this, coverSourceFile] () {
+        QThread::currentThread()->setPriority(QThread::IdlePriority);
+
+        if (d->mStopRequest == 1) {
+            return;
+        }
+
+        d->mThumbnailCache.createThumbnails(coverSourceFile);
+    });
 }
 
 void AbstractFileListing::removeDirectory(const QUrl &removedDirectory, QList<QUrl> &allRemovedFiles)
@@ -436,6 +1021,8 @@ QHash<QUrl, QDateTime> &AbstractFileListing::allFiles()
 
 void AbstractFileListing::checkFilesToRemove()
 {
+    emitRenamedFiles();
+
     QList<QUrl> allRemovedFiles;
 
     for (auto itFile = d->mAllFiles.begin(); itFile != d->mAllFiles.end(); ++itFile) {
@@ -455,16 +1042,12 @@ FileScanner &AbstractFileListing::fileScanner()
 bool AbstractFileListing::checkEmbeddedCoverImage(const QString &localFileName)
 {
 #if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
-    auto imageData = d->mImageScanner.imageData(localFileName);
-
-    if (imageData.contains(KFileMetaData::EmbeddedImageData::FrontCover)) {
-        if (!imageData[KFileMetaData::EmbeddedImageData::FrontCover].isEmpty()) {
-            return true;
-        }
-    }
-#endif
+    return hasFrontCoverImage(d->mImageScanner, localFileName);
+#else
+    Q_UNUSED(localFileName);
 
     return false;
+#endif
 }
 
 
@@ -28,6 +28,8 @@
 #include <QHash>
 #include <QVector>
 #include <QDateTime>
+#include <QPair>
+#include <QStringList>
 
 #include <memory>
 
@@ -35,7 +37,10 @@ class AbstractFileListingPrivate;
 class MusicAudioTrack;
 class NotificationItem;
 class FileScanner;
+class ScanScheduler;
+class FileIdentity;
 class QFileInfo;
+class QThreadPool;
 
 class ELISALIB_EXPORT AbstractFileListing : public QObject
 {
@@ -52,12 +57,18 @@ public:
 
     const QString &sourceName() const;
 
+    void setScanScheduler(ScanScheduler *scheduler);
+
 Q_SIGNALS:
 
     void tracksList(const QList<MusicAudioTrack> &tracks, const QHash<QString, QUrl> &covers, const QString &musicSource);
 
     void removedTracksList(const QList<QUrl> &removedTracks);
 
+    void renamedTracksList(const QHash<QUrl, QUrl> &renamedTracks, const QHash<QString, QUrl> &covers);
+
+    void embeddedCoverTracksList(const QList<QUrl> &tracksWithEmbeddedCover);
+
     void modifyTracksList(const QList<MusicAudioTrack> &modifiedTracks, const QHash<QString, QUrl> &covers, const QString &musicSource);
 
     void indexingStarted();
@@ -82,6 +93,8 @@ public Q_SLOTS:
 
     void restoredTracks(const QString &musicSource, QHash<QUrl, QDateTime> allFiles);
 
+    void restoredFileSizes(const QString &musicSource, QHash<QUrl, qint64> fileSizes);
+
 protected Q_SLOTS:
 
     void directoryChanged(const QString &path);
@@ -100,6 +113,8 @@ protected:
 
     void watchPath(const QString &pathName);
 
+    void watchPaths(const QStringList &pathNames);
+
     void addFileInDirectory(const QUrl &newFile, const QUrl &directoryName);
 
     void scanDirectoryTree(const QString &path);
@@ -110,6 +125,8 @@ protected:
 
     void addCover(const MusicAudioTrack &newTrack);
 
+    QString directoryCoverFile(const QString &directoryPath);
+
     void removeDirectory(const QUrl &removedDirectory, QList<QUrl> &allRemovedFiles);
 
     void removeFile(const QUrl &oneRemovedTrack, QList<QUrl> &allRemovedFiles);
@@ -120,12 +137,38 @@ protected:
 
     void checkFilesToRemove();
 
+    void renameFiles(const QHash<QUrl, QUrl> &renamedFiles);
+
+    void emitRenamedFiles();
+
+    void waitForScanBudget(qint64 lastFileNanoSeconds);
+
     FileScanner& fileScanner();
 
     bool checkEmbeddedCoverImage(const QString &localFileName);
 
 private:
 
+    bool isTrackFileToScan(const QUrl &scanFile, const QFileInfo &scanFileInfo);
+
+    bool isFileUpToDate(const QUrl &scanFile, const QFileInfo &scanFileInfo);
+
+    void rememberFileIdentity(const QUrl &trackFile, const FileIdentity &identity);
+
+    void forgetFileIdentity(const QUrl &trackFile);
+
+    bool detectRenamedFile(const QUrl &newFile, const FileIdentity &identity, const QUrl &directoryName);
+
+    QUrl missingRestoredFile(const QUrl &newFile, const FileIdentity &identity) const;
+
+    void delayRemovedFiles(const QList<QUrl> &removedFiles);
+
+    void emitRemovedFiles();
+
+    QList<MusicAudioTrack> scanTrackFiles(const QList<QPair<QUrl, QFileInfo>> &filesToScan, QThreadPool *threadPool, int extraWorkers);
+
+    void addCoverThumbnails(const QString &coverSourceFile);
+
     std::unique_ptr<AbstractFileListingPrivate> d;
 
 };
@@ -0,0 +1,217 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "audiofileclassifier.h"
+
+#include <QHash>
+#include <QSet>
+#include <QFile>
+#include <QMimeDatabase>
+
+class AudioFileClassifierPrivate
+{
+public:
+
+    QMimeDatabase mMimeDb;
+
+    QString mCachedDirectory;
+
+    QHash<QString, bool> mSuffixesInDirectory;
+
+    int mContentChecksCount = 0;
+
+    static const int mHeaderSize = 16;
+
+};
+
+AudioFileClassifier::AudioFileClassifier() : d(std::make_unique<AudioFileClassifierPrivate>())
+{
+}
+
+AudioFileClassifier::~AudioFileClassifier()
+= default;
+
+bool AudioFileClassifier::isAudioFile(const QString &localFileName)
+{
+    const auto separatorIndex = localFileName.lastIndexOf(QLatin1Char('/'));
+    const auto directoryName = localFileName.left(separatorIndex);
+    const auto fileName = localFileName.mid(separatorIndex + 1);
+
+    const auto suffixIndex = fileName.lastIndexOf(QLatin1Char('.'));
+    const auto suffix = (suffixIndex > 0 ? fileName.mid(suffixIndex + 1).toLower() : QString());
+
+    switch (kindFromSuffix(suffix))
+    {
+    case FileKind::Audio:
+        return true;
+    case FileKind::NotAudio:
+        return false;
+    case FileKind::Unknown:
+        break;
+    }
+
+    if (directoryName != d->mCachedDirectory) {
+        d->mCachedDirectory = directoryName;
+        d->mSuffixesInDirectory.clear();
+    }
+
+    // files without extension have nothing in common
+    if (!suffix.isEmpty()) {
+        auto itSuffix = d->mSuffixesInDirectory.constFind(suffix);
+        if (itSuffix != d->mSuffixesInDirectory.cend()) {
+            return itSuffix.value();
+        }
+    }
+
+    ++d->mContentChecksCount;
+
+    auto headerKind = FileKind::Unknown;
+
+    QFile currentFile(localFileName);
+    if (currentFile.open(QIODevice::ReadOnly)) {
+        headerKind = kindFromHeader(currentFile.read(AudioFileClassifierPrivate::mHeaderSize));
+    }
+
+    auto result = false;
+
+    switch (headerKind)
+    {
+    case FileKind::Audio:
+        result = true;
+        break;
+    case FileKind::NotAudio:
+        result = false;
+        break;
+    case FileKind::Unknown:
+        result = d->mMimeDb.mimeTypeForFile(localFileName).name().startsWith(QStringLiteral("audio/"));
+        break;
+    }
+
+    if (!suffix.isEmpty()) {
+        d->mSuffixesInDirectory[suffix] = result;
+    }
+
+    return result;
+}
+
+int AudioFileClassifier::contentChecksCount() const
+{
+    return d->mContentChecksCount;
+}
+
+AudioFileClassifier::FileKind AudioFileClassifier::kindFromSuffix(const QString &suffix)
+{
+    static const auto audioSuffixes = QSet<QString>{
+            QStringLiteral("mp3"), QStringLiteral("mp2"), QStringLiteral("mpga"),
+            QStringLiteral("ogg"), QStringLiteral("oga"), QStringLiteral("opus"), QStringLiteral("spx"),
+            QStringLiteral("flac"), QStringLiteral("m4a"), QStringLiteral("m4b"), QStringLiteral("aac"),
+            QStringLiteral("wav"), QStringLiteral("aif"), QStringLiteral("aiff"), QStringLiteral("aifc"),
+            QStringLiteral("wma"), QStringLiteral("ape"), QStringLiteral("wv"), QStringLiteral("mpc"),
+            QStringLiteral("tta"), QStringLiteral("dsf"), QStringLiteral("dff"), QStringLiteral("mka"),
+            QStringLiteral("ac3"), QStringLiteral("amr"), QStringLiteral("au"), QStringLiteral("mid"),
+            QStringLiteral("midi")};
+
+    static const auto otherSuffixes = QSet<QString>{
+            QStringLiteral("jpg"), QStringLiteral("jpeg"), QStringLiteral("png"), QStringLiteral("gif"),
+            QStringLiteral("bmp"), QStringLiteral("webp"), QStringLiteral("tif"), QStringLiteral("tiff"),
+            QStringLiteral("svg"), QStringLiteral("ico"),
+            QStringLiteral("cue"), QStringLiteral("log"), QStringLiteral("nfo"), QStringLiteral("txt"),
+            QStringLiteral("m3u"), QStringLiteral("m3u8"), QStringLiteral("pls"), QStringLiteral("xspf"),
+            QStringLiteral("md5"), QStringLiteral("sfv"), QStringLiteral("ffp"), QStringLiteral("accurip"),
+            QStringLiteral("lrc"), QStringLiteral("pdf"), QStringLiteral("db"), QStringLiteral("ini"),
+            QStringLiteral("url"), QStringLiteral("htm"), QStringLiteral("html"), QStringLiteral("xml"),
+            QStringLiteral("json"), QStringLiteral("zip"), QStringLiteral("rar"), QStringLiteral("7z"),
+            QStringLiteral("gz"), QStringLiteral("part"), QStringLiteral("torrent"),
+            QStringLiteral("avi"), QStringLiteral("mkv"), QStringLiteral("mp4"), QStringLiteral("mov"),
+            QStringLiteral("wmv"), QStringLiteral("mpg"), QStringLiteral("mpeg"), QStringLiteral("webm"),
+            QStringLiteral("ogv")};
+
+    if (audioSuffixes.contains(suffix)) {
+        return FileKind::Audio;
+    }
+
+    if (otherSuffixes.contains(suffix)) {
+        return FileKind::NotAudio;
+    }
+
+    return FileKind::Unknown;
+}
+
+AudioFileClassifier::FileKind AudioFileClassifier::kindFromHeader(const QByteArray &header)
+{
+    if (header.startsWith("ID3") || header.startsWith("fLaC") || header.startsWith("OggS") ||
+            header.startsWith("MAC ") || header.startsWith("wvpk") || header.startsWith("MPCK") ||
+            header.startsWith("MP+") || header.startsWith("TTA1") || header.startsWith("DSD ") ||
+            header.startsWith("FRM8") || header.startsWith("MThd") || header.startsWith(".snd")) {
+        return FileKind::Audio;
+    }
+
+    if (header.size() >= 12) {
+        const auto chunkType = header.mid(8, 4);
+
+        if (header.startsWith("RIFF") && chunkType == "WAVE") {
+            return FileKind::Audio;
+        }
+
+        if (header.startsWith("FORM") && (chunkType == "AIFF" || chunkType == "AIFC")) {
+            return FileKind::Audio;
+        }
+
+        if (header.mid(4, 4) == "ftyp" && (chunkType == "M4A " || chunkType == "M4B " || chunkType == "M4P ")) {
+            return FileKind::Audio;
+        }
+    }
+
+    if (header.size() >= 4) {
+        const auto firstByte = static_cast<unsigned char>(header.at(0));
+        const auto secondByte = static_cast<unsigned char>(header.at(1));
+        const auto thirdByte = static_cast<unsigned char>(header.at(2));
+        const auto fourthByte = static_cast<unsigned char>(header.at(3));
+
+        const auto version = (secondByte >> 3) & 0x03;
+        const auto layer = (secondByte >> 1) & 0x03;
+
+        // ADTS AAC frame: twelve bits synchronization word, layer always zero and a valid sampling frequency
+        if (firstByte == 0xFF && (secondByte & 0xF6) == 0xF0 && ((thirdByte >> 2) & 0x0F) < 13) {
+            return FileKind::Audio;
+        }
+
+        // MPEG audio frame: eleven bits synchronization word, valid version, layer, bitrate, sample rate and emphasis
+        // layer I is left to the mime database, its header starts with the FF FE UTF-16 byte order mark
+        if (firstByte == 0xFF && (secondByte & 0xE0) == 0xE0 && version != 0x01 && layer != 0x00 && layer != 0x03 &&
+                (thirdByte >> 4) != 0x00 && (thirdByte >> 4) != 0x0F && ((thirdByte >> 2) & 0x03) != 0x03 &&
+                (fourthByte & 0x03) != 0x02) {
+            return FileKind::Audio;
+        }
+    }
+
+    if (header.size() >= 2) {
+        const auto firstByte = static_cast<unsigned char>(header.at(0));
+        const auto secondByte = static_cast<unsigned char>(header.at(1));
+
+        // JPEG and PNG covers saved without extension
+        if (firstByte == 0xFF && secondByte == 0xD8) {
+            return FileKind::NotAudio;
+        }
+    }
+
+    if (header.startsWith("\x89PNG") || header.startsWith("%PDF") || header.startsWith("PK\x03\x04")) {
+        return FileKind::NotAudio;
+    }
+
+    return FileKind::Unknown;
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef AUDIOFILECLASSIFIER_H
+#define AUDIOFILECLASSIFIER_H
+
+#include "elisaLib_export.h"
+
+#include <QString>
+#include <QByteArray>
+
+#include <memory>
+
+class AudioFileClassifierPrivate;
+
+class ELISALIB_EXPORT AudioFileClassifier
+{
+
+public:
+
+    enum class FileKind {
+        Unknown,
+        Audio,
+        NotAudio,
+    };
+
+    AudioFileClassifier();
+
+    ~AudioFileClassifier();
+
+    /* known extensions are decided without any I/O, others are sniffed once per extension and directory */
+    bool isAudioFile(const QString &localFileName);
+
+    int contentChecksCount() const;
+
+    static FileKind kindFromSuffix(const QString &suffix);
+
+    static FileKind kindFromHeader(const QByteArray &header);
+
+private:
+
+    std::unique_ptr<AudioFileClassifierPrivate> d;
+
+};
+
+#endif // AUDIOFILECLASSIFIER_H
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "directoryscanorder.h"
+
+#include <QDir>
+#include <QFile>
+#include <QPair>
+
+#if defined Q_OS_UNIX
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+
+QFileInfoList DirectoryScanOrder::entryInfoList(const QString &directoryPath, Mode mode)
+{
+    auto result = QFileInfoList();
+
+#if defined Q_OS_UNIX
+    if (mode == Mode::InodeOrder) {
+        auto *directoryHandle = ::opendir(QFile::encodeName(directoryPath).constData());
+
+        if (!directoryHandle) {
+            return result;
+        }
+
+        auto allEntries = QList<QPair<quint64, QString>>();
+
+        // readdir gives the inode numbers without any stat
+        while (auto *oneEntry = ::readdir(directoryHandle)) {
+            if (oneEntry->d_name[0] == '.') {
+                continue;
+            }
+
+            allEntries.push_back({static_cast<quint64>(oneEntry->d_ino), QFile::decodeName(oneEntry->d_name)});
+        }
+
+        ::closedir(directoryHandle);
+
+        // inodes are close to their on-disk order: stat calls follow the inode tables instead of seeking around
+        std::sort(allEntries.begin(), allEntries.end(), [](const QPair<quint64, QString> &first, const QPair<quint64, QString> &second) {
+            return first.first < second.first;
+        });
+
+        const auto directoryPrefix = directoryPath.endsWith(QLatin1Char('/')) ? directoryPath : directoryPath + QLatin1Char('/');
+
+        result.reserve(allEntries.size());
+        for (const auto &oneEntry : allEntries) {
+            auto oneEntryInfo = QFileInfo(directoryPrefix + oneEntry.second);
+
+            // QFileInfo caches the stat data: read it now, in inode order
+            if (!oneEntryInfo.isDir() && !oneEntryInfo.isFile()) {
+                continue;
+            }
+
+            result.push_back(oneEntryInfo);
+        }
+
+        return result;
+    }
+#else
+    Q_UNUSED(mode);
+#endif
+
+    QDir rootDirectory(directoryPath);
+
+    result = rootDirectory.entryInfoList(QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs);
+
+    return result;
+}
+
+bool DirectoryScanOrder::prefetchTagRegions(const QString &fileName)
+{
+#if defined Q_OS_LINUX || defined Q_OS_FREEBSD
+    const auto fileDescriptor = ::open(QFile::encodeName(fileName).constData(), O_RDONLY | O_CLOEXEC);
+
+    if (fileDescriptor < 0) {
+        return false;
+    }
+
+    struct stat fileInformation;
+    auto fileSize = qint64(0);
+    if (::fstat(fileDescriptor, &fileInformation) == 0) {
+        fileSize = static_cast<qint64>(fileInformation.st_size);
+    }
+
+    const auto headSize = mTagsHeadSize;
+    const auto tailSize = mTagsTailSize;
+
+    // ID3v2, Vorbis comments, FLAC and MP4 headers are at the start, ID3v1 and APE tags at the end
+    auto result = ::posix_fadvise(fileDescriptor, 0, std::min(fileSize, headSize), POSIX_FADV_WILLNEED) == 0;
+
+    if (fileSize > headSize) {
+        const auto tailStart = std::max(headSize, fileSize - tailSize);
+
+        result = (::posix_fadvise(fileDescriptor, tailStart, fileSize - tailStart, POSIX_FADV_WILLNEED) == 0) && result;
+    }
+
+    ::close(fileDescriptor);
+
+    return result;
+#else
+    Q_UNUSED(fileName);
+
+    return false;
+#endif
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DIRECTORYSCANORDER_H
+#define DIRECTORYSCANORDER_H
+
+#include "elisaLib_export.h"
+
+#include <QString>
+#include <QFileInfo>
+#include <QList>
+#include <QtGlobal>
+
+class ELISALIB_EXPORT DirectoryScanOrder
+{
+
+public:
+
+    enum class Mode {
+        ListingOrder,
+        InodeOrder,
+    };
+
+    /* lists the visible files and directories, with their stat data already read in the order of the listing */
+    static QFileInfoList entryInfoList(const QString &directoryPath, Mode mode);
+
+    /* asks the kernel to start reading the parts of a file holding its tags */
+    static bool prefetchTagRegions(const QString &fileName);
+
+    static const qint64 mTagsHeadSize = 256 * 1024;
+
+    static const qint64 mTagsTailSize = 128 * 1024;
+
+};
+
+#endif // DIRECTORYSCANORDER_H
@@ -0,0 +1,468 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "embeddedcoverprobe.h"
+
+#include "tagparsing.h"
+
+#include <QIODevice>
+#include <QFile>
+#include <QByteArray>
+
+#include <algorithm>
+#include <cstring>
+
+using TagParsing::frontCoverPictureType;
+
+static const uchar* bytesAt(const QByteArray &data, int offset)
+{
+    return reinterpret_cast<const uchar*>(data.constData() + offset);
+}
+
+static QByteArray readAt(QIODevice &device, qint64 position, qint64 size)
+{
+    if (!device.seek(position)) {
+        return {};
+    }
+
+    return device.read(size);
+}
+
+static EmbeddedCoverProbe::Presence probeId3v2(QIODevice &device, qint64 &tagEnd)
+{
+    const auto tagHeader = readAt(device, 0, 10);
+
+    if (tagHeader.size() < 10) {
+        return EmbeddedCoverProbe::Presence::Unknown;
+    }
+
+    const auto majorVersion = static_cast<int>(tagHeader.at(3));
+    const auto tagFlags = static_cast<uchar>(tagHeader.at(5));
+    const auto tagSize = static_cast<qint64>(TagParsing::syncSafe32(bytesAt(tagHeader, 6)));
+    const auto framesEnd = 10 + tagSize;
+
+    tagEnd = framesEnd + ((majorVersion == 4 && (tagFlags & 0x10)) ? 10 : 0);
+
+    if (majorVersion < 2 || majorVersion > 4) {
+        return EmbeddedCoverProbe::Presence::Unknown;
+    }
+
+    // before version 4 the unsynchronisation of the whole tag moves every frame
+    if ((tagFlags & 0x80) && majorVersion < 4) {
+        return EmbeddedCoverProbe::Presence::Unknown;
+    }
+
+    auto framePosition = qint64(10);
+
+    if ((tagFlags & 0x40) && majorVersion > 2) {
+        const auto extendedHeader = readAt(device, framePosition, 4);
+
+        if (extendedHeader.size() < 4) {
+            return EmbeddedCoverProbe::Presence::Unknown;
+        }
+
+        framePosition += (majorVersion == 3 ? 4 + TagParsing::bigEndian32(bytesAt(extendedHeader, 0)) :
+                                              TagParsing::syncSafe32(bytesAt(extendedHeader, 0)));
+    }
+
+    const auto frameHeaderSize = (majorVersion == 2 ? 6 : 10);
+    const auto pictureFrameId = QByteArray(majorVersion == 2 ? "PIC" : "APIC");
+
+    while (framePosition + frameHeaderSize <= framesEnd) {
+        const auto frameHeader = readAt(device, framePosition, frameHeaderSize);
+
+        if (frameHeader.size() < frameHeaderSize) {
+            return EmbeddedCoverProbe::Presence::Unknown;
+        }
+
+        // padding
+        if (frameHeader.at(0) == 0) {
+            break;
+        }
+
+        auto frameSize = qint64(0);
+        switch (majorVersion)
+        {
+        case 2:
+            frameSize = TagParsing::bigEndian24(bytesAt(frameHeader, 3));
+            break;
+        case 3:
+            frameSize = TagParsing::bigEndian32(bytesAt(frameHeader, 4));
+            break;
+        default:
+            frameSize = TagParsing::syncSafe32(bytesAt(frameHeader, 4));
+            break;
+        }
+
+        const auto frameBodyPosition = framePosition + frameHeaderSize;
+
+        if (frameHeader.startsWith(pictureFrameId) && frameSize > 0) {
+            auto skippedBytes = 0;
+
+            if (majorVersion == 3) {
+                const auto formatFlags = static_cast<uchar>(frameHeader.at(9));
+
+                // compressed or encrypted
+                if (formatFlags & 0xc0) {
+                    return EmbeddedCoverProbe::Presence::Unknown;
+                }
+
+                skippedBytes += ((formatFlags & 0x20) ? 1 : 0);
+            } else if (majorVersion == 4) {
+                const auto formatFlags = static_cast<uchar>(frameHeader.at(9));
+
+                // compressed, encrypted or unsynchronised
+                if (formatFlags & 0x0e) {
+                    return EmbeddedCoverProbe::Presence::Unknown;
+                }
+
+                skippedBytes += ((formatFlags & 0x40) ? 1 : 0) + ((formatFlags & 0x01) ? 4 : 0);
+            }
+
+            // text encoding, then a three letters format or a nul terminated MIME type, then the picture type
+            const auto frameStart = readAt(device, frameBodyPosition + skippedBytes, std::min<qint64>(frameSize - skippedBytes, 256));
+
+            auto pictureTypeIndex = -1;
+            if (majorVersion == 2) {
+                pictureTypeIndex = 4;
+            } else {
+                const auto mimeTypeEnd = frameStart.indexOf('\0', 1);
+                pictureTypeIndex = (mimeTypeEnd < 0 ? -1 : mimeTypeEnd + 1);
+            }
+
+            if (pictureTypeIndex < 0 || pictureTypeIndex >= frameStart.size()) {
+                return EmbeddedCoverProbe::Presence::Unknown;
+            }
+
+            if (static_cast<uchar>(frameStart.at(pictureTypeIndex)) == frontCoverPictureType) {
+                return EmbeddedCoverProbe::Presence::Present;
+            }
+        }
+
+        framePosition = frameBodyPosition + frameSize;
+    }
+
+    return EmbeddedCoverProbe::Presence::Absent;
+}
+
+static EmbeddedCoverProbe::Presence probeFlac(QIODevice &device, qint64 streamStart)
+{
+    auto blockPosition = streamStart + 4;
+
+    while (true) {
+        const auto blockHeader = readAt(device, blockPosition, 4);
+
+        if (blockHeader.size() < 4) {
+            return EmbeddedCoverProbe::Presence::Unknown;
+        }
+
+        const auto isLastBlock = (static_cast<uchar>(blockHeader.at(0)) & 0x80) != 0;
+        const auto blockType = static_cast<uchar>(blockHeader.at(0)) & 0x7f;
+        const auto blockSize = static_cast<qint64>(TagParsing::bigEndian24(bytesAt(blockHeader, 1)));
+
+        if (blockType == 127) {
+            return EmbeddedCoverProbe::Presence::Unknown;
+        }
+
+        if (blockType == 6) {
+            const auto pictureType = readAt(device, blockPosition + 4, 4);
+
+            if (pictureType.size() < 4) {
+                return EmbeddedCoverProbe::Presence::Unknown;
+            }
+
+            if (TagParsing::bigEndian32(bytesAt(pictureType, 0)) == frontCoverPictureType) {
+                return EmbeddedCoverProbe::Presence::Present;
+            }
+        }
+
+        if (isLastBlock) {
+            break;
+        }
+
+        blockPosition += 4 + blockSize;
+    }
+
+    return EmbeddedCoverProbe::Presence::Absent;
+}
+
+/* the body of the pages of one logical stream, read as a single byte stream */
+class OggStreamReader
+{
+public:
+
+    explicit OggStreamReader(QIODevice &device) : mDevice(device)
+    {
+    }
+
+    bool nextPage()
+    {
+        // a misbehaving file must not make the probe read the whole stream
+        if (++mPagesCount > 1000) {
+            return false;
+        }
+
+        // the longest segment table follows the fixed part of the header
+        const auto pageHeader = readAt(mDevice, mNextPagePosition, TagParsing::oggPageFixedHeaderSize + 255);
+
+        TagParsing::OggPageHeader page;
+        if (!TagParsing::readOggPageHeader(bytesAt(pageHeader, 0), pageHeader.size(), page)) {
+            return false;
+        }
+
+        mPageBodyPosition = mNextPagePosition + page.mHeaderSize;
+        mNextPagePosition = mPageBodyPosition + page.mBodySize;
+
+        if (mPagesCount == 1) {
+            mSerialNumber = page.mSerialNumber;
+        } else if (page.mSerialNumber != mSerialNumber) {
+            mPageBodyRemaining = 0;
+            return nextPage();
+        }
+
+        mPageBodyRemaining = page.mBodySize;
+
+        return true;
+    }
+
+    QByteArray read(qint64 size)
+    {
+        auto result = QByteArray();
+
+        while (result.size() < size) {
+            if (mPageBodyRemaining == 0 && !nextPage()) {
+                return {};
+            }
+
+            const auto chunkSize = std::min(size - result.size(), mPageBodyRemaining);
+            const auto chunk = readAt(mDevice, mPageBodyPosition, chunkSize);
+
+            if (chunk.size() < chunkSize) {
+                return {};
+            }
+
+            result.append(chunk);
+            mPageBodyPosition += chunkSize;
+            mPageBodyRemaining -= chunkSize;
+        }
+
+        return result;
+    }
+
+    bool skip(qint64 size)
+    {
+        while (size > 0) {
+            if (mPageBodyRemaining == 0 && !nextPage()) {
+                return false;
+            }
+
+            const auto chunkSize = std::min(size, mPageBodyRemaining);
+
+            mPageBodyPosition += chunkSize;
+            mPageBodyRemaining -= chunkSize;
+            size -= chunkSize;
+        }
+
+        return true;
+    }
+
+private:
+
+    QIODevice &mDevice;
+
+    qint64 mNextPagePosition = 0;
+
+    qint64 mPageBodyPosition = 0;
+
+    qint64 mPageBodyRemaining = 0;
+
+    quint32 mSerialNumber = 0;
+
+    int mPagesCount = 0;
+
+};
+
+static EmbeddedCoverProbe::Presence probeOgg(QIODevice &device)
+{
+    OggStreamReader oggStream(device);
+
+    if (!oggStream.nextPage()) {
+        return EmbeddedCoverProbe::Presence::Unknown;
+    }
+
+    const auto identificationHeader = oggStream.read(8);
+
+    auto commentHeaderMagic = QByteArray();
+    if (identificationHeader.startsWith("\x01vorbis")) {
+        commentHeaderMagic = QByteArray("\x03vorbis");
+    } else if (identificationHeader.startsWith("OpusHead")) {
+        commentHeaderMagic = QByteArray("OpusTags");
+    } else {
+        return EmbeddedCoverProbe::Presence::Unknown;
+    }
+
+    // the comment header always starts the second page
+    if (!oggStream.nextPage() || oggStream.read(commentHeaderMagic.size()) != commentHeaderMagic) {
+        return EmbeddedCoverProbe::Presence::Unknown;
+    }
+
+    const auto vendorLength = oggStream.read(4);
+    if (vendorLength.size() < 4 || !oggStream.skip(TagParsing::littleEndian32(bytesAt(vendorLength, 0)))) {
+        return EmbeddedCoverProbe::Presence::Unknown;
+    }
+
+    const auto commentsCount = oggStream.read(4);
+    if (commentsCount.size() < 4) {
+        return EmbeddedCoverProbe::Presence::Unknown;
+    }
+
+    const auto pictureKey = QByteArray("METADATA_BLOCK_PICTURE=");
+    const auto allCommentsCount = TagParsing::littleEndian32(bytesAt(commentsCount, 0));
+
+    for (quint32 commentIndex = 0; commentIndex < allCommentsCount; ++commentIndex) {
+        const auto commentLength = oggStream.read(4);
+        if (commentLength.size() < 4) {
+            return EmbeddedCoverProbe::Presence::Unknown;
+        }
+
+        const auto commentSize = static_cast<qint64>(TagParsing::littleEndian32(bytesAt(commentLength, 0)));
+
+        // the key and the first base64 quartets of the value hold the picture type
+        const auto commentStartSize = std::min<qint64>(commentSize, pictureKey.size() + 8);
+        const auto commentStart = oggStream.read(commentStartSize);
+        if (commentStart.size() < commentStartSize || !oggStream.skip(commentSize - commentStartSize)) {
+            return EmbeddedCoverProbe::Presence::Unknown;
+        }
+
+        if (commentStart.size() < pictureKey.size() + 8 || commentStart.left(pictureKey.size()).toUpper() != pictureKey) {
+            continue;
+        }
+
+        const auto pictureStart = QByteArray::fromBase64(commentStart.mid(pictureKey.size()));
+        if (pictureStart.size() >= 4 && TagParsing::bigEndian32(bytesAt(pictureStart, 0)) == frontCoverPictureType) {
+            return EmbeddedCoverProbe::Presence::Present;
+        }
+    }
+
+    return EmbeddedCoverProbe::Presence::Absent;
+}
+
+static bool findMp4Atom(QIODevice &device, qint64 begin, qint64 end, const char *atomType, qint64 &bodyBegin, qint64 &bodyEnd)
+{
+    TagParsing::Mp4Atom atom;
+
+    for (auto atomPosition = begin; atomPosition < end; atomPosition += atom.mEnd) {
+        const auto atomHeader = readAt(device, atomPosition, 16);
+
+        // the positions of the atom are relative to its header
+        if (atomHeader.size() < std::min<qint64>(16, end - atomPosition) ||
+                !TagParsing::readMp4Atom(bytesAt(atomHeader, 0), 0, end - atomPosition, atom)) {
+            return false;
+        }
+
+        if (std::memcmp(atom.mType, atomType, 4) == 0) {
+            bodyBegin = atomPosition + atom.mBodyBegin;
+            bodyEnd = atomPosition + atom.mEnd;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static EmbeddedCoverProbe::Presence probeMp4(QIODevice &device)
+{
+    auto bodyBegin = qint64(0);
+    auto bodyEnd = device.size();
+
+    if (!findMp4Atom(device, bodyBegin, bodyEnd, "moov", bodyBegin, bodyEnd)) {
+        return EmbeddedCoverProbe::Presence::Unknown;
+    }
+
+    if (!findMp4Atom(device, bodyBegin, bodyEnd, "udta", bodyBegin, bodyEnd) ||
+            !findMp4Atom(device, bodyBegin, bodyEnd, "meta", bodyBegin, bodyEnd)) {
+        return EmbeddedCoverProbe::Presence::Absent;
+    }
+
+    // meta is a full atom: its children come after a version and flags
+    bodyBegin += 4;
+
+    if (!findMp4Atom(device, bodyBegin, bodyEnd, "ilst", bodyBegin, bodyEnd) ||
+            !findMp4Atom(device, bodyBegin, bodyEnd, "covr", bodyBegin, bodyEnd) ||
+            !findMp4Atom(device, bodyBegin, bodyEnd, "data", bodyBegin, bodyEnd)) {
+        return EmbeddedCoverProbe::Presence::Absent;
+    }
+
+    // type and locale come before the picture
+    return (bodyEnd - bodyBegin > 8 ? EmbeddedCoverProbe::Presence::Present : EmbeddedCoverProbe::Presence::Absent);
+}
+
+EmbeddedCoverProbe::Presence EmbeddedCoverProbe::probe(const QString &localFileName)
+{
+    QFile audioFile(localFileName);
+
+    // only a few bytes are read at each position: buffering would read around every seek
+    if (!audioFile.open(QIODevice::ReadOnly | QIODevice::Unbuffered)) {
+        return Presence::Unknown;
+    }
+
+    return probe(audioFile);
+}
+
+EmbeddedCoverProbe::Presence EmbeddedCoverProbe::probe(QIODevice &device)
+{
+    if (device.isSequential()) {
+        return Presence::Unknown;
+    }
+
+    const auto fileHeader = readAt(device, 0, 12);
+
+    if (fileHeader.size() < 4) {
+        return Presence::Unknown;
+    }
+
+    if (fileHeader.startsWith("ID3")) {
+        auto tagEnd = qint64(0);
+        const auto tagPresence = probeId3v2(device, tagEnd);
+
+        // some FLAC files start with an ID3v2 tag
+        if (tagPresence != Presence::Present && readAt(device, tagEnd, 4) == "fLaC") {
+            return probeFlac(device, tagEnd);
+        }
+
+        return tagPresence;
+    }
+
+    if (fileHeader.startsWith("fLaC")) {
+        return probeFlac(device, 0);
+    }
+
+    if (fileHeader.startsWith("OggS")) {
+        return probeOgg(device);
+    }
+
+    if (fileHeader.size() >= 8 && fileHeader.mid(4, 4) == "ftyp") {
+        return probeMp4(device);
+    }
+
+    // an MPEG audio frame: there is no tag where the extractors look for one
+    if (static_cast<uchar>(fileHeader.at(0)) == 0xff && (static_cast<uchar>(fileHeader.at(1)) & 0xe0) == 0xe0) {
+        return Presence::Absent;
+    }
+
+    return Presence::Unknown;
+}
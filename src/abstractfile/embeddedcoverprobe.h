@@ -0,0 +1,45 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef EMBEDDEDCOVERPROBE_H
+#define EMBEDDEDCOVERPROBE_H
+
+#include "elisaLib_export.h"
+
+#include <QString>
+
+class QIODevice;
+
+class ELISALIB_EXPORT EmbeddedCoverProbe
+{
+
+public:
+
+    enum class Presence {
+        Unknown,
+        Present,
+        Absent,
+    };
+
+    /* walks the tag headers of ID3v2, FLAC, MP4 and Ogg files looking for a front cover without reading the pictures */
+    static Presence probe(const QString &localFileName);
+
+    static Presence probe(QIODevice &device);
+
+};
+
+#endif // EMBEDDEDCOVERPROBE_H
@@ -0,0 +1,512 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "scanscheduler.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QThreadPool>
+#include <QThread>
+#include <QThreadStorage>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+
+#if defined Q_OS_UNIX
+#include <sys/types.h>
+#include <sys/stat.h>
+#endif
+
+#if defined Q_OS_LINUX
+#include <sys/sysmacros.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+
+class ScanDeviceState
+{
+public:
+
+    ScanScheduler::StorageKind mStorageKind = ScanScheduler::StorageKind::Unknown;
+
+    int mConcurrency = 1;
+
+    int mBusyWorkers = 0;
+
+};
+
+class ScanSchedulerPrivate
+{
+public:
+
+    ScanDeviceState& deviceState(quint64 deviceId)
+    {
+        auto itDevice = mDevices.find(deviceId);
+
+        if (itDevice == mDevices.end()) {
+            itDevice = mDevices.insert(deviceId, {});
+
+            itDevice->mStorageKind = ScanScheduler::detectStorageKind(deviceId);
+
+            switch (itDevice->mStorageKind)
+            {
+            case ScanScheduler::StorageKind::Rotational:
+                itDevice->mConcurrency = 1;
+                break;
+            case ScanScheduler::StorageKind::SolidState:
+                itDevice->mConcurrency = std::max(2, QThread::idealThreadCount());
+                break;
+            case ScanScheduler::StorageKind::Unknown:
+                itDevice->mConcurrency = 2;
+                break;
+            }
+        }
+
+        return *itDevice;
+    }
+
+    QMutex mDevicesMutex;
+
+    QWaitCondition mWorkerReleased;
+
+    QHash<quint64, ScanDeviceState> mDevices;
+
+    QThreadPool mThreadPool;
+
+    int mExtractedFilesCount = 0;
+
+    qint64 mExtractionTime = 0;
+
+    QMutex mBudgetMutex;
+
+    QWaitCondition mBudgetChanged;
+
+    QElapsedTimer mBudgetClock;
+
+    qint64 mNextFileTime = 0;
+
+    qint64 mCpuBudgetTime = 0;
+
+    QAtomicInt mBackgroundPriority = 0;
+
+    QAtomicInt mFilesPerSecondBudget = 0;
+
+    QAtomicInt mCpuPercentBudget = 100;
+
+    QAtomicInt mIsPaused = 0;
+
+    QAtomicInt mFastTagReader = 0;
+
+    QAtomicInt mIsStopping = 0;
+
+};
+
+ScanScheduler::ScanScheduler() : d(std::make_unique<ScanSchedulerPrivate>())
+{
+    d->mThreadPool.setMaxThreadCount(std::max(1, QThread::idealThreadCount()));
+    d->mBudgetClock.start();
+}
+
+ScanScheduler::~ScanScheduler()
+{
+    {
+        QMutexLocker lock(&d->mBudgetMutex);
+
+        d->mIsStopping = 1;
+        d->mBudgetChanged.wakeAll();
+    }
+
+    d->mThreadPool.clear();
+    d->mThreadPool.waitForDone();
+}
+
+quint64 ScanScheduler::deviceId(const QString &path) const
+{
+#if defined Q_OS_UNIX
+    struct stat pathInformation;
+
+    if (::stat(QFile::encodeName(path).constData(), &pathInformation) == 0) {
+        return static_cast<quint64>(pathInformation.st_dev);
+    }
+#else
+    Q_UNUSED(path);
+#endif
+
+    return 0;
+}
+
+ScanScheduler::StorageKind ScanScheduler::storageKind(quint64 deviceId)
+{
+    QMutexLocker lock(&d->mDevicesMutex);
+
+    return d->deviceState(deviceId).mStorageKind;
+}
+
+int ScanScheduler::deviceConcurrency(quint64 deviceId)
+{
+    QMutexLocker lock(&d->mDevicesMutex);
+
+    return d->deviceState(deviceId).mConcurrency;
+}
+
+void ScanScheduler::setDeviceConcurrency(quint64 deviceId, int concurrency)
+{
+    QMutexLocker lock(&d->mDevicesMutex);
+
+    d->deviceState(deviceId).mConcurrency = std::max(1, concurrency);
+
+    d->mWorkerReleased.wakeAll();
+}
+
+void ScanScheduler::acquire(quint64 deviceId)
+{
+    QMutexLocker lock(&d->mDevicesMutex);
+
+    // look the device up again after each wait: other devices may have been added meanwhile
+    while (d->deviceState(deviceId).mBusyWorkers >= d->deviceState(deviceId).mConcurrency) {
+        d->mWorkerReleased.wait(&d->mDevicesMutex);
+    }
+
+    ++d->deviceState(deviceId).mBusyWorkers;
+}
+
+int ScanScheduler::tryAcquire(quint64 deviceId, int workersCount)
+{
+    QMutexLocker lock(&d->mDevicesMutex);
+
+    auto &currentDevice = d->deviceState(deviceId);
+
+    auto acquiredWorkers = std::max(0, std::min(workersCount, currentDevice.mConcurrency - currentDevice.mBusyWorkers));
+    currentDevice.mBusyWorkers += acquiredWorkers;
+
+    return acquiredWorkers;
+}
+
+void ScanScheduler::release(quint64 deviceId, int workersCount)
+{
+    if (workersCount <= 0) {
+        return;
+    }
+
+    QMutexLocker lock(&d->mDevicesMutex);
+
+    auto &currentDevice = d->deviceState(deviceId);
+
+    currentDevice.mBusyWorkers = std::max(0, currentDevice.mBusyWorkers - workersCount);
+
+    d->mWorkerReleased.wakeAll();
+}
+
+int ScanScheduler::busyWorkers(quint64 deviceId)
+{
+    QMutexLocker lock(&d->mDevicesMutex);
+
+    return d->deviceState(deviceId).mBusyWorkers;
+}
+
+QThreadPool &ScanScheduler::threadPool()
+{
+    return d->mThreadPool;
+}
+
+void ScanScheduler::recordExtraction(int filesCount, qint64 elapsedNanoSeconds)
+{
+    QMutexLocker lock(&d->mDevicesMutex);
+
+    d->mExtractedFilesCount += filesCount;
+    d->mExtractionTime += elapsedNanoSeconds;
+}
+
+int ScanScheduler::extractedFilesCount() const
+{
+    QMutexLocker lock(&d->mDevicesMutex);
+
+    return d->mExtractedFilesCount;
+}
+
+qint64 ScanScheduler::extractionTime() const
+{
+    QMutexLocker lock(&d->mDevicesMutex);
+
+    return d->mExtractionTime;
+}
+
+void ScanScheduler::setBackgroundPriority(bool backgroundPriority)
+{
+    d->mBackgroundPriority = (backgroundPriority ? 1 : 0);
+}
+
+bool ScanScheduler::backgroundPriority() const
+{
+    return d->mBackgroundPriority == 1;
+}
+
+void ScanScheduler::setFilesPerSecondBudget(int filesPerSecond)
+{
+    QMutexLocker lock(&d->mBudgetMutex);
+
+    d->mFilesPerSecondBudget = std::max(0, filesPerSecond);
+    d->mNextFileTime = 0;
+
+    d->mBudgetChanged.wakeAll();
+}
+
+int ScanScheduler::filesPerSecondBudget() const
+{
+    return d->mFilesPerSecondBudget;
+}
+
+void ScanScheduler::setCpuPercentBudget(int cpuPercent)
+{
+    QMutexLocker lock(&d->mBudgetMutex);
+
+    d->mCpuPercentBudget = std::max(1, std::min(100, cpuPercent));
+    d->mCpuBudgetTime = 0;
+
+    d->mBudgetChanged.wakeAll();
+}
+
+int ScanScheduler::cpuPercentBudget() const
+{
+    return d->mCpuPercentBudget;
+}
+
+void ScanScheduler::setPaused(bool paused)
+{
+    QMutexLocker lock(&d->mBudgetMutex);
+
+    d->mIsPaused = (paused ? 1 : 0);
+
+    d->mBudgetChanged.wakeAll();
+}
+
+bool ScanScheduler::isPaused() const
+{
+    return d->mIsPaused == 1;
+}
+
+void ScanScheduler::setFastTagReader(bool fastTagReader)
+{
+    d->mFastTagReader = (fastTagReader ? 1 : 0);
+}
+
+bool ScanScheduler::fastTagReader() const
+{
+    return d->mFastTagReader == 1;
+}
+
+void ScanScheduler::prepareScanThread()
+{
+    static QThreadStorage<bool> loweredThreads;
+
+    if (d->mBackgroundPriority == 0 || loweredThreads.hasLocalData()) {
+        return;
+    }
+
+    lowerCurrentThreadPriority();
+    loweredThreads.setLocalData(true);
+}
+
+void ScanScheduler::waitForBudget(qint64 lastFileNanoSeconds, const QAtomicInt &stopRequest)
+{
+    // the common case of an unlimited budget does not need the lock
+    if (d->mIsPaused == 0 && d->mFilesPerSecondBudget == 0 && d->mCpuPercentBudget == 100) {
+        return;
+    }
+
+    QMutexLocker lock(&d->mBudgetMutex);
+
+    // playback may need the disk and the processor back at any time: wake up regularly to see a stop request
+    while (d->mIsPaused == 1 && d->mIsStopping == 0 && stopRequest == 0) {
+        d->mBudgetChanged.wait(&d->mBudgetMutex, 100);
+    }
+
+    if (d->mIsStopping == 1 || stopRequest == 1) {
+        return;
+    }
+
+    const auto currentTime = d->mBudgetClock.nsecsElapsed();
+
+    // all workers share the processor budget: p% of work books 100% of time on a common clock,
+    // so extra workers on other devices do not multiply the budget
+    auto waitEnd = currentTime;
+    if (d->mCpuPercentBudget < 100 && lastFileNanoSeconds > 0) {
+        d->mCpuBudgetTime = std::max(d->mCpuBudgetTime, currentTime - lastFileNanoSeconds) +
+                lastFileNanoSeconds * 100 / d->mCpuPercentBudget;
+        waitEnd = d->mCpuBudgetTime;
+    }
+
+    // all workers share the files budget: each one reserves the next free time slot
+    if (d->mFilesPerSecondBudget > 0) {
+        waitEnd = std::max(waitEnd, d->mNextFileTime);
+        d->mNextFileTime = waitEnd + 1000000000 / d->mFilesPerSecondBudget;
+    }
+
+    while (d->mIsStopping == 0 && stopRequest == 0) {
+        const auto remainingTime = waitEnd - d->mBudgetClock.nsecsElapsed();
+
+        if (remainingTime <= 0) {
+            break;
+        }
+
+        d->mBudgetChanged.wait(&d->mBudgetMutex, static_cast<unsigned long>(std::min<qint64>(remainingTime / 1000000 + 1, 100)));
+    }
+}
+
+void ScanScheduler::waitWhilePaused(const QAtomicInt &stopRequest)
+{
+    if (d->mIsPaused == 0) {
+        return;
+    }
+
+    QMutexLocker lock(&d->mBudgetMutex);
+
+    while (d->mIsPaused == 1 && d->mIsStopping == 0 && stopRequest == 0) {
+        d->mBudgetChanged.wait(&d->mBudgetMutex, 100);
+    }
+}
+
+void ScanScheduler::lowerCurrentThreadPriority()
+{
+    // SCHED_IDLE on Linux
+    QThread::currentThread()->setPriority(QThread::IdlePriority);
+
+#if defined Q_OS_LINUX && defined SYS_ioprio_set
+    // there is no glibc wrapper: IOPRIO_WHO_PROCESS with a zero id is the calling thread, IOPRIO_CLASS_IDLE is 3
+    const int ioPriorityWhoProcess = 1;
+    const int ioPriorityIdleClass = 3;
+    const int ioPriorityClassShift = 13;
+
+    ::syscall(SYS_ioprio_set, ioPriorityWhoProcess, 0, ioPriorityIdleClass << ioPriorityClassShift);
+#endif
+}
+
+ScanScheduler::StorageKind ScanScheduler::detectStorageKind(quint64 deviceId)
+{
+#if defined Q_OS_LINUX
+    const auto deviceMajor = major(static_cast<dev_t>(deviceId));
+    const auto deviceMinor = minor(static_cast<dev_t>(deviceId));
+
+    // anonymous devices like network file systems, tmpfs or btrfs subvolumes have no block device
+    if (deviceMajor == 0) {
+        return StorageKind::Unknown;
+    }
+
+    const auto blockDevicePath = QStringLiteral("/sys/dev/block/%1:%2").arg(deviceMajor).arg(deviceMinor);
+
+    QFile rotationalFile(blockDevicePath + QStringLiteral("/queue/rotational"));
+
+    // a partition has no queue, its parent disk has it
+    if (!rotationalFile.exists()) {
+        rotationalFile.setFileName(QFileInfo(blockDevicePath).canonicalFilePath() + QStringLiteral("/../queue/rotational"));
+    }
+
+    if (!rotationalFile.open(QIODevice::ReadOnly)) {
+        return StorageKind::Unknown;
+    }
+
+    const auto rotationalValue = rotationalFile.readAll().trimmed();
+
+    if (rotationalValue == "1") {
+        return StorageKind::Rotational;
+    }
+
+    if (rotationalValue == "0") {
+        return StorageKind::SolidState;
+    }
+#else
+    Q_UNUSED(deviceId);
+#endif
+
+    return StorageKind::Unknown;
+}
+
+ScanScheduler::DeviceSlot::DeviceSlot(ScanScheduler *scheduler, const QString &path)
+    : mScheduler(scheduler)
+{
+    if (!mScheduler) {
+        return;
+    }
+
+    mScheduler->prepareScanThread();
+
+    mDeviceId = mScheduler->deviceId(path);
+    mScheduler->acquire(mDeviceId);
+    mIsHeld = true;
+}
+
+ScanScheduler::DeviceSlot::~DeviceSlot()
+{
+    release();
+}
+
+int ScanScheduler::DeviceSlot::acquireExtraWorkers(int wantedWorkers)
+{
+    if (!mScheduler || !mIsHeld || wantedWorkers <= 0) {
+        return 0;
+    }
+
+    auto newWorkers = mScheduler->tryAcquire(mDeviceId, wantedWorkers);
+    mExtraWorkers += newWorkers;
+
+    return newWorkers;
+}
+
+void ScanScheduler::DeviceSlot::releaseExtraWorkers()
+{
+    if (!mScheduler) {
+        return;
+    }
+
+    mScheduler->release(mDeviceId, mExtraWorkers);
+    mExtraWorkers = 0;
+}
+
+void ScanScheduler::DeviceSlot::release()
+{
+    if (!mScheduler || !mIsHeld) {
+        return;
+    }
+
+    releaseExtraWorkers();
+
+    mScheduler->release(mDeviceId, 1);
+    mIsHeld = false;
+}
+
+QThreadPool *ScanScheduler::DeviceSlot::threadPool() const
+{
+    if (!mScheduler) {
+        return nullptr;
+    }
+
+    return &mScheduler->threadPool();
+}
+
+ScanScheduler::StorageKind ScanScheduler::DeviceSlot::storageKind() const
+{
+    if (!mScheduler) {
+        return StorageKind::Unknown;
+    }
+
+    return mScheduler->storageKind(mDeviceId);
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCANSCHEDULER_H
+#define SCANSCHEDULER_H
+
+#include "elisaLib_export.h"
+
+#include <QString>
+#include <QtGlobal>
+
+#include <memory>
+
+class QThreadPool;
+class QAtomicInt;
+class ScanSchedulerPrivate;
+
+class ELISALIB_EXPORT ScanScheduler
+{
+
+public:
+
+    enum class StorageKind {
+        Unknown,
+        Rotational,
+        SolidState,
+    };
+
+    /* holds one scan worker of the device backing a path until released or destroyed */
+    class ELISALIB_EXPORT DeviceSlot
+    {
+
+    public:
+
+        DeviceSlot(ScanScheduler *scheduler, const QString &path);
+
+        ~DeviceSlot();
+
+        DeviceSlot(const DeviceSlot &other) = delete;
+
+        DeviceSlot& operator=(const DeviceSlot &other) = delete;
+
+        int acquireExtraWorkers(int wantedWorkers);
+
+        void releaseExtraWorkers();
+
+        void release();
+
+        QThreadPool* threadPool() const;
+
+        StorageKind storageKind() const;
+
+    private:
+
+        ScanScheduler *mScheduler = nullptr;
+
+        quint64 mDeviceId = 0;
+
+        bool mIsHeld = false;
+
+        int mExtraWorkers = 0;
+
+    };
+
+    ScanScheduler();
+
+    ~ScanScheduler();
+
+    quint64 deviceId(const QString &path) const;
+
+    StorageKind storageKind(quint64 deviceId);
+
+    int deviceConcurrency(quint64 deviceId);
+
+    void setDeviceConcurrency(quint64 deviceId, int concurrency);
+
+    void acquire(quint64 deviceId);
+
+    int tryAcquire(quint64 deviceId, int workersCount);
+
+    void release(quint64 deviceId, int workersCount);
+
+    int busyWorkers(quint64 deviceId);
+
+    QThreadPool& threadPool();
+
+    void recordExtraction(int filesCount, qint64 elapsedNanoSeconds);
+
+    int extractedFilesCount() const;
+
+    qint64 extractionTime() const;
+
+    void setBackgroundPriority(bool backgroundPriority);
+
+    bool backgroundPriority() const;
+
+    void setFilesPerSecondBudget(int filesPerSecond);
+
+    int filesPerSecondBudget() const;
+
+    void setCpuPercentBudget(int cpuPercent);
+
+    int cpuPercentBudget() const;
+
+    void setPaused(bool paused);
+
+    bool isPaused() const;
+
+    /* the scan workers read common tag formats with FastTagReader before falling back to the extractors */
+    void setFastTagReader(bool fastTagReader);
+
+    bool fastTagReader() const;
+
+    /* lowers the priority of the calling thread once when background priority is enabled */
+    void prepareScanThread();
+
+    /* blocks the calling scan worker while paused or over budget, returns early when stopRequest is set */
+    void waitForBudget(qint64 lastFileNanoSeconds, const QAtomicInt &stopRequest);
+
+    /* blocks the calling worker while paused without booking any budget, returns early when stopRequest is set */
+    void waitWhilePaused(const QAtomicInt &stopRequest);
+
+    static void lowerCurrentThreadPriority();
+
+    static StorageKind detectStorageKind(quint64 deviceId);
+
+private:
+
+    std::unique_ptr<ScanSchedulerPrivate> d;
+
+};
+
+#endif // SCANSCHEDULER_H
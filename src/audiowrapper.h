@@ -43,11 +43,21 @@ class ELISALIB_EXPORT AudioWrapper : public QObject
                WRITE setVolume
                NOTIFY volumeChanged)
 
+    Q_PROPERTY(qreal replayGain
+               READ replayGain
+               WRITE setReplayGain
+               NOTIFY replayGainChanged)
+
     Q_PROPERTY(QUrl source
                READ source
                WRITE setSource
                NOTIFY sourceChanged)
 
+    Q_PROPERTY(QUrl nextSource
+               READ nextSource
+               WRITE setNextSource
+               NOTIFY nextSourceChanged)
+
     Q_PROPERTY(QMediaPlayer::MediaStatus status
                READ status
                NOTIFY statusChanged)
@@ -88,8 +98,12 @@ public:
 
     qreal volume() const;
 
+    qreal replayGain() const;
+
     QUrl source() const;
 
+    QUrl nextSource() const;
+
     QMediaPlayer::MediaStatus status() const;
 
     QMediaPlayer::State playbackState() const;
@@ -110,8 +124,14 @@ Q_SIGNALS:
 
     void volumeChanged();
 
+    void replayGainChanged();
+
     void sourceChanged();
 
+    void nextSourceChanged();
+
+    void nextSourceStarted(const QUrl &source);
+
     void statusChanged(QMediaPlayer::MediaStatus status);
 
     void playbackStateChanged(QMediaPlayer::State state);
@@ -138,8 +158,14 @@ public Q_SLOTS:
 
     void setVolume(qreal volume);
 
+    void setReplayGain(qreal gain);
+
     void setSource(const QUrl &source);
 
+    void loadSource(const QUrl &source, bool forceReload);
+
+    void setNextSource(const QUrl &source);
+
     void setPosition(qint64 position);
 
     void play();
@@ -172,8 +198,6 @@ private:
 
     void playerDurationSignalChanges(qint64 newDuration);
 
-    void playerPositionSignalChanges(qint64 newPosition);
-
     void playerVolumeSignalChanges();
 
     void playerMutedSignalChanges(bool isMuted);
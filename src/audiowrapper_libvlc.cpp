@@ -20,6 +20,8 @@
 #include <QTimer>
 #include <QAudio>
 #include <QDir>
+#include <QAtomicInt>
+#include <QAtomicInteger>
 
 #if defined Q_OS_WIN
 
@@ -30,6 +32,8 @@ typedef SSIZE_T ssize_t;
 
 #include <vlc/vlc.h>
 
+#include <cmath>
+
 #include "config-upnp-qt.h"
 
 class AudioWrapperPrivate
@@ -47,6 +51,14 @@ public:
 
     libvlc_media_t *mMedia = nullptr;
 
+    libvlc_media_t *mNextMedia = nullptr;
+
+    QUrl mSource;
+
+    QUrl mNextSource;
+
+    QAtomicInt mHasNextMedia;
+
     qint64 mMediaDuration = 0;
 
     QMediaPlayer::State mPreviousPlayerState = QMediaPlayer::StoppedState;
@@ -55,10 +67,18 @@ public:
 
     qreal mPreviousVolume = 100.0;
 
+    qreal mUserVolume = 100.0;
+
+    qreal mReplayGain = 0.0;
+
     qint64 mSavedPosition = 0.0;
 
     qint64 mPreviousPosition = 0;
 
+    QAtomicInteger<qint64> mPosition;
+
+    QTimer mPositionTimer;
+
     QMediaPlayer::Error mError = QMediaPlayer::NoError;
 
     bool mIsMuted = false;
@@ -71,18 +91,32 @@ public:
 
     void mediaIsEnded();
 
+    libvlc_media_t *createMedia(const QUrl &source) const;
+
+    void signalEndOfMedia();
+
+    /* libvlc tears its input down on EndReached and cannot change media from its event thread: the next media is
+       only parsed ahead and set from the Qt thread, this saves the parsing but is not gapless */
+    void switchToNextMedia();
+
     bool signalPlaybackChange(QMediaPlayer::State newPlayerState);
 
     void signalMediaStatusChange(QMediaPlayer::MediaStatus newMediaStatus);
 
     void signalVolumeChange(int newVolume);
 
+    qreal replayGainFactor() const;
+
+    void applyVolume();
+
     void signalMutedChange(bool isMuted);
 
     void signalDurationChange(libvlc_time_t newDuration);
 
     void signalPositionChange(float newPosition);
 
+    void publishPosition();
+
     void signalSeekableChange(bool isSeekable);
 
     void signalErrorChange(QMediaPlayer::Error errorCode);
@@ -97,6 +131,10 @@ static void vlc_callback(const struct libvlc_event_t *p_event, void *p_data)
 AudioWrapper::AudioWrapper(QObject *parent) : QObject(parent), d(std::make_unique<AudioWrapperPrivate>())
 {
     d->mParent = this;
+
+    d->mPositionTimer.setInterval(500);
+    connect(&d->mPositionTimer, &QTimer::timeout, this, [this]() {d->publishPosition();});
+
     d->mInstance = libvlc_new(0, nullptr);
     libvlc_set_user_agent(d->mInstance, "elisa", "Elisa Music Player");
     libvlc_set_app_id(d->mInstance, "org.kde.elisa", "0.3.80", "elisa");
@@ -128,6 +166,10 @@ AudioWrapper::AudioWrapper(QObject *parent) : QObject(parent), d(std::make_uniqu
 
 AudioWrapper::~AudioWrapper()
 {
+    if (d->mNextMedia) {
+        libvlc_media_release(d->mNextMedia);
+    }
+
     if (d->mInstance) {
         libvlc_release(d->mInstance);
     }
@@ -144,7 +186,12 @@ qreal AudioWrapper::volume() const
         return 100.0;
     }
 
-    return d->mPreviousVolume;
+    return d->mPreviousVolume / d->replayGainFactor();
+}
+
+qreal AudioWrapper::replayGain() const
+{
+    return d->mReplayGain;
 }
 
 QUrl AudioWrapper::source() const
@@ -153,7 +200,12 @@ QUrl AudioWrapper::source() const
         return {};
     }
 
-    return {}/*d->mPlayer.media().canonicalUrl()*/;
+    return d->mSource;
+}
+
+QUrl AudioWrapper::nextSource() const
+{
+    return d->mNextSource;
 }
 
 QMediaPlayer::Error AudioWrapper::error() const
@@ -214,31 +266,41 @@ void AudioWrapper::setMuted(bool muted)
 
 void AudioWrapper::setVolume(qreal volume)
 {
-    if (!d->mPlayer) {
+    d->mUserVolume = volume;
+    d->applyVolume();
+}
+
+void AudioWrapper::setReplayGain(qreal gain)
+{
+    if (qFuzzyCompare(1. + d->mReplayGain, 1. + gain)) {
         return;
     }
 
-    //auto realVolume = static_cast<qreal>(QAudio::convertVolume(volume / 100.0, QAudio::LogarithmicVolumeScale, QAudio::LinearVolumeScale));
-    libvlc_audio_set_volume(d->mPlayer, qRound(volume));
+    d->mReplayGain = gain;
+    d->applyVolume();
+
+    Q_EMIT replayGainChanged();
 }
 
 void AudioWrapper::setSource(const QUrl &source)
 {
-    d->mMedia = libvlc_media_new_path(d->mInstance, QDir::toNativeSeparators(source.toLocalFile()).toUtf8().constData());
-    if (!d->mMedia) {
-        qDebug() << "AudioWrapper::setSource"
-                 << "failed creating media"
-                 << libvlc_errmsg()
-                 << QDir::toNativeSeparators(source.toLocalFile()).toUtf8().constData();
+    loadSource(source, false);
+}
 
-        d->mMedia = libvlc_media_new_path(d->mInstance, QDir::toNativeSeparators(source.toLocalFile()).toLatin1().constData());
-        if (!d->mMedia) {
-            qDebug() << "AudioWrapper::setSource"
-                     << "failed creating media"
-                     << libvlc_errmsg()
-                     << QDir::toNativeSeparators(source.toLocalFile()).toLatin1().constData();
-            return;
-        }
+void AudioWrapper::loadSource(const QUrl &source, bool forceReload)
+{
+    if (!forceReload && source == d->mSource && d->mMedia && d->mPreviousPlayerState != QMediaPlayer::StoppedState) {
+        return;
+    }
+
+    if (d->mMedia) {
+        libvlc_media_release(d->mMedia);
+    }
+
+    d->mSource = source;
+    d->mMedia = d->createMedia(source);
+    if (!d->mMedia) {
+        return;
     }
 
     libvlc_media_player_set_media(d->mPlayer, d->mMedia);
@@ -252,6 +314,32 @@ void AudioWrapper::setSource(const QUrl &source)
     d->signalMediaStatusChange(QMediaPlayer::BufferedMedia);
 }
 
+void AudioWrapper::setNextSource(const QUrl &source)
+{
+    if (d->mNextSource == source) {
+        return;
+    }
+
+    d->mHasNextMedia.storeRelease(0);
+
+    if (d->mNextMedia) {
+        libvlc_media_release(d->mNextMedia);
+        d->mNextMedia = nullptr;
+    }
+
+    d->mNextSource = source;
+
+    if (!source.isEmpty()) {
+        d->mNextMedia = d->createMedia(source);
+        if (d->mNextMedia) {
+            libvlc_media_parse_with_options(d->mNextMedia, libvlc_media_parse_local, -1);
+            d->mHasNextMedia.storeRelease(1);
+        }
+    }
+
+    Q_EMIT nextSourceChanged();
+}
+
 void AudioWrapper::setPosition(qint64 position)
 {
     if (!d->mPlayer) {
@@ -268,6 +356,9 @@ void AudioWrapper::setPosition(qint64 position)
     }
 
     libvlc_media_player_set_position(d->mPlayer, static_cast<float>(position) / d->mMediaDuration);
+
+    d->mPosition.storeRelease(position);
+    QMetaObject::invokeMethod(this, [this]() {d->publishPosition();}, Qt::QueuedConnection);
 }
 
 void AudioWrapper::play()
@@ -326,6 +417,13 @@ void AudioWrapper::playerVolumeChanged()
 void AudioWrapper::playerStateSignalChanges(QMediaPlayer::State newState)
 {
     QMetaObject::invokeMethod(this, [this, newState]() {
+        if (newState == QMediaPlayer::PlayingState) {
+            d->mPositionTimer.start();
+        } else {
+            d->mPositionTimer.stop();
+            d->publishPosition();
+        }
+
         Q_EMIT playbackStateChanged(newState);
         switch (newState)
         {
@@ -357,11 +455,6 @@ void AudioWrapper::playerDurationSignalChanges(qint64 newDuration)
     QMetaObject::invokeMethod(this, [this, newDuration]() {Q_EMIT durationChanged(newDuration);}, Qt::QueuedConnection);
 }
 
-void AudioWrapper::playerPositionSignalChanges(qint64 newPosition)
-{
-    QMetaObject::invokeMethod(this, [this, newPosition]() {Q_EMIT positionChanged(newPosition);}, Qt::QueuedConnection);
-}
-
 void AudioWrapper::playerVolumeSignalChanges()
 {
     QMetaObject::invokeMethod(this, [this]() {Q_EMIT volumeChanged();}, Qt::QueuedConnection);
@@ -384,31 +477,26 @@ void AudioWrapperPrivate::vlcEventCallback(const struct libvlc_event_t *p_event)
     switch(eventType)
     {
     case libvlc_MediaPlayerOpening:
-        qDebug() << "AudioWrapperPrivate::vlcEventCallback" << "libvlc_MediaPlayerOpening";
         signalMediaStatusChange(QMediaPlayer::LoadedMedia);
         break;
     case libvlc_MediaPlayerBuffering:
-        qDebug() << "AudioWrapperPrivate::vlcEventCallback" << "libvlc_MediaPlayerBuffering";
         signalMediaStatusChange(QMediaPlayer::BufferedMedia);
         break;
     case libvlc_MediaPlayerPlaying:
-        qDebug() << "AudioWrapperPrivate::vlcEventCallback" << "libvlc_MediaPlayerPlaying";
         signalPlaybackChange(QMediaPlayer::PlayingState);
         break;
     case libvlc_MediaPlayerPaused:
-        qDebug() << "AudioWrapperPrivate::vlcEventCallback" << "libvlc_MediaPlayerPaused";
         signalPlaybackChange(QMediaPlayer::PausedState);
         break;
     case libvlc_MediaPlayerStopped:
-        qDebug() << "AudioWrapperPrivate::vlcEventCallback" << "libvlc_MediaPlayerStopped";
         signalPlaybackChange(QMediaPlayer::StoppedState);
         break;
     case libvlc_MediaPlayerEndReached:
-        qDebug() << "AudioWrapperPrivate::vlcEventCallback" << "libvlc_MediaPlayerEndReached";
-        signalMediaStatusChange(QMediaPlayer::BufferedMedia);
-        signalMediaStatusChange(QMediaPlayer::NoMedia);
-        signalMediaStatusChange(QMediaPlayer::EndOfMedia);
-        mediaIsEnded();
+        if (mHasNextMedia.loadAcquire()) {
+            QMetaObject::invokeMethod(mParent, [this]() {switchToNextMedia();}, Qt::QueuedConnection);
+            break;
+        }
+        signalEndOfMedia();
         break;
     case libvlc_MediaPlayerEncounteredError:
         qDebug() << "AudioWrapperPrivate::vlcEventCallback" << "libvlc_MediaPlayerEncounteredError";
@@ -417,15 +505,12 @@ void AudioWrapperPrivate::vlcEventCallback(const struct libvlc_event_t *p_event)
         signalMediaStatusChange(QMediaPlayer::InvalidMedia);
         break;
     case libvlc_MediaPlayerPositionChanged:
-        qDebug() << "AudioWrapperPrivate::vlcEventCallback" << "libvlc_MediaPlayerPositionChanged";
         signalPositionChange(p_event->u.media_player_position_changed.new_position);
         break;
     case libvlc_MediaPlayerSeekableChanged:
-        qDebug() << "AudioWrapperPrivate::vlcEventCallback" << "libvlc_MediaPlayerSeekableChanged";
         signalSeekableChange(p_event->u.media_player_seekable_changed.new_seekable);
         break;
     case libvlc_MediaPlayerLengthChanged:
-        qDebug() << "AudioWrapperPrivate::vlcEventCallback" << "libvlc_MediaPlayerLengthChanged";
         signalDurationChange(p_event->u.media_player_length_changed.new_length);
         if (mHasSavedPosition) {
             mParent->setPosition(mSavedPosition);
@@ -433,19 +518,15 @@ void AudioWrapperPrivate::vlcEventCallback(const struct libvlc_event_t *p_event)
         }
         break;
     case libvlc_MediaPlayerMuted:
-        qDebug() << "AudioWrapperPrivate::vlcEventCallback" << "libvlc_MediaPlayerMuted";
         signalMutedChange(true);
         break;
     case libvlc_MediaPlayerUnmuted:
-        qDebug() << "AudioWrapperPrivate::vlcEventCallback" << "libvlc_MediaPlayerUnmuted";
         signalMutedChange(false);
         break;
     case libvlc_MediaPlayerAudioVolume:
-        qDebug() << "AudioWrapperPrivate::vlcEventCallback" << "libvlc_MediaPlayerAudioVolume";
         signalVolumeChange(qRound(p_event->u.media_player_audio_volume.volume * 100));
         break;
     case libvlc_MediaPlayerAudioDevice:
-        qDebug() << "AudioWrapperPrivate::vlcEventCallback" << "libvlc_MediaPlayerAudioDevice";
         break;
     default:
         qDebug() << "AudioWrapperPrivate::vlcEventCallback" << "eventType" << eventType;
@@ -455,10 +536,74 @@ void AudioWrapperPrivate::vlcEventCallback(const struct libvlc_event_t *p_event)
 
 void AudioWrapperPrivate::mediaIsEnded()
 {
-    libvlc_media_release(mMedia);
+    if (mMedia) {
+        libvlc_media_release(mMedia);
+    }
     mMedia = nullptr;
 }
 
+libvlc_media_t *AudioWrapperPrivate::createMedia(const QUrl &source) const
+{
+    auto media = libvlc_media_new_path(mInstance, QDir::toNativeSeparators(source.toLocalFile()).toUtf8().constData());
+    if (!media) {
+        qDebug() << "AudioWrapperPrivate::createMedia"
+                 << "failed creating media"
+                 << libvlc_errmsg()
+                 << QDir::toNativeSeparators(source.toLocalFile()).toUtf8().constData();
+
+        media = libvlc_media_new_path(mInstance, QDir::toNativeSeparators(source.toLocalFile()).toLatin1().constData());
+        if (!media) {
+            qDebug() << "AudioWrapperPrivate::createMedia"
+                     << "failed creating media"
+                     << libvlc_errmsg()
+                     << QDir::toNativeSeparators(source.toLocalFile()).toLatin1().constData();
+        }
+    }
+
+    return media;
+}
+
+void AudioWrapperPrivate::signalEndOfMedia()
+{
+    signalMediaStatusChange(QMediaPlayer::BufferedMedia);
+    signalMediaStatusChange(QMediaPlayer::NoMedia);
+    signalMediaStatusChange(QMediaPlayer::EndOfMedia);
+    mediaIsEnded();
+}
+
+void AudioWrapperPrivate::switchToNextMedia()
+{
+    if (!mNextMedia) {
+        signalEndOfMedia();
+        return;
+    }
+
+    mediaIsEnded();
+
+    mMedia = mNextMedia;
+    mNextMedia = nullptr;
+    mHasNextMedia.storeRelease(0);
+
+    mSource = mNextSource;
+    mNextSource.clear();
+
+    libvlc_media_player_set_media(mPlayer, mMedia);
+    libvlc_media_player_play(mPlayer);
+
+    mPosition.storeRelease(0);
+    publishPosition();
+
+    signalDurationChange(libvlc_media_get_duration(mMedia));
+
+    signalMediaStatusChange(QMediaPlayer::LoadingMedia);
+    signalMediaStatusChange(QMediaPlayer::LoadedMedia);
+    signalMediaStatusChange(QMediaPlayer::BufferedMedia);
+
+    Q_EMIT mParent->sourceChanged();
+    Q_EMIT mParent->nextSourceChanged();
+    Q_EMIT mParent->nextSourceStarted(mSource);
+}
+
 bool AudioWrapperPrivate::signalPlaybackChange(QMediaPlayer::State newPlayerState)
 {
     if (mPreviousPlayerState != newPlayerState) {
@@ -498,6 +643,21 @@ void AudioWrapperPrivate::signalVolumeChange(int newVolume)
     }
 }
 
+qreal AudioWrapperPrivate::replayGainFactor() const
+{
+    return std::pow(10., mReplayGain / 20.);
+}
+
+void AudioWrapperPrivate::applyVolume()
+{
+    if (!mPlayer) {
+        return;
+    }
+
+    //auto realVolume = static_cast<qreal>(QAudio::convertVolume(volume / 100.0, QAudio::LogarithmicVolumeScale, QAudio::LinearVolumeScale));
+    libvlc_audio_set_volume(mPlayer, qBound(0, qRound(mUserVolume * replayGainFactor()), 200));
+}
+
 void AudioWrapperPrivate::signalMutedChange(bool isMuted)
 {
     if (mIsMuted != isMuted) {
@@ -522,12 +682,17 @@ void AudioWrapperPrivate::signalPositionChange(float newPosition)
         return;
     }
 
-    auto computedPosition = qRound64(newPosition * mMediaDuration);
+    mPosition.storeRelease(qRound64(newPosition * mMediaDuration));
+}
+
+void AudioWrapperPrivate::publishPosition()
+{
+    auto currentPosition = mPosition.loadAcquire();
 
-    if (mPreviousPosition != computedPosition) {
-        mPreviousPosition = computedPosition;
+    if (mPreviousPosition != currentPosition) {
+        mPreviousPosition = currentPosition;
 
-        mParent->playerPositionSignalChanges(mPreviousPosition);
+        Q_EMIT mParent->positionChanged(mPreviousPosition);
     }
 }
 
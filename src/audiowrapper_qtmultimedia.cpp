@@ -20,6 +20,8 @@
 #include <QTimer>
 #include <QAudio>
 
+#include <cmath>
+
 #include "config-upnp-qt.h"
 
 class AudioWrapperPrivate
@@ -27,23 +29,40 @@ class AudioWrapperPrivate
 
 public:
 
-    QMediaPlayer mPlayer;
+    explicit AudioWrapperPrivate(AudioWrapper *parent) : mParent(parent)
+    {
+    }
+
+    void connectPlayer(QMediaPlayer *player);
+
+    bool hasNextPlayer() const;
+
+    bool switchToNextPlayer();
+
+    void applyVolume();
+
+    AudioWrapper *mParent = nullptr;
+
+    QMediaPlayer mFirstPlayer;
+
+    QMediaPlayer mSecondPlayer;
+
+    QMediaPlayer *mPlayer = &mFirstPlayer;
+
+    QMediaPlayer *mNextPlayer = &mSecondPlayer;
+
+    QUrl mNextSource;
+
+    qreal mVolume = 100.;
+
+    qreal mReplayGain = 0.;
 
 };
 
-AudioWrapper::AudioWrapper(QObject *parent) : QObject(parent), d(std::make_unique<AudioWrapperPrivate>())
+AudioWrapper::AudioWrapper(QObject *parent) : QObject(parent), d(std::make_unique<AudioWrapperPrivate>(this))
 {
-    connect(&d->mPlayer, &QMediaPlayer::mutedChanged, this, &AudioWrapper::playerMutedChanged);
-    connect(&d->mPlayer, &QMediaPlayer::volumeChanged, this, &AudioWrapper::playerVolumeChanged);
-    connect(&d->mPlayer, &QMediaPlayer::mediaChanged, this, &AudioWrapper::sourceChanged);
-    connect(&d->mPlayer, &QMediaPlayer::mediaStatusChanged, this, &AudioWrapper::statusChanged);
-    connect(&d->mPlayer, &QMediaPlayer::mediaStatusChanged, this, &AudioWrapper::mediaStatusChanged);
-    connect(&d->mPlayer, &QMediaPlayer::stateChanged, this, &AudioWrapper::playbackStateChanged);
-    connect(&d->mPlayer, &QMediaPlayer::stateChanged, this, &AudioWrapper::playerStateChanged);
-    connect(&d->mPlayer, QOverload<QMediaPlayer::Error>::of(&QMediaPlayer::error), this, &AudioWrapper::errorChanged);
-    connect(&d->mPlayer, &QMediaPlayer::durationChanged, this, &AudioWrapper::durationChanged);
-    connect(&d->mPlayer, &QMediaPlayer::positionChanged, this, &AudioWrapper::positionChanged);
-    connect(&d->mPlayer, &QMediaPlayer::seekableChanged, this, &AudioWrapper::seekableChanged);
+    d->connectPlayer(&d->mFirstPlayer);
+    d->connectPlayer(&d->mSecondPlayer);
 }
 
 AudioWrapper::~AudioWrapper()
@@ -51,105 +70,147 @@ AudioWrapper::~AudioWrapper()
 
 bool AudioWrapper::muted() const
 {
-    return d->mPlayer.isMuted();
+    return d->mPlayer->isMuted();
 }
 
 qreal AudioWrapper::volume() const
 {
-    auto realVolume = static_cast<qreal>(d->mPlayer.volume() / 100.0);
-    auto userVolume = static_cast<qreal>(QAudio::convertVolume(realVolume, QAudio::LinearVolumeScale, QAudio::LogarithmicVolumeScale));
+    return d->mVolume;
+}
 
-    return userVolume * 100.0;
+qreal AudioWrapper::replayGain() const
+{
+    return d->mReplayGain;
 }
 
 QUrl AudioWrapper::source() const
 {
-    return d->mPlayer.media().canonicalUrl();
+    return d->mPlayer->media().canonicalUrl();
 }
 
 QMediaPlayer::Error AudioWrapper::error() const
 {
-    if (d->mPlayer.error() != QMediaPlayer::NoError) {
-        qDebug() << "AudioWrapper::error" << d->mPlayer.errorString();
+    if (d->mPlayer->error() != QMediaPlayer::NoError) {
+        qDebug() << "AudioWrapper::error" << d->mPlayer->errorString();
     }
 
-    return d->mPlayer.error();
+    return d->mPlayer->error();
 }
 
 qint64 AudioWrapper::duration() const
 {
-    return d->mPlayer.duration();
+    return d->mPlayer->duration();
 }
 
 qint64 AudioWrapper::position() const
 {
-    return d->mPlayer.position();
+    return d->mPlayer->position();
 }
 
 bool AudioWrapper::seekable() const
 {
-    return d->mPlayer.isSeekable();
+    return d->mPlayer->isSeekable();
 }
 
 QAudio::Role AudioWrapper::audioRole() const
 {
-    return d->mPlayer.audioRole();
+    return d->mPlayer->audioRole();
 }
 
 QMediaPlayer::State AudioWrapper::playbackState() const
 {
-    return d->mPlayer.state();
+    return d->mPlayer->state();
 }
 
 QMediaPlayer::MediaStatus AudioWrapper::status() const
 {
-    return d->mPlayer.mediaStatus();
+    return d->mPlayer->mediaStatus();
+}
+
+QUrl AudioWrapper::nextSource() const
+{
+    return d->mNextSource;
 }
 
 void AudioWrapper::setMuted(bool muted)
 {
-    d->mPlayer.setMuted(muted);
+    d->mPlayer->setMuted(muted);
+    d->mNextPlayer->setMuted(muted);
 }
 
 void AudioWrapper::setVolume(qreal volume)
 {
-    auto realVolume = static_cast<qreal>(QAudio::convertVolume(volume / 100.0, QAudio::LogarithmicVolumeScale, QAudio::LinearVolumeScale));
-    d->mPlayer.setVolume(qRound(realVolume * 100));
+    d->mVolume = volume;
+    d->applyVolume();
+}
+
+void AudioWrapper::setReplayGain(qreal gain)
+{
+    if (qFuzzyCompare(1. + d->mReplayGain, 1. + gain)) {
+        return;
+    }
+
+    d->mReplayGain = gain;
+    d->applyVolume();
+
+    Q_EMIT replayGainChanged();
 }
 
 void AudioWrapper::setSource(const QUrl &source)
 {
-    d->mPlayer.setMedia({source});
+    loadSource(source, false);
+}
+
+void AudioWrapper::loadSource(const QUrl &source, bool forceReload)
+{
+    if (!forceReload && source == d->mPlayer->media().canonicalUrl() && d->mPlayer->state() != QMediaPlayer::StoppedState) {
+        return;
+    }
+
+    d->mPlayer->setMedia({source});
+}
+
+void AudioWrapper::setNextSource(const QUrl &source)
+{
+    if (d->mNextSource == source) {
+        return;
+    }
+
+    d->mNextSource = source;
+    d->mNextPlayer->setMedia(source.isEmpty() ? QMediaContent{} : QMediaContent{source});
+
+    Q_EMIT nextSourceChanged();
 }
 
 void AudioWrapper::setPosition(qint64 position)
 {
-    d->mPlayer.setPosition(position);
+    d->mPlayer->setPosition(position);
 }
 
 void AudioWrapper::play()
 {
-    d->mPlayer.play();
+    d->mPlayer->play();
 }
 
 void AudioWrapper::pause()
 {
-    d->mPlayer.pause();
+    d->mPlayer->pause();
 }
 
 void AudioWrapper::stop()
 {
-    d->mPlayer.stop();
+    d->mPlayer->stop();
 }
 
 void AudioWrapper::seek(qint64 position)
 {
-    d->mPlayer.setPosition(position);
+    d->mPlayer->setPosition(position);
 }
 
 void AudioWrapper::setAudioRole(QAudio::Role audioRole)
 {
-    d->mPlayer.setAudioRole(audioRole);
+    d->mPlayer->setAudioRole(audioRole);
+    d->mNextPlayer->setAudioRole(audioRole);
 }
 
 void AudioWrapper::mediaStatusChanged()
@@ -158,7 +219,7 @@ void AudioWrapper::mediaStatusChanged()
 
 void AudioWrapper::playerStateChanged()
 {
-    switch(d->mPlayer.state())
+    switch(d->mPlayer->state())
     {
     case QMediaPlayer::State::StoppedState:
         Q_EMIT stopped();
@@ -197,11 +258,6 @@ void AudioWrapper::playerDurationSignalChanges(qint64 newDuration)
     QMetaObject::invokeMethod(this, [this, newDuration]() {Q_EMIT durationChanged(newDuration);}, Qt::QueuedConnection);
 }
 
-void AudioWrapper::playerPositionSignalChanges(qint64 newPosition)
-{
-    QMetaObject::invokeMethod(this, [this, newPosition]() {Q_EMIT positionChanged(newPosition);}, Qt::QueuedConnection);
-}
-
 void AudioWrapper::playerVolumeSignalChanges()
 {
     QMetaObject::invokeMethod(this, [this]() {Q_EMIT volumeChanged();}, Qt::QueuedConnection);
@@ -217,5 +273,124 @@ void AudioWrapper::playerSeekableSignalChanges(bool isSeekable)
     QMetaObject::invokeMethod(this, [this, isSeekable]() {Q_EMIT seekableChanged(isSeekable);}, Qt::QueuedConnection);
 }
 
+void AudioWrapperPrivate::connectPlayer(QMediaPlayer *player)
+{
+    QObject::connect(player, &QMediaPlayer::mutedChanged, mParent, [this, player]() {
+        if (player == mPlayer) {
+            mParent->playerMutedChanged();
+        }
+    });
+    QObject::connect(player, &QMediaPlayer::volumeChanged, mParent, [this, player]() {
+        if (player == mPlayer) {
+            mParent->playerVolumeChanged();
+        }
+    });
+    QObject::connect(player, &QMediaPlayer::mediaChanged, mParent, [this, player]() {
+        if (player == mPlayer) {
+            Q_EMIT mParent->sourceChanged();
+        }
+    });
+    QObject::connect(player, &QMediaPlayer::mediaStatusChanged, mParent, [this, player](QMediaPlayer::MediaStatus status) {
+        if (player != mPlayer) {
+            return;
+        }
+
+        if (status == QMediaPlayer::EndOfMedia && switchToNextPlayer()) {
+            return;
+        }
+
+        Q_EMIT mParent->statusChanged(status);
+        mParent->mediaStatusChanged();
+    });
+    QObject::connect(player, &QMediaPlayer::stateChanged, mParent, [this, player](QMediaPlayer::State state) {
+        if (player != mPlayer) {
+            return;
+        }
+
+        // a player reaching the end of its media reports Stopped before EndOfMedia:
+        // hold the stop back until it is known whether the next player takes over
+        if (state == QMediaPlayer::StoppedState && hasNextPlayer()) {
+            if (player->mediaStatus() == QMediaPlayer::EndOfMedia && switchToNextPlayer()) {
+                return;
+            }
+
+            QMetaObject::invokeMethod(mParent, [this, player]() {
+                if (player == mPlayer && player->state() == QMediaPlayer::StoppedState) {
+                    Q_EMIT mParent->playbackStateChanged(QMediaPlayer::StoppedState);
+                    mParent->playerStateChanged();
+                }
+            }, Qt::QueuedConnection);
+
+            return;
+        }
+
+        Q_EMIT mParent->playbackStateChanged(state);
+        mParent->playerStateChanged();
+    });
+    QObject::connect(player, QOverload<QMediaPlayer::Error>::of(&QMediaPlayer::error), mParent, [this, player](QMediaPlayer::Error error) {
+        if (player == mPlayer) {
+            Q_EMIT mParent->errorChanged(error);
+        }
+    });
+    QObject::connect(player, &QMediaPlayer::durationChanged, mParent, [this, player](qint64 duration) {
+        if (player == mPlayer) {
+            Q_EMIT mParent->durationChanged(duration);
+        }
+    });
+    QObject::connect(player, &QMediaPlayer::positionChanged, mParent, [this, player](qint64 position) {
+        if (player == mPlayer) {
+            Q_EMIT mParent->positionChanged(position);
+        }
+    });
+    QObject::connect(player, &QMediaPlayer::seekableChanged, mParent, [this, player](bool seekable) {
+        if (player == mPlayer) {
+            Q_EMIT mParent->seekableChanged(seekable);
+        }
+    });
+}
+
+bool AudioWrapperPrivate::hasNextPlayer() const
+{
+    if (mNextSource.isEmpty()) {
+        return false;
+    }
+
+    const auto nextStatus = mNextPlayer->mediaStatus();
+
+    return nextStatus != QMediaPlayer::NoMedia && nextStatus != QMediaPlayer::InvalidMedia && mNextPlayer->error() == QMediaPlayer::NoError;
+}
+
+bool AudioWrapperPrivate::switchToNextPlayer()
+{
+    if (!hasNextPlayer()) {
+        return false;
+    }
+
+    const auto startedSource = mNextSource;
+    mNextSource.clear();
+
+    std::swap(mPlayer, mNextPlayer);
+    mPlayer->play();
+
+    Q_EMIT mParent->sourceChanged();
+    Q_EMIT mParent->nextSourceChanged();
+    Q_EMIT mParent->durationChanged(mPlayer->duration());
+    Q_EMIT mParent->seekableChanged(mPlayer->isSeekable());
+    Q_EMIT mParent->positionChanged(mPlayer->position());
+    Q_EMIT mParent->statusChanged(mPlayer->mediaStatus());
+    Q_EMIT mParent->nextSourceStarted(startedSource);
+
+    return true;
+}
+
+void AudioWrapperPrivate::applyVolume()
+{
+    auto realVolume = static_cast<qreal>(QAudio::convertVolume(mVolume / 100.0, QAudio::LogarithmicVolumeScale, QAudio::LinearVolumeScale));
+    realVolume = qBound(0., realVolume * std::pow(10., mReplayGain / 20.), 1.);
+
+    mPlayer->setVolume(qRound(realVolume * 100));
+    mNextPlayer->setVolume(qRound(realVolume * 100));
+}
+
 
 #include "moc_audiowrapper.cpp"
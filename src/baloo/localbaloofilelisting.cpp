@@ -45,6 +45,8 @@
 #include <QDBusServiceWatcher>
 
 #include <QThread>
+#include <QElapsedTimer>
+#include <QTimer>
 #include <QHash>
 #include <QFileInfo>
 #include <QDir>
@@ -74,8 +76,16 @@ public:
 
     BalooWatcherApplicationAdaptor *mDbusAdaptor = nullptr;
 
+    QList<QPair<QUrl, QDateTime>> mPendingEmbeddedCoverTracks;
+
     QAtomicInt mStopRequest = 0;
 
+    int mBalooFilesBatchSize = 100;
+
+    int mEmbeddedCoverChecksBatchSize = 50;
+
+    bool mEmbeddedCoverChecksScheduled = false;
+
     bool mIsRegisteredToBaloo = false;
 
     bool mIsRegisteringToBaloo = false;
@@ -255,6 +265,30 @@ void LocalBalooFileListing::registerToBaloo()
 void LocalBalooFileListing::renamedFiles(const QString &from, const QString &to, const QStringList &listFiles)
 {
     qDebug() << "LocalBalooFileListing::renamedFiles" << from << to << listFiles;
+
+    auto allRenamedFiles = QHash<QUrl, QUrl>();
+
+    if (listFiles.isEmpty()) {
+        allRenamedFiles[QUrl::fromLocalFile(from)] = QUrl::fromLocalFile(to);
+    }
+
+    // a renamed directory lists the files it contains, either with their old or with their new path
+    for (const auto &oneFile : listFiles) {
+        if (oneFile.startsWith(to)) {
+            allRenamedFiles[QUrl::fromLocalFile(from + oneFile.mid(to.size()))] = QUrl::fromLocalFile(oneFile);
+        } else if (oneFile.startsWith(from)) {
+            allRenamedFiles[QUrl::fromLocalFile(oneFile)] = QUrl::fromLocalFile(to + oneFile.mid(from.size()));
+        }
+    }
+
+    for (auto itRenamedFile = allRenamedFiles.begin(); itRenamedFile != allRenamedFiles.end(); ++itRenamedFile) {
+        const auto newDirectory = QUrl::fromLocalFile(QFileInfo(itRenamedFile.value().toLocalFile()).absolutePath());
+
+        addFileInDirectory(itRenamedFile.value(), newDirectory);
+    }
+
+    renameFiles(allRenamedFiles);
+    emitRenamedFiles();
 }
 
 void LocalBalooFileListing::serviceOwnerChanged(const QString &serviceName, const QString &oldOwner, const QString &newOwner)
@@ -306,7 +340,7 @@ void LocalBalooFileListing::triggerRefreshOfContent()
     AbstractFileListing::triggerRefreshOfContent();
 
     auto resultIterator = d->mQuery.exec();
-    auto newFiles = QList<MusicAudioTrack>();
+    auto filesToScan = QList<QPair<QUrl, QFileInfo>>();
 
     while(resultIterator.next() && d->mStopRequest == 0) {
         const auto &fileName = resultIterator.filePath();
@@ -315,7 +349,7 @@ void LocalBalooFileListing::triggerRefreshOfContent()
         auto scanFileInfo = QFileInfo(fileName);
 
         if (!scanFileInfo.exists()) {
-            return;
+            continue;
         }
 
         auto itExistingFile = allFiles().find(newFileUrl);
@@ -330,46 +364,131 @@ void LocalBalooFileListing::triggerRefreshOfContent()
 
         addFileInDirectory(newFileUrl, currentDirectory);
 
-        const auto &newTrack = scanOneFile(newFileUrl, scanFileInfo);
+        filesToScan.push_back({newFileUrl, scanFileInfo});
+
+        if (filesToScan.size() >= d->mBalooFilesBatchSize) {
+            scanBalooFiles(filesToScan);
+            filesToScan.clear();
+        }
+    }
+
+    scanBalooFiles(filesToScan);
+
+    checkFilesToRemove();
+
+    Q_EMIT indexingFinished();
+
+    scheduleEmbeddedCoverChecks();
+}
+
+void LocalBalooFileListing::scanBalooFiles(const QList<QPair<QUrl, QFileInfo>> &filesToScan)
+{
+    auto newFiles = QList<MusicAudioTrack>();
+    auto newWatchedFiles = QStringList();
+
+    QElapsedTimer extractionTimer;
+    auto lastFileDuration = qint64(0);
+
+    for (const auto &oneFile : filesToScan) {
+        waitForScanBudget(lastFileDuration);
+
+        if (d->mStopRequest == 1) {
+            break;
+        }
+
+        extractionTimer.start();
+
+        auto newTrack = balooTrack(oneFile.first, oneFile.second);
+
+        if (newTrack.isValid()) {
+            // Baloo has the tags but not the pictures: the flag must be right even when the folder art is later removed
+            d->mPendingEmbeddedCoverTracks.push_back({newTrack.resourceURI(), newTrack.fileModificationTime()});
+
+            newWatchedFiles.push_back(oneFile.first.toLocalFile());
+        } else {
+            newTrack = AbstractFileListing::scanOneFile(oneFile.first, oneFile.second);
+        }
 
         if (newTrack.isValid()) {
+            addCover(newTrack);
             newFiles.push_back(newTrack);
-            if (newFiles.size() > 500 && d->mStopRequest == 0) {
-                emitNewFiles(newFiles);
-                newFiles.clear();
-            }
         }
+
+        lastFileDuration = extractionTimer.nsecsElapsed();
     }
 
+    watchPaths(newWatchedFiles);
+
     if (!newFiles.isEmpty() && d->mStopRequest == 0) {
         emitNewFiles(newFiles);
     }
+}
+
+void LocalBalooFileListing::scheduleEmbeddedCoverChecks()
+{
+    if (d->mEmbeddedCoverChecksScheduled || d->mPendingEmbeddedCoverTracks.isEmpty() || d->mStopRequest == 1) {
+        return;
+    }
 
-    checkFilesToRemove();
+    d->mEmbeddedCoverChecksScheduled = true;
 
-    Q_EMIT indexingFinished();
+    QTimer::singleShot(0, this, &LocalBalooFileListing::checkPendingEmbeddedCovers);
 }
 
-MusicAudioTrack LocalBalooFileListing::scanOneFile(const QUrl &scanFile, const QFileInfo &scanFileInfo)
+void LocalBalooFileListing::checkPendingEmbeddedCovers()
 {
-    auto newTrack = MusicAudioTrack();
+    d->mEmbeddedCoverChecksScheduled = false;
 
-    auto localFileName = scanFile.toLocalFile();
+    auto tracksWithEmbeddedCover = QList<QUrl>();
 
-    Baloo::File match(localFileName);
+    QElapsedTimer checkTimer;
+    auto lastFileDuration = qint64(0);
 
-    match.load();
+    for (int checkIndex = 0; checkIndex < d->mEmbeddedCoverChecksBatchSize && !d->mPendingEmbeddedCoverTracks.isEmpty(); ++checkIndex) {
+        waitForScanBudget(lastFileDuration);
 
-    newTrack.setFileModificationTime(scanFileInfo.fileTime(QFile::FileModificationTime));
-    newTrack.setResourceURI(scanFile);
+        if (d->mStopRequest == 1) {
+            return;
+        }
 
-    fileScanner().scanProperties(match, newTrack);
+        checkTimer.start();
+
+        const auto oneTrack = d->mPendingEmbeddedCoverTracks.takeFirst();
+        const auto localFileName = oneTrack.first.toLocalFile();
+
+        // a file modified or removed since its scan has been or will be handled by its own notification
+        const auto currentFileInfo = QFileInfo(localFileName);
+        if (!currentFileInfo.exists() || currentFileInfo.fileTime(QFile::FileModificationTime) != oneTrack.second) {
+            continue;
+        }
+
+        if (checkEmbeddedCoverImage(localFileName)) {
+            tracksWithEmbeddedCover.push_back(oneTrack.first);
+        }
+
+        lastFileDuration = checkTimer.nsecsElapsed();
+    }
+
+    // only the flag changes: the tracks are not sent again through modifyTracksList
+    if (!tracksWithEmbeddedCover.isEmpty()) {
+        Q_EMIT embeddedCoverTracksList(tracksWithEmbeddedCover);
+    }
+
+    // one batch per event loop iteration keeps the listing responsive to Baloo notifications
+    scheduleEmbeddedCoverChecks();
+}
+
+MusicAudioTrack LocalBalooFileListing::scanOneFile(const QUrl &scanFile, const QFileInfo &scanFileInfo)
+{
+    auto newTrack = balooTrack(scanFile, scanFileInfo);
 
     if (!newTrack.isValid()) {
         newTrack = AbstractFileListing::scanOneFile(scanFile, scanFileInfo);
     }
 
     if (newTrack.isValid()) {
+        const auto localFileName = scanFile.toLocalFile();
+
         newTrack.setHasEmbeddedCover(checkEmbeddedCoverImage(localFileName));
         addCover(newTrack);
         watchPath(localFileName);
@@ -378,6 +497,22 @@ MusicAudioTrack LocalBalooFileListing::scanOneFile(const QUrl &scanFile, const Q
     return newTrack;
 }
 
+MusicAudioTrack LocalBalooFileListing::balooTrack(const QUrl &scanFile, const QFileInfo &scanFileInfo)
+{
+    auto newTrack = MusicAudioTrack();
+
+    Baloo::File match(scanFile.toLocalFile());
+
+    match.load();
+
+    newTrack.setFileModificationTime(scanFileInfo.fileTime(QFile::FileModificationTime));
+    newTrack.setResourceURI(scanFile);
+
+    fileScanner().scanProperties(match, newTrack);
+
+    return newTrack;
+}
+
 bool LocalBalooFileListing::checkBalooConfiguration()
 {
     bool problemDetected = false;
@@ -25,12 +25,15 @@
 #include <QUrl>
 #include <QHash>
 #include <QVector>
+#include <QList>
+#include <QPair>
 
 #include <memory>
 
 class LocalBalooFileListingPrivate;
 class MusicAudioTrack;
 class QDBusPendingCallWatcher;
+class QFileInfo;
 
 class LocalBalooFileListing : public AbstractFileListing
 {
@@ -69,6 +72,8 @@ private Q_SLOTS:
 
     void registeredToBalooWatcher(QDBusPendingCallWatcher *watcher);
 
+    void checkPendingEmbeddedCovers();
+
 private:
 
     void registerToBaloo();
@@ -79,6 +84,13 @@ private:
 
     MusicAudioTrack scanOneFile(const QUrl &scanFile, const QFileInfo &scanFileInfo) override;
 
+    /* the tags Baloo has indexed for a file, an invalid track when the file needs the extractors */
+    MusicAudioTrack balooTrack(const QUrl &scanFile, const QFileInfo &scanFileInfo);
+
+    void scanBalooFiles(const QList<QPair<QUrl, QFileInfo>> &filesToScan);
+
+    void scheduleEmbeddedCoverChecks();
+
     bool checkBalooConfiguration();
 
     std::unique_ptr<LocalBalooFileListingPrivate> d;
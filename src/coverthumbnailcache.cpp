@@ -0,0 +1,281 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "coverthumbnailcache.h"
+
+#include "config-upnp-qt.h"
+
+#if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
+
+#include <KFileMetaData/EmbeddedImageData>
+
+#endif
+
+#include <QStandardPaths>
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDir>
+#include <QSaveFile>
+#include <QBuffer>
+#include <QImageReader>
+
+#include <algorithm>
+
+class CoverThumbnailCachePrivate
+{
+public:
+
+    QString mCacheDirectory;
+
+};
+
+static QSize scaledCoverSize(const QSize &coverSize, const QSize &requestedSize)
+{
+    if (!coverSize.isValid() || coverSize.isEmpty()) {
+        return coverSize;
+    }
+
+    auto result = coverSize;
+
+    if (requestedSize.width() > 0 && requestedSize.height() > 0) {
+        result = coverSize.scaled(requestedSize, Qt::KeepAspectRatio);
+    } else if (requestedSize.width() > 0) {
+        result = QSize(requestedSize.width(), qMax(1, coverSize.height() * requestedSize.width() / coverSize.width()));
+    } else if (requestedSize.height() > 0) {
+        result = QSize(qMax(1, coverSize.width() * requestedSize.height() / coverSize.height()), requestedSize.height());
+    }
+
+    if (result.width() >= coverSize.width() || result.height() >= coverSize.height()) {
+        return coverSize;
+    }
+
+    return result;
+}
+
+static QImage readScaledImage(QImageReader &coverReader, const QSize &requestedSize)
+{
+    const auto coverSize = coverReader.size();
+    const auto targetSize = scaledCoverSize(coverSize, requestedSize);
+
+    if (targetSize != coverSize) {
+        coverReader.setScaledSize(targetSize);
+    }
+
+    return coverReader.read();
+}
+
+CoverThumbnailCache::CoverThumbnailCache(const QString &cacheDirectory) : d(std::make_unique<CoverThumbnailCachePrivate>())
+{
+    if (cacheDirectory.isEmpty()) {
+        d->mCacheDirectory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/covers");
+    } else {
+        d->mCacheDirectory = cacheDirectory;
+    }
+}
+
+CoverThumbnailCache::~CoverThumbnailCache() = default;
+
+const QVector<int> &CoverThumbnailCache::thumbnailSizes()
+{
+    static const auto sizes = QVector<int>{64, 360};
+
+    return sizes;
+}
+
+QImage CoverThumbnailCache::readCover(const QString &sourceFile, const QSize &requestedSize)
+{
+    if (!QImageReader::imageFormat(sourceFile).isEmpty()) {
+        QImageReader coverReader(sourceFile);
+
+        return readScaledImage(coverReader, requestedSize);
+    }
+
+#if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
+    KFileMetaData::EmbeddedImageData embeddedImage;
+
+    auto imageData = embeddedImage.imageData(sourceFile);
+
+    if (!imageData.contains(KFileMetaData::EmbeddedImageData::FrontCover)) {
+        return {};
+    }
+
+    auto coverData = imageData[KFileMetaData::EmbeddedImageData::FrontCover];
+
+    QBuffer coverBuffer(&coverData);
+    coverBuffer.open(QIODevice::ReadOnly);
+
+    QImageReader coverReader(&coverBuffer);
+
+    auto result = readScaledImage(coverReader, requestedSize);
+
+    if (result.isNull()) {
+        result = QImage::fromData(coverData);
+
+        const auto fallbackSize = scaledCoverSize(result.size(), requestedSize);
+        if (!result.isNull() && fallbackSize != result.size()) {
+            result = result.scaled(fallbackSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        }
+    }
+
+    return result;
+#else
+    return {};
+#endif
+}
+
+QString CoverThumbnailCache::cacheDirectory() const
+{
+    return d->mCacheDirectory;
+}
+
+QString CoverThumbnailCache::thumbnailFileName(const QString &sourceFile, int thumbnailSize) const
+{
+    QFileInfo sourceInfo(sourceFile);
+
+    if (!sourceInfo.exists()) {
+        return {};
+    }
+
+    const auto sourceHash = QCryptographicHash::hash(sourceInfo.absoluteFilePath().toUtf8(), QCryptographicHash::Sha1).toHex();
+
+    return d->mCacheDirectory + QStringLiteral("/") + QString::fromLatin1(sourceHash) +
+            QStringLiteral("-%1-%2-%3.png").arg(sourceInfo.lastModified().toMSecsSinceEpoch()).arg(sourceInfo.size()).arg(thumbnailSize);
+}
+
+QImage CoverThumbnailCache::thumbnail(const QString &sourceFile, const QSize &requestedSize) const
+{
+    const auto requestedDimension = qMax(requestedSize.width(), requestedSize.height());
+
+    if (requestedDimension <= 0) {
+        return {};
+    }
+
+    const auto &sizes = thumbnailSizes();
+    auto itSize = std::find_if(sizes.begin(), sizes.end(), [requestedDimension](int oneSize) {return oneSize >= requestedDimension;});
+
+    if (itSize == sizes.end()) {
+        return {};
+    }
+
+    const auto fileName = thumbnailFileName(sourceFile, *itSize);
+
+    if (fileName.isEmpty() || !QFileInfo::exists(fileName)) {
+        return {};
+    }
+
+    QImageReader thumbnailReader(fileName);
+
+    return readScaledImage(thumbnailReader, requestedSize);
+}
+
+bool CoverThumbnailCache::hasThumbnails(const QString &sourceFile) const
+{
+    for (auto oneSize : thumbnailSizes()) {
+        const auto fileName = thumbnailFileName(sourceFile, oneSize);
+
+        if (fileName.isEmpty() || !QFileInfo::exists(fileName)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool CoverThumbnailCache::storeThumbnails(const QString &sourceFile, const QImage &coverImage) const
+{
+    if (coverImage.isNull()) {
+        return false;
+    }
+
+    QDir cacheDirectory(d->mCacheDirectory);
+
+    if (!cacheDirectory.mkpath(QStringLiteral("."))) {
+        return false;
+    }
+
+    const auto sourceHash = QCryptographicHash::hash(QFileInfo(sourceFile).absoluteFilePath().toUtf8(), QCryptographicHash::Sha1).toHex();
+    const auto staleThumbnails = cacheDirectory.entryList({QString::fromLatin1(sourceHash) + QStringLiteral("-*")}, QDir::Files);
+
+    for (const auto &oneStaleThumbnail : staleThumbnails) {
+        cacheDirectory.remove(oneStaleThumbnail);
+    }
+
+    for (auto oneSize : thumbnailSizes()) {
+        const auto fileName = thumbnailFileName(sourceFile, oneSize);
+
+        if (fileName.isEmpty()) {
+            return false;
+        }
+
+        auto thumbnailImage = coverImage;
+        if (coverImage.width() > oneSize || coverImage.height() > oneSize) {
+            thumbnailImage = coverImage.scaled(oneSize, oneSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        }
+
+        QSaveFile thumbnailFile(fileName);
+
+        if (!thumbnailFile.open(QIODevice::WriteOnly)) {
+            return false;
+        }
+
+        if (!thumbnailImage.save(&thumbnailFile, "PNG")) {
+            thumbnailFile.cancelWriting();
+            return false;
+        }
+
+        if (!thumbnailFile.commit()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool CoverThumbnailCache::createThumbnails(const QString &sourceFile) const
+{
+    if (hasThumbnails(sourceFile)) {
+        return true;
+    }
+
+    const auto largestSize = thumbnailSizes().last();
+    const auto coverImage = readCover(sourceFile, {largestSize, largestSize});
+
+    return storeThumbnails(sourceFile, coverImage);
+}
+
+void CoverThumbnailCache::trimCache(qint64 maximumSize) const
+{
+    QDir cacheDirectory(d->mCacheDirectory);
+
+    const auto allThumbnails = cacheDirectory.entryInfoList({QStringLiteral("*.png")}, QDir::Files, QDir::Time | QDir::Reversed);
+
+    auto cacheSize = qint64(0);
+    for (const auto &oneThumbnail : allThumbnails) {
+        cacheSize += oneThumbnail.size();
+    }
+
+    for (const auto &oneThumbnail : allThumbnails) {
+        if (cacheSize <= maximumSize) {
+            break;
+        }
+
+        if (cacheDirectory.remove(oneThumbnail.fileName())) {
+            cacheSize -= oneThumbnail.size();
+        }
+    }
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef COVERTHUMBNAILCACHE_H
+#define COVERTHUMBNAILCACHE_H
+
+#include "elisaLib_export.h"
+
+#include <QString>
+#include <QSize>
+#include <QImage>
+#include <QVector>
+
+#include <memory>
+
+class CoverThumbnailCachePrivate;
+
+class ELISALIB_EXPORT CoverThumbnailCache
+{
+
+public:
+
+    explicit CoverThumbnailCache(const QString &cacheDirectory = {});
+
+    ~CoverThumbnailCache();
+
+    /* disk space the indexer lets the thumbnails use before trimCache removes the oldest ones */
+    static const qint64 maximumCacheSize = 256 * 1024 * 1024;
+
+    static const QVector<int>& thumbnailSizes();
+
+    static QImage readCover(const QString &sourceFile, const QSize &requestedSize);
+
+    QString cacheDirectory() const;
+
+    QString thumbnailFileName(const QString &sourceFile, int thumbnailSize) const;
+
+    QImage thumbnail(const QString &sourceFile, const QSize &requestedSize) const;
+
+    bool hasThumbnails(const QString &sourceFile) const;
+
+    bool storeThumbnails(const QString &sourceFile, const QImage &coverImage) const;
+
+    bool createThumbnails(const QString &sourceFile) const;
+
+    /* removes the oldest thumbnails until the cache directory holds at most maximumSize bytes */
+    void trimCache(qint64 maximumSize) const;
+
+private:
+
+    std::unique_ptr<CoverThumbnailCachePrivate> d;
+
+};
+
+#endif // COVERTHUMBNAILCACHE_H
@@ -18,6 +18,11 @@
 #include "databaseinterface.h"
 
 #include "musicaudiotrack.h"
+#include "databasestatistics.h"
+#include "datablock.h"
+#include "loudnessanalyzer.h"
+
+#include "databaseLogging.h"
 
 #include <KI18n/KLocalizedString>
 
@@ -30,12 +35,46 @@
 #include <QSqlError>
 
 #include <QDateTime>
+#include <QFileInfo>
+#include <QMap>
 #include <QMutex>
 #include <QVariant>
 #include <QAtomicInt>
+#include <QElapsedTimer>
 #include <QDebug>
 
 #include <algorithm>
+#include <chrono>
+
+/* columns of the Tracks UNIQUE constraint that are not part of the album key */
+class TrackUniqueEntry
+{
+public:
+
+    qulonglong mTrackId = 0;
+
+    QString mTitle;
+
+    QString mAlbumArtistName;
+
+    int mTrackNumber = -1;
+
+    int mDiscNumber = -1;
+
+};
+
+/* (AlbumTitle, AlbumPath) of a track */
+using TrackAlbumKey = QPair<QString, QString>;
+
+class TrackFileOrigin
+{
+public:
+
+    qulonglong mTrackId = 0;
+
+    int mPriority = 1;
+
+};
 
 class DatabaseInterfacePrivate
 {
@@ -56,13 +95,13 @@ public:
           mInsertTrackMapping(mTracksDatabase), mUpdateTrackFirstPlayStatistics(mTracksDatabase),
           mInsertMusicSource(mTracksDatabase), mSelectMusicSource(mTracksDatabase),
           mUpdateTrackMapping(mTracksDatabase),
-          mSelectTracksMapping(mTracksDatabase), mSelectTracksMappingPriority(mTracksDatabase),
-          mUpdateAlbumArtUriFromAlbumIdQuery(mTracksDatabase), mSelectTracksMappingPriorityByTrackId(mTracksDatabase),
+          mSelectTracksMapping(mTracksDatabase), mUpdateAlbumArtUriFromAlbumIdQuery(mTracksDatabase),
           mSelectAllTrackFilesFromSourceQuery(mTracksDatabase),  mSelectAlbumIdsFromArtist(mTracksDatabase),
           mRemoveTracksMappingFromSource(mTracksDatabase), mRemoveTracksMapping(mTracksDatabase),
+          mRenameTrackMapping(mTracksDatabase), mUpdateTrackEmbeddedCover(mTracksDatabase),
           mSelectTracksWithoutMappingQuery(mTracksDatabase), mSelectAlbumIdFromTitleAndArtistQuery(mTracksDatabase),
           mSelectAlbumIdFromTitleWithoutArtistQuery(mTracksDatabase),
-          mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery(mTracksDatabase), mSelectAlbumArtUriFromAlbumIdQuery(mTracksDatabase),
+          mSelectAlbumArtUriFromAlbumIdQuery(mTracksDatabase),
           mInsertComposerQuery(mTracksDatabase), mSelectComposerByNameQuery(mTracksDatabase),
           mSelectComposerQuery(mTracksDatabase), mInsertLyricistQuery(mTracksDatabase),
           mSelectLyricistByNameQuery(mTracksDatabase), mSelectLyricistQuery(mTracksDatabase),
@@ -78,7 +117,9 @@ public:
           mQueryMaximumLyricistIdQuery(mTracksDatabase), mQueryMaximumComposerIdQuery(mTracksDatabase),
           mQueryMaximumGenreIdQuery(mTracksDatabase), mSelectAllArtistsWithGenreFilterQuery(mTracksDatabase),
           mSelectAllAlbumsShortWithGenreArtistFilterQuery(mTracksDatabase), mSelectAllAlbumsShortWithArtistFilterQuery(mTracksDatabase),
-          mSelectAllRecentlyPlayedTracksQuery(mTracksDatabase), mSelectAllFrequentlyPlayedTracksQuery(mTracksDatabase)
+          mSelectAllRecentlyPlayedTracksQuery(mTracksDatabase), mSelectAllFrequentlyPlayedTracksQuery(mTracksDatabase),
+          mUpdateTrackLoudnessQuery(mTracksDatabase), mSelectAlbumTracksLoudnessQuery(mTracksDatabase),
+          mUpdateAlbumLoudnessQuery(mTracksDatabase), mSelectTracksWithoutLoudnessQuery(mTracksDatabase)
     {
     }
 
@@ -138,12 +179,8 @@ public:
 
     QSqlQuery mSelectTracksMapping;
 
-    QSqlQuery mSelectTracksMappingPriority;
-
     QSqlQuery mUpdateAlbumArtUriFromAlbumIdQuery;
 
-    QSqlQuery mSelectTracksMappingPriorityByTrackId;
-
     QSqlQuery mSelectAllTrackFilesFromSourceQuery;
 
     QSqlQuery mSelectAlbumIdsFromArtist;
@@ -152,14 +189,16 @@ public:
 
     QSqlQuery mRemoveTracksMapping;
 
+    QSqlQuery mRenameTrackMapping;
+
+    QSqlQuery mUpdateTrackEmbeddedCover;
+
     QSqlQuery mSelectTracksWithoutMappingQuery;
 
     QSqlQuery mSelectAlbumIdFromTitleAndArtistQuery;
 
     QSqlQuery mSelectAlbumIdFromTitleWithoutArtistQuery;
 
-    QSqlQuery mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery;
-
     QSqlQuery mSelectAlbumArtUriFromAlbumIdQuery;
 
     QSqlQuery mInsertComposerQuery;
@@ -226,6 +265,14 @@ public:
 
     QSqlQuery mSelectAllFrequentlyPlayedTracksQuery;
 
+    QSqlQuery mUpdateTrackLoudnessQuery;
+
+    QSqlQuery mSelectAlbumTracksLoudnessQuery;
+
+    QSqlQuery mUpdateAlbumLoudnessQuery;
+
+    QSqlQuery mSelectTracksWithoutLoudnessQuery;
+
     QSet<qulonglong> mModifiedTrackIds;
 
     QSet<qulonglong> mModifiedAlbumIds;
@@ -238,6 +285,14 @@ public:
 
     QSet<qulonglong> mInsertedArtists;
 
+    QHash<QString, qulonglong> mArtistIds;
+
+    QHash<QString, qulonglong> mComposerIds;
+
+    QHash<QString, qulonglong> mLyricistIds;
+
+    QHash<QString, qulonglong> mGenreIds;
+
     qulonglong mAlbumId = 1;
 
     qulonglong mArtistId = 1;
@@ -252,12 +307,262 @@ public:
 
     qulonglong mDiscoverId = 1;
 
+    /* in-memory copy of the Tracks UNIQUE constraint, bucketed by album */
+    QHash<TrackAlbumKey, QVector<TrackUniqueEntry>> mTracksByAlbum;
+
+    QHash<qulonglong, TrackAlbumKey> mTrackAlbumKeys;
+
+    /* TracksMapping rows by FileName, and the files of each track by Priority */
+    QHash<QString, TrackFileOrigin> mTrackFiles;
+
+    QHash<qulonglong, QMap<int, QString>> mTrackFilesByPriority;
+
+    bool mTrackDuplicatesLoaded = false;
+
     QAtomicInt mStopRequest = 0;
 
     bool mInitFinished = false;
 
+    void clearTrackDuplicates()
+    {
+        mTracksByAlbum.clear();
+        mTrackAlbumKeys.clear();
+        mTrackFiles.clear();
+        mTrackFilesByPriority.clear();
+        mTrackDuplicatesLoaded = false;
+    }
+
+    /* an existing track matches on every column of the constraint, a NULL album artist matching any */
+    qulonglong duplicateTrackId(const TrackAlbumKey &albumKey, const TrackUniqueEntry &track) const
+    {
+        auto result = qulonglong(0);
+
+        const auto itAlbum = mTracksByAlbum.constFind(albumKey);
+        if (itAlbum == mTracksByAlbum.constEnd()) {
+            return result;
+        }
+
+        for (const auto &oneTrack : *itAlbum) {
+            if (oneTrack.mTitle != track.mTitle || oneTrack.mTrackNumber != track.mTrackNumber ||
+                    oneTrack.mDiscNumber != track.mDiscNumber) {
+                continue;
+            }
+
+            if (oneTrack.mAlbumArtistName == track.mAlbumArtistName) {
+                return oneTrack.mTrackId;
+            }
+
+            if (oneTrack.mAlbumArtistName.isNull()) {
+                result = oneTrack.mTrackId;
+            }
+        }
+
+        return result;
+    }
+
+    void setTrackUniqueEntry(const TrackAlbumKey &albumKey, const TrackUniqueEntry &track)
+    {
+        removeTrackUniqueEntry(track.mTrackId);
+
+        /* SQLite never reports a conflict on a NULL album title */
+        if (albumKey.first.isEmpty()) {
+            return;
+        }
+
+        mTracksByAlbum[albumKey].push_back(track);
+        mTrackAlbumKeys[track.mTrackId] = albumKey;
+    }
+
+    void removeTrackUniqueEntry(qulonglong trackId)
+    {
+        const auto itAlbumKey = mTrackAlbumKeys.find(trackId);
+        if (itAlbumKey == mTrackAlbumKeys.end()) {
+            return;
+        }
+
+        const auto itAlbum = mTracksByAlbum.find(*itAlbumKey);
+        if (itAlbum != mTracksByAlbum.end()) {
+            auto &albumTracks = *itAlbum;
+
+            albumTracks.erase(std::remove_if(albumTracks.begin(), albumTracks.end(),
+                                             [trackId](const TrackUniqueEntry &oneTrack) {return oneTrack.mTrackId == trackId;}),
+                              albumTracks.end());
+
+            if (albumTracks.isEmpty()) {
+                mTracksByAlbum.erase(itAlbum);
+            }
+        }
+
+        mTrackAlbumKeys.erase(itAlbumKey);
+    }
+
+    void setAlbumArtistOfTracks(const TrackAlbumKey &albumKey, const QString &artistName)
+    {
+        const auto itAlbum = mTracksByAlbum.find(albumKey);
+        if (itAlbum == mTracksByAlbum.end()) {
+            return;
+        }
+
+        for (auto &oneTrack : *itAlbum) {
+            if (oneTrack.mAlbumArtistName.isNull()) {
+                oneTrack.mAlbumArtistName = artistName;
+            }
+        }
+    }
+
+    /* a file keeps its priority, a new copy of a track goes after all the known ones */
+    int trackFilePriority(qulonglong trackId, const QString &fileName) const
+    {
+        const auto itFile = mTrackFiles.constFind(fileName);
+        if (itFile != mTrackFiles.constEnd() && itFile->mTrackId == trackId) {
+            return itFile->mPriority;
+        }
+
+        const auto itTrack = mTrackFilesByPriority.constFind(trackId);
+        if (itTrack == mTrackFilesByPriority.constEnd() || itTrack->isEmpty()) {
+            return 1;
+        }
+
+        return itTrack->lastKey() + 1;
+    }
+
+    void setTrackFile(const QString &fileName, qulonglong trackId, int priority)
+    {
+        removeTrackFile(fileName);
+
+        mTrackFiles[fileName] = {trackId, priority};
+
+        if (trackId != 0) {
+            mTrackFilesByPriority[trackId][priority] = fileName;
+        }
+    }
+
+    /* returns the track now resolved to another of its copies, 0 if none */
+    qulonglong removeTrackFile(const QString &fileName)
+    {
+        auto result = qulonglong(0);
+
+        const auto itFile = mTrackFiles.find(fileName);
+        if (itFile == mTrackFiles.end()) {
+            return result;
+        }
+
+        const auto origin = *itFile;
+        mTrackFiles.erase(itFile);
+
+        const auto itTrack = mTrackFilesByPriority.find(origin.mTrackId);
+        if (itTrack == mTrackFilesByPriority.end()) {
+            return result;
+        }
+
+        const auto wasPreferredFile = (itTrack->firstKey() == origin.mPriority);
+
+        itTrack->remove(origin.mPriority);
+
+        if (itTrack->isEmpty()) {
+            mTrackFilesByPriority.erase(itTrack);
+        } else if (wasPreferredFile) {
+            result = origin.mTrackId;
+        }
+
+        return result;
+    }
+
+    void renameTrackFile(const QString &oldFileName, const QString &newFileName)
+    {
+        const auto itFile = mTrackFiles.find(oldFileName);
+        if (itFile == mTrackFiles.end()) {
+            return;
+        }
+
+        const auto origin = *itFile;
+        mTrackFiles.erase(itFile);
+
+        setTrackFile(newFileName, origin.mTrackId, origin.mPriority);
+    }
+
+    /* the TracksMapping rows of a removed track go away with it */
+    void removeTrack(qulonglong trackId)
+    {
+        removeTrackUniqueEntry(trackId);
+
+        const auto trackFiles = mTrackFilesByPriority.take(trackId);
+        for (const auto &oneFileName : trackFiles) {
+            mTrackFiles.remove(oneFileName);
+        }
+    }
+
 };
 
+static const QVector<DatabaseInterface::ColumnsRoles> &trackDataRoles()
+{
+    static const auto roles = QVector<DatabaseInterface::ColumnsRoles>{
+            DatabaseInterface::DatabaseIdRole,
+            DatabaseInterface::TitleRole,
+            DatabaseInterface::AlbumRole,
+            DatabaseInterface::AlbumIdRole,
+            DatabaseInterface::ArtistRole,
+            DatabaseInterface::AlbumArtistRole,
+            DatabaseInterface::ResourceRole,
+            DatabaseInterface::TrackNumberRole,
+            DatabaseInterface::DiscNumberRole,
+            DatabaseInterface::DurationRole,
+            DatabaseInterface::MilliSecondsDurationRole,
+            DatabaseInterface::RatingRole,
+            DatabaseInterface::ImageUrlRole,
+            DatabaseInterface::IsSingleDiscAlbumRole,
+            DatabaseInterface::GenreRole,
+            DatabaseInterface::ComposerRole,
+            DatabaseInterface::LyricistRole,
+            DatabaseInterface::HasEmbeddedCover,
+            DatabaseInterface::FileModificationTime,
+            DatabaseInterface::FirstPlayDate,
+            DatabaseInterface::LastPlayDate,
+            DatabaseInterface::PlayCounter,
+            DatabaseInterface::PlayFrequency,
+            DatabaseInterface::TrackGainRole,
+            DatabaseInterface::TrackPeakRole,
+            DatabaseInterface::AlbumGainRole,
+            DatabaseInterface::AlbumPeakRole,};
+
+    return roles;
+}
+
+static const QVector<DatabaseInterface::ColumnsRoles> &albumDataRoles()
+{
+    static const auto roles = QVector<DatabaseInterface::ColumnsRoles>{
+            DatabaseInterface::DatabaseIdRole,
+            DatabaseInterface::TitleRole,
+            DatabaseInterface::SecondaryTextRole,
+            DatabaseInterface::ImageUrlRole,
+            DatabaseInterface::ArtistRole,
+            DatabaseInterface::AllArtistsRole,
+            DatabaseInterface::HighestTrackRating,
+            DatabaseInterface::IsSingleDiscAlbumRole,
+            DatabaseInterface::GenreRole,};
+
+    return roles;
+}
+
+static const QVector<DatabaseInterface::ColumnsRoles> &artistDataRoles()
+{
+    static const auto roles = QVector<DatabaseInterface::ColumnsRoles>{
+            DatabaseInterface::DatabaseIdRole,
+            DatabaseInterface::TitleRole,
+            DatabaseInterface::GenreRole,};
+
+    return roles;
+}
+
+static const QVector<DatabaseInterface::ColumnsRoles> &genreDataRoles()
+{
+    static const auto roles = QVector<DatabaseInterface::ColumnsRoles>{
+            DatabaseInterface::DatabaseIdRole,
+            DatabaseInterface::TitleRole,};
+
+    return roles;
+}
+
 DatabaseInterface::DatabaseInterface(QObject *parent) : QObject(parent), d(nullptr)
 {
 }
@@ -271,7 +576,7 @@ DatabaseInterface::~DatabaseInterface()
 
 void DatabaseInterface::init(const QString &dbName, const QString &databaseFileName)
 {
-    qInfo() << QCoreApplication::libraryPaths();
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::init" << QCoreApplication::libraryPaths();
     QSqlDatabase tracksDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), dbName);
 
     if (!databaseFileName.isEmpty()) {
@@ -283,11 +588,11 @@ void DatabaseInterface::init(const QString &dbName, const QString &databaseFileN
 
     auto result = tracksDatabase.open();
     if (result) {
-        qDebug() << "database open";
+        qCDebug(orgKdeElisaDatabase) << "database open";
     } else {
-        qDebug() << "database not open";
+        qCWarning(orgKdeElisaDatabase) << "database not open";
     }
-    qDebug() << "DatabaseInterface::init" << (tracksDatabase.driver()->hasFeature(QSqlDriver::Transactions) ? "yes" : "no");
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::init" << (tracksDatabase.driver()->hasFeature(QSqlDriver::Transactions) ? "yes" : "no");
 
     tracksDatabase.exec(QStringLiteral("PRAGMA foreign_keys = ON;"));
 
@@ -299,6 +604,8 @@ void DatabaseInterface::init(const QString &dbName, const QString &databaseFileN
     if (!databaseFileName.isEmpty()) {
         reloadExistingDatabase();
     }
+
+    initNamesCache();
 }
 
 qulonglong DatabaseInterface::albumIdFromTitleAndArtist(const QString &title, const QString &artist)
@@ -501,14 +808,14 @@ DatabaseInterface::ListTrackDataType DatabaseInterface::albumData(qulonglong dat
 
     d->mSelectTrackQuery.bindValue(QStringLiteral(":albumId"), databaseId);
 
-    auto queryResult = d->mSelectTrackQuery.exec();
+    auto queryResult = execQuery(d->mSelectTrackQuery);
 
     if (!queryResult || !d->mSelectTrackQuery.isSelect() || !d->mSelectTrackQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::albumData" << d->mSelectTrackQuery.lastQuery();
-        qDebug() << "DatabaseInterface::albumData" << d->mSelectTrackQuery.boundValues();
-        qDebug() << "DatabaseInterface::albumData" << d->mSelectTrackQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::albumData" << d->mSelectTrackQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::albumData" << d->mSelectTrackQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::albumData" << d->mSelectTrackQuery.lastError();
     }
 
     while (d->mSelectTrackQuery.next()) {
@@ -517,6 +824,8 @@ DatabaseInterface::ListTrackDataType DatabaseInterface::albumData(qulonglong dat
         result.push_back(buildTrackDataFromDatabaseRecord(currentRecord));
     }
 
+    recordQueryRows(d->mSelectTrackQuery, result.size());
+
     d->mSelectTrackQuery.finish();
 
     transactionResult = finishTransaction();
@@ -552,7 +861,7 @@ DatabaseInterface::ListArtistDataType DatabaseInterface::allArtistsData()
 
 DatabaseInterface::ListArtistDataType DatabaseInterface::allArtistsDataByGenre(const QString &genre)
 {
-    qDebug() << "DatabaseInterface::allArtistsDataByGenre" << genre;
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::allArtistsDataByGenre" << genre;
 
     auto result = ListArtistDataType{};
 
@@ -569,7 +878,7 @@ DatabaseInterface::ListArtistDataType DatabaseInterface::allArtistsDataByGenre(c
 
     result = internalAllArtistsPartialData(d->mSelectAllArtistsWithGenreFilterQuery);
 
-    qDebug() << "DatabaseInterface::allArtistsDataByGenre" << result.count();
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::allArtistsDataByGenre" << result.count();
 
     transactionResult = finishTransaction();
     if (!transactionResult) {
@@ -602,6 +911,106 @@ DatabaseInterface::ListGenreDataType DatabaseInterface::allGenresData()
     return result;
 }
 
+QSharedPointer<const DataBlock> DatabaseInterface::allTracksDataBlock()
+{
+    auto stream = DataBlockStream{};
+
+    allTracksDataBlock(stream);
+
+    return stream.result();
+}
+
+void DatabaseInterface::allTracksDataBlock(DataBlockStream &stream)
+{
+    if (!d) {
+        return;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    internalAllTracksDataBlock(stream);
+
+    finishTransaction();
+}
+
+QSharedPointer<const DataBlock> DatabaseInterface::allAlbumsDataBlock()
+{
+    auto stream = DataBlockStream{};
+
+    allAlbumsDataBlock(stream);
+
+    return stream.result();
+}
+
+void DatabaseInterface::allAlbumsDataBlock(DataBlockStream &stream)
+{
+    if (!d) {
+        return;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    internalAllAlbumsDataBlock(d->mSelectAllAlbumsShortQuery, stream);
+
+    finishTransaction();
+}
+
+QSharedPointer<const DataBlock> DatabaseInterface::allArtistsDataBlock()
+{
+    auto stream = DataBlockStream{};
+
+    allArtistsDataBlock(stream);
+
+    return stream.result();
+}
+
+void DatabaseInterface::allArtistsDataBlock(DataBlockStream &stream)
+{
+    if (!d) {
+        return;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    internalAllArtistsDataBlock(d->mSelectAllArtistsQuery, stream);
+
+    finishTransaction();
+}
+
+QSharedPointer<const DataBlock> DatabaseInterface::allGenresDataBlock()
+{
+    auto stream = DataBlockStream{};
+
+    allGenresDataBlock(stream);
+
+    return stream.result();
+}
+
+void DatabaseInterface::allGenresDataBlock(DataBlockStream &stream)
+{
+    if (!d) {
+        return;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    internalAllGenresDataBlock(stream);
+
+    finishTransaction();
+}
+
 DatabaseInterface::DataType DatabaseInterface::oneData(ElisaUtils::PlayListEntryType aType, qulonglong databaseId)
 {
     auto result = DataType{};
@@ -742,6 +1151,22 @@ void DatabaseInterface::applicationAboutToQuit()
     d->mStopRequest = 1;
 }
 
+void DatabaseInterface::setStatistics(DatabaseStatistics *statistics)
+{
+    mStatistics = statistics;
+}
+
+void DatabaseInterface::measureQueueLatency(qint64 postedTimeStamp)
+{
+    if (!mStatistics) {
+        return;
+    }
+
+    const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    mStatistics->recordQueueLatency(now - postedTimeStamp);
+}
+
 void DatabaseInterface::removeAllTracksFromSource(const QString &sourceName)
 {
     auto transactionResult = startTransaction();
@@ -765,6 +1190,10 @@ void DatabaseInterface::removeAllTracksFromSource(const QString &sourceName)
         Q_EMIT artistsAdded(newArtists);
     }
 
+    for (auto trackId : qAsConst(d->mModifiedTrackIds)) {
+        Q_EMIT trackModified(internalOneTrackPartialData(trackId));
+    }
+
     transactionResult = finishTransaction();
     if (!transactionResult) {
         return;
@@ -778,8 +1207,10 @@ void DatabaseInterface::askRestoredTracks(const QString &musicSource)
         return;
     }
 
-    auto result = internalAllFileNameFromSource(internalSourceIdFromName(musicSource));
+    auto fileSizes = QHash<QUrl, qint64>{};
+    auto result = internalAllFileNameFromSource(internalSourceIdFromName(musicSource), &fileSizes);
 
+    Q_EMIT restoredFileSizes(musicSource, fileSizes);
     Q_EMIT restoredTracks(musicSource, result);
 
     transactionResult = finishTransaction();
@@ -806,6 +1237,90 @@ void DatabaseInterface::trackHasStartedPlaying(const QUrl &fileName, const QDate
     }
 }
 
+void DatabaseInterface::askTracksWithoutLoudness()
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    auto result = ListTrackDataType{};
+
+    if (!internalGenericPartialData(d->mSelectTracksWithoutLoudnessQuery)) {
+        return;
+    }
+
+    while(d->mSelectTracksWithoutLoudnessQuery.next()) {
+        const auto &currentRecord = d->mSelectTracksWithoutLoudnessQuery.record();
+
+        result.push_back({{DatabaseIdRole, currentRecord.value(0)},
+                          {AlbumIdRole, currentRecord.value(1)},
+                          {ResourceRole, currentRecord.value(2)},});
+    }
+
+    d->mSelectTracksWithoutLoudnessQuery.finish();
+
+    Q_EMIT tracksWithoutLoudness(result);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+}
+
+void DatabaseInterface::updateTracksLoudness(const ListTrackDataType &tracks)
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    initChangesTrackers();
+
+    auto modifiedAlbumIds = QSet<qulonglong>{};
+
+    for (const auto &oneTrack : tracks) {
+        d->mUpdateTrackLoudnessQuery.bindValue(QStringLiteral(":trackId"), oneTrack.databaseId());
+        d->mUpdateTrackLoudnessQuery.bindValue(QStringLiteral(":trackGain"), oneTrack[TrackGainRole]);
+        d->mUpdateTrackLoudnessQuery.bindValue(QStringLiteral(":trackPeak"), oneTrack[TrackPeakRole]);
+
+        auto queryResult = execQuery(d->mUpdateTrackLoudnessQuery);
+
+        if (!queryResult || !d->mUpdateTrackLoudnessQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateTracksLoudness" << d->mUpdateTrackLoudnessQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateTracksLoudness" << d->mUpdateTrackLoudnessQuery.boundValues();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateTracksLoudness" << d->mUpdateTrackLoudnessQuery.lastError();
+
+            d->mUpdateTrackLoudnessQuery.finish();
+
+            continue;
+        }
+
+        d->mUpdateTrackLoudnessQuery.finish();
+
+        recordModifiedTrack(oneTrack.databaseId());
+
+        if (oneTrack.contains(AlbumIdRole) && !oneTrack[AlbumIdRole].isNull()) {
+            modifiedAlbumIds.insert(oneTrack[AlbumIdRole].toULongLong());
+        }
+    }
+
+    for (auto albumId : qAsConst(modifiedAlbumIds)) {
+        updateAlbumLoudness(albumId);
+    }
+
+    for (auto trackId : qAsConst(d->mModifiedTrackIds)) {
+        Q_EMIT trackModified(internalOneTrackPartialData(trackId));
+    }
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+}
+
 void DatabaseInterface::initChangesTrackers()
 {
     d->mModifiedTrackIds.clear();
@@ -832,6 +1347,9 @@ void DatabaseInterface::insertTracksList(const QList<MusicAudioTrack> &tracks, c
         return;
     }
 
+    QElapsedTimer transactionTimer;
+    transactionTimer.start();
+
     auto transactionResult = startTransaction();
     if (!transactionResult) {
         return;
@@ -839,36 +1357,20 @@ void DatabaseInterface::insertTracksList(const QList<MusicAudioTrack> &tracks, c
 
     initChangesTrackers();
 
-    for(const auto &oneTrack : tracks) {
-        d->mSelectTracksMapping.bindValue(QStringLiteral(":fileName"), oneTrack.resourceURI());
-
-        auto result = d->mSelectTracksMapping.exec();
-
-        if (!result || !d->mSelectTracksMapping.isSelect() || !d->mSelectTracksMapping.isActive()) {
-            Q_EMIT databaseError();
-
-            qDebug() << "DatabaseInterface::insertTracksList" << d->mSelectTracksMapping.lastQuery();
-            qDebug() << "DatabaseInterface::insertTracksList" << d->mSelectTracksMapping.boundValues();
-            qDebug() << "DatabaseInterface::insertTracksList" << d->mSelectTracksMapping.lastError();
-
-            d->mSelectTracksMapping.finish();
-
-            rollBackTransaction();
-            return;
-        }
+    loadTrackDuplicatesIndex();
 
-        bool isNewTrack = !d->mSelectTracksMapping.next();
+    for(const auto &oneTrack : tracks) {
+        const auto itTrackFile = d->mTrackFiles.constFind(oneTrack.resourceURI().toString());
+        const bool isNewTrack = (itTrackFile == d->mTrackFiles.constEnd());
 
         if (isNewTrack) {
             insertTrackOrigin(oneTrack.resourceURI(), oneTrack.fileModificationTime(), insertMusicSource(musicSource));
-        } else if (!d->mSelectTracksMapping.record().value(0).isNull() && d->mSelectTracksMapping.record().value(0).toULongLong() != 0) {
-            updateTrackOrigin(d->mSelectTracksMapping.record().value(0).toULongLong(), oneTrack.resourceURI(), oneTrack.fileModificationTime());
+        } else if (itTrackFile->mTrackId != 0) {
+            updateTrackOrigin(itTrackFile->mTrackId, oneTrack.resourceURI(), oneTrack.fileModificationTime());
         } else {
             continue;
         }
 
-        d->mSelectTracksMapping.finish();
-
         const auto insertedTrackId = internalInsertTrack(oneTrack, covers, 0,
                                                          (isNewTrack ? TrackFileInsertType::NewTrackFileInsert : TrackFileInsertType::ModifiedTrackFileInsert));
 
@@ -891,7 +1393,7 @@ void DatabaseInterface::insertTracksList(const QList<MusicAudioTrack> &tracks, c
         for (auto artistId : qAsConst(d->mInsertedArtists)) {
             newArtists.push_back({{DatabaseIdRole, artistId}});
         }
-        qInfo() << "artistsAdded" << newArtists.size();
+        qCInfo(orgKdeElisaDatabase) << "artistsAdded" << newArtists.size();
         Q_EMIT artistsAdded(newArtists);
     }
 
@@ -903,7 +1405,7 @@ void DatabaseInterface::insertTracksList(const QList<MusicAudioTrack> &tracks, c
             newAlbums.push_back(internalOneAlbumPartialData(albumId));
         }
 
-        qInfo() << "albumsAdded" << newAlbums.size();
+        qCInfo(orgKdeElisaDatabase) << "albumsAdded" << newAlbums.size();
         Q_EMIT albumsAdded(newAlbums);
     }
 
@@ -919,7 +1421,7 @@ void DatabaseInterface::insertTracksList(const QList<MusicAudioTrack> &tracks, c
             d->mModifiedTrackIds.remove(trackId);
         }
 
-        qInfo() << "tracksAdded" << newTracks.size();
+        qCInfo(orgKdeElisaDatabase) << "tracksAdded" << newTracks.size();
         Q_EMIT tracksAdded(newTracks);
     }
 
@@ -928,6 +1430,9 @@ void DatabaseInterface::insertTracksList(const QList<MusicAudioTrack> &tracks, c
     }
 
     transactionResult = finishTransaction();
+
+    recordTransaction(QStringLiteral("insertTracksList"), transactionTimer, tracks.size());
+
     if (!transactionResult) {
         return;
     }
@@ -935,6 +1440,9 @@ void DatabaseInterface::insertTracksList(const QList<MusicAudioTrack> &tracks, c
 
 void DatabaseInterface::removeTracksList(const QList<QUrl> &removedTracks)
 {
+    QElapsedTimer transactionTimer;
+    transactionTimer.start();
+
     auto transactionResult = startTransaction();
     if (!transactionResult) {
         return;
@@ -952,7 +1460,189 @@ void DatabaseInterface::removeTracksList(const QList<QUrl> &removedTracks)
         Q_EMIT artistsAdded(newArtists);
     }
 
+    for (auto trackId : qAsConst(d->mModifiedTrackIds)) {
+        Q_EMIT trackModified(internalOneTrackPartialData(trackId));
+    }
+
+    transactionResult = finishTransaction();
+
+    recordTransaction(QStringLiteral("removeTracksList"), transactionTimer, removedTracks.size());
+
+    if (!transactionResult) {
+        return;
+    }
+}
+
+void DatabaseInterface::renameTracksList(const QHash<QUrl, QUrl> &renamedTracks, const QHash<QString, QUrl> &covers)
+{
+    QElapsedTimer transactionTimer;
+    transactionTimer.start();
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    initChangesTrackers();
+
+    auto replacedTracks = QList<QUrl>();
+
+    for (auto itRenamedTrack = renamedTracks.begin(); itRenamedTrack != renamedTracks.end(); ++itRenamedTrack) {
+        const auto trackId = internalTrackIdFromFileName(itRenamedTrack.key());
+        if (trackId == 0) {
+            continue;
+        }
+
+        // the renamed file may replace a file already known under its new name
+        if (internalTrackIdFromFileName(itRenamedTrack.value()) != 0) {
+            replacedTracks.push_back(itRenamedTrack.value());
+        }
+    }
+
+    if (!replacedTracks.isEmpty()) {
+        internalRemoveTracksList(replacedTracks);
+    }
+
+    auto movedFromAlbums = QSet<qulonglong>();
+
+    for (auto itRenamedTrack = renamedTracks.begin(); itRenamedTrack != renamedTracks.end(); ++itRenamedTrack) {
+        const auto trackId = internalTrackIdFromFileName(itRenamedTrack.key());
+        if (trackId == 0) {
+            continue;
+        }
+
+        d->mRenameTrackMapping.bindValue(QStringLiteral(":oldFileName"), itRenamedTrack.key().toString());
+        d->mRenameTrackMapping.bindValue(QStringLiteral(":newFileName"), itRenamedTrack.value().toString());
+
+        auto result = execQuery(d->mRenameTrackMapping);
+
+        if (!result || !d->mRenameTrackMapping.isActive()) {
+            Q_EMIT databaseError();
+
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::renameTracksList" << d->mRenameTrackMapping.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::renameTracksList" << d->mRenameTrackMapping.boundValues();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::renameTracksList" << d->mRenameTrackMapping.lastError();
+
+            d->mRenameTrackMapping.finish();
+
+            continue;
+        }
+
+        d->mRenameTrackMapping.finish();
+
+        if (d->mTrackDuplicatesLoaded) {
+            d->renameTrackFile(itRenamedTrack.key().toString(), itRenamedTrack.value().toString());
+        }
+
+        // the album of a track is the one of its directory
+        if (itRenamedTrack.key().adjusted(QUrl::RemoveFilename) != itRenamedTrack.value().adjusted(QUrl::RemoveFilename)) {
+            const auto oldAlbumId = moveTrackToDirectory(trackId, itRenamedTrack.value(), covers);
+
+            if (oldAlbumId != 0) {
+                movedFromAlbums.insert(oldAlbumId);
+            }
+        }
+
+        recordModifiedTrack(trackId);
+    }
+
+    for (auto oldAlbumId : qAsConst(movedFromAlbums)) {
+        if (!fetchTrackIds(oldAlbumId).isEmpty()) {
+            recordModifiedAlbum(oldAlbumId);
+            continue;
+        }
+
+        d->mModifiedAlbumIds.remove(oldAlbumId);
+        d->mInsertedAlbums.remove(oldAlbumId);
+
+        removeAlbumInDatabase(oldAlbumId);
+        Q_EMIT albumRemoved(oldAlbumId);
+    }
+
+    if (!d->mInsertedArtists.isEmpty()) {
+        ListArtistDataType newArtists;
+
+        for (auto artistId : qAsConst(d->mInsertedArtists)) {
+            newArtists.push_back({{DatabaseIdRole, artistId}});
+        }
+
+        Q_EMIT artistsAdded(newArtists);
+    }
+
+    if (!d->mInsertedAlbums.isEmpty()) {
+        ListAlbumDataType newAlbums;
+
+        for (auto albumId : qAsConst(d->mInsertedAlbums)) {
+            d->mModifiedAlbumIds.remove(albumId);
+            newAlbums.push_back(internalOneAlbumPartialData(albumId));
+        }
+
+        Q_EMIT albumsAdded(newAlbums);
+    }
+
+    for (auto albumId : qAsConst(d->mModifiedAlbumIds)) {
+        Q_EMIT albumModified({{DatabaseIdRole, albumId}}, albumId);
+    }
+
+    for (auto trackId : qAsConst(d->mModifiedTrackIds)) {
+        Q_EMIT trackModified(internalOneTrackPartialData(trackId));
+    }
+
+    transactionResult = finishTransaction();
+
+    recordTransaction(QStringLiteral("renameTracksList"), transactionTimer, renamedTracks.size());
+
+    if (!transactionResult) {
+        return;
+    }
+}
+
+void DatabaseInterface::setTracksEmbeddedCover(const QList<QUrl> &tracksWithEmbeddedCover)
+{
+    QElapsedTimer transactionTimer;
+    transactionTimer.start();
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    initChangesTrackers();
+
+    for (const auto &oneTrackFile : tracksWithEmbeddedCover) {
+        const auto trackId = internalTrackIdFromFileName(oneTrackFile);
+        if (trackId == 0) {
+            continue;
+        }
+
+        d->mUpdateTrackEmbeddedCover.bindValue(QStringLiteral(":trackId"), trackId);
+        d->mUpdateTrackEmbeddedCover.bindValue(QStringLiteral(":hasEmbeddedCover"), true);
+
+        auto result = execQuery(d->mUpdateTrackEmbeddedCover);
+
+        if (!result || !d->mUpdateTrackEmbeddedCover.isActive()) {
+            Q_EMIT databaseError();
+
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::setTracksEmbeddedCover" << d->mUpdateTrackEmbeddedCover.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::setTracksEmbeddedCover" << d->mUpdateTrackEmbeddedCover.boundValues();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::setTracksEmbeddedCover" << d->mUpdateTrackEmbeddedCover.lastError();
+
+            continue;
+        }
+
+        d->mUpdateTrackEmbeddedCover.finish();
+
+        recordModifiedTrack(trackId);
+    }
+
+    for (auto trackId : qAsConst(d->mModifiedTrackIds)) {
+        Q_EMIT trackModified(internalOneTrackPartialData(trackId));
+    }
+
     transactionResult = finishTransaction();
+
+    recordTransaction(QStringLiteral("setTracksEmbeddedCover"), transactionTimer, tracksWithEmbeddedCover.size());
+
     if (!transactionResult) {
         return;
     }
@@ -961,6 +1651,9 @@ void DatabaseInterface::removeTracksList(const QList<QUrl> &removedTracks)
 void DatabaseInterface::modifyTracksList(const QList<MusicAudioTrack> &modifiedTracks, const QHash<QString, QUrl> &covers,
                                          const QString &musicSource)
 {
+    QElapsedTimer transactionTimer;
+    transactionTimer.start();
+
     auto transactionResult = startTransaction();
     if (!transactionResult) {
         return;
@@ -1036,6 +1729,9 @@ void DatabaseInterface::modifyTracksList(const QList<MusicAudioTrack> &modifiedT
     }
 
     transactionResult = finishTransaction();
+
+    recordTransaction(QStringLiteral("modifyTracksList"), transactionTimer, modifiedTracks.size());
+
     if (!transactionResult) {
         return;
     }
@@ -1047,7 +1743,7 @@ bool DatabaseInterface::startTransaction() const
 
     auto transactionResult = d->mTracksDatabase.transaction();
     if (!transactionResult) {
-        qDebug() << "transaction failed" << d->mTracksDatabase.lastError() << d->mTracksDatabase.lastError().driverText();
+        qCWarning(orgKdeElisaDatabase) << "transaction failed" << d->mTracksDatabase.lastError() << d->mTracksDatabase.lastError().driverText();
 
         return result;
     }
@@ -1064,7 +1760,9 @@ bool DatabaseInterface::finishTransaction() const
     auto transactionResult = d->mTracksDatabase.commit();
 
     if (!transactionResult) {
-        qDebug() << "commit failed" << d->mTracksDatabase.lastError() << d->mTracksDatabase.lastError().nativeErrorCode();
+        d->clearTrackDuplicates();
+
+        qCWarning(orgKdeElisaDatabase) << "commit failed" << d->mTracksDatabase.lastError() << d->mTracksDatabase.lastError().nativeErrorCode();
 
         return result;
     }
@@ -1078,10 +1776,16 @@ bool DatabaseInterface::rollBackTransaction() const
 {
     auto result = false;
 
+    d->mArtistIds.clear();
+    d->mComposerIds.clear();
+    d->mLyricistIds.clear();
+    d->mGenreIds.clear();
+    d->clearTrackDuplicates();
+
     auto transactionResult = d->mTracksDatabase.rollback();
 
     if (!transactionResult) {
-        qDebug() << "commit failed" << d->mTracksDatabase.lastError() << d->mTracksDatabase.lastError().nativeErrorCode();
+        qCWarning(orgKdeElisaDatabase) << "commit failed" << d->mTracksDatabase.lastError() << d->mTracksDatabase.lastError().nativeErrorCode();
 
         return result;
     }
@@ -1100,7 +1804,10 @@ void DatabaseInterface::initDatabase()
 
     auto listTables = d->mTracksDatabase.tables();
 
-    if (!listTables.contains(QStringLiteral("DatabaseVersionV9"))) {
+    if (!listTables.contains(QStringLiteral("DatabaseVersionV12")) &&
+            !listTables.contains(QStringLiteral("DatabaseVersionV11")) &&
+            !listTables.contains(QStringLiteral("DatabaseVersionV10")) &&
+            !listTables.contains(QStringLiteral("DatabaseVersionV9"))) {
         auto oldTables = QStringList{
                 QStringLiteral("DatabaseVersionV2"),
                 QStringLiteral("DatabaseVersionV3"),
@@ -1129,8 +1836,8 @@ void DatabaseInterface::initDatabase()
             auto result = createSchemaQuery.exec(QStringLiteral("DROP TABLE ") + oneTable);
 
             if (!result) {
-                qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
-                qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
+                qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
+                qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
 
                 Q_EMIT databaseError();
             }
@@ -1139,14 +1846,47 @@ void DatabaseInterface::initDatabase()
         listTables = d->mTracksDatabase.tables();
     }
 
-    if (!listTables.contains(QStringLiteral("DatabaseVersionV9"))) {
+    if (listTables.contains(QStringLiteral("DatabaseVersionV9")) &&
+            !listTables.contains(QStringLiteral("DatabaseVersionV10"))) {
+        if (!upgradeDatabaseV9()) {
+            rollBackTransaction();
+
+            return;
+        }
+
+        listTables = d->mTracksDatabase.tables();
+    }
+
+    if (listTables.contains(QStringLiteral("DatabaseVersionV10")) &&
+            !listTables.contains(QStringLiteral("DatabaseVersionV11"))) {
+        if (!upgradeDatabaseV10()) {
+            rollBackTransaction();
+
+            return;
+        }
+
+        listTables = d->mTracksDatabase.tables();
+    }
+
+    if (listTables.contains(QStringLiteral("DatabaseVersionV11")) &&
+            !listTables.contains(QStringLiteral("DatabaseVersionV12"))) {
+        if (!upgradeDatabaseV11()) {
+            rollBackTransaction();
+
+            return;
+        }
+
+        listTables = d->mTracksDatabase.tables();
+    }
+
+    if (!listTables.contains(QStringLiteral("DatabaseVersionV12"))) {
         QSqlQuery createSchemaQuery(d->mTracksDatabase);
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `DatabaseVersionV9` (`Version` INTEGER PRIMARY KEY NOT NULL)"));
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `DatabaseVersionV12` (`Version` INTEGER PRIMARY KEY NOT NULL)"));
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1160,8 +1900,8 @@ void DatabaseInterface::initDatabase()
                                                                    "UNIQUE (`Name`))"));
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1175,8 +1915,8 @@ void DatabaseInterface::initDatabase()
                                                                    "UNIQUE (`Name`))"));
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1190,8 +1930,8 @@ void DatabaseInterface::initDatabase()
                                                                    "UNIQUE (`Name`))"));
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1205,8 +1945,8 @@ void DatabaseInterface::initDatabase()
                                                                    "UNIQUE (`Name`))"));
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1220,8 +1960,8 @@ void DatabaseInterface::initDatabase()
                                                                    "UNIQUE (`Name`))"));
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1242,8 +1982,8 @@ void DatabaseInterface::initDatabase()
                                                                    "ON DELETE CASCADE)"));
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
         }
     }
 
@@ -1254,14 +1994,17 @@ void DatabaseInterface::initDatabase()
                                                                    "`ID` INTEGER PRIMARY KEY NOT NULL, "
                                                                    "`Title` VARCHAR(85) NOT NULL, "
                                                                    "`ArtistName` VARCHAR(55), "
+                                                                   "`ArtistID` INTEGER, "
                                                                    "`AlbumTitle` VARCHAR(55), "
                                                                    "`AlbumArtistName` VARCHAR(55), "
                                                                    "`AlbumPath` VARCHAR(255), "
+                                                                   "`AlbumID` INTEGER, "
                                                                    "`TrackNumber` INTEGER DEFAULT -1, "
                                                                    "`DiscNumber` INTEGER DEFAULT -1, "
                                                                    "`Duration` INTEGER NOT NULL, "
                                                                    "`Rating` INTEGER NOT NULL DEFAULT 0, "
                                                                    "`Genre` VARCHAR(55), "
+                                                                   "`GenreID` INTEGER, "
                                                                    "`Composer` VARCHAR(55), "
                                                                    "`Lyricist` VARCHAR(55), "
                                                                    "`Comment` VARCHAR(255) DEFAULT '', "
@@ -1274,6 +2017,10 @@ void DatabaseInterface::initDatabase()
                                                                    "`FirstPlayDate` INTEGER, "
                                                                    "`LastPlayDate` INTEGER, "
                                                                    "`PlayCounter` INTEGER NOT NULL, "
+                                                                   "`TrackGain` REAL, "
+                                                                   "`TrackPeak` REAL, "
+                                                                   "`AlbumGain` REAL, "
+                                                                   "`AlbumPeak` REAL, "
                                                                    "UNIQUE ("
                                                                    "`Title`, `AlbumTitle`, `AlbumArtistName`, "
                                                                    "`AlbumPath`, `TrackNumber`, `DiscNumber`"
@@ -1282,35 +2029,103 @@ void DatabaseInterface::initDatabase()
                                                                    "CONSTRAINT fk_tracks_composer FOREIGN KEY (`Composer`) REFERENCES `Composer`(`Name`), "
                                                                    "CONSTRAINT fk_tracks_lyricist FOREIGN KEY (`Lyricist`) REFERENCES `Lyricist`(`Name`), "
                                                                    "CONSTRAINT fk_tracks_genre FOREIGN KEY (`Genre`) REFERENCES `Genre`(`Name`), "
+                                                                   "CONSTRAINT fk_tracks_artist_id FOREIGN KEY (`ArtistID`) REFERENCES `Artists`(`ID`), "
+                                                                   "CONSTRAINT fk_tracks_album_id FOREIGN KEY (`AlbumID`) REFERENCES `Albums`(`ID`), "
+                                                                   "CONSTRAINT fk_tracks_genre_id FOREIGN KEY (`GenreID`) REFERENCES `Genre`(`ID`), "
                                                                    "CONSTRAINT fk_tracks_album FOREIGN KEY ("
                                                                    "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"
                                                                    "REFERENCES `Albums`(`Title`, `ArtistName`, `AlbumPath`))"));
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    if (!listTables.contains(QStringLiteral("TracksMapping"))) {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `TracksMapping` ("
+                                                                   "`TrackID` INTEGER NULL, "
+                                                                   "`DiscoverID` INTEGER NOT NULL, "
+                                                                   "`FileName` VARCHAR(255) NOT NULL, "
+                                                                   "`Priority` INTEGER NOT NULL, "
+                                                                   "`FileModifiedTime` DATETIME NOT NULL, "
+                                                                   "`FileSize` INTEGER, "
+                                                                   "PRIMARY KEY (`FileName`), "
+                                                                   "CONSTRAINT TracksUnique UNIQUE (`TrackID`, `Priority`), "
+                                                                   "CONSTRAINT fk_tracksmapping_trackID FOREIGN KEY (`TrackID`) REFERENCES `Tracks`(`ID`) ON DELETE CASCADE, "
+                                                                   "CONSTRAINT fk_tracksmapping_discoverID FOREIGN KEY (`DiscoverID`) REFERENCES `DiscoverSource`(`ID`))"));
+
+        if (!result) {
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`TitleAlbumsIndex` ON `Albums` "
+                                                                  "(`Title`)"));
+
+        if (!result) {
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createTrackIndex.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`ArtistNameAlbumsIndex` ON `Albums` "
+                                                                  "(`ArtistName`)"));
+
+        if (!result) {
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createTrackIndex.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`TracksAlbumIndex` ON `Tracks` "
+                                                                  "(`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"));
+
+        if (!result) {
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createTrackIndex.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createTrackIndex.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
-    if (!listTables.contains(QStringLiteral("TracksMapping"))) {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `TracksMapping` ("
-                                                                   "`TrackID` INTEGER NULL, "
-                                                                   "`DiscoverID` INTEGER NOT NULL, "
-                                                                   "`FileName` VARCHAR(255) NOT NULL, "
-                                                                   "`Priority` INTEGER NOT NULL, "
-                                                                   "`FileModifiedTime` DATETIME NOT NULL, "
-                                                                   "PRIMARY KEY (`FileName`), "
-                                                                   "CONSTRAINT TracksUnique UNIQUE (`TrackID`, `Priority`), "
-                                                                   "CONSTRAINT fk_tracksmapping_trackID FOREIGN KEY (`TrackID`) REFERENCES `Tracks`(`ID`) ON DELETE CASCADE, "
-                                                                   "CONSTRAINT fk_tracksmapping_discoverID FOREIGN KEY (`DiscoverID`) REFERENCES `DiscoverSource`(`ID`))"));
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`ArtistNameIndex` ON `Tracks` "
+                                                                  "(`ArtistName`)"));
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createTrackIndex.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
         }
     }
 
@@ -1319,12 +2134,12 @@ void DatabaseInterface::initDatabase()
 
         const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
                                                                   "IF NOT EXISTS "
-                                                                  "`TitleAlbumsIndex` ON `Albums` "
-                                                                  "(`Title`)"));
+                                                                  "`AlbumArtistNameIndex` ON `Tracks` "
+                                                                  "(`AlbumArtistName`)"));
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initDatabase" << createTrackIndex.lastQuery();
-            qDebug() << "DatabaseInterface::initDatabase" << createTrackIndex.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createTrackIndex.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createTrackIndex.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1335,12 +2150,12 @@ void DatabaseInterface::initDatabase()
 
         const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
                                                                   "IF NOT EXISTS "
-                                                                  "`ArtistNameAlbumsIndex` ON `Albums` "
-                                                                  "(`ArtistName`)"));
+                                                                  "`TracksFileNameIndex` ON `TracksMapping` "
+                                                                  "(`FileName`)"));
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initDatabase" << createTrackIndex.lastQuery();
-            qDebug() << "DatabaseInterface::initDatabase" << createTrackIndex.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createTrackIndex.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createTrackIndex.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1351,12 +2166,12 @@ void DatabaseInterface::initDatabase()
 
         const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
                                                                   "IF NOT EXISTS "
-                                                                  "`TracksAlbumIndex` ON `Tracks` "
-                                                                  "(`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"));
+                                                                  "`TracksAlbumIDIndex` ON `Tracks` "
+                                                                  "(`AlbumID`)"));
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initDatabase" << createTrackIndex.lastQuery();
-            qDebug() << "DatabaseInterface::initDatabase" << createTrackIndex.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createTrackIndex.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createTrackIndex.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1367,12 +2182,12 @@ void DatabaseInterface::initDatabase()
 
         const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
                                                                   "IF NOT EXISTS "
-                                                                  "`ArtistNameIndex` ON `Tracks` "
-                                                                  "(`ArtistName`)"));
+                                                                  "`TracksArtistIDIndex` ON `Tracks` "
+                                                                  "(`ArtistID`)"));
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initDatabase" << createTrackIndex.lastQuery();
-            qDebug() << "DatabaseInterface::initDatabase" << createTrackIndex.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createTrackIndex.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createTrackIndex.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1383,12 +2198,12 @@ void DatabaseInterface::initDatabase()
 
         const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
                                                                   "IF NOT EXISTS "
-                                                                  "`AlbumArtistNameIndex` ON `Tracks` "
-                                                                  "(`AlbumArtistName`)"));
+                                                                  "`TracksGenreIDIndex` ON `Tracks` "
+                                                                  "(`GenreID`)"));
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initDatabase" << createTrackIndex.lastQuery();
-            qDebug() << "DatabaseInterface::initDatabase" << createTrackIndex.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createTrackIndex.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createTrackIndex.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1399,12 +2214,12 @@ void DatabaseInterface::initDatabase()
 
         const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
                                                                   "IF NOT EXISTS "
-                                                                  "`TracksFileNameIndex` ON `TracksMapping` "
-                                                                  "(`FileName`)"));
+                                                                  "`TracksTitleNoCaseIndex` ON `Tracks` "
+                                                                  "(`Title` COLLATE NOCASE)"));
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initDatabase" << createTrackIndex.lastQuery();
-            qDebug() << "DatabaseInterface::initDatabase" << createTrackIndex.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createTrackIndex.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createTrackIndex.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1416,6 +2231,151 @@ void DatabaseInterface::initDatabase()
     }
 }
 
+QStringList DatabaseInterface::tableColumnNames(const QString &tableName) const
+{
+    auto result = QStringList();
+
+    QSqlQuery tableInfoQuery(d->mTracksDatabase);
+
+    if (!tableInfoQuery.exec(QStringLiteral("PRAGMA table_info(`") + tableName + QStringLiteral("`)"))) {
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::tableColumnNames" << tableInfoQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::tableColumnNames" << tableInfoQuery.lastError();
+
+        return result;
+    }
+
+    while (tableInfoQuery.next()) {
+        result.push_back(tableInfoQuery.record().value(QStringLiteral("name")).toString());
+    }
+
+    return result;
+}
+
+bool DatabaseInterface::upgradeDatabaseV9()
+{
+    qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << "upgrade database schema to version 10";
+
+    /* older builds committed the upgrade even when it failed half way, only add the columns still missing */
+    const auto existingColumns = tableColumnNames(QStringLiteral("Tracks"));
+
+    auto upgradeQueries = QStringList{};
+
+    if (!existingColumns.contains(QStringLiteral("ArtistID"))) {
+        upgradeQueries.push_back(QStringLiteral("ALTER TABLE `Tracks` ADD COLUMN `ArtistID` INTEGER REFERENCES `Artists`(`ID`)"));
+    }
+
+    if (!existingColumns.contains(QStringLiteral("AlbumID"))) {
+        upgradeQueries.push_back(QStringLiteral("ALTER TABLE `Tracks` ADD COLUMN `AlbumID` INTEGER REFERENCES `Albums`(`ID`)"));
+    }
+
+    if (!existingColumns.contains(QStringLiteral("GenreID"))) {
+        upgradeQueries.push_back(QStringLiteral("ALTER TABLE `Tracks` ADD COLUMN `GenreID` INTEGER REFERENCES `Genre`(`ID`)"));
+    }
+
+    upgradeQueries += QStringList{
+            QStringLiteral("UPDATE `Tracks` "
+                           "SET "
+                           "`ArtistID` = (SELECT artists.`ID` FROM `Artists` artists WHERE artists.`Name` = `Tracks`.`ArtistName`), "
+                           "`GenreID` = (SELECT genres.`ID` FROM `Genre` genres WHERE genres.`Name` = `Tracks`.`Genre`), "
+                           "`AlbumID` = ("
+                           "SELECT album.`ID` "
+                           "FROM `Albums` album "
+                           "WHERE "
+                           "album.`Title` = `Tracks`.`AlbumTitle` AND "
+                           "(album.`ArtistName` = `Tracks`.`AlbumArtistName` OR `Tracks`.`AlbumArtistName` IS NULL) AND "
+                           "album.`AlbumPath` = `Tracks`.`AlbumPath` "
+                           "ORDER BY (album.`ArtistName` IS `Tracks`.`AlbumArtistName`) DESC, album.`ID` "
+                           "LIMIT 1"
+                           ")"),
+            QStringLiteral("CREATE TABLE `DatabaseVersionV10` (`Version` INTEGER PRIMARY KEY NOT NULL)"),
+            QStringLiteral("DROP TABLE `DatabaseVersionV9`"),};
+
+    for (const auto &oneQuery : upgradeQueries) {
+        QSqlQuery upgradeSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = upgradeSchemaQuery.exec(oneQuery);
+
+        if (!result) {
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << upgradeSchemaQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << upgradeSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool DatabaseInterface::upgradeDatabaseV10()
+{
+    qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV10" << "upgrade database schema to version 11";
+
+    const auto existingColumns = tableColumnNames(QStringLiteral("Tracks"));
+
+    auto upgradeQueries = QStringList{};
+
+    for (const auto &oneColumn : {QStringLiteral("TrackGain"), QStringLiteral("TrackPeak"), QStringLiteral("AlbumGain"), QStringLiteral("AlbumPeak")}) {
+        if (!existingColumns.contains(oneColumn)) {
+            upgradeQueries.push_back(QStringLiteral("ALTER TABLE `Tracks` ADD COLUMN `") + oneColumn + QStringLiteral("` REAL"));
+        }
+    }
+
+    upgradeQueries += QStringList{
+            QStringLiteral("CREATE TABLE `DatabaseVersionV11` (`Version` INTEGER PRIMARY KEY NOT NULL)"),
+            QStringLiteral("DROP TABLE `DatabaseVersionV10`"),};
+
+    for (const auto &oneQuery : upgradeQueries) {
+        QSqlQuery upgradeSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = upgradeSchemaQuery.exec(oneQuery);
+
+        if (!result) {
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV10" << upgradeSchemaQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV10" << upgradeSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool DatabaseInterface::upgradeDatabaseV11()
+{
+    qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << "upgrade database schema to version 12";
+
+    auto upgradeQueries = QStringList{};
+
+    if (!tableColumnNames(QStringLiteral("TracksMapping")).contains(QStringLiteral("FileSize"))) {
+        upgradeQueries.push_back(QStringLiteral("ALTER TABLE `TracksMapping` ADD COLUMN `FileSize` INTEGER"));
+    }
+
+    upgradeQueries += QStringList{
+            QStringLiteral("CREATE TABLE `DatabaseVersionV12` (`Version` INTEGER PRIMARY KEY NOT NULL)"),
+            QStringLiteral("DROP TABLE `DatabaseVersionV11`"),};
+
+    for (const auto &oneQuery : upgradeQueries) {
+        QSqlQuery upgradeSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = upgradeSchemaQuery.exec(oneQuery);
+
+        if (!result) {
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << upgradeSchemaQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << upgradeSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void DatabaseInterface::initRequest()
 {
     auto transactionResult = startTransaction();
@@ -1437,13 +2397,7 @@ void DatabaseInterface::initRequest()
                                                    "FROM "
                                                    "`Tracks` tracks3 "
                                                    "WHERE "
-                                                   "tracks3.`AlbumTitle` = album.`Title` AND "
-                                                   "(tracks3.`AlbumArtistName` = album.`ArtistName` OR "
-                                                   "(tracks3.`AlbumArtistName` IS NULL AND "
-                                                   "album.`ArtistName` IS NULL"
-                                                   ")"
-                                                   ") AND "
-                                                   "tracks3.`AlbumPath` = album.`AlbumPath` "
+                                                   "tracks3.`AlbumID` = album.`ID` "
                                                    ") as `TracksCount`, "
                                                    "("
                                                    "SELECT "
@@ -1451,13 +2405,7 @@ void DatabaseInterface::initRequest()
                                                    "FROM "
                                                    "`Tracks` tracks2 "
                                                    "WHERE "
-                                                   "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                   "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                   "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                   "album.`ArtistName` IS NULL"
-                                                   ")"
-                                                   ") AND "
-                                                   "tracks2.`AlbumPath` = album.`AlbumPath` "
+                                                   "tracks2.`AlbumID` = album.`ID` "
                                                    ") as `IsSingleDiscAlbum`, "
                                                    "GROUP_CONCAT(tracks.`ArtistName`, ', ') as AllArtists, "
                                                    "MAX(tracks.`Rating`) as HighestRating, "
@@ -1465,17 +2413,9 @@ void DatabaseInterface::initRequest()
                                                    "FROM "
                                                    "`Albums` album LEFT JOIN "
                                                    "`Tracks` tracks ON "
-                                                   "tracks.`AlbumTitle` = album.`Title` AND "
-                                                   "("
-                                                   "tracks.`AlbumArtistName` = album.`ArtistName` OR "
-                                                   "("
-                                                   "tracks.`AlbumArtistName` IS NULL AND "
-                                                   "album.`ArtistName` IS NULL"
-                                                   ")"
-                                                   ") AND "
-                                                   "tracks.`AlbumPath` = album.`AlbumPath`"
+                                                   "tracks.`AlbumID` = album.`ID` "
                                                    "LEFT JOIN "
-                                                   "`Genre` genres ON tracks.`Genre` = genres.`Name` "
+                                                   "`Genre` genres ON tracks.`GenreID` = genres.`ID` "
                                                    "WHERE "
                                                    "album.`ID` = :albumId "
                                                    "GROUP BY album.`ID`");
@@ -1483,8 +2423,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectAlbumQuery, selectAlbumQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAlbumQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAlbumQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1504,13 +2444,7 @@ void DatabaseInterface::initRequest()
                                                   "FROM "
                                                   "`Tracks` tracks "
                                                   "WHERE "
-                                                  "tracks.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks.`AlbumPath` = album.`AlbumPath` "
+                                                  "tracks.`AlbumID` = album.`ID` "
                                                   ") as `TracksCount`, "
                                                   "("
                                                   "SELECT "
@@ -1518,13 +2452,7 @@ void DatabaseInterface::initRequest()
                                                   "FROM "
                                                   "`Tracks` tracks2 "
                                                   "WHERE "
-                                                  "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks2.`AlbumPath` = album.`AlbumPath` "
+                                                  "tracks2.`AlbumID` = album.`ID` "
                                                   ") as `IsSingleDiscAlbum` "
                                                   "FROM `Albums` album "
                                                   "ORDER BY album.`Title` COLLATE NOCASE");
@@ -1532,8 +2460,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectAllAlbumsQuery, selectAllAlbumsText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1549,8 +2477,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectAllGenresQuery, selectAllGenresText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1572,34 +2500,22 @@ void DatabaseInterface::initRequest()
                                                   "FROM "
                                                   "`Tracks` tracks2 "
                                                   "WHERE "
-                                                  "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks2.`AlbumPath` = album.`AlbumPath` "
+                                                  "tracks2.`AlbumID` = album.`ID` "
                                                   ") as `IsSingleDiscAlbum` "
                                                   "FROM "
                                                   "`Albums` album, "
                                                   "`Tracks` tracks LEFT JOIN "
-                                                  "`Genre` genres ON tracks.`Genre` = genres.`Name` "
+                                                  "`Genre` genres ON tracks.`GenreID` = genres.`ID` "
                                                   "WHERE "
-                                                  "tracks.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks.`AlbumPath` = album.`AlbumPath` "
+                                                  "tracks.`AlbumID` = album.`ID` "
                                                   "GROUP BY album.`ID`, album.`Title`, album.`AlbumPath` "
                                                   "ORDER BY album.`Title` COLLATE NOCASE");
 
         auto result = prepareQuery(d->mSelectAllAlbumsShortQuery, selectAllAlbumsText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1618,24 +2534,17 @@ void DatabaseInterface::initRequest()
                                                   "FROM "
                                                   "`Albums` album, "
                                                   "`Tracks` tracks LEFT JOIN "
-                                                  "`Genre` genres ON tracks.`Genre` = genres.`Name` "
+                                                  "`Genre` genres ON tracks.`GenreID` = genres.`ID` "
                                                   "WHERE "
-                                                  "tracks.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks.`AlbumPath` = album.`AlbumPath` AND "
+                                                  "tracks.`AlbumID` = album.`ID` AND "
                                                   "EXISTS ("
                                                   "  SELECT tracks2.`Genre` "
                                                   "  FROM "
                                                   "  `Tracks` tracks2, "
                                                   "  `Genre` genre2 "
                                                   "  WHERE "
-                                                  "  tracks2.`AlbumTitle` = album.`Title` AND "
-                                                  "  tracks2.`AlbumArtistName` = album.`ArtistName` AND "
-                                                  "  tracks2.`Genre` = genre2.`Name` AND "
+                                                  "  tracks2.`AlbumID` = album.`ID` AND "
+                                                  "  tracks2.`GenreID` = genre2.`ID` AND "
                                                   "  genre2.`Name` = :genreFilter AND "
                                                   "  (tracks2.`ArtistName` = :artistFilter OR tracks2.`AlbumArtistName` = :artistFilter) "
                                                   ") "
@@ -1645,8 +2554,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectAllAlbumsShortWithGenreArtistFilterQuery, selectAllAlbumsText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortWithGenreArtistFilterQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortWithGenreArtistFilterQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortWithGenreArtistFilterQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortWithGenreArtistFilterQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1665,22 +2574,15 @@ void DatabaseInterface::initRequest()
                                                   "FROM "
                                                   "`Albums` album, "
                                                   "`Tracks` tracks LEFT JOIN "
-                                                  "`Genre` genres ON tracks.`Genre` = genres.`Name` "
+                                                  "`Genre` genres ON tracks.`GenreID` = genres.`ID` "
                                                   "WHERE "
-                                                  "tracks.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks.`AlbumPath` = album.`AlbumPath` AND "
+                                                  "tracks.`AlbumID` = album.`ID` AND "
                                                   "EXISTS ("
                                                   "  SELECT tracks2.`Genre` "
                                                   "  FROM "
                                                   "  `Tracks` tracks2 "
                                                   "  WHERE "
-                                                  "  tracks2.`AlbumTitle` = album.`Title` AND "
-                                                  "  tracks2.`AlbumArtistName` = album.`ArtistName` AND "
+                                                  "  tracks2.`AlbumID` = album.`ID` AND "
                                                   "  (tracks2.`ArtistName` = :artistFilter OR tracks2.`AlbumArtistName` = :artistFilter) "
                                                   ") "
                                                   "GROUP BY album.`ID`, album.`Title`, album.`AlbumPath` "
@@ -1689,8 +2591,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectAllAlbumsShortWithArtistFilterQuery, selectAllAlbumsText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortWithArtistFilterQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortWithArtistFilterQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortWithArtistFilterQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortWithArtistFilterQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1701,16 +2603,16 @@ void DatabaseInterface::initRequest()
                                                              "artists.`Name`, "
                                                              "GROUP_CONCAT(genres.`Name`, ', ') as AllGenres "
                                                              "FROM `Artists` artists  LEFT JOIN "
-                                                             "`Tracks` tracks ON artists.`Name` = tracks.`ArtistName` LEFT JOIN "
-                                                             "`Genre` genres ON tracks.`Genre` = genres.`Name` "
+                                                             "`Tracks` tracks ON artists.`ID` = tracks.`ArtistID` LEFT JOIN "
+                                                             "`Genre` genres ON tracks.`GenreID` = genres.`ID` "
                                                              "GROUP BY artists.`ID` "
                                                              "ORDER BY artists.`Name` COLLATE NOCASE");
 
         auto result = prepareQuery(d->mSelectAllArtistsQuery, selectAllArtistsWithFilterText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllArtistsQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllArtistsQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllArtistsQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllArtistsQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1721,8 +2623,8 @@ void DatabaseInterface::initRequest()
                                                                   "artists.`Name`, "
                                                                   "GROUP_CONCAT(genres.`Name`, ', ') as AllGenres "
                                                                   "FROM `Artists` artists  LEFT JOIN "
-                                                                  "`Tracks` tracks ON (tracks.`ArtistName` = artists.`Name` OR tracks.`AlbumArtistName` = artists.`Name`) LEFT JOIN "
-                                                                  "`Genre` genres ON tracks.`Genre` = genres.`Name` "
+                                                                  "`Tracks` tracks ON (tracks.`ArtistID` = artists.`ID` OR tracks.`AlbumArtistName` = artists.`Name`) LEFT JOIN "
+                                                                  "`Genre` genres ON tracks.`GenreID` = genres.`ID` "
                                                                   "WHERE "
                                                                   "EXISTS ("
                                                                   "  SELECT tracks2.`Genre` "
@@ -1730,8 +2632,8 @@ void DatabaseInterface::initRequest()
                                                                   "  `Tracks` tracks2, "
                                                                   "  `Genre` genre2 "
                                                                   "  WHERE "
-                                                                  "  (tracks2.`ArtistName` = artists.`Name` OR tracks2.`AlbumArtistName` = artists.`Name`) AND "
-                                                                  "  tracks2.`Genre` = genre2.`Name` AND "
+                                                                  "  (tracks2.`ArtistID` = artists.`ID` OR tracks2.`AlbumArtistName` = artists.`Name`) AND "
+                                                                  "  tracks2.`GenreID` = genre2.`ID` AND "
                                                                   "  genre2.`Name` = :genreFilter "
                                                                   ") "
                                                                   "GROUP BY artists.`ID` "
@@ -1740,8 +2642,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectAllArtistsWithGenreFilterQuery, selectAllArtistsWithGenreFilterText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllArtistsWithGenreFilterQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllArtistsWithGenreFilterQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllArtistsWithGenreFilterQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllArtistsWithGenreFilterQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1756,8 +2658,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectAllComposersQuery, selectAllComposersWithFilterText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllComposersQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllComposersQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllComposersQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllComposersQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1772,8 +2674,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectAllLyricistsQuery, selectAllLyricistsWithFilterText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllLyricistsQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllLyricistsQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllLyricistsQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllLyricistsQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1800,13 +2702,7 @@ void DatabaseInterface::initRequest()
                                                   "FROM "
                                                   "`Tracks` tracks2 "
                                                   "WHERE "
-                                                  "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks2.`AlbumPath` = album.`AlbumPath` "
+                                                  "tracks2.`AlbumID` = album.`ID` "
                                                   ") as `IsSingleDiscAlbum`, "
                                                   "trackGenre.`Name`, "
                                                   "trackComposer.`Name`, "
@@ -1821,28 +2717,31 @@ void DatabaseInterface::initRequest()
                                                   "tracks.`FirstPlayDate`, "
                                                   "tracks.`LastPlayDate`, "
                                                   "tracks.`PlayCounter`, "
-                                                  "tracks.`PlayCounter` / (strftime('%s', 'now') - tracks.`FirstPlayDate`) as PlayFrequency "
+                                                  "tracks.`PlayCounter` / (strftime('%s', 'now') - tracks.`FirstPlayDate`) as PlayFrequency, "
+                                                  "tracks.`TrackGain`, "
+                                                  "tracks.`TrackPeak`, "
+                                                  "tracks.`AlbumGain`, "
+                                                  "tracks.`AlbumPeak` "
                                                   "FROM "
                                                   "`Tracks` tracks, "
                                                   "`TracksMapping` tracksMapping "
                                                   "LEFT JOIN "
                                                   "`Albums` album "
                                                   "ON "
-                                                  "tracks.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                  "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                  "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
+                                                  "tracks.`AlbumID` = album.`ID` "
+                                                  "LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreID` "
                                                   "LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` "
                                                   "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` "
                                                   "WHERE "
                                                   "tracksMapping.`TrackID` = tracks.`ID` AND "
-                                                  "tracksMapping.`Priority` = (SELECT MIN(`Priority`) FROM `TracksMapping` WHERE `TrackID` = tracks.`ID`)");
+                                                  "tracksMapping.`Priority` = (SELECT MIN(`Priority`) FROM `TracksMapping` WHERE `TrackID` = tracks.`ID`) "
+                                                  "ORDER BY tracks.`Title` COLLATE NOCASE");
 
         auto result = prepareQuery(d->mSelectAllTracksQuery, selectAllTracksText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllTracksQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllTracksQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllTracksQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllTracksQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1869,13 +2768,7 @@ void DatabaseInterface::initRequest()
                                                   "FROM "
                                                   "`Tracks` tracks2 "
                                                   "WHERE "
-                                                  "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks2.`AlbumPath` = album.`AlbumPath` "
+                                                  "tracks2.`AlbumID` = album.`ID` "
                                                   ") as `IsSingleDiscAlbum`, "
                                                   "trackGenre.`Name`, "
                                                   "trackComposer.`Name`, "
@@ -1890,17 +2783,19 @@ void DatabaseInterface::initRequest()
                                                   "tracks.`FirstPlayDate`, "
                                                   "tracks.`LastPlayDate`, "
                                                   "tracks.`PlayCounter`, "
-                                                  "tracks.`PlayCounter` / (strftime('%s', 'now') - tracks.`FirstPlayDate`) as PlayFrequency "
+                                                  "tracks.`PlayCounter` / (strftime('%s', 'now') - tracks.`FirstPlayDate`) as PlayFrequency, "
+                                                  "tracks.`TrackGain`, "
+                                                  "tracks.`TrackPeak`, "
+                                                  "tracks.`AlbumGain`, "
+                                                  "tracks.`AlbumPeak` "
                                                   "FROM "
                                                   "`Tracks` tracks, "
                                                   "`TracksMapping` tracksMapping "
                                                   "LEFT JOIN "
                                                   "`Albums` album "
                                                   "ON "
-                                                  "tracks.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                  "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                  "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
+                                                  "tracks.`AlbumID` = album.`ID` "
+                                                  "LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreID` "
                                                   "LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` "
                                                   "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` "
                                                   "WHERE "
@@ -1913,8 +2808,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectAllRecentlyPlayedTracksQuery, selectAllTracksText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllRecentlyPlayedTracksQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllRecentlyPlayedTracksQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllRecentlyPlayedTracksQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllRecentlyPlayedTracksQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -1941,13 +2836,7 @@ void DatabaseInterface::initRequest()
                                                   "FROM "
                                                   "`Tracks` tracks2 "
                                                   "WHERE "
-                                                  "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks2.`AlbumPath` = album.`AlbumPath` "
+                                                  "tracks2.`AlbumID` = album.`ID` "
                                                   ") as `IsSingleDiscAlbum`, "
                                                   "trackGenre.`Name`, "
                                                   "trackComposer.`Name`, "
@@ -1962,17 +2851,19 @@ void DatabaseInterface::initRequest()
                                                   "tracks.`FirstPlayDate`, "
                                                   "tracks.`LastPlayDate`, "
                                                   "tracks.`PlayCounter`, "
-                                                  "tracks.`PlayCounter` / (strftime('%s', 'now') - tracks.`FirstPlayDate`) as PlayFrequency "
+                                                  "tracks.`PlayCounter` / (strftime('%s', 'now') - tracks.`FirstPlayDate`) as PlayFrequency, "
+                                                  "tracks.`TrackGain`, "
+                                                  "tracks.`TrackPeak`, "
+                                                  "tracks.`AlbumGain`, "
+                                                  "tracks.`AlbumPeak` "
                                                   "FROM "
                                                   "`Tracks` tracks, "
                                                   "`TracksMapping` tracksMapping "
                                                   "LEFT JOIN "
                                                   "`Albums` album "
                                                   "ON "
-                                                  "tracks.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                  "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                  "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
+                                                  "tracks.`AlbumID` = album.`ID` "
+                                                  "LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreID` "
                                                   "LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` "
                                                   "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` "
                                                   "WHERE "
@@ -1985,8 +2876,89 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectAllFrequentlyPlayedTracksQuery, selectAllTracksText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllFrequentlyPlayedTracksQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllFrequentlyPlayedTracksQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllFrequentlyPlayedTracksQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllFrequentlyPlayedTracksQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto updateTrackLoudnessQueryText = QStringLiteral("UPDATE `Tracks` "
+                                                           "SET "
+                                                           "`TrackGain` = :trackGain, "
+                                                           "`TrackPeak` = :trackPeak "
+                                                           "WHERE "
+                                                           "`ID` = :trackId");
+
+        auto result = prepareQuery(d->mUpdateTrackLoudnessQuery, updateTrackLoudnessQueryText);
+
+        if (!result) {
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackLoudnessQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackLoudnessQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectAlbumTracksLoudnessQueryText = QStringLiteral("SELECT "
+                                                                 "tracks.`ID`, "
+                                                                 "tracks.`TrackGain`, "
+                                                                 "tracks.`TrackPeak`, "
+                                                                 "tracks.`Duration` "
+                                                                 "FROM "
+                                                                 "`Tracks` tracks "
+                                                                 "WHERE "
+                                                                 "tracks.`AlbumID` = :albumId");
+
+        auto result = prepareQuery(d->mSelectAlbumTracksLoudnessQuery, selectAlbumTracksLoudnessQueryText);
+
+        if (!result) {
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumTracksLoudnessQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumTracksLoudnessQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto updateAlbumLoudnessQueryText = QStringLiteral("UPDATE `Tracks` "
+                                                           "SET "
+                                                           "`AlbumGain` = :albumGain, "
+                                                           "`AlbumPeak` = :albumPeak "
+                                                           "WHERE "
+                                                           "`AlbumID` = :albumId");
+
+        auto result = prepareQuery(d->mUpdateAlbumLoudnessQuery, updateAlbumLoudnessQueryText);
+
+        if (!result) {
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateAlbumLoudnessQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateAlbumLoudnessQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectTracksWithoutLoudnessQueryText = QStringLiteral("SELECT "
+                                                                   "tracks.`ID`, "
+                                                                   "tracks.`AlbumID`, "
+                                                                   "tracksMapping.`FileName` "
+                                                                   "FROM "
+                                                                   "`Tracks` tracks, "
+                                                                   "`TracksMapping` tracksMapping "
+                                                                   "WHERE "
+                                                                   "tracks.`TrackGain` IS NULL AND "
+                                                                   "tracks.`TrackPeak` IS NULL AND "
+                                                                   "tracksMapping.`TrackID` = tracks.`ID` AND "
+                                                                   "tracksMapping.`Priority` = (SELECT MIN(`Priority`) FROM `TracksMapping` WHERE `TrackID` = tracks.`ID`)");
+
+        auto result = prepareQuery(d->mSelectTracksWithoutLoudnessQuery, selectTracksWithoutLoudnessQueryText);
+
+        if (!result) {
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksWithoutLoudnessQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksWithoutLoudnessQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2009,16 +2981,14 @@ void DatabaseInterface::initRequest()
                                                        "LEFT JOIN "
                                                        "`Albums` album "
                                                        "ON "
-                                                       "tracks.`AlbumTitle` = album.`Title` AND "
-                                                       "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                       "tracks.`AlbumPath` = album.`AlbumPath` "
+                                                       "tracks.`AlbumID` = album.`ID` "
                                                        "");
 
         auto result = prepareQuery(d->mSelectAllTracksShortQuery, selectAllTracksShortText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllTracksShortQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllTracksShortQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllTracksShortQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllTracksShortQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2034,8 +3004,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectArtistByNameQuery, selectArtistByNameText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectArtistByNameQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectArtistByNameQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectArtistByNameQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectArtistByNameQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2051,8 +3021,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectComposerByNameQuery, selectComposerByNameText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectComposerByNameQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectComposerByNameQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectComposerByNameQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectComposerByNameQuery.lastError();
         }
     }
 
@@ -2066,8 +3036,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectLyricistByNameQuery, selectLyricistByNameText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectLyricistByNameQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectLyricistByNameQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectLyricistByNameQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectLyricistByNameQuery.lastError();
         }
     }
 
@@ -2081,8 +3051,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectGenreByNameQuery, selectGenreByNameText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectGenreByNameQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectGenreByNameQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreByNameQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreByNameQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2095,8 +3065,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mInsertArtistsQuery, insertArtistsText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mInsertArtistsQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mInsertArtistsQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertArtistsQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertArtistsQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2109,8 +3079,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mInsertGenreQuery, insertGenreText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mInsertGenreQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mInsertGenreQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertGenreQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertGenreQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2123,8 +3093,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mInsertComposerQuery, insertComposerText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mInsertComposerQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mInsertComposerQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertComposerQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertComposerQuery.lastError();
         }
     }
 
@@ -2135,8 +3105,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mInsertLyricistQuery, insertLyricistText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mInsertLyricistQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mInsertLyricistQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertLyricistQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertLyricistQuery.lastError();
         }
     }
 
@@ -2161,13 +3131,7 @@ void DatabaseInterface::initRequest()
                                                    "FROM "
                                                    "`Tracks` tracks2 "
                                                    "WHERE "
-                                                   "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                   "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                   "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                   "album.`ArtistName` IS NULL"
-                                                   ")"
-                                                   ") AND "
-                                                   "tracks2.`AlbumPath` = album.`AlbumPath` "
+                                                   "tracks2.`AlbumID` = album.`ID` "
                                                    ") as `IsSingleDiscAlbum`, "
                                                    "trackGenre.`Name`, "
                                                    "trackComposer.`Name`, "
@@ -2182,19 +3146,21 @@ void DatabaseInterface::initRequest()
                                                    "tracks.`FirstPlayDate`, "
                                                    "tracks.`LastPlayDate`, "
                                                    "tracks.`PlayCounter`, "
-                                                   "tracks.`PlayCounter` / (strftime('%s', 'now') - tracks.`FirstPlayDate`) as PlayFrequency "
+                                                   "tracks.`PlayCounter` / (strftime('%s', 'now') - tracks.`FirstPlayDate`) as PlayFrequency, "
+                                                   "tracks.`TrackGain`, "
+                                                   "tracks.`TrackPeak`, "
+                                                   "tracks.`AlbumGain`, "
+                                                   "tracks.`AlbumPeak` "
                                                    "FROM "
                                                    "`Tracks` tracks, "
                                                    "`TracksMapping` tracksMapping "
                                                    "LEFT JOIN "
                                                    "`Albums` album "
                                                    "ON "
-                                                   "tracks.`AlbumTitle` = album.`Title` AND "
-                                                   "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                   "tracks.`AlbumPath` = album.`AlbumPath` "
+                                                   "tracks.`AlbumID` = album.`ID` "
                                                    "LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` "
                                                    "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` "
-                                                   "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
+                                                   "LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreID` "
                                                    "WHERE "
                                                    "tracksMapping.`TrackID` = tracks.`ID` AND "
                                                    "album.`ID` = :albumId AND "
@@ -2205,8 +3171,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectTrackQuery, selectTrackQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectTrackQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectTrackQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2232,13 +3198,7 @@ void DatabaseInterface::initRequest()
                                                          "FROM "
                                                          "`Tracks` tracks2 "
                                                          "WHERE "
-                                                         "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                         "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                         "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                         "album.`ArtistName` IS NULL"
-                                                         ")"
-                                                         ") AND "
-                                                         "tracks2.`AlbumPath` = album.`AlbumPath` "
+                                                         "tracks2.`AlbumID` = album.`ID` "
                                                          ") as `IsSingleDiscAlbum`, "
                                                          "trackGenre.`Name`, "
                                                          "trackComposer.`Name`, "
@@ -2253,19 +3213,21 @@ void DatabaseInterface::initRequest()
                                                          "tracks.`FirstPlayDate`, "
                                                          "tracks.`LastPlayDate`, "
                                                          "tracks.`PlayCounter`, "
-                                                         "tracks.`PlayCounter` / (strftime('%s', 'now') - tracks.`FirstPlayDate`) as PlayFrequency "
+                                                         "tracks.`PlayCounter` / (strftime('%s', 'now') - tracks.`FirstPlayDate`) as PlayFrequency, "
+                                                         "tracks.`TrackGain`, "
+                                                         "tracks.`TrackPeak`, "
+                                                         "tracks.`AlbumGain`, "
+                                                         "tracks.`AlbumPeak` "
                                                          "FROM "
                                                          "`Tracks` tracks, "
                                                          "`TracksMapping` tracksMapping "
                                                          "LEFT JOIN "
                                                          "`Albums` album "
                                                          "ON "
-                                                         "tracks.`AlbumTitle` = album.`Title` AND "
-                                                         "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                         "tracks.`AlbumPath` = album.`AlbumPath` "
+                                                         "tracks.`AlbumID` = album.`ID` "
                                                          "LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` "
                                                          "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` "
-                                                         "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
+                                                         "LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreID` "
                                                          "WHERE "
                                                          "tracks.`ID` = :trackId AND "
                                                          "tracksMapping.`TrackID` = tracks.`ID` AND "
@@ -2274,8 +3236,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectTrackFromIdQuery, selectTrackFromIdQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectTrackFromIdQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectTrackFromIdQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackFromIdQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackFromIdQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2288,8 +3250,8 @@ void DatabaseInterface::initRequest()
         const auto result = prepareQuery(d->mSelectCountAlbumsForArtistQuery, selectCountAlbumsQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForArtistQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForArtistQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForArtistQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForArtistQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2302,18 +3264,16 @@ void DatabaseInterface::initRequest()
                                                             "LEFT JOIN "
                                                             "`Albums` album "
                                                             "ON "
-                                                            "tracks.`AlbumTitle` = album.`Title` AND "
-                                                            "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                            "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                            "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
+                                                            "tracks.`AlbumID` = album.`ID` "
+                                                            "LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreID` "
                                                             "WHERE "
                                                             "album.`ArtistName` = :artistName");
 
         const auto result = prepareQuery(d->mSelectGenreForArtistQuery, selectGenreForArtistQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectGenreForArtistQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectGenreForArtistQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreForArtistQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreForArtistQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2326,18 +3286,16 @@ void DatabaseInterface::initRequest()
                                                            "LEFT JOIN "
                                                            "`Albums` album "
                                                            "ON "
-                                                           "tracks.`AlbumTitle` = album.`Title` AND "
-                                                           "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                           "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                           "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
+                                                           "tracks.`AlbumID` = album.`ID` "
+                                                           "LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreID` "
                                                            "WHERE "
                                                            "album.`ID` = :albumId");
 
         const auto result = prepareQuery(d->mSelectGenreForAlbumQuery, selectGenreForAlbumQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectGenreForAlbumQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectGenreForAlbumQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreForAlbumQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreForAlbumQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2350,16 +3308,14 @@ void DatabaseInterface::initRequest()
                                                          "`Albums` album "
                                                          "LEFT JOIN `Composer` albumComposer ON albumComposer.`Name` = tracks.`Composer` "
                                                          "WHERE "
-                                                         "(tracks.`AlbumTitle` = album.`Title` OR tracks.`AlbumTitle` IS NULL ) AND "
-                                                         "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                         "(tracks.`AlbumPath` = album.`AlbumPath` OR tracks.`AlbumPath` IS NULL ) AND "
+                                                         "tracks.`AlbumID` = album.`ID` AND "
                                                          "albumComposer.`Name` = :artistName");
 
         const auto result = prepareQuery(d->mSelectCountAlbumsForComposerQuery, selectCountAlbumsQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForComposerQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForComposerQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForComposerQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForComposerQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2372,16 +3328,14 @@ void DatabaseInterface::initRequest()
                                                          "`Albums` album "
                                                          "LEFT JOIN `Lyricist` albumLyricist ON albumLyricist.`Name` = tracks.`Lyricist` "
                                                          "WHERE "
-                                                         "(tracks.`AlbumTitle` = album.`Title` OR tracks.`AlbumTitle` IS NULL ) AND "
-                                                         "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                         "(tracks.`AlbumPath` = album.`AlbumPath` OR tracks.`AlbumPath` IS NULL ) AND "
+                                                         "tracks.`AlbumID` = album.`ID` AND "
                                                          "albumLyricist.`Name` = :artistName");
 
         const auto result = prepareQuery(d->mSelectCountAlbumsForLyricistQuery, selectCountAlbumsQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForLyricistQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForLyricistQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForLyricistQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForLyricistQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2399,8 +3353,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectAlbumIdFromTitleQuery, selectAlbumIdFromTitleQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2419,8 +3373,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectAlbumIdFromTitleAndArtistQuery, selectAlbumIdFromTitleAndArtistQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleAndArtistQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleAndArtistQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleAndArtistQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleAndArtistQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2439,8 +3393,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectAlbumIdFromTitleWithoutArtistQuery, selectAlbumIdFromTitleWithoutArtistQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleWithoutArtistQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleWithoutArtistQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleWithoutArtistQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleWithoutArtistQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2463,8 +3417,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mInsertAlbumQuery, insertAlbumQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mInsertAlbumQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mInsertAlbumQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertAlbumQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertAlbumQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2482,8 +3436,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mInsertTrackMapping, insertTrackMappingQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mInsertTrackMapping.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mInsertTrackMapping.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertTrackMapping.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertTrackMapping.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2494,14 +3448,15 @@ void DatabaseInterface::initRequest()
                                                                    "SET "
                                                                    "`TrackID` = :trackId, "
                                                                    "`Priority` = :priority, "
-                                                                   "`FileModifiedTime` = :mtime "
+                                                                   "`FileModifiedTime` = :mtime, "
+                                                                   "`FileSize` = :fileSize "
                                                                    "WHERE `FileName` = :fileName");
 
         auto result = prepareQuery(d->mUpdateTrackMapping, initialUpdateTracksValidityQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mUpdateTrackMapping.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mUpdateTrackMapping.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackMapping.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackMapping.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2514,8 +3469,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mRemoveTracksMappingFromSource, removeTracksMappingFromSourceQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mRemoveTracksMappingFromSource.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mRemoveTracksMappingFromSource.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTracksMappingFromSource.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTracksMappingFromSource.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2528,8 +3483,40 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mRemoveTracksMapping, removeTracksMappingQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mRemoveTracksMapping.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mRemoveTracksMapping.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTracksMapping.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTracksMapping.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto renameTrackMappingQueryText = QStringLiteral("UPDATE `TracksMapping` "
+                                                          "SET "
+                                                          "`FileName` = :newFileName "
+                                                          "WHERE `FileName` = :oldFileName");
+
+        auto result = prepareQuery(d->mRenameTrackMapping, renameTrackMappingQueryText);
+
+        if (!result) {
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRenameTrackMapping.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRenameTrackMapping.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto updateTrackEmbeddedCoverQueryText = QStringLiteral("UPDATE `Tracks` "
+                                                                "SET "
+                                                                "`HasEmbeddedCover` = :hasEmbeddedCover "
+                                                                "WHERE `ID` = :trackId");
+
+        auto result = prepareQuery(d->mUpdateTrackEmbeddedCover, updateTrackEmbeddedCoverQueryText);
+
+        if (!result) {
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackEmbeddedCover.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackEmbeddedCover.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2556,13 +3543,7 @@ void DatabaseInterface::initRequest()
                                                                   "FROM "
                                                                   "`Tracks` tracks2 "
                                                                   "WHERE "
-                                                                  "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                                  "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                                  "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                                  "album.`ArtistName` IS NULL"
-                                                                  ")"
-                                                                  ") AND "
-                                                                  "tracks2.`AlbumPath` = album.`AlbumPath` "
+                                                                  "tracks2.`AlbumID` = album.`ID` "
                                                                   ") as `IsSingleDiscAlbum`, "
                                                                   "trackGenre.`Name`, "
                                                                   "trackComposer.`Name`, "
@@ -2577,26 +3558,28 @@ void DatabaseInterface::initRequest()
                                                                   "tracks.`FirstPlayDate`, "
                                                                   "tracks.`LastPlayDate`, "
                                                                   "tracks.`PlayCounter`, "
-                                                                  "tracks.`PlayCounter` / (strftime('%s', 'now') - tracks.`FirstPlayDate`) as PlayFrequency "
+                                                                  "tracks.`PlayCounter` / (strftime('%s', 'now') - tracks.`FirstPlayDate`) as PlayFrequency, "
+                                                                  "tracks.`TrackGain`, "
+                                                                  "tracks.`TrackPeak`, "
+                                                                  "tracks.`AlbumGain`, "
+                                                                  "tracks.`AlbumPeak` "
                                                                   "FROM "
                                                                   "`Tracks` tracks "
                                                                   "LEFT JOIN "
                                                                   "`Albums` album "
                                                                   "ON "
-                                                                  "tracks.`AlbumTitle` = album.`Title` AND "
-                                                                  "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                                  "tracks.`AlbumPath` = album.`AlbumPath` "
+                                                                  "tracks.`AlbumID` = album.`ID` "
                                                                   "LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` "
                                                                   "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` "
-                                                                  "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
+                                                                  "LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreID` "
                                                                   "WHERE "
                                                                   "tracks.`ID` NOT IN (SELECT tracksMapping2.`TrackID` FROM `TracksMapping` tracksMapping2)");
 
         auto result = prepareQuery(d->mSelectTracksWithoutMappingQuery, selectTracksWithoutMappingQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectTracksWithoutMappingQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectTracksWithoutMappingQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksWithoutMappingQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksWithoutMappingQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2617,45 +3600,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectTracksMapping, selectTracksMappingQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectTracksMapping.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectTracksMapping.lastError();
-
-            Q_EMIT databaseError();
-        }
-    }
-
-    {
-        auto selectTracksMappingPriorityQueryText = QStringLiteral("SELECT "
-                                                                   "`Priority` "
-                                                                   "FROM "
-                                                                   "`TracksMapping` "
-                                                                   "WHERE "
-                                                                   "`TrackID` = :trackId AND "
-                                                                   "`FileName` = :fileName");
-
-        auto result = prepareQuery(d->mSelectTracksMappingPriority, selectTracksMappingPriorityQueryText);
-
-        if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectTracksMappingPriority.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectTracksMappingPriority.lastError();
-
-            Q_EMIT databaseError();
-        }
-    }
-
-    {
-        auto selectTracksMappingPriorityQueryByTrackIdText = QStringLiteral("SELECT "
-                                                                            "MAX(`Priority`) "
-                                                                            "FROM "
-                                                                            "`TracksMapping` "
-                                                                            "WHERE "
-                                                                            "`TrackID` = :trackId");
-
-        auto result = prepareQuery(d->mSelectTracksMappingPriorityByTrackId, selectTracksMappingPriorityQueryByTrackIdText);
-
-        if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectTracksMappingPriorityByTrackId.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectTracksMappingPriorityByTrackId.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksMapping.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksMapping.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2664,7 +3610,8 @@ void DatabaseInterface::initRequest()
     {
         auto selectAllTrackFilesFromSourceQueryText = QStringLiteral("SELECT "
                                                                      "tracksMapping.`FileName`, "
-                                                                     "tracksMapping.`FileModifiedTime` "
+                                                                     "tracksMapping.`FileModifiedTime`, "
+                                                                     "tracksMapping.`FileSize` "
                                                                      "FROM "
                                                                      "`TracksMapping` tracksMapping "
                                                                      "WHERE "
@@ -2673,8 +3620,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectAllTrackFilesFromSourceQuery, selectAllTrackFilesFromSourceQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllTrackFilesFromSourceQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAllTrackFilesFromSourceQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllTrackFilesFromSourceQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllTrackFilesFromSourceQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2687,8 +3634,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mInsertMusicSource, insertMusicSourceQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mInsertMusicSource.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mInsertMusicSource.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertMusicSource.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertMusicSource.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2700,8 +3647,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectMusicSource, selectMusicSourceQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectMusicSource.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectMusicSource.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectMusicSource.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectMusicSource.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2717,9 +3664,7 @@ void DatabaseInterface::initRequest()
                                                    "WHERE "
                                                    "tracks.`Title` = :title AND "
                                                    "album.`ID` = :album AND "
-                                                   "(tracks.`AlbumTitle` = album.`Title` OR tracks.`AlbumTitle` IS NULL ) AND "
-                                                   "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                   "(tracks.`AlbumPath` = album.`AlbumPath` OR tracks.`AlbumPath` IS NULL ) AND "
+                                                   "tracks.`AlbumID` = album.`ID` AND "
                                                    "tracks.`ArtistName` = :artist AND "
                                                    "tracksMapping.`TrackID` = tracks.`ID` AND "
                                                    "tracksMapping.`Priority` = (SELECT MIN(`Priority`) FROM `TracksMapping` WHERE `TrackID` = tracks.`ID`)");
@@ -2727,8 +3672,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectTrackIdFromTitleAlbumIdArtistQuery, selectTrackQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectTrackIdFromTitleAlbumIdArtistQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectTrackIdFromTitleAlbumIdArtistQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackIdFromTitleAlbumIdArtistQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackIdFromTitleAlbumIdArtistQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2740,10 +3685,13 @@ void DatabaseInterface::initRequest()
                                                    "`ID`, "
                                                    "`Title`, "
                                                    "`ArtistName`, "
+                                                   "`ArtistID`, "
                                                    "`AlbumTitle`, "
+                                                   "`AlbumID`, "
                                                    "`AlbumArtistName`, "
                                                    "`AlbumPath`, "
                                                    "`Genre`, "
+                                                   "`GenreID`, "
                                                    "`Composer`, "
                                                    "`Lyricist`, "
                                                    "`Comment`, "
@@ -2763,10 +3711,13 @@ void DatabaseInterface::initRequest()
                                                    ":trackId, "
                                                    ":title, "
                                                    ":artistName, "
+                                                   ":artistId, "
                                                    ":albumTitle, "
+                                                   ":albumId, "
                                                    ":albumArtistName, "
                                                    ":albumPath, "
                                                    ":genre, "
+                                                   ":genreId, "
                                                    ":composer, "
                                                    ":lyricist, "
                                                    ":comment, "
@@ -2785,8 +3736,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mInsertTrackQuery, insertTrackQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mInsertTrackQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mInsertTrackQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertTrackQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertTrackQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2797,10 +3748,13 @@ void DatabaseInterface::initRequest()
                                                    "SET "
                                                    "`Title` = :title, "
                                                    "`ArtistName` = :artistName, "
+                                                   "`ArtistID` = :artistId, "
                                                    "`AlbumTitle` = :albumTitle, "
+                                                   "`AlbumID` = :albumId, "
                                                    "`AlbumArtistName` = :albumArtistName, "
                                                    "`AlbumPath` = :albumPath, "
                                                    "`Genre` = :genre, "
+                                                   "`GenreID` = :genreId, "
                                                    "`Composer` = :composer, "
                                                    "`Lyricist` = :lyricist, "
                                                    "`Comment` = :comment, "
@@ -2811,15 +3765,20 @@ void DatabaseInterface::initRequest()
                                                    "`SampleRate` = :sampleRate, "
                                                    "`Year` = :year, "
                                                    " `Duration` = :trackDuration, "
-                                                   "`Rating` = :trackRating "
+                                                   "`Rating` = :trackRating, "
+                                                   "`HasEmbeddedCover` = :hasEmbeddedCover, "
+                                                   "`TrackGain` = NULL, "
+                                                   "`TrackPeak` = NULL, "
+                                                   "`AlbumGain` = NULL, "
+                                                   "`AlbumPeak` = NULL "
                                                    "WHERE "
                                                    "`ID` = :trackId");
 
         auto result = prepareQuery(d->mUpdateTrackQuery, updateTrackQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mUpdateTrackQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mUpdateTrackQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2835,8 +3794,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mUpdateAlbumArtistQuery, updateAlbumArtistQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtistQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtistQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtistQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtistQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2854,8 +3813,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mUpdateAlbumArtistInTracksQuery, updateAlbumArtistInTracksQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtistInTracksQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtistInTracksQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtistInTracksQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtistInTracksQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2869,8 +3828,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mQueryMaximumTrackIdQuery, queryMaximumTrackIdQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mQueryMaximumTrackIdQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mQueryMaximumTrackIdQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumTrackIdQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumTrackIdQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2884,8 +3843,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mQueryMaximumAlbumIdQuery, queryMaximumAlbumIdQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mQueryMaximumAlbumIdQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mQueryMaximumAlbumIdQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumAlbumIdQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumAlbumIdQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2899,8 +3858,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mQueryMaximumArtistIdQuery, queryMaximumArtistIdQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mQueryMaximumArtistIdQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mQueryMaximumArtistIdQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumArtistIdQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumArtistIdQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2914,8 +3873,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mQueryMaximumLyricistIdQuery, queryMaximumLyricistIdQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mQueryMaximumLyricistIdQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mQueryMaximumLyricistIdQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumLyricistIdQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumLyricistIdQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2929,8 +3888,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mQueryMaximumComposerIdQuery, queryMaximumComposerIdQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mQueryMaximumComposerIdQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mQueryMaximumComposerIdQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumComposerIdQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumComposerIdQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2944,8 +3903,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mQueryMaximumGenreIdQuery, queryMaximumGenreIdQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mQueryMaximumGenreIdQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mQueryMaximumGenreIdQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumGenreIdQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumGenreIdQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -2966,32 +3925,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery, selectTrackQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
-    }
-
-    {
-        auto selectTrackQueryText = QStringLiteral("SELECT "
-                                                   "tracks.ID "
-                                                   "FROM "
-                                                   "`Tracks` tracks, "
-                                                   "`Albums` albums "
-                                                   "WHERE "
-                                                   "tracks.`Title` = :title AND "
-                                                   "tracks.`ArtistName` = :trackArtist AND "
-                                                   "tracks.`AlbumTitle` = :album AND "
-                                                   "(tracks.`AlbumArtistName` = :albumArtist OR tracks.`AlbumArtistName` IS NULL) AND "
-                                                   "tracks.`AlbumPath` = :albumPath AND "
-                                                   "tracks.`TrackNumber` = :trackNumber");
-
-        auto result = prepareQuery(d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery, selectTrackQueryText);
-
-        if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -3007,8 +3942,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectAlbumArtUriFromAlbumIdQuery, selectAlbumArtUriFromAlbumIdQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAlbumArtUriFromAlbumIdQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAlbumArtUriFromAlbumIdQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumArtUriFromAlbumIdQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumArtUriFromAlbumIdQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -3023,8 +3958,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mUpdateAlbumArtUriFromAlbumIdQuery, updateAlbumArtUriFromAlbumIdQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtUriFromAlbumIdQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtUriFromAlbumIdQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtUriFromAlbumIdQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtUriFromAlbumIdQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -3051,13 +3986,7 @@ void DatabaseInterface::initRequest()
                                                               "FROM "
                                                               "`Tracks` tracks2 "
                                                               "WHERE "
-                                                              "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                              "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                              "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                              "album.`ArtistName` IS NULL"
-                                                              ")"
-                                                              ") AND "
-                                                              "tracks2.`AlbumPath` = album.`AlbumPath` "
+                                                              "tracks2.`AlbumID` = album.`ID` "
                                                               ") as `IsSingleDiscAlbum`, "
                                                               "trackGenre.`Name`, "
                                                               "trackComposer.`Name`, "
@@ -3072,19 +4001,21 @@ void DatabaseInterface::initRequest()
                                                               "tracks.`FirstPlayDate`, "
                                                               "tracks.`LastPlayDate`, "
                                                               "tracks.`PlayCounter`, "
-                                                              "tracks.`PlayCounter` / (strftime('%s', 'now') - tracks.`FirstPlayDate`) as PlayFrequency "
+                                                              "tracks.`PlayCounter` / (strftime('%s', 'now') - tracks.`FirstPlayDate`) as PlayFrequency, "
+                                                              "tracks.`TrackGain`, "
+                                                              "tracks.`TrackPeak`, "
+                                                              "tracks.`AlbumGain`, "
+                                                              "tracks.`AlbumPeak` "
                                                               "FROM "
                                                               "`Tracks` tracks, "
                                                               "`TracksMapping` tracksMapping "
                                                               "LEFT JOIN "
                                                               "`Albums` album "
                                                               "ON "
-                                                              "tracks.`AlbumTitle` = album.`Title` AND "
-                                                              "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                              "tracks.`AlbumPath` = album.`AlbumPath` "
+                                                              "tracks.`AlbumID` = album.`ID` "
                                                               "LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` "
                                                               "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` "
-                                                              "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
+                                                              "LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreID` "
                                                               "WHERE "
                                                               "tracks.`ArtistName` = :artistName AND "
                                                               "tracksMapping.`TrackID` = tracks.`ID` AND "
@@ -3095,8 +4026,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectTracksFromArtist, selectTracksFromArtistQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectTracksFromArtist.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectTracksFromArtist.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksFromArtist.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksFromArtist.lastError();
 
             Q_EMIT databaseError();
         }
@@ -3113,8 +4044,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectAlbumIdsFromArtist, selectAlbumIdsFromArtistQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAlbumIdsFromArtist.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectAlbumIdsFromArtist.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdsFromArtist.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdsFromArtist.lastError();
 
             Q_EMIT databaseError();
         }
@@ -3130,8 +4061,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectArtistQuery, selectArtistQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectArtistQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectArtistQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectArtistQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectArtistQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -3148,8 +4079,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mUpdateTrackStatistics, updateTrackStatisticsQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mUpdateTrackStatistics.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mUpdateTrackStatistics.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackStatistics.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackStatistics.lastError();
 
             Q_EMIT databaseError();
         }
@@ -3166,8 +4097,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mUpdateTrackFirstPlayStatistics, updateTrackFirstPlayStatisticsQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mUpdateTrackFirstPlayStatistics.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mUpdateTrackFirstPlayStatistics.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackFirstPlayStatistics.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackFirstPlayStatistics.lastError();
 
             Q_EMIT databaseError();
         }
@@ -3183,8 +4114,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectGenreQuery, selectGenreQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectGenreQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectGenreQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -3200,8 +4131,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectComposerQuery, selectComposerQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectComposerQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectComposerQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectComposerQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectComposerQuery.lastError();
         }
     }
 
@@ -3215,8 +4146,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mSelectLyricistQuery, selectLyricistQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectLyricistQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mSelectLyricistQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectLyricistQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectLyricistQuery.lastError();
         }
     }
 
@@ -3228,8 +4159,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mRemoveTrackQuery, removeTrackQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mRemoveTrackQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mRemoveTrackQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTrackQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTrackQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -3243,8 +4174,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mRemoveAlbumQuery, removeAlbumQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mRemoveAlbumQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mRemoveAlbumQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveAlbumQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveAlbumQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -3258,8 +4189,8 @@ void DatabaseInterface::initRequest()
         auto result = prepareQuery(d->mRemoveArtistQuery, removeAlbumQueryText);
 
         if (!result) {
-            qDebug() << "DatabaseInterface::initRequest" << d->mRemoveArtistQuery.lastQuery();
-            qDebug() << "DatabaseInterface::initRequest" << d->mRemoveArtistQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveArtistQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveArtistQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -3289,14 +4220,14 @@ qulonglong DatabaseInterface::insertAlbum(const QString &title, const QString &a
             d->mSelectAlbumIdFromTitleAndArtistQuery.bindValue(QStringLiteral(":artistName"), trackArtist);
         }
 
-        auto queryResult = d->mSelectAlbumIdFromTitleAndArtistQuery.exec();
+        auto queryResult = execQuery(d->mSelectAlbumIdFromTitleAndArtistQuery);
 
         if (!queryResult || !d->mSelectAlbumIdFromTitleAndArtistQuery.isSelect() || !d->mSelectAlbumIdFromTitleAndArtistQuery.isActive()) {
             Q_EMIT databaseError();
 
-            qDebug() << "DatabaseInterface::insertAlbum" << d->mSelectAlbumIdFromTitleAndArtistQuery.lastQuery();
-            qDebug() << "DatabaseInterface::insertAlbum" << d->mSelectAlbumIdFromTitleAndArtistQuery.boundValues();
-            qDebug() << "DatabaseInterface::insertAlbum" << d->mSelectAlbumIdFromTitleAndArtistQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertAlbum" << d->mSelectAlbumIdFromTitleAndArtistQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertAlbum" << d->mSelectAlbumIdFromTitleAndArtistQuery.boundValues();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertAlbum" << d->mSelectAlbumIdFromTitleAndArtistQuery.lastError();
 
             d->mSelectAlbumIdFromTitleAndArtistQuery.finish();
 
@@ -3318,14 +4249,14 @@ qulonglong DatabaseInterface::insertAlbum(const QString &title, const QString &a
         d->mSelectAlbumIdFromTitleWithoutArtistQuery.bindValue(QStringLiteral(":title"), title);
         d->mSelectAlbumIdFromTitleWithoutArtistQuery.bindValue(QStringLiteral(":albumPath"), trackPath);
 
-        auto queryResult = d->mSelectAlbumIdFromTitleWithoutArtistQuery.exec();
+        auto queryResult = execQuery(d->mSelectAlbumIdFromTitleWithoutArtistQuery);
 
         if (!queryResult || !d->mSelectAlbumIdFromTitleWithoutArtistQuery.isSelect() || !d->mSelectAlbumIdFromTitleWithoutArtistQuery.isActive()) {
             Q_EMIT databaseError();
 
-            qDebug() << "DatabaseInterface::insertAlbum" << d->mSelectAlbumIdFromTitleWithoutArtistQuery.lastQuery();
-            qDebug() << "DatabaseInterface::insertAlbum" << d->mSelectAlbumIdFromTitleWithoutArtistQuery.boundValues();
-            qDebug() << "DatabaseInterface::insertAlbum" << d->mSelectAlbumIdFromTitleWithoutArtistQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertAlbum" << d->mSelectAlbumIdFromTitleWithoutArtistQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertAlbum" << d->mSelectAlbumIdFromTitleWithoutArtistQuery.boundValues();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertAlbum" << d->mSelectAlbumIdFromTitleWithoutArtistQuery.lastError();
 
             d->mSelectAlbumIdFromTitleWithoutArtistQuery.finish();
 
@@ -3354,14 +4285,14 @@ qulonglong DatabaseInterface::insertAlbum(const QString &title, const QString &a
     d->mInsertAlbumQuery.bindValue(QStringLiteral(":albumPath"), trackPath);
     d->mInsertAlbumQuery.bindValue(QStringLiteral(":coverFileName"), albumArtURI);
 
-    auto queryResult = d->mInsertAlbumQuery.exec();
+    auto queryResult = execQuery(d->mInsertAlbumQuery);
 
     if (!queryResult || !d->mInsertAlbumQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::insertAlbum" << d->mInsertAlbumQuery.lastQuery();
-        qDebug() << "DatabaseInterface::insertAlbum" << d->mInsertAlbumQuery.boundValues();
-        qDebug() << "DatabaseInterface::insertAlbum" << d->mInsertAlbumQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertAlbum" << d->mInsertAlbumQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertAlbum" << d->mInsertAlbumQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertAlbum" << d->mInsertAlbumQuery.lastError();
 
         d->mInsertAlbumQuery.finish();
 
@@ -3395,14 +4326,14 @@ bool DatabaseInterface::updateAlbumFromId(qulonglong albumId, const QUrl &albumA
         d->mUpdateAlbumArtUriFromAlbumIdQuery.bindValue(QStringLiteral(":albumId"), albumId);
         d->mUpdateAlbumArtUriFromAlbumIdQuery.bindValue(QStringLiteral(":coverFileName"), albumArtUri);
 
-        auto result = d->mUpdateAlbumArtUriFromAlbumIdQuery.exec();
+        auto result = execQuery(d->mUpdateAlbumArtUriFromAlbumIdQuery);
 
         if (!result || !d->mUpdateAlbumArtUriFromAlbumIdQuery.isActive()) {
             Q_EMIT databaseError();
 
-            qDebug() << "DatabaseInterface::updateAlbumFromId" << d->mUpdateAlbumArtUriFromAlbumIdQuery.lastQuery();
-            qDebug() << "DatabaseInterface::updateAlbumFromId" << d->mUpdateAlbumArtUriFromAlbumIdQuery.boundValues();
-            qDebug() << "DatabaseInterface::updateAlbumFromId" << d->mUpdateAlbumArtUriFromAlbumIdQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumFromId" << d->mUpdateAlbumArtUriFromAlbumIdQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumFromId" << d->mUpdateAlbumArtUriFromAlbumIdQuery.boundValues();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumFromId" << d->mUpdateAlbumArtUriFromAlbumIdQuery.lastError();
 
             d->mUpdateAlbumArtUriFromAlbumIdQuery.finish();
 
@@ -3431,16 +4362,21 @@ qulonglong DatabaseInterface::insertArtist(const QString &name)
         return result;
     }
 
+    const auto itName = d->mArtistIds.constFind(name);
+    if (itName != d->mArtistIds.constEnd()) {
+        return itName.value();
+    }
+
     d->mSelectArtistByNameQuery.bindValue(QStringLiteral(":name"), name);
 
-    auto queryResult = d->mSelectArtistByNameQuery.exec();
+    auto queryResult = execQuery(d->mSelectArtistByNameQuery);
 
     if (!queryResult || !d->mSelectArtistByNameQuery.isSelect() || !d->mSelectArtistByNameQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.lastQuery();
-        qDebug() << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.boundValues();
-        qDebug() << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.lastError();
 
         d->mSelectArtistByNameQuery.finish();
 
@@ -3449,6 +4385,7 @@ qulonglong DatabaseInterface::insertArtist(const QString &name)
 
     if (d->mSelectArtistByNameQuery.next()) {
         result = d->mSelectArtistByNameQuery.record().value(0).toULongLong();
+        d->mArtistIds[name] = result;
 
         d->mSelectArtistByNameQuery.finish();
 
@@ -3460,14 +4397,14 @@ qulonglong DatabaseInterface::insertArtist(const QString &name)
     d->mInsertArtistsQuery.bindValue(QStringLiteral(":artistId"), d->mArtistId);
     d->mInsertArtistsQuery.bindValue(QStringLiteral(":name"), name);
 
-    queryResult = d->mInsertArtistsQuery.exec();
+    queryResult = execQuery(d->mInsertArtistsQuery);
 
     if (!queryResult || !d->mInsertArtistsQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::insertArtist" << d->mInsertArtistsQuery.lastQuery();
-        qDebug() << "DatabaseInterface::insertArtist" << d->mInsertArtistsQuery.boundValues();
-        qDebug() << "DatabaseInterface::insertArtist" << d->mInsertArtistsQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mInsertArtistsQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mInsertArtistsQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mInsertArtistsQuery.lastError();
 
         d->mInsertArtistsQuery.finish();
 
@@ -3475,6 +4412,7 @@ qulonglong DatabaseInterface::insertArtist(const QString &name)
     }
 
     result = d->mArtistId;
+    d->mArtistIds[name] = result;
 
     ++d->mArtistId;
 
@@ -3493,16 +4431,21 @@ qulonglong DatabaseInterface::insertComposer(const QString &name)
         return result;
     }
 
+    const auto itName = d->mComposerIds.constFind(name);
+    if (itName != d->mComposerIds.constEnd()) {
+        return itName.value();
+    }
+
     d->mSelectComposerByNameQuery.bindValue(QStringLiteral(":name"), name);
 
-    auto queryResult = d->mSelectComposerByNameQuery.exec();
+    auto queryResult = execQuery(d->mSelectComposerByNameQuery);
 
     if (!queryResult || !d->mSelectComposerByNameQuery.isSelect() || !d->mSelectComposerByNameQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::insertComposer" << d->mSelectComposerByNameQuery.lastQuery();
-        qDebug() << "DatabaseInterface::insertComposer" << d->mSelectComposerByNameQuery.boundValues();
-        qDebug() << "DatabaseInterface::insertComposer" << d->mSelectComposerByNameQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertComposer" << d->mSelectComposerByNameQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertComposer" << d->mSelectComposerByNameQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertComposer" << d->mSelectComposerByNameQuery.lastError();
 
         d->mSelectComposerByNameQuery.finish();
 
@@ -3512,6 +4455,7 @@ qulonglong DatabaseInterface::insertComposer(const QString &name)
 
     if (d->mSelectComposerByNameQuery.next()) {
         result = d->mSelectComposerByNameQuery.record().value(0).toULongLong();
+        d->mComposerIds[name] = result;
 
         d->mSelectComposerByNameQuery.finish();
 
@@ -3523,14 +4467,14 @@ qulonglong DatabaseInterface::insertComposer(const QString &name)
     d->mInsertComposerQuery.bindValue(QStringLiteral(":composerId"), d->mComposerId);
     d->mInsertComposerQuery.bindValue(QStringLiteral(":name"), name);
 
-    queryResult = d->mInsertComposerQuery.exec();
+    queryResult = execQuery(d->mInsertComposerQuery);
 
     if (!queryResult || !d->mInsertComposerQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::insertComposer" << d->mInsertComposerQuery.lastQuery();
-        qDebug() << "DatabaseInterface::insertComposer" << d->mInsertComposerQuery.boundValues();
-        qDebug() << "DatabaseInterface::insertComposer" << d->mInsertComposerQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertComposer" << d->mInsertComposerQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertComposer" << d->mInsertComposerQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertComposer" << d->mInsertComposerQuery.lastError();
 
         d->mInsertComposerQuery.finish();
 
@@ -3538,6 +4482,7 @@ qulonglong DatabaseInterface::insertComposer(const QString &name)
     }
 
     result = d->mComposerId;
+    d->mComposerIds[name] = result;
 
     ++d->mComposerId;
 
@@ -3556,16 +4501,21 @@ qulonglong DatabaseInterface::insertGenre(const QString &name)
         return result;
     }
 
+    const auto itName = d->mGenreIds.constFind(name);
+    if (itName != d->mGenreIds.constEnd()) {
+        return itName.value();
+    }
+
     d->mSelectGenreByNameQuery.bindValue(QStringLiteral(":name"), name);
 
-    auto queryResult = d->mSelectGenreByNameQuery.exec();
+    auto queryResult = execQuery(d->mSelectGenreByNameQuery);
 
     if (!queryResult || !d->mSelectGenreByNameQuery.isSelect() || !d->mSelectGenreByNameQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::insertGenre" << d->mSelectGenreByNameQuery.lastQuery();
-        qDebug() << "DatabaseInterface::insertGenre" << d->mSelectGenreByNameQuery.boundValues();
-        qDebug() << "DatabaseInterface::insertGenre" << d->mSelectGenreByNameQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertGenre" << d->mSelectGenreByNameQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertGenre" << d->mSelectGenreByNameQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertGenre" << d->mSelectGenreByNameQuery.lastError();
 
         d->mSelectGenreByNameQuery.finish();
 
@@ -3574,6 +4524,7 @@ qulonglong DatabaseInterface::insertGenre(const QString &name)
 
     if (d->mSelectGenreByNameQuery.next()) {
         result = d->mSelectGenreByNameQuery.record().value(0).toULongLong();
+        d->mGenreIds[name] = result;
 
         d->mSelectGenreByNameQuery.finish();
 
@@ -3585,14 +4536,14 @@ qulonglong DatabaseInterface::insertGenre(const QString &name)
     d->mInsertGenreQuery.bindValue(QStringLiteral(":genreId"), d->mGenreId);
     d->mInsertGenreQuery.bindValue(QStringLiteral(":name"), name);
 
-    queryResult = d->mInsertGenreQuery.exec();
+    queryResult = execQuery(d->mInsertGenreQuery);
 
     if (!queryResult || !d->mInsertGenreQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::insertGenre" << d->mInsertGenreQuery.lastQuery();
-        qDebug() << "DatabaseInterface::insertGenre" << d->mInsertGenreQuery.boundValues();
-        qDebug() << "DatabaseInterface::insertGenre" << d->mInsertGenreQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertGenre" << d->mInsertGenreQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertGenre" << d->mInsertGenreQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertGenre" << d->mInsertGenreQuery.lastError();
 
         d->mInsertGenreQuery.finish();
 
@@ -3600,6 +4551,7 @@ qulonglong DatabaseInterface::insertGenre(const QString &name)
     }
 
     result = d->mGenreId;
+    d->mGenreIds[name] = result;
 
     ++d->mGenreId;
 
@@ -3618,14 +4570,14 @@ void DatabaseInterface::insertTrackOrigin(const QUrl &fileNameURI, const QDateTi
     d->mInsertTrackMapping.bindValue(QStringLiteral(":priority"), 1);
     d->mInsertTrackMapping.bindValue(QStringLiteral(":mtime"), fileModifiedTime);
 
-    auto queryResult = d->mInsertTrackMapping.exec();
+    auto queryResult = execQuery(d->mInsertTrackMapping);
 
     if (!queryResult || !d->mInsertTrackMapping.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::insertArtist" << d->mInsertTrackMapping.lastQuery();
-        qDebug() << "DatabaseInterface::insertArtist" << d->mInsertTrackMapping.boundValues();
-        qDebug() << "DatabaseInterface::insertArtist" << d->mInsertTrackMapping.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mInsertTrackMapping.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mInsertTrackMapping.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mInsertTrackMapping.lastError();
 
         d->mInsertTrackMapping.finish();
 
@@ -3633,23 +4585,36 @@ void DatabaseInterface::insertTrackOrigin(const QUrl &fileNameURI, const QDateTi
     }
 
     d->mInsertTrackMapping.finish();
+
+    if (d->mTrackDuplicatesLoaded) {
+        d->setTrackFile(fileNameURI.toString(), 0, 1);
+    }
 }
 
 void DatabaseInterface::updateTrackOrigin(qulonglong trackId, const QUrl &fileName, const QDateTime &fileModifiedTime)
 {
+    const auto priority = computeTrackPriority(trackId, fileName);
+
     d->mUpdateTrackMapping.bindValue(QStringLiteral(":trackId"), trackId);
     d->mUpdateTrackMapping.bindValue(QStringLiteral(":fileName"), fileName);
-    d->mUpdateTrackMapping.bindValue(QStringLiteral(":priority"), computeTrackPriority(trackId, fileName));
+    d->mUpdateTrackMapping.bindValue(QStringLiteral(":priority"), priority);
     d->mUpdateTrackMapping.bindValue(QStringLiteral(":mtime"), fileModifiedTime);
+    // recognizes the file when it is found under another name while Elisa was not running
+    const auto fileInfo = QFileInfo(fileName.toLocalFile());
+    if (fileName.isLocalFile() && fileInfo.exists()) {
+        d->mUpdateTrackMapping.bindValue(QStringLiteral(":fileSize"), fileInfo.size());
+    } else {
+        d->mUpdateTrackMapping.bindValue(QStringLiteral(":fileSize"), {});
+    }
 
-    auto queryResult = d->mUpdateTrackMapping.exec();
+    auto queryResult = execQuery(d->mUpdateTrackMapping);
 
     if (!queryResult || !d->mUpdateTrackMapping.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::updateTrackOrigin" << d->mUpdateTrackMapping.lastQuery();
-        qDebug() << "DatabaseInterface::updateTrackOrigin" << d->mUpdateTrackMapping.boundValues();
-        qDebug() << "DatabaseInterface::updateTrackOrigin" << d->mUpdateTrackMapping.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackOrigin" << d->mUpdateTrackMapping.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackOrigin" << d->mUpdateTrackMapping.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackOrigin" << d->mUpdateTrackMapping.lastError();
 
         d->mUpdateTrackMapping.finish();
 
@@ -3657,6 +4622,10 @@ void DatabaseInterface::updateTrackOrigin(qulonglong trackId, const QUrl &fileNa
     }
 
     d->mInsertTrackMapping.finish();
+
+    if (d->mTrackDuplicatesLoaded) {
+        d->setTrackFile(fileName.toString(), trackId, priority);
+    }
 }
 
 int DatabaseInterface::computeTrackPriority(qulonglong trackId, const QUrl &fileName)
@@ -3667,54 +4636,9 @@ int DatabaseInterface::computeTrackPriority(qulonglong trackId, const QUrl &file
         return result;
     }
 
-    d->mSelectTracksMappingPriority.bindValue(QStringLiteral(":trackId"), trackId);
-    d->mSelectTracksMappingPriority.bindValue(QStringLiteral(":fileName"), fileName);
-
-    auto queryResult = d->mSelectTracksMappingPriority.exec();
-
-    if (!queryResult || !d->mSelectTracksMappingPriority.isSelect() || !d->mSelectTracksMappingPriority.isActive()) {
-        Q_EMIT databaseError();
-
-        qDebug() << "DatabaseInterface::internalTrackIdFromFileName" << d->mSelectTracksMappingPriority.lastQuery();
-        qDebug() << "DatabaseInterface::internalTrackIdFromFileName" << d->mSelectTracksMappingPriority.boundValues();
-        qDebug() << "DatabaseInterface::internalTrackIdFromFileName" << d->mSelectTracksMappingPriority.lastError();
-
-        d->mSelectTracksMappingPriority.finish();
-
-        return result;
-    }
-
-    if (d->mSelectTracksMappingPriority.next()) {
-        result = d->mSelectTracksMappingPriority.record().value(0).toInt();
-
-        d->mSelectTracksMappingPriority.finish();
-
-        return result;
-    }
-
-    d->mSelectTracksMappingPriority.finish();
+    loadTrackDuplicatesIndex();
 
-    d->mSelectTracksMappingPriorityByTrackId.bindValue(QStringLiteral(":trackId"), trackId);
-
-    queryResult = d->mSelectTracksMappingPriorityByTrackId.exec();
-
-    if (!queryResult || !d->mSelectTracksMappingPriorityByTrackId.isSelect() || !d->mSelectTracksMappingPriorityByTrackId.isActive()) {
-        Q_EMIT databaseError();
-
-        qDebug() << "DatabaseInterface::internalTrackIdFromFileName" << d->mSelectTracksMappingPriorityByTrackId.lastQuery();
-        qDebug() << "DatabaseInterface::internalTrackIdFromFileName" << d->mSelectTracksMappingPriorityByTrackId.boundValues();
-        qDebug() << "DatabaseInterface::internalTrackIdFromFileName" << d->mSelectTracksMappingPriorityByTrackId.lastError();
-
-        d->mSelectTracksMappingPriorityByTrackId.finish();
-
-        return result;
-    }
-
-    if (d->mSelectTracksMappingPriorityByTrackId.next()) {
-        result = d->mSelectTracksMappingPriorityByTrackId.record().value(0).toInt() + 1;
-    }
-
-    d->mSelectTracksMappingPriorityByTrackId.finish();
+    result = d->trackFilePriority(trackId, fileName.toString());
 
     return result;
 }
@@ -3740,9 +4664,11 @@ qulonglong DatabaseInterface::internalInsertTrack(const MusicAudioTrack &oneTrac
     auto albumId = insertAlbum(oneTrack.albumName(), (oneTrack.isValidAlbumArtist() ? oneTrack.albumArtist() : QString()),
                                oneTrack.artist(), trackPath, covers[oneTrack.resourceURI().toString()]);
 
-    auto otherTrackId = getDuplicateTrackIdFromTitleAlbumTrackDiscNumber(oneTrack.title(), oneTrack.artist(), oneTrack.albumName(),
-                                                                         oneTrack.albumArtist(), trackPath, oneTrack.trackNumber(),
-                                                                         oneTrack.discNumber());
+    const auto &albumData = internalOneAlbumPartialData(albumId);
+
+    auto otherTrackId = getDuplicateTrackIdFromTitleAlbumTrackDiscNumber(oneTrack.title(), albumData[AlbumDataType::key_type::TitleRole].toString(),
+                                                                         albumData[AlbumDataType::key_type::ArtistRole].toString(),
+                                                                         trackPath, oneTrack.trackNumber(), oneTrack.discNumber());
     bool isModifiedTrack = (otherTrackId != 0) || (insertType == TrackFileInsertType::ModifiedTrackFileInsert);
     bool isSameTrack = false;
 
@@ -3774,13 +4700,14 @@ qulonglong DatabaseInterface::internalInsertTrack(const MusicAudioTrack &oneTrac
         isSameTrack = isSameTrack && (oldTrack.channels() == oneTrack.channels());
         isSameTrack = isSameTrack && (oldTrack.bitRate() == oneTrack.bitRate());
         isSameTrack = isSameTrack && (oldTrack.sampleRate() == oneTrack.sampleRate());
+        isSameTrack = isSameTrack && (oldTrack.hasEmbeddedCover() == oneTrack.hasEmbeddedCover());
 
         oldAlbumId = internalAlbumIdFromTitleAndArtist(oldTrack.albumName(), oldTrack.albumArtist());
 
         if (!isSameTrack) {
             auto newTrack = oneTrack;
             newTrack.setDatabaseId(oldTrack.databaseId());
-            updateTrackInDatabase(newTrack, trackPath);
+            updateTrackInDatabase(newTrack, trackPath, albumId);
             updateTrackOrigin(newTrack.databaseId(), oneTrack.resourceURI(), oneTrack.fileModificationTime());
             updateAlbumFromId(albumId, oneTrack.albumCover(), oneTrack, trackPath);
 
@@ -3805,26 +4732,37 @@ qulonglong DatabaseInterface::internalInsertTrack(const MusicAudioTrack &oneTrac
         originTrackId = d->mTrackId;
     }
 
-    resultId = originTrackId;
-
-    const auto &albumData = internalOneAlbumPartialData(albumId);
+    resultId = originTrackId;
 
     if (!isSameTrack) {
         d->mInsertTrackQuery.bindValue(QStringLiteral(":trackId"), originTrackId);
         d->mInsertTrackQuery.bindValue(QStringLiteral(":title"), oneTrack.title());
-        insertArtist(oneTrack.artist());
+        const auto artistId = insertArtist(oneTrack.artist());
         d->mInsertTrackQuery.bindValue(QStringLiteral(":artistName"), oneTrack.artist());
+        if (artistId != 0) {
+            d->mInsertTrackQuery.bindValue(QStringLiteral(":artistId"), artistId);
+        } else {
+            d->mInsertTrackQuery.bindValue(QStringLiteral(":artistId"), {});
+        }
         d->mInsertTrackQuery.bindValue(QStringLiteral(":albumTitle"), albumData[AlbumDataType::key_type::TitleRole]);
+        if (albumId != 0) {
+            d->mInsertTrackQuery.bindValue(QStringLiteral(":albumId"), albumId);
+        } else {
+            d->mInsertTrackQuery.bindValue(QStringLiteral(":albumId"), {});
+        }
         d->mInsertTrackQuery.bindValue(QStringLiteral(":albumArtistName"), albumData[AlbumDataType::key_type::ArtistRole]);
         d->mInsertTrackQuery.bindValue(QStringLiteral(":albumPath"), trackPath);
         d->mInsertTrackQuery.bindValue(QStringLiteral(":trackNumber"), oneTrack.trackNumber());
         d->mInsertTrackQuery.bindValue(QStringLiteral(":discNumber"), oneTrack.discNumber());
         d->mInsertTrackQuery.bindValue(QStringLiteral(":trackDuration"), QVariant::fromValue<qlonglong>(oneTrack.duration().msecsSinceStartOfDay()));
         d->mInsertTrackQuery.bindValue(QStringLiteral(":trackRating"), oneTrack.rating());
-        if (insertGenre(oneTrack.genre()) != 0) {
+        const auto genreId = insertGenre(oneTrack.genre());
+        if (genreId != 0) {
             d->mInsertTrackQuery.bindValue(QStringLiteral(":genre"), oneTrack.genre());
+            d->mInsertTrackQuery.bindValue(QStringLiteral(":genreId"), genreId);
         } else {
             d->mInsertTrackQuery.bindValue(QStringLiteral(":genre"), {});
+            d->mInsertTrackQuery.bindValue(QStringLiteral(":genreId"), {});
         }
         if (insertComposer(oneTrack.composer()) != 0) {
             d->mInsertTrackQuery.bindValue(QStringLiteral(":composer"), oneTrack.composer());
@@ -3844,7 +4782,7 @@ qulonglong DatabaseInterface::internalInsertTrack(const MusicAudioTrack &oneTrac
         d->mInsertTrackQuery.bindValue(QStringLiteral(":hasEmbeddedCover"), oneTrack.hasEmbeddedCover());
         d->mInsertTrackQuery.bindValue(QStringLiteral(":importDate"), QDateTime::currentDateTime().toMSecsSinceEpoch());
 
-        auto result = d->mInsertTrackQuery.exec();
+        auto result = execQuery(d->mInsertTrackQuery);
 
         if (result && d->mInsertTrackQuery.isActive()) {
             d->mInsertTrackQuery.finish();
@@ -3853,6 +4791,17 @@ qulonglong DatabaseInterface::internalInsertTrack(const MusicAudioTrack &oneTrac
                 ++d->mTrackId;
             }
 
+            if (d->mTrackDuplicatesLoaded) {
+                auto insertedTrack = TrackUniqueEntry{};
+                insertedTrack.mTrackId = originTrackId;
+                insertedTrack.mTitle = oneTrack.title();
+                insertedTrack.mAlbumArtistName = albumData[AlbumDataType::key_type::ArtistRole].toString();
+                insertedTrack.mTrackNumber = oneTrack.trackNumber();
+                insertedTrack.mDiscNumber = oneTrack.discNumber();
+
+                d->setTrackUniqueEntry({albumData[AlbumDataType::key_type::TitleRole].toString(), trackPath}, insertedTrack);
+            }
+
             updateTrackOrigin(originTrackId, oneTrack.resourceURI(), oneTrack.fileModificationTime());
 
             if (isModifiedTrack) {
@@ -3881,10 +4830,10 @@ qulonglong DatabaseInterface::internalInsertTrack(const MusicAudioTrack &oneTrac
 
             Q_EMIT databaseError();
 
-            qDebug() << "DatabaseInterface::internalInsertTrack" << oneTrack << oneTrack.resourceURI();
-            qDebug() << "DatabaseInterface::internalInsertTrack" << d->mInsertTrackQuery.lastQuery();
-            qDebug() << "DatabaseInterface::internalInsertTrack" << d->mInsertTrackQuery.boundValues();
-            qDebug() << "DatabaseInterface::internalInsertTrack" << d->mInsertTrackQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertTrack" << oneTrack << oneTrack.resourceURI();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertTrack" << d->mInsertTrackQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertTrack" << d->mInsertTrackQuery.boundValues();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertTrack" << d->mInsertTrackQuery.lastError();
         }
     }
 
@@ -3939,52 +4888,72 @@ DatabaseInterface::TrackDataType DatabaseInterface::buildTrackDataFromDatabaseRe
 {
     TrackDataType result;
 
-    result[TrackDataType::key_type::DatabaseIdRole] = trackRecord.value(0);
-    result[TrackDataType::key_type::TitleRole] = trackRecord.value(1);
-    result[TrackDataType::key_type::AlbumRole] = trackRecord.value(10);
-    result[TrackDataType::key_type::AlbumIdRole] = trackRecord.value(2);
-    result[TrackDataType::key_type::ArtistRole] = trackRecord.value(3);
-    result[TrackDataType::key_type::AlbumArtistRole] = trackRecord.value(4);
-    result[TrackDataType::key_type::ResourceRole] = trackRecord.value(5);
-    result[TrackDataType::key_type::TrackNumberRole] = trackRecord.value(7);
-    result[TrackDataType::key_type::DiscNumberRole] = trackRecord.value(8);
-    result[TrackDataType::key_type::DurationRole] = QTime::fromMSecsSinceStartOfDay(trackRecord.value(9).toInt());
-    result[TrackDataType::key_type::MilliSecondsDurationRole] = trackRecord.value(9).toInt();
-    result[TrackDataType::key_type::RatingRole] = trackRecord.value(11);
-    result[TrackDataType::key_type::ImageUrlRole] = QUrl(trackRecord.value(12).toString());
-    result[TrackDataType::key_type::IsSingleDiscAlbumRole] = trackRecord.value(13);
-    result[TrackDataType::key_type::GenreRole] = trackRecord.value(14);
-    result[TrackDataType::key_type::ComposerRole] = trackRecord.value(15);
-    result[TrackDataType::key_type::LyricistRole] = trackRecord.value(16);
-    result[TrackDataType::key_type::HasEmbeddedCover] = trackRecord.value(22);
-    result[TrackDataType::key_type::FileModificationTime] = trackRecord.value(6);
-    result[TrackDataType::key_type::FirstPlayDate] = trackRecord.value(24);
-    result[TrackDataType::key_type::LastPlayDate] = trackRecord.value(25);
-    result[TrackDataType::key_type::PlayCounter] = trackRecord.value(26);
-    result[TrackDataType::key_type::PlayFrequency] = trackRecord.value(27);
+    const auto &roles = trackDataRoles();
+
+    auto trackValues = QVector<QVariant>(roles.size());
+    trackValuesFromDatabaseRecord(trackRecord, trackValues);
+
+    for (int column = 0; column < roles.size(); ++column) {
+        result[roles[column]] = trackValues[column];
+    }
     result[DataType::key_type::ElementTypeRole] = ElisaUtils::Track;
 
     return result;
 }
 
+void DatabaseInterface::trackValuesFromDatabaseRecord(const QSqlRecord &trackRecord, QVector<QVariant> &trackValues) const
+{
+    trackValues[0] = trackRecord.value(0);
+    trackValues[1] = trackRecord.value(1);
+    trackValues[2] = trackRecord.value(10);
+    trackValues[3] = trackRecord.value(2);
+    trackValues[4] = trackRecord.value(3);
+    trackValues[5] = trackRecord.value(4);
+    trackValues[6] = trackRecord.value(5);
+    trackValues[7] = trackRecord.value(7);
+    trackValues[8] = trackRecord.value(8);
+    trackValues[9] = QTime::fromMSecsSinceStartOfDay(trackRecord.value(9).toInt());
+    trackValues[10] = trackRecord.value(9).toInt();
+    trackValues[11] = trackRecord.value(11);
+    trackValues[12] = QUrl(trackRecord.value(12).toString());
+    trackValues[13] = trackRecord.value(13);
+    trackValues[14] = trackRecord.value(14);
+    trackValues[15] = trackRecord.value(15);
+    trackValues[16] = trackRecord.value(16);
+    trackValues[17] = trackRecord.value(22);
+    trackValues[18] = trackRecord.value(6);
+    trackValues[19] = trackRecord.value(24);
+    trackValues[20] = trackRecord.value(25);
+    trackValues[21] = trackRecord.value(26);
+    trackValues[22] = trackRecord.value(27);
+    trackValues[23] = trackRecord.value(28);
+    trackValues[24] = trackRecord.value(29);
+    trackValues[25] = trackRecord.value(30);
+    trackValues[26] = trackRecord.value(31);
+}
+
 void DatabaseInterface::internalRemoveTracksList(const QList<QUrl> &removedTracks)
 {
+    loadTrackDuplicatesIndex();
+
     for (const auto &removedTrackFileName : removedTracks) {
         d->mRemoveTracksMapping.bindValue(QStringLiteral(":fileName"), removedTrackFileName.toString());
 
-        auto result = d->mRemoveTracksMapping.exec();
+        auto result = execQuery(d->mRemoveTracksMapping);
 
         if (!result || !d->mRemoveTracksMapping.isActive()) {
             Q_EMIT databaseError();
 
-            qDebug() << "DatabaseInterface::internalRemoveTracksList" << d->mRemoveTracksMapping.lastQuery();
-            qDebug() << "DatabaseInterface::internalRemoveTracksList" << d->mRemoveTracksMapping.boundValues();
-            qDebug() << "DatabaseInterface::internalRemoveTracksList" << d->mRemoveTracksMapping.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalRemoveTracksList" << d->mRemoveTracksMapping.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalRemoveTracksList" << d->mRemoveTracksMapping.boundValues();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalRemoveTracksList" << d->mRemoveTracksMapping.lastError();
 
             continue;
         }
 
         d->mRemoveTracksMapping.finish();
+
+        recordRemovedTrackFile(removedTrackFileName);
     }
 
     internalRemoveTracksWithoutMapping();
@@ -3992,23 +4961,27 @@ void DatabaseInterface::internalRemoveTracksList(const QList<QUrl> &removedTrack
 
 void DatabaseInterface::internalRemoveTracksList(const QHash<QUrl, QDateTime> &removedTracks, qulonglong sourceId)
 {
+    loadTrackDuplicatesIndex();
+
     for (auto itRemovedTrack = removedTracks.begin(); itRemovedTrack != removedTracks.end(); ++itRemovedTrack) {
         d->mRemoveTracksMappingFromSource.bindValue(QStringLiteral(":fileName"), itRemovedTrack.key().toString());
         d->mRemoveTracksMappingFromSource.bindValue(QStringLiteral(":sourceId"), sourceId);
 
-        auto result = d->mRemoveTracksMappingFromSource.exec();
+        auto result = execQuery(d->mRemoveTracksMappingFromSource);
 
         if (!result || !d->mRemoveTracksMappingFromSource.isActive()) {
             Q_EMIT databaseError();
 
-            qDebug() << "DatabaseInterface::removeTracksList" << d->mRemoveTracksMappingFromSource.lastQuery();
-            qDebug() << "DatabaseInterface::removeTracksList" << d->mRemoveTracksMappingFromSource.boundValues();
-            qDebug() << "DatabaseInterface::removeTracksList" << d->mRemoveTracksMappingFromSource.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::removeTracksList" << d->mRemoveTracksMappingFromSource.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::removeTracksList" << d->mRemoveTracksMappingFromSource.boundValues();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::removeTracksList" << d->mRemoveTracksMappingFromSource.lastError();
 
             continue;
         }
 
         d->mRemoveTracksMappingFromSource.finish();
+
+        recordRemovedTrackFile(itRemovedTrack.key());
     }
 
     internalRemoveTracksWithoutMapping();
@@ -4016,14 +4989,14 @@ void DatabaseInterface::internalRemoveTracksList(const QHash<QUrl, QDateTime> &r
 
 void DatabaseInterface::internalRemoveTracksWithoutMapping()
 {
-    auto queryResult = d->mSelectTracksWithoutMappingQuery.exec();
+    auto queryResult = execQuery(d->mSelectTracksWithoutMappingQuery);
 
     if (!queryResult || !d->mSelectTracksWithoutMappingQuery.isSelect() || !d->mSelectTracksWithoutMappingQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::insertArtist" << d->mSelectTracksWithoutMappingQuery.lastQuery();
-        qDebug() << "DatabaseInterface::insertArtist" << d->mSelectTracksWithoutMappingQuery.boundValues();
-        qDebug() << "DatabaseInterface::insertArtist" << d->mSelectTracksWithoutMappingQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mSelectTracksWithoutMappingQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mSelectTracksWithoutMappingQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mSelectTracksWithoutMappingQuery.lastError();
 
         d->mSelectTracksWithoutMappingQuery.finish();
 
@@ -4049,6 +5022,7 @@ void DatabaseInterface::internalRemoveTracksWithoutMapping()
 
     for (const auto &oneRemovedTrack : willRemoveTrack) {
         removeTrackInDatabase(oneRemovedTrack.databaseId());
+        d->mModifiedTrackIds.remove(oneRemovedTrack.databaseId());
 
         Q_EMIT trackRemoved(oneRemovedTrack.databaseId());
 
@@ -4097,14 +5071,14 @@ QUrl DatabaseInterface::internalAlbumArtUriFromAlbumId(qulonglong albumId)
 
     d->mSelectAlbumArtUriFromAlbumIdQuery.bindValue(QStringLiteral(":albumId"), albumId);
 
-    auto queryResult = d->mSelectAlbumArtUriFromAlbumIdQuery.exec();
+    auto queryResult = execQuery(d->mSelectAlbumArtUriFromAlbumIdQuery);
 
     if (!queryResult || !d->mSelectAlbumArtUriFromAlbumIdQuery.isSelect() || !d->mSelectAlbumArtUriFromAlbumIdQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::insertArtist" << d->mSelectAlbumArtUriFromAlbumIdQuery.lastQuery();
-        qDebug() << "DatabaseInterface::insertArtist" << d->mSelectAlbumArtUriFromAlbumIdQuery.boundValues();
-        qDebug() << "DatabaseInterface::insertArtist" << d->mSelectAlbumArtUriFromAlbumIdQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mSelectAlbumArtUriFromAlbumIdQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mSelectAlbumArtUriFromAlbumIdQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mSelectAlbumArtUriFromAlbumIdQuery.lastError();
 
         d->mSelectAlbumArtUriFromAlbumIdQuery.finish();
 
@@ -4130,14 +5104,14 @@ bool DatabaseInterface::isValidArtist(qulonglong albumId)
 
     d->mSelectAlbumQuery.bindValue(QStringLiteral(":albumId"), albumId);
 
-    auto queryResult = d->mSelectAlbumQuery.exec();
+    auto queryResult = execQuery(d->mSelectAlbumQuery);
 
     if (!queryResult || !d->mSelectAlbumQuery.isSelect() || !d->mSelectAlbumQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::internalAlbumFromId" << d->mSelectAlbumQuery.lastQuery();
-        qDebug() << "DatabaseInterface::internalAlbumFromId" << d->mSelectAlbumQuery.boundValues();
-        qDebug() << "DatabaseInterface::internalAlbumFromId" << d->mSelectAlbumQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalAlbumFromId" << d->mSelectAlbumQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalAlbumFromId" << d->mSelectAlbumQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalAlbumFromId" << d->mSelectAlbumQuery.lastError();
 
         d->mSelectAlbumQuery.finish();
 
@@ -4163,14 +5137,14 @@ qulonglong DatabaseInterface::internalSourceIdFromName(const QString &sourceName
 
     d->mSelectMusicSource.bindValue(QStringLiteral(":name"), sourceName);
 
-    auto queryResult = d->mSelectMusicSource.exec();
+    auto queryResult = execQuery(d->mSelectMusicSource);
 
     if (!queryResult || !d->mSelectMusicSource.isSelect() || !d->mSelectMusicSource.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::insertMusicSource" << d->mSelectMusicSource.lastQuery();
-        qDebug() << "DatabaseInterface::insertMusicSource" << d->mSelectMusicSource.boundValues();
-        qDebug() << "DatabaseInterface::insertMusicSource" << d->mSelectMusicSource.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertMusicSource" << d->mSelectMusicSource.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertMusicSource" << d->mSelectMusicSource.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertMusicSource" << d->mSelectMusicSource.lastError();
 
         d->mSelectMusicSource.finish();
 
@@ -4188,20 +5162,20 @@ qulonglong DatabaseInterface::internalSourceIdFromName(const QString &sourceName
     return sourceId;
 }
 
-QHash<QUrl, QDateTime> DatabaseInterface::internalAllFileNameFromSource(qulonglong sourceId)
+QHash<QUrl, QDateTime> DatabaseInterface::internalAllFileNameFromSource(qulonglong sourceId, QHash<QUrl, qint64> *fileSizes)
 {
     QHash<QUrl, QDateTime> allFileNames;
 
     d->mSelectAllTrackFilesFromSourceQuery.bindValue(QStringLiteral(":discoverId"), sourceId);
 
-    auto queryResult = d->mSelectAllTrackFilesFromSourceQuery.exec();
+    auto queryResult = execQuery(d->mSelectAllTrackFilesFromSourceQuery);
 
     if (!queryResult || !d->mSelectAllTrackFilesFromSourceQuery.isSelect() || !d->mSelectAllTrackFilesFromSourceQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::insertMusicSource" << d->mSelectAllTrackFilesFromSourceQuery.lastQuery();
-        qDebug() << "DatabaseInterface::insertMusicSource" << d->mSelectAllTrackFilesFromSourceQuery.boundValues();
-        qDebug() << "DatabaseInterface::insertMusicSource" << d->mSelectAllTrackFilesFromSourceQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertMusicSource" << d->mSelectAllTrackFilesFromSourceQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertMusicSource" << d->mSelectAllTrackFilesFromSourceQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertMusicSource" << d->mSelectAllTrackFilesFromSourceQuery.lastError();
 
         d->mSelectAllTrackFilesFromSourceQuery.finish();
 
@@ -4213,6 +5187,11 @@ QHash<QUrl, QDateTime> DatabaseInterface::internalAllFileNameFromSource(qulonglo
         auto fileModificationTime = d->mSelectAllTrackFilesFromSourceQuery.record().value(1).toDateTime();
 
         allFileNames[fileName] = fileModificationTime;
+
+        const auto &fileSize = d->mSelectAllTrackFilesFromSourceQuery.record().value(2);
+        if (fileSizes && !fileSize.isNull()) {
+            (*fileSizes)[fileName] = fileSize.toLongLong();
+        }
     }
 
     d->mSelectAllTrackFilesFromSourceQuery.finish();
@@ -4224,14 +5203,14 @@ bool DatabaseInterface::internalGenericPartialData(QSqlQuery &query)
 {
     auto result = false;
 
-    auto queryResult = query.exec();
+    auto queryResult = execQuery(query);
 
     if (!queryResult || !query.isSelect() || !query.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::internalAllGenericPartialData" << query.lastQuery();
-        qDebug() << "DatabaseInterface::internalAllGenericPartialData" << query.boundValues();
-        qDebug() << "DatabaseInterface::internalAllGenericPartialData" << query.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalAllGenericPartialData" << query.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalAllGenericPartialData" << query.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalAllGenericPartialData" << query.lastError();
 
         query.finish();
 
@@ -4256,16 +5235,21 @@ qulonglong DatabaseInterface::insertLyricist(const QString &name)
         return result;
     }
 
+    const auto itName = d->mLyricistIds.constFind(name);
+    if (itName != d->mLyricistIds.constEnd()) {
+        return itName.value();
+    }
+
     d->mSelectLyricistByNameQuery.bindValue(QStringLiteral(":name"), name);
 
-    auto queryResult = d->mSelectLyricistByNameQuery.exec();
+    auto queryResult = execQuery(d->mSelectLyricistByNameQuery);
 
     if (!queryResult || !d->mSelectLyricistByNameQuery.isSelect() || !d->mSelectLyricistByNameQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::insertLyricist" << d->mSelectLyricistByNameQuery.lastQuery();
-        qDebug() << "DatabaseInterface::insertLyricist" << d->mSelectLyricistByNameQuery.boundValues();
-        qDebug() << "DatabaseInterface::insertLyricist" << d->mSelectLyricistByNameQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertLyricist" << d->mSelectLyricistByNameQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertLyricist" << d->mSelectLyricistByNameQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertLyricist" << d->mSelectLyricistByNameQuery.lastError();
 
         d->mSelectLyricistByNameQuery.finish();
 
@@ -4274,6 +5258,7 @@ qulonglong DatabaseInterface::insertLyricist(const QString &name)
 
     if (d->mSelectLyricistByNameQuery.next()) {
         result = d->mSelectLyricistByNameQuery.record().value(0).toULongLong();
+        d->mLyricistIds[name] = result;
 
         d->mSelectLyricistByNameQuery.finish();
 
@@ -4285,14 +5270,14 @@ qulonglong DatabaseInterface::insertLyricist(const QString &name)
     d->mInsertLyricistQuery.bindValue(QStringLiteral(":lyricistId"), d->mLyricistId);
     d->mInsertLyricistQuery.bindValue(QStringLiteral(":name"), name);
 
-    queryResult = d->mInsertLyricistQuery.exec();
+    queryResult = execQuery(d->mInsertLyricistQuery);
 
     if (!queryResult || !d->mInsertLyricistQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::insertLyricist" << d->mInsertLyricistQuery.lastQuery();
-        qDebug() << "DatabaseInterface::insertLyricist" << d->mInsertLyricistQuery.boundValues();
-        qDebug() << "DatabaseInterface::insertLyricist" << d->mInsertLyricistQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertLyricist" << d->mInsertLyricistQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertLyricist" << d->mInsertLyricistQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertLyricist" << d->mInsertLyricistQuery.lastError();
 
         d->mInsertLyricistQuery.finish();
 
@@ -4300,6 +5285,7 @@ qulonglong DatabaseInterface::insertLyricist(const QString &name)
     }
 
     result = d->mLyricistId;
+    d->mLyricistIds[name] = result;
 
     ++d->mLyricistId;
 
@@ -4318,16 +5304,21 @@ qulonglong DatabaseInterface::internalArtistIdFromName(const QString &name)
         return result;
     }
 
+    const auto itArtist = d->mArtistIds.constFind(name);
+    if (itArtist != d->mArtistIds.constEnd()) {
+        return itArtist.value();
+    }
+
     d->mSelectArtistByNameQuery.bindValue(QStringLiteral(":name"), name);
 
-    auto queryResult = d->mSelectArtistByNameQuery.exec();
+    auto queryResult = execQuery(d->mSelectArtistByNameQuery);
 
     if (!queryResult || !d->mSelectArtistByNameQuery.isSelect() || !d->mSelectArtistByNameQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.lastQuery();
-        qDebug() << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.boundValues();
-        qDebug() << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertArtist" << d->mSelectArtistByNameQuery.lastError();
 
         d->mSelectArtistByNameQuery.finish();
 
@@ -4341,6 +5332,7 @@ qulonglong DatabaseInterface::internalArtistIdFromName(const QString &name)
     }
 
     result = d->mSelectArtistByNameQuery.record().value(0).toULongLong();
+    d->mArtistIds[name] = result;
 
     d->mSelectArtistByNameQuery.finish();
 
@@ -4349,28 +5341,40 @@ qulonglong DatabaseInterface::internalArtistIdFromName(const QString &name)
 
 void DatabaseInterface::removeTrackInDatabase(qulonglong trackId)
 {
+    d->removeTrack(trackId);
+
     d->mRemoveTrackQuery.bindValue(QStringLiteral(":trackId"), trackId);
 
-    auto result = d->mRemoveTrackQuery.exec();
+    auto result = execQuery(d->mRemoveTrackQuery);
 
     if (!result || !d->mRemoveTrackQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::removeTrackInDatabase" << d->mRemoveTrackQuery.lastQuery();
-        qDebug() << "DatabaseInterface::removeTrackInDatabase" << d->mRemoveTrackQuery.boundValues();
-        qDebug() << "DatabaseInterface::removeTrackInDatabase" << d->mRemoveTrackQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::removeTrackInDatabase" << d->mRemoveTrackQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::removeTrackInDatabase" << d->mRemoveTrackQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::removeTrackInDatabase" << d->mRemoveTrackQuery.lastError();
     }
 
     d->mRemoveTrackQuery.finish();
 }
 
-void DatabaseInterface::updateTrackInDatabase(const MusicAudioTrack &oneTrack, const QString &albumPath)
+void DatabaseInterface::updateTrackInDatabase(const MusicAudioTrack &oneTrack, const QString &albumPath, qulonglong albumId)
 {
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":trackId"), oneTrack.databaseId());
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":title"), oneTrack.title());
-    insertArtist(oneTrack.artist());
+    const auto artistId = insertArtist(oneTrack.artist());
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":artistName"), oneTrack.artist());
+    if (artistId != 0) {
+        d->mUpdateTrackQuery.bindValue(QStringLiteral(":artistId"), artistId);
+    } else {
+        d->mUpdateTrackQuery.bindValue(QStringLiteral(":artistId"), {});
+    }
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":albumTitle"), oneTrack.albumName());
+    if (albumId != 0) {
+        d->mUpdateTrackQuery.bindValue(QStringLiteral(":albumId"), albumId);
+    } else {
+        d->mUpdateTrackQuery.bindValue(QStringLiteral(":albumId"), {});
+    }
     if (oneTrack.isValidAlbumArtist()) {
         d->mUpdateTrackQuery.bindValue(QStringLiteral(":albumArtistName"), oneTrack.albumArtist());
     } else {
@@ -4381,10 +5385,13 @@ void DatabaseInterface::updateTrackInDatabase(const MusicAudioTrack &oneTrack, c
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":discNumber"), oneTrack.discNumber());
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":trackDuration"), QVariant::fromValue<qlonglong>(oneTrack.duration().msecsSinceStartOfDay()));
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":trackRating"), oneTrack.rating());
-    if (insertGenre(oneTrack.genre()) != 0) {
+    const auto genreId = insertGenre(oneTrack.genre());
+    if (genreId != 0) {
         d->mUpdateTrackQuery.bindValue(QStringLiteral(":genre"), oneTrack.genre());
+        d->mUpdateTrackQuery.bindValue(QStringLiteral(":genreId"), genreId);
     } else {
         d->mUpdateTrackQuery.bindValue(QStringLiteral(":genre"), {});
+        d->mUpdateTrackQuery.bindValue(QStringLiteral(":genreId"), {});
     }
     if (insertComposer(oneTrack.composer()) != 0) {
         d->mUpdateTrackQuery.bindValue(QStringLiteral(":composer"), oneTrack.composer());
@@ -4401,32 +5408,73 @@ void DatabaseInterface::updateTrackInDatabase(const MusicAudioTrack &oneTrack, c
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":channels"), oneTrack.channels());
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":bitRate"), oneTrack.bitRate());
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":sampleRate"), oneTrack.sampleRate());
+    d->mUpdateTrackQuery.bindValue(QStringLiteral(":hasEmbeddedCover"), oneTrack.hasEmbeddedCover());
 
-    auto result = d->mUpdateTrackQuery.exec();
+    auto result = execQuery(d->mUpdateTrackQuery);
 
     if (!result || !d->mUpdateTrackQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::updateTrackInDatabase" << d->mUpdateTrackQuery.lastQuery();
-        qDebug() << "DatabaseInterface::updateTrackInDatabase" << d->mUpdateTrackQuery.boundValues();
-        qDebug() << "DatabaseInterface::updateTrackInDatabase" << d->mUpdateTrackQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackInDatabase" << d->mUpdateTrackQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackInDatabase" << d->mUpdateTrackQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackInDatabase" << d->mUpdateTrackQuery.lastError();
     }
 
     d->mUpdateTrackQuery.finish();
+
+    if (d->mTrackDuplicatesLoaded) {
+        auto updatedTrack = TrackUniqueEntry{};
+        updatedTrack.mTrackId = oneTrack.databaseId();
+        updatedTrack.mTitle = oneTrack.title();
+        updatedTrack.mAlbumArtistName = (oneTrack.isValidAlbumArtist() ? oneTrack.albumArtist() : QString());
+        updatedTrack.mTrackNumber = oneTrack.trackNumber();
+        updatedTrack.mDiscNumber = oneTrack.discNumber();
+
+        d->setTrackUniqueEntry({oneTrack.albumName(), albumPath}, updatedTrack);
+    }
+}
+
+qulonglong DatabaseInterface::moveTrackToDirectory(qulonglong trackId, const QUrl &newFileName, const QHash<QString, QUrl> &covers)
+{
+    const auto movedTrack = internalTrackFromDatabaseId(trackId);
+    if (!movedTrack.isValid()) {
+        return 0;
+    }
+
+    QUrl::FormattingOptions currentOptions = QUrl::PreferLocalFile |
+            QUrl::RemoveAuthority | QUrl::RemoveFilename | QUrl::RemoveFragment |
+            QUrl::RemovePassword | QUrl::RemovePort | QUrl::RemoveQuery |
+            QUrl::RemoveScheme | QUrl::RemoveUserInfo;
+
+    const auto &albumPath = newFileName.toString(currentOptions);
+    const auto &albumCover = covers.value(newFileName.toString());
+
+    const auto newAlbumId = insertAlbum(movedTrack.albumName(), (movedTrack.isValidAlbumArtist() ? movedTrack.albumArtist() : QString()),
+                                        movedTrack.artist(), albumPath, albumCover);
+
+    if (newAlbumId != 0 && !d->mInsertedAlbums.contains(newAlbumId)) {
+        updateAlbumFromId(newAlbumId, albumCover, movedTrack, albumPath);
+        recordModifiedAlbum(newAlbumId);
+    }
+
+    // the play history stays with the track row, only its album columns change
+    updateTrackInDatabase(movedTrack, albumPath, newAlbumId);
+
+    return (movedTrack.albumId() != newAlbumId ? movedTrack.albumId() : 0);
 }
 
 void DatabaseInterface::removeAlbumInDatabase(qulonglong albumId)
 {
     d->mRemoveAlbumQuery.bindValue(QStringLiteral(":albumId"), albumId);
 
-    auto result = d->mRemoveAlbumQuery.exec();
+    auto result = execQuery(d->mRemoveAlbumQuery);
 
     if (!result || !d->mRemoveAlbumQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::removeAlbumInDatabase" << d->mRemoveAlbumQuery.lastQuery();
-        qDebug() << "DatabaseInterface::removeAlbumInDatabase" << d->mRemoveAlbumQuery.boundValues();
-        qDebug() << "DatabaseInterface::removeAlbumInDatabase" << d->mRemoveAlbumQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::removeAlbumInDatabase" << d->mRemoveAlbumQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::removeAlbumInDatabase" << d->mRemoveAlbumQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::removeAlbumInDatabase" << d->mRemoveAlbumQuery.lastError();
     }
 
     d->mRemoveAlbumQuery.finish();
@@ -4434,16 +5482,23 @@ void DatabaseInterface::removeAlbumInDatabase(qulonglong albumId)
 
 void DatabaseInterface::removeArtistInDatabase(qulonglong artistId)
 {
+    for (auto itArtist = d->mArtistIds.begin(); itArtist != d->mArtistIds.end(); ++itArtist) {
+        if (itArtist.value() == artistId) {
+            d->mArtistIds.erase(itArtist);
+            break;
+        }
+    }
+
     d->mRemoveArtistQuery.bindValue(QStringLiteral(":artistId"), artistId);
 
-    auto result = d->mRemoveArtistQuery.exec();
+    auto result = execQuery(d->mRemoveArtistQuery);
 
     if (!result || !d->mRemoveArtistQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::removeArtistInDatabase" << d->mRemoveArtistQuery.lastQuery();
-        qDebug() << "DatabaseInterface::removeArtistInDatabase" << d->mRemoveArtistQuery.boundValues();
-        qDebug() << "DatabaseInterface::removeArtistInDatabase" << d->mRemoveArtistQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::removeArtistInDatabase" << d->mRemoveArtistQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::removeArtistInDatabase" << d->mRemoveArtistQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::removeArtistInDatabase" << d->mRemoveArtistQuery.lastError();
     }
 
     d->mRemoveArtistQuery.finish();
@@ -4451,7 +5506,7 @@ void DatabaseInterface::removeArtistInDatabase(qulonglong artistId)
 
 void DatabaseInterface::reloadExistingDatabase()
 {
-    qDebug() << "DatabaseInterface::reloadExistingDatabase";
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::reloadExistingDatabase";
 
     d->mArtistId = initialId(DataUtils::DataType::AllArtists);
     d->mComposerId = initialId(DataUtils::DataType::AllComposers);
@@ -4461,6 +5516,130 @@ void DatabaseInterface::reloadExistingDatabase()
     d->mGenreId = initialId(DataUtils::DataType::AllGenres);;
 }
 
+void DatabaseInterface::initNamesCache()
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    loadNamesCache(QStringLiteral("Artists"), d->mArtistIds);
+    loadNamesCache(QStringLiteral("Composer"), d->mComposerIds);
+    loadNamesCache(QStringLiteral("Lyricist"), d->mLyricistIds);
+    loadNamesCache(QStringLiteral("Genre"), d->mGenreIds);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+}
+
+void DatabaseInterface::loadNamesCache(const QString &tableName, QHash<QString, qulonglong> &namesCache)
+{
+    namesCache.clear();
+
+    QSqlQuery selectNamesQuery(d->mTracksDatabase);
+    selectNamesQuery.setForwardOnly(true);
+
+    auto queryResult = selectNamesQuery.exec(QStringLiteral("SELECT `ID`, `Name` FROM `") + tableName + QStringLiteral("`"));
+
+    if (!queryResult || !selectNamesQuery.isSelect() || !selectNamesQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::loadNamesCache" << selectNamesQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::loadNamesCache" << selectNamesQuery.lastError();
+
+        return;
+    }
+
+    while (selectNamesQuery.next()) {
+        const auto &currentRecord = selectNamesQuery.record();
+
+        namesCache[currentRecord.value(1).toString()] = currentRecord.value(0).toULongLong();
+    }
+
+    selectNamesQuery.finish();
+}
+
+void DatabaseInterface::loadTrackDuplicatesIndex()
+{
+    if (d->mTrackDuplicatesLoaded) {
+        return;
+    }
+
+    d->clearTrackDuplicates();
+
+    QSqlQuery selectTracksQuery(d->mTracksDatabase);
+    selectTracksQuery.setForwardOnly(true);
+
+    auto queryResult = selectTracksQuery.exec(QStringLiteral("SELECT `ID`, `Title`, `AlbumTitle`, `AlbumArtistName`, "
+                                                             "`AlbumPath`, `TrackNumber`, `DiscNumber` "
+                                                             "FROM `Tracks`"));
+
+    if (!queryResult || !selectTracksQuery.isSelect() || !selectTracksQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::loadTrackDuplicatesIndex" << selectTracksQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::loadTrackDuplicatesIndex" << selectTracksQuery.lastError();
+
+        return;
+    }
+
+    while (selectTracksQuery.next()) {
+        const auto &currentRecord = selectTracksQuery.record();
+
+        auto oneTrack = TrackUniqueEntry{};
+        oneTrack.mTrackId = currentRecord.value(0).toULongLong();
+        oneTrack.mTitle = currentRecord.value(1).toString();
+        oneTrack.mAlbumArtistName = currentRecord.value(3).toString();
+        oneTrack.mTrackNumber = currentRecord.value(5).toInt();
+        oneTrack.mDiscNumber = currentRecord.value(6).toInt();
+
+        d->setTrackUniqueEntry({currentRecord.value(2).toString(), currentRecord.value(4).toString()}, oneTrack);
+    }
+
+    selectTracksQuery.finish();
+
+    QSqlQuery selectTracksMappingQuery(d->mTracksDatabase);
+    selectTracksMappingQuery.setForwardOnly(true);
+
+    queryResult = selectTracksMappingQuery.exec(QStringLiteral("SELECT `TrackID`, `FileName`, `Priority` FROM `TracksMapping`"));
+
+    if (!queryResult || !selectTracksMappingQuery.isSelect() || !selectTracksMappingQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::loadTrackDuplicatesIndex" << selectTracksMappingQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::loadTrackDuplicatesIndex" << selectTracksMappingQuery.lastError();
+
+        d->clearTrackDuplicates();
+
+        return;
+    }
+
+    while (selectTracksMappingQuery.next()) {
+        const auto &currentRecord = selectTracksMappingQuery.record();
+
+        d->setTrackFile(currentRecord.value(1).toString(), currentRecord.value(0).toULongLong(), currentRecord.value(2).toInt());
+    }
+
+    selectTracksMappingQuery.finish();
+
+    d->mTrackDuplicatesLoaded = true;
+}
+
+void DatabaseInterface::recordRemovedTrackFile(const QUrl &fileName)
+{
+    if (!d->mTrackDuplicatesLoaded) {
+        return;
+    }
+
+    const auto trackWithOtherFile = d->removeTrackFile(fileName.toString());
+
+    if (trackWithOtherFile != 0) {
+        recordModifiedTrack(trackWithOtherFile);
+    }
+}
+
 qulonglong DatabaseInterface::initialId(DataUtils::DataType aType)
 {
     switch (aType)
@@ -4492,14 +5671,14 @@ qulonglong DatabaseInterface::genericInitialId(QSqlQuery &request)
         return result;
     }
 
-    auto queryResult = request.exec();
+    auto queryResult = execQuery(request);
 
     if (!queryResult || !request.isSelect() || !request.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::insertMusicSource" << request.lastQuery();
-        qDebug() << "DatabaseInterface::insertMusicSource" << request.boundValues();
-        qDebug() << "DatabaseInterface::insertMusicSource" << request.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertMusicSource" << request.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertMusicSource" << request.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertMusicSource" << request.lastError();
 
         request.finish();
 
@@ -4531,14 +5710,14 @@ qulonglong DatabaseInterface::insertMusicSource(const QString &name)
 
     d->mSelectMusicSource.bindValue(QStringLiteral(":name"), name);
 
-    auto queryResult = d->mSelectMusicSource.exec();
+    auto queryResult = execQuery(d->mSelectMusicSource);
 
     if (!queryResult || !d->mSelectMusicSource.isSelect() || !d->mSelectMusicSource.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::insertMusicSource" << d->mSelectMusicSource.lastQuery();
-        qDebug() << "DatabaseInterface::insertMusicSource" << d->mSelectMusicSource.boundValues();
-        qDebug() << "DatabaseInterface::insertMusicSource" << d->mSelectMusicSource.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertMusicSource" << d->mSelectMusicSource.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertMusicSource" << d->mSelectMusicSource.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertMusicSource" << d->mSelectMusicSource.lastError();
 
         d->mSelectMusicSource.finish();
 
@@ -4558,14 +5737,14 @@ qulonglong DatabaseInterface::insertMusicSource(const QString &name)
     d->mInsertMusicSource.bindValue(QStringLiteral(":discoverId"), d->mDiscoverId);
     d->mInsertMusicSource.bindValue(QStringLiteral(":name"), name);
 
-    queryResult = d->mInsertMusicSource.exec();
+    queryResult = execQuery(d->mInsertMusicSource);
 
     if (!queryResult || !d->mInsertMusicSource.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::insertMusicSource" << d->mInsertMusicSource.lastQuery();
-        qDebug() << "DatabaseInterface::insertMusicSource" << d->mInsertMusicSource.boundValues();
-        qDebug() << "DatabaseInterface::insertMusicSource" << d->mInsertMusicSource.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertMusicSource" << d->mInsertMusicSource.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertMusicSource" << d->mInsertMusicSource.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::insertMusicSource" << d->mInsertMusicSource.lastError();
 
         d->mInsertMusicSource.finish();
 
@@ -4585,14 +5764,14 @@ QList<qulonglong> DatabaseInterface::fetchTrackIds(qulonglong albumId)
 
     d->mSelectTrackQuery.bindValue(QStringLiteral(":albumId"), albumId);
 
-    auto result = d->mSelectTrackQuery.exec();
+    auto result = execQuery(d->mSelectTrackQuery);
 
     if (!result || !d->mSelectTrackQuery.isSelect() || !d->mSelectTrackQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::fetchTrackIds" << d->mSelectTrackQuery.lastQuery();
-        qDebug() << "DatabaseInterface::fetchTrackIds" << d->mSelectTrackQuery.boundValues();
-        qDebug() << "DatabaseInterface::fetchTrackIds" << d->mSelectTrackQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::fetchTrackIds" << d->mSelectTrackQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::fetchTrackIds" << d->mSelectTrackQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::fetchTrackIds" << d->mSelectTrackQuery.lastError();
     }
 
     while (d->mSelectTrackQuery.next()) {
@@ -4613,14 +5792,14 @@ qulonglong DatabaseInterface::internalAlbumIdFromTitleAndArtist(const QString &t
     d->mSelectAlbumIdFromTitleQuery.bindValue(QStringLiteral(":title"), title);
     d->mSelectAlbumIdFromTitleQuery.bindValue(QStringLiteral(":artistName"), artist);
 
-    auto queryResult = d->mSelectAlbumIdFromTitleQuery.exec();
+    auto queryResult = execQuery(d->mSelectAlbumIdFromTitleQuery);
 
     if (!queryResult || !d->mSelectAlbumIdFromTitleQuery.isSelect() || !d->mSelectAlbumIdFromTitleQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::internalAlbumIdFromTitleAndArtist" << d->mSelectAlbumIdFromTitleQuery.lastQuery();
-        qDebug() << "DatabaseInterface::internalAlbumIdFromTitleAndArtist" << d->mSelectAlbumIdFromTitleQuery.boundValues();
-        qDebug() << "DatabaseInterface::internalAlbumIdFromTitleAndArtist" << d->mSelectAlbumIdFromTitleQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalAlbumIdFromTitleAndArtist" << d->mSelectAlbumIdFromTitleQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalAlbumIdFromTitleAndArtist" << d->mSelectAlbumIdFromTitleQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalAlbumIdFromTitleAndArtist" << d->mSelectAlbumIdFromTitleQuery.lastError();
 
         d->mSelectAlbumIdFromTitleQuery.finish();
 
@@ -4636,14 +5815,14 @@ qulonglong DatabaseInterface::internalAlbumIdFromTitleAndArtist(const QString &t
     if (result == 0) {
         d->mSelectAlbumIdFromTitleWithoutArtistQuery.bindValue(QStringLiteral(":title"), title);
 
-        auto queryResult = d->mSelectAlbumIdFromTitleWithoutArtistQuery.exec();
+        auto queryResult = execQuery(d->mSelectAlbumIdFromTitleWithoutArtistQuery);
 
         if (!queryResult || !d->mSelectAlbumIdFromTitleWithoutArtistQuery.isSelect() || !d->mSelectAlbumIdFromTitleWithoutArtistQuery.isActive()) {
             Q_EMIT databaseError();
 
-            qDebug() << "DatabaseInterface::internalAlbumIdFromTitleAndArtist" << d->mSelectAlbumIdFromTitleWithoutArtistQuery.lastQuery();
-            qDebug() << "DatabaseInterface::internalAlbumIdFromTitleAndArtist" << d->mSelectAlbumIdFromTitleWithoutArtistQuery.boundValues();
-            qDebug() << "DatabaseInterface::internalAlbumIdFromTitleAndArtist" << d->mSelectAlbumIdFromTitleWithoutArtistQuery.lastError();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalAlbumIdFromTitleAndArtist" << d->mSelectAlbumIdFromTitleWithoutArtistQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalAlbumIdFromTitleAndArtist" << d->mSelectAlbumIdFromTitleWithoutArtistQuery.boundValues();
+            qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalAlbumIdFromTitleAndArtist" << d->mSelectAlbumIdFromTitleWithoutArtistQuery.lastError();
 
             d->mSelectAlbumIdFromTitleWithoutArtistQuery.finish();
 
@@ -4674,14 +5853,14 @@ MusicAudioTrack DatabaseInterface::internalTrackFromDatabaseId(qulonglong id)
 
     d->mSelectTrackFromIdQuery.bindValue(QStringLiteral(":trackId"), id);
 
-    auto queryResult = d->mSelectTrackFromIdQuery.exec();
+    auto queryResult = execQuery(d->mSelectTrackFromIdQuery);
 
     if (!queryResult || !d->mSelectTrackFromIdQuery.isSelect() || !d->mSelectTrackFromIdQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::internalTrackFromDatabaseId" << d->mSelectAlbumQuery.lastQuery();
-        qDebug() << "DatabaseInterface::internalTrackFromDatabaseId" << d->mSelectAlbumQuery.boundValues();
-        qDebug() << "DatabaseInterface::internalTrackFromDatabaseId" << d->mSelectAlbumQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackFromDatabaseId" << d->mSelectAlbumQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackFromDatabaseId" << d->mSelectAlbumQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackFromDatabaseId" << d->mSelectAlbumQuery.lastError();
 
         d->mSelectTrackFromIdQuery.finish();
 
@@ -4718,14 +5897,14 @@ qulonglong DatabaseInterface::internalTrackIdFromTitleAlbumTracDiscNumber(const
     d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery.bindValue(QStringLiteral(":trackNumber"), trackNumber);
     d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery.bindValue(QStringLiteral(":discNumber"), discNumber);
 
-    auto queryResult = d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery.exec();
+    auto queryResult = execQuery(d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery);
 
     if (!queryResult || !d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery.isSelect() || !d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::trackIdFromTitleAlbumArtist" << d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery.lastQuery();
-        qDebug() << "DatabaseInterface::trackIdFromTitleAlbumArtist" << d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery.boundValues();
-        qDebug() << "DatabaseInterface::trackIdFromTitleAlbumArtist" << d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::trackIdFromTitleAlbumArtist" << d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::trackIdFromTitleAlbumArtist" << d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::trackIdFromTitleAlbumArtist" << d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery.lastError();
 
         d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery.finish();
 
@@ -4741,9 +5920,9 @@ qulonglong DatabaseInterface::internalTrackIdFromTitleAlbumTracDiscNumber(const
     return result;
 }
 
-qulonglong DatabaseInterface::getDuplicateTrackIdFromTitleAlbumTrackDiscNumber(const QString &title, const QString &trackArtist,
-                                                                               const QString &album, const QString &albumArtist,
-                                                                               const QString &trackPath, int trackNumber, int discNumber)
+qulonglong DatabaseInterface::getDuplicateTrackIdFromTitleAlbumTrackDiscNumber(const QString &title, const QString &album,
+                                                                               const QString &albumArtist, const QString &trackPath,
+                                                                               int trackNumber, int discNumber)
 {
     auto result = qulonglong(0);
 
@@ -4751,33 +5930,15 @@ qulonglong DatabaseInterface::getDuplicateTrackIdFromTitleAlbumTrackDiscNumber(c
         return result;
     }
 
-    d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.bindValue(QStringLiteral(":title"), title);
-    d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.bindValue(QStringLiteral(":trackArtist"), trackArtist);
-    d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.bindValue(QStringLiteral(":album"), album);
-    d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.bindValue(QStringLiteral(":albumPath"), trackPath);
-    d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.bindValue(QStringLiteral(":albumArtist"), albumArtist);
-    d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.bindValue(QStringLiteral(":trackNumber"), trackNumber);
-    d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.bindValue(QStringLiteral(":discNumber"), discNumber);
-
-    auto queryResult = d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.exec();
+    loadTrackDuplicatesIndex();
 
-    if (!queryResult || !d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.isSelect() || !d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.isActive()) {
-        Q_EMIT databaseError();
-
-        qDebug() << "DatabaseInterface::trackIdFromTitleAlbumArtist" << d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.lastQuery();
-        qDebug() << "DatabaseInterface::trackIdFromTitleAlbumArtist" << d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.boundValues();
-        qDebug() << "DatabaseInterface::trackIdFromTitleAlbumArtist" << d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.lastError();
-
-        d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.finish();
-
-        return result;
-    }
-
-    if (d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.next()) {
-        result = d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.record().value(0).toULongLong();
-    }
+    auto track = TrackUniqueEntry{};
+    track.mTitle = title;
+    track.mAlbumArtistName = albumArtist;
+    track.mTrackNumber = trackNumber;
+    track.mDiscNumber = discNumber;
 
-    d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.finish();
+    result = d->duplicateTrackId({album, trackPath}, track);
 
     return result;
 }
@@ -4792,14 +5953,14 @@ qulonglong DatabaseInterface::internalTrackIdFromFileName(const QUrl &fileName)
 
     d->mSelectTracksMapping.bindValue(QStringLiteral(":fileName"), fileName);
 
-    auto queryResult = d->mSelectTracksMapping.exec();
+    auto queryResult = execQuery(d->mSelectTracksMapping);
 
     if (!queryResult || !d->mSelectTracksMapping.isSelect() || !d->mSelectTracksMapping.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::internalTrackIdFromFileName" << d->mSelectTracksMapping.lastQuery();
-        qDebug() << "DatabaseInterface::internalTrackIdFromFileName" << d->mSelectTracksMapping.boundValues();
-        qDebug() << "DatabaseInterface::internalTrackIdFromFileName" << d->mSelectTracksMapping.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackIdFromFileName" << d->mSelectTracksMapping.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackIdFromFileName" << d->mSelectTracksMapping.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackIdFromFileName" << d->mSelectTracksMapping.lastError();
 
         d->mSelectTracksMapping.finish();
 
@@ -4824,14 +5985,14 @@ DatabaseInterface::ListTrackDataType DatabaseInterface::internalTracksFromAuthor
 
     d->mSelectTracksFromArtist.bindValue(QStringLiteral(":artistName"), ArtistName);
 
-    auto result = d->mSelectTracksFromArtist.exec();
+    auto result = execQuery(d->mSelectTracksFromArtist);
 
     if (!result || !d->mSelectTracksFromArtist.isSelect() || !d->mSelectTracksFromArtist.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::tracksFromAuthor" << d->mSelectTracksFromArtist.lastQuery();
-        qDebug() << "DatabaseInterface::tracksFromAuthor" << d->mSelectTracksFromArtist.boundValues();
-        qDebug() << "DatabaseInterface::tracksFromAuthor" << d->mSelectTracksFromArtist.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromAuthor" << d->mSelectTracksFromArtist.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromAuthor" << d->mSelectTracksFromArtist.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromAuthor" << d->mSelectTracksFromArtist.lastError();
 
         return allTracks;
     }
@@ -4842,6 +6003,8 @@ DatabaseInterface::ListTrackDataType DatabaseInterface::internalTracksFromAuthor
         allTracks.push_back(buildTrackDataFromDatabaseRecord(currentRecord));
     }
 
+    recordQueryRows(d->mSelectTracksFromArtist, allTracks.size());
+
     d->mSelectTracksFromArtist.finish();
 
     return allTracks;
@@ -4853,14 +6016,14 @@ QList<qulonglong> DatabaseInterface::internalAlbumIdsFromAuthor(const QString &A
 
     d->mSelectAlbumIdsFromArtist.bindValue(QStringLiteral(":artistName"), ArtistName);
 
-    auto result = d->mSelectAlbumIdsFromArtist.exec();
+    auto result = execQuery(d->mSelectAlbumIdsFromArtist);
 
     if (!result || !d->mSelectAlbumIdsFromArtist.isSelect() || !d->mSelectAlbumIdsFromArtist.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::tracksFromAuthor" << d->mSelectAlbumIdsFromArtist.lastQuery();
-        qDebug() << "DatabaseInterface::tracksFromAuthor" << d->mSelectAlbumIdsFromArtist.boundValues();
-        qDebug() << "DatabaseInterface::tracksFromAuthor" << d->mSelectAlbumIdsFromArtist.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromAuthor" << d->mSelectAlbumIdsFromArtist.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromAuthor" << d->mSelectAlbumIdsFromArtist.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromAuthor" << d->mSelectAlbumIdsFromArtist.lastError();
 
         return allAlbumIds;
     }
@@ -4878,28 +6041,39 @@ QList<qulonglong> DatabaseInterface::internalAlbumIdsFromAuthor(const QString &A
 
 DatabaseInterface::ListArtistDataType DatabaseInterface::internalAllArtistsPartialData(QSqlQuery &artistsQuery)
 {
-    auto result = ListArtistDataType{};
+    auto stream = DataBlockStream{};
+
+    internalAllArtistsDataBlock(artistsQuery, stream);
+
+    return stream.result()->toList<ListArtistDataType>();
+}
+
+void DatabaseInterface::internalAllArtistsDataBlock(QSqlQuery &artistsQuery, DataBlockStream &stream)
+{
+    stream.start(ElisaUtils::Artist, artistDataRoles());
 
     if (!internalGenericPartialData(artistsQuery)) {
-        return result;
+        stream.finish();
+        return;
     }
 
-    while(artistsQuery.next()) {
-        auto newData = ArtistDataType{};
+    auto artistValues = QVector<QVariant>(artistDataRoles().size());
 
+    while(artistsQuery.next()) {
         const auto &currentRecord = artistsQuery.record();
 
-        newData[DataType::key_type::DatabaseIdRole] = currentRecord.value(0);
-        newData[DataType::key_type::TitleRole] = currentRecord.value(1);
-        newData[DataType::key_type::GenreRole] = QVariant::fromValue(currentRecord.value(2).toString().split(QStringLiteral(", ")));
-        newData[DataType::key_type::ElementTypeRole] = ElisaUtils::Artist;
+        artistValues[0] = currentRecord.value(0);
+        artistValues[1] = currentRecord.value(1);
+        artistValues[2] = QVariant::fromValue(currentRecord.value(2).toString().split(QStringLiteral(", ")));
 
-        result.push_back(newData);
+        stream.appendRow(artistValues);
     }
 
+    recordQueryRows(artistsQuery, stream.rowCount());
+
     artistsQuery.finish();
 
-    return result;
+    stream.finish();
 }
 
 DatabaseInterface::ArtistDataType DatabaseInterface::internalOneArtistPartialData(qulonglong databaseId)
@@ -4928,34 +6102,45 @@ DatabaseInterface::ArtistDataType DatabaseInterface::internalOneArtistPartialDat
 
 DatabaseInterface::ListAlbumDataType DatabaseInterface::internalAllAlbumsPartialData(QSqlQuery &query)
 {
-    auto result = ListAlbumDataType{};
+    auto stream = DataBlockStream{};
+
+    internalAllAlbumsDataBlock(query, stream);
+
+    return stream.result()->toList<ListAlbumDataType>();
+}
+
+void DatabaseInterface::internalAllAlbumsDataBlock(QSqlQuery &query, DataBlockStream &stream)
+{
+    stream.start(ElisaUtils::Album, albumDataRoles());
 
     if (!internalGenericPartialData(query)) {
-        return result;
+        stream.finish();
+        return;
     }
 
-    while(query.next()) {
-        auto newData = AlbumDataType{};
+    auto albumValues = QVector<QVariant>(albumDataRoles().size());
 
+    while(query.next()) {
         const auto &currentRecord = query.record();
 
-        newData[DataType::key_type::DatabaseIdRole] = currentRecord.value(0);
-        newData[DataType::key_type::TitleRole] = currentRecord.value(1);
-        newData[DataType::key_type::SecondaryTextRole] = currentRecord.value(2);
-        newData[DataType::key_type::ImageUrlRole] = currentRecord.value(3);
-        newData[DataType::key_type::ArtistRole] = currentRecord.value(4);
-        newData[DataType::key_type::AllArtistsRole] = QVariant::fromValue(currentRecord.value(5).toString().split(QStringLiteral(", ")));
-        newData[DataType::key_type::HighestTrackRating] = currentRecord.value(6);
-        newData[DataType::key_type::IsSingleDiscAlbumRole] = currentRecord.value(8);
-        newData[DataType::key_type::GenreRole] = QVariant::fromValue(currentRecord.value(7).toString().split(QStringLiteral(", ")));
-        newData[DataType::key_type::ElementTypeRole] = ElisaUtils::Album;
+        albumValues[0] = currentRecord.value(0);
+        albumValues[1] = currentRecord.value(1);
+        albumValues[2] = currentRecord.value(2);
+        albumValues[3] = currentRecord.value(3);
+        albumValues[4] = currentRecord.value(4);
+        albumValues[5] = QVariant::fromValue(currentRecord.value(5).toString().split(QStringLiteral(", ")));
+        albumValues[6] = currentRecord.value(6);
+        albumValues[7] = currentRecord.value(8);
+        albumValues[8] = QVariant::fromValue(currentRecord.value(7).toString().split(QStringLiteral(", ")));
 
-        result.push_back(newData);
+        stream.appendRow(albumValues);
     }
 
+    recordQueryRows(query, stream.rowCount());
+
     query.finish();
 
-    return result;
+    stream.finish();
 }
 
 DatabaseInterface::AlbumDataType DatabaseInterface::internalOneAlbumPartialData(qulonglong databaseId)
@@ -4990,23 +6175,37 @@ DatabaseInterface::AlbumDataType DatabaseInterface::internalOneAlbumPartialData(
 
 DatabaseInterface::ListTrackDataType DatabaseInterface::internalAllTracksPartialData()
 {
-    auto result = ListTrackDataType{};
+    auto stream = DataBlockStream{};
+
+    internalAllTracksDataBlock(stream);
+
+    return stream.result()->toList<ListTrackDataType>();
+}
+
+void DatabaseInterface::internalAllTracksDataBlock(DataBlockStream &stream)
+{
+    stream.start(ElisaUtils::Track, trackDataRoles());
 
     if (!internalGenericPartialData(d->mSelectAllTracksQuery)) {
-        return result;
+        stream.finish();
+        return;
     }
 
+    auto trackValues = QVector<QVariant>(trackDataRoles().size());
+
     while(d->mSelectAllTracksQuery.next()) {
         const auto &currentRecord = d->mSelectAllTracksQuery.record();
 
-        auto newData = buildTrackDataFromDatabaseRecord(currentRecord);
+        trackValuesFromDatabaseRecord(currentRecord, trackValues);
 
-        result.push_back(newData);
+        stream.appendRow(trackValues);
     }
 
+    recordQueryRows(d->mSelectAllTracksQuery, stream.rowCount());
+
     d->mSelectAllTracksQuery.finish();
 
-    return result;
+    stream.finish();
 }
 
 DatabaseInterface::ListTrackDataType DatabaseInterface::internalRecentlyPlayedTracksData(int count)
@@ -5027,6 +6226,8 @@ DatabaseInterface::ListTrackDataType DatabaseInterface::internalRecentlyPlayedTr
         result.push_back(newData);
     }
 
+    recordQueryRows(d->mSelectAllRecentlyPlayedTracksQuery, result.size());
+
     d->mSelectAllRecentlyPlayedTracksQuery.finish();
 
     return result;
@@ -5050,6 +6251,8 @@ DatabaseInterface::ListTrackDataType DatabaseInterface::internalFrequentlyPlayed
         result.push_back(newData);
     }
 
+    recordQueryRows(d->mSelectAllFrequentlyPlayedTracksQuery, result.size());
+
     d->mSelectAllFrequentlyPlayedTracksQuery.finish();
 
     return result;
@@ -5078,27 +6281,38 @@ DatabaseInterface::TrackDataType DatabaseInterface::internalOneTrackPartialData(
 
 DatabaseInterface::ListGenreDataType DatabaseInterface::internalAllGenresPartialData()
 {
-    ListGenreDataType result;
+    auto stream = DataBlockStream{};
+
+    internalAllGenresDataBlock(stream);
+
+    return stream.result()->toList<ListGenreDataType>();
+}
+
+void DatabaseInterface::internalAllGenresDataBlock(DataBlockStream &stream)
+{
+    stream.start(ElisaUtils::Genre, genreDataRoles());
 
     if (!internalGenericPartialData(d->mSelectAllGenresQuery)) {
-        return result;
+        stream.finish();
+        return;
     }
 
-    while(d->mSelectAllGenresQuery.next()) {
-        auto newData = GenreDataType{};
+    auto genreValues = QVector<QVariant>(genreDataRoles().size());
 
+    while(d->mSelectAllGenresQuery.next()) {
         const auto &currentRecord = d->mSelectAllGenresQuery.record();
 
-        newData[DataType::key_type::DatabaseIdRole] = currentRecord.value(0);
-        newData[DataType::key_type::TitleRole] = currentRecord.value(1);
-        newData[DataType::key_type::ElementTypeRole] = ElisaUtils::Genre;
+        genreValues[0] = currentRecord.value(0);
+        genreValues[1] = currentRecord.value(1);
 
-        result.push_back(newData);
+        stream.appendRow(genreValues);
     }
 
+    recordQueryRows(d->mSelectAllGenresQuery, stream.rowCount());
+
     d->mSelectAllGenresQuery.finish();
 
-    return result;
+    stream.finish();
 }
 
 DatabaseInterface::GenreDataType DatabaseInterface::internalOneGenrePartialData(qulonglong databaseId)
@@ -5144,6 +6358,8 @@ DatabaseInterface::ListArtistDataType DatabaseInterface::internalAllComposersPar
         result.push_back(newData);
     }
 
+    recordQueryRows(d->mSelectAllComposersQuery, result.size());
+
     d->mSelectAllComposersQuery.finish();
 
     return result;
@@ -5192,6 +6408,8 @@ DatabaseInterface::ListArtistDataType DatabaseInterface::internalAllLyricistsPar
         result.push_back(newData);
     }
 
+    recordQueryRows(d->mSelectAllLyricistsQuery, result.size());
+
     d->mSelectAllLyricistsQuery.finish();
 
     return result;
@@ -5226,6 +6444,51 @@ bool DatabaseInterface::prepareQuery(QSqlQuery &query, const QString &queryText)
     return query.prepare(queryText);
 }
 
+bool DatabaseInterface::execQuery(QSqlQuery &query)
+{
+    if (!mStatistics) {
+        return query.exec();
+    }
+
+    QElapsedTimer queryTimer;
+    queryTimer.start();
+
+    auto result = query.exec();
+
+    const auto elapsedTime = queryTimer.nsecsElapsed();
+
+    mStatistics->recordQuery(query.lastQuery(), elapsedTime);
+
+    if (elapsedTime > qint64(mStatistics->slowQueryThreshold()) * 1000 * 1000) {
+        qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::execQuery" << "slow query" << elapsedTime / 1000000 << "ms" << query.lastQuery().simplified();
+        qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::execQuery" << "slow query" << query.boundValues();
+    }
+
+    return result;
+}
+
+void DatabaseInterface::recordQueryRows(const QSqlQuery &query, int rowsCount) const
+{
+    if (!mStatistics) {
+        return;
+    }
+
+    mStatistics->recordRows(query.lastQuery(), rowsCount);
+}
+
+void DatabaseInterface::recordTransaction(const QString &name, const QElapsedTimer &timer, int tracksCount) const
+{
+    if (!mStatistics) {
+        return;
+    }
+
+    const auto elapsedTime = timer.nsecsElapsed();
+
+    mStatistics->recordTransaction(name, elapsedTime, tracksCount);
+
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::recordTransaction" << name << tracksCount << "tracks in" << elapsedTime / 1000000 << "ms";
+}
+
 void DatabaseInterface::updateAlbumArtist(qulonglong albumId, const QString &title,
                                           const QString &albumPath,
                                           const QString &artistName)
@@ -5234,14 +6497,14 @@ void DatabaseInterface::updateAlbumArtist(qulonglong albumId, const QString &tit
     insertArtist(artistName);
     d->mUpdateAlbumArtistQuery.bindValue(QStringLiteral(":artistName"), artistName);
 
-    auto queryResult = d->mUpdateAlbumArtistQuery.exec();
+    auto queryResult = execQuery(d->mUpdateAlbumArtistQuery);
 
     if (!queryResult || !d->mUpdateAlbumArtistQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::updateAlbumArtist" << d->mUpdateAlbumArtistQuery.lastQuery();
-        qDebug() << "DatabaseInterface::updateAlbumArtist" << d->mUpdateAlbumArtistQuery.boundValues();
-        qDebug() << "DatabaseInterface::updateAlbumArtist" << d->mUpdateAlbumArtistQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumArtist" << d->mUpdateAlbumArtistQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumArtist" << d->mUpdateAlbumArtistQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumArtist" << d->mUpdateAlbumArtistQuery.lastError();
 
         d->mUpdateAlbumArtistQuery.finish();
 
@@ -5254,14 +6517,14 @@ void DatabaseInterface::updateAlbumArtist(qulonglong albumId, const QString &tit
     d->mUpdateAlbumArtistInTracksQuery.bindValue(QStringLiteral(":albumPath"), albumPath);
     d->mUpdateAlbumArtistInTracksQuery.bindValue(QStringLiteral(":artistName"), artistName);
 
-    queryResult = d->mUpdateAlbumArtistInTracksQuery.exec();
+    queryResult = execQuery(d->mUpdateAlbumArtistInTracksQuery);
 
     if (!queryResult || !d->mUpdateAlbumArtistInTracksQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::updateAlbumArtist" << d->mUpdateAlbumArtistInTracksQuery.lastQuery();
-        qDebug() << "DatabaseInterface::updateAlbumArtist" << d->mUpdateAlbumArtistInTracksQuery.boundValues();
-        qDebug() << "DatabaseInterface::updateAlbumArtist" << d->mUpdateAlbumArtistInTracksQuery.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumArtist" << d->mUpdateAlbumArtistInTracksQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumArtist" << d->mUpdateAlbumArtistInTracksQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumArtist" << d->mUpdateAlbumArtistInTracksQuery.lastError();
 
         d->mUpdateAlbumArtistInTracksQuery.finish();
 
@@ -5269,6 +6532,85 @@ void DatabaseInterface::updateAlbumArtist(qulonglong albumId, const QString &tit
     }
 
     d->mUpdateAlbumArtistInTracksQuery.finish();
+
+    if (d->mTrackDuplicatesLoaded) {
+        d->setAlbumArtistOfTracks({title, albumPath}, artistName);
+    }
+}
+
+void DatabaseInterface::updateAlbumLoudness(qulonglong albumId)
+{
+    d->mSelectAlbumTracksLoudnessQuery.bindValue(QStringLiteral(":albumId"), albumId);
+
+    auto queryResult = execQuery(d->mSelectAlbumTracksLoudnessQuery);
+
+    if (!queryResult || !d->mSelectAlbumTracksLoudnessQuery.isSelect() || !d->mSelectAlbumTracksLoudnessQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumLoudness" << d->mSelectAlbumTracksLoudnessQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumLoudness" << d->mSelectAlbumTracksLoudnessQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumLoudness" << d->mSelectAlbumTracksLoudnessQuery.lastError();
+
+        d->mSelectAlbumTracksLoudnessQuery.finish();
+
+        return;
+    }
+
+    auto albumTrackIds = QList<qulonglong>{};
+    auto tracksLoudness = QVector<qreal>{};
+    auto tracksDuration = QVector<qreal>{};
+    auto albumPeak = qreal{0.};
+    auto isComplete = true;
+
+    while (d->mSelectAlbumTracksLoudnessQuery.next()) {
+        const auto &currentRecord = d->mSelectAlbumTracksLoudnessQuery.record();
+
+        albumTrackIds.push_back(currentRecord.value(0).toULongLong());
+
+        if (currentRecord.value(1).isNull()) {
+            // tracks that failed to decode are left out of the album gain instead of blocking it
+            if (currentRecord.value(2).isNull() || currentRecord.value(2).toDouble() >= 0.) {
+                isComplete = false;
+            }
+            continue;
+        }
+
+        tracksLoudness.push_back(LoudnessAnalyzer::loudnessFromGain(currentRecord.value(1).toDouble()));
+        albumPeak = std::max(albumPeak, currentRecord.value(2).toDouble());
+        tracksDuration.push_back(currentRecord.value(3).toDouble());
+    }
+
+    d->mSelectAlbumTracksLoudnessQuery.finish();
+
+    if (!isComplete || tracksLoudness.isEmpty()) {
+        return;
+    }
+
+    const auto albumGain = LoudnessAnalyzer::gainFromLoudness(LoudnessAnalyzer::combinedLoudness(tracksLoudness, tracksDuration));
+
+    d->mUpdateAlbumLoudnessQuery.bindValue(QStringLiteral(":albumId"), albumId);
+    d->mUpdateAlbumLoudnessQuery.bindValue(QStringLiteral(":albumGain"), albumGain);
+    d->mUpdateAlbumLoudnessQuery.bindValue(QStringLiteral(":albumPeak"), albumPeak);
+
+    queryResult = execQuery(d->mUpdateAlbumLoudnessQuery);
+
+    if (!queryResult || !d->mUpdateAlbumLoudnessQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumLoudness" << d->mUpdateAlbumLoudnessQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumLoudness" << d->mUpdateAlbumLoudnessQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumLoudness" << d->mUpdateAlbumLoudnessQuery.lastError();
+
+        d->mUpdateAlbumLoudnessQuery.finish();
+
+        return;
+    }
+
+    d->mUpdateAlbumLoudnessQuery.finish();
+
+    for (auto trackId : qAsConst(albumTrackIds)) {
+        recordModifiedTrack(trackId);
+    }
 }
 
 void DatabaseInterface::updateTrackStatistics(qulonglong databaseId, const QDateTime &time)
@@ -5276,14 +6618,14 @@ void DatabaseInterface::updateTrackStatistics(qulonglong databaseId, const QDate
     d->mUpdateTrackStatistics.bindValue(QStringLiteral(":trackId"), databaseId);
     d->mUpdateTrackStatistics.bindValue(QStringLiteral(":playDate"), time.toMSecsSinceEpoch());
 
-    auto queryResult = d->mUpdateTrackStatistics.exec();
+    auto queryResult = execQuery(d->mUpdateTrackStatistics);
 
     if (!queryResult || !d->mUpdateTrackStatistics.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::updateTrackStatistics" << d->mUpdateTrackStatistics.lastQuery();
-        qDebug() << "DatabaseInterface::updateTrackStatistics" << d->mUpdateTrackStatistics.boundValues();
-        qDebug() << "DatabaseInterface::updateTrackStatistics" << d->mUpdateTrackStatistics.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackStatistics" << d->mUpdateTrackStatistics.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackStatistics" << d->mUpdateTrackStatistics.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackStatistics" << d->mUpdateTrackStatistics.lastError();
 
         d->mUpdateTrackStatistics.finish();
 
@@ -5295,14 +6637,14 @@ void DatabaseInterface::updateTrackStatistics(qulonglong databaseId, const QDate
     d->mUpdateTrackFirstPlayStatistics.bindValue(QStringLiteral(":trackId"), databaseId);
     d->mUpdateTrackFirstPlayStatistics.bindValue(QStringLiteral(":playDate"), time.toMSecsSinceEpoch());
 
-    queryResult = d->mUpdateTrackFirstPlayStatistics.exec();
+    queryResult = execQuery(d->mUpdateTrackFirstPlayStatistics);
 
     if (!queryResult || !d->mUpdateTrackFirstPlayStatistics.isActive()) {
         Q_EMIT databaseError();
 
-        qDebug() << "DatabaseInterface::updateTrackStatistics" << d->mUpdateTrackFirstPlayStatistics.lastQuery();
-        qDebug() << "DatabaseInterface::updateTrackStatistics" << d->mUpdateTrackFirstPlayStatistics.boundValues();
-        qDebug() << "DatabaseInterface::updateTrackStatistics" << d->mUpdateTrackFirstPlayStatistics.lastError();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackStatistics" << d->mUpdateTrackFirstPlayStatistics.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackStatistics" << d->mUpdateTrackFirstPlayStatistics.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackStatistics" << d->mUpdateTrackFirstPlayStatistics.lastError();
 
         d->mUpdateTrackFirstPlayStatistics.finish();
 
@@ -31,13 +31,19 @@
 #include <QUrl>
 #include <QDateTime>
 #include <QPair>
+#include <QSharedPointer>
+#include <QVector>
 
 #include <memory>
 
 class DatabaseInterfacePrivate;
+class DataBlock;
+class DataBlockStream;
+class DatabaseStatistics;
 class QMutex;
 class QSqlRecord;
 class QSqlQuery;
+class QElapsedTimer;
 class MusicAudioTrack;
 
 class ELISALIB_EXPORT DatabaseInterface : public QObject
@@ -84,6 +90,10 @@ public:
         LastPlayDate,
         PlayCounter,
         PlayFrequency,
+        TrackGainRole,
+        TrackPeakRole,
+        AlbumGainRole,
+        AlbumPeakRole,
         ElementTypeRole,
     };
 
@@ -315,6 +325,22 @@ public:
 
     ListGenreDataType allGenresData();
 
+    QSharedPointer<const DataBlock> allTracksDataBlock();
+
+    void allTracksDataBlock(DataBlockStream &stream);
+
+    QSharedPointer<const DataBlock> allAlbumsDataBlock();
+
+    void allAlbumsDataBlock(DataBlockStream &stream);
+
+    QSharedPointer<const DataBlock> allArtistsDataBlock();
+
+    void allArtistsDataBlock(DataBlockStream &stream);
+
+    QSharedPointer<const DataBlock> allGenresDataBlock();
+
+    void allGenresDataBlock(DataBlockStream &stream);
+
     DataType oneData(ElisaUtils::PlayListEntryType aType, qulonglong databaseId);
 
     ListTrackDataType tracksDataFromAuthor(const QString &artistName);
@@ -328,6 +354,8 @@ public:
 
     void applicationAboutToQuit();
 
+    void setStatistics(DatabaseStatistics *statistics);
+
 Q_SIGNALS:
 
     void artistsAdded(const DatabaseInterface::ListArtistDataType &newArtists);
@@ -358,12 +386,22 @@ Q_SIGNALS:
 
     void restoredTracks(const QString &musicSource, QHash<QUrl, QDateTime> allFiles);
 
+    /* the size of the restored files, when it was known, sent just before restoredTracks */
+    void restoredFileSizes(const QString &musicSource, QHash<QUrl, qint64> fileSizes);
+
+    void tracksWithoutLoudness(const DatabaseInterface::ListTrackDataType &tracks);
+
 public Q_SLOTS:
 
     void insertTracksList(const QList<MusicAudioTrack> &tracks, const QHash<QString, QUrl> &covers, const QString &musicSource);
 
     void removeTracksList(const QList<QUrl> &removedTracks);
 
+    void renameTracksList(const QHash<QUrl, QUrl> &renamedTracks, const QHash<QString, QUrl> &covers);
+
+    /* records the embedded pictures found after the tracks were inserted, without touching their other data */
+    void setTracksEmbeddedCover(const QList<QUrl> &tracksWithEmbeddedCover);
+
     void modifyTracksList(const QList<MusicAudioTrack> &modifiedTracks, const QHash<QString, QUrl> &covers, const QString &musicSource);
 
     void removeAllTracksFromSource(const QString &sourceName);
@@ -372,8 +410,16 @@ public Q_SLOTS:
 
     void trackHasStartedPlaying(const QUrl &fileName, const QDateTime &time);
 
+    void askTracksWithoutLoudness();
+
+    void updateTracksLoudness(const DatabaseInterface::ListTrackDataType &tracks);
+
+    void measureQueueLatency(qint64 postedTimeStamp);
+
 private:
 
+    friend class DatabaseInterfaceTests;
+
     enum class TrackFileInsertType {
         NewTrackFileInsert,
         ModifiedTrackFileInsert,
@@ -400,7 +446,7 @@ private:
     qulonglong internalTrackIdFromTitleAlbumTracDiscNumber(const QString &title, const QString &artist, const QString &album,
                                                            int trackNumber, int discNumber);
 
-    qulonglong getDuplicateTrackIdFromTitleAlbumTrackDiscNumber(const QString &title, const QString &trackArtist, const QString &album,
+    qulonglong getDuplicateTrackIdFromTitleAlbumTrackDiscNumber(const QString &title, const QString &album,
                                                                 const QString &albumArtist, const QString &trackPath,
                                                                 int trackNumber, int discNumber);
 
@@ -412,6 +458,14 @@ private:
 
     void initDatabase();
 
+    QStringList tableColumnNames(const QString &tableName) const;
+
+    bool upgradeDatabaseV9();
+
+    bool upgradeDatabaseV10();
+
+    bool upgradeDatabaseV11();
+
     void initRequest();
 
     qulonglong insertAlbum(const QString &title, const QString &albumArtist, const QString &trackArtist,
@@ -428,7 +482,10 @@ private:
 
     void removeTrackInDatabase(qulonglong trackId);
 
-    void updateTrackInDatabase(const MusicAudioTrack &oneTrack, const QString &albumPath);
+    void updateTrackInDatabase(const MusicAudioTrack &oneTrack, const QString &albumPath, qulonglong albumId);
+
+    /* a track moved to another directory joins the album of its new directory, returns its previous album */
+    qulonglong moveTrackToDirectory(qulonglong trackId, const QUrl &newFileName, const QHash<QString, QUrl> &covers);
 
     void removeAlbumInDatabase(qulonglong albumId);
 
@@ -436,6 +493,14 @@ private:
 
     void reloadExistingDatabase();
 
+    void initNamesCache();
+
+    void loadNamesCache(const QString &tableName, QHash<QString, qulonglong> &namesCache);
+
+    void loadTrackDuplicatesIndex();
+
+    void recordRemovedTrackFile(const QUrl &fileName);
+
     qulonglong initialId(DataUtils::DataType aType);
 
     qulonglong genericInitialId(QSqlQuery &request);
@@ -455,6 +520,8 @@ private:
 
     TrackDataType buildTrackDataFromDatabaseRecord(const QSqlRecord &trackRecord) const;
 
+    void trackValuesFromDatabaseRecord(const QSqlRecord &trackRecord, QVector<QVariant> &trackValues) const;
+
     void internalRemoveTracksList(const QList<QUrl> &removedTracks);
 
     void internalRemoveTracksList(const QHash<QUrl, QDateTime> &removedTracks, qulonglong sourceId);
@@ -471,20 +538,26 @@ private:
 
     qulonglong internalSourceIdFromName(const QString &sourceName);
 
-    QHash<QUrl, QDateTime> internalAllFileNameFromSource(qulonglong sourceId);
+    QHash<QUrl, QDateTime> internalAllFileNameFromSource(qulonglong sourceId, QHash<QUrl, qint64> *fileSizes = nullptr);
 
     bool internalGenericPartialData(QSqlQuery &query);
 
     ListArtistDataType internalAllArtistsPartialData(QSqlQuery &artistsQuery);
 
+    void internalAllArtistsDataBlock(QSqlQuery &artistsQuery, DataBlockStream &stream);
+
     ArtistDataType internalOneArtistPartialData(qulonglong databaseId);
 
     ListAlbumDataType internalAllAlbumsPartialData(QSqlQuery &query);
 
+    void internalAllAlbumsDataBlock(QSqlQuery &query, DataBlockStream &stream);
+
     AlbumDataType internalOneAlbumPartialData(qulonglong databaseId);
 
     ListTrackDataType internalAllTracksPartialData();
 
+    void internalAllTracksDataBlock(DataBlockStream &stream);
+
     ListTrackDataType internalRecentlyPlayedTracksData(int count);
 
     ListTrackDataType internalFrequentlyPlayedTracksData(int count);
@@ -493,6 +566,8 @@ private:
 
     ListGenreDataType internalAllGenresPartialData();
 
+    void internalAllGenresDataBlock(DataBlockStream &stream);
+
     GenreDataType internalOneGenrePartialData(qulonglong databaseId);
 
     ListArtistDataType internalAllComposersPartialData();
@@ -505,13 +580,23 @@ private:
 
     bool prepareQuery(QSqlQuery &query, const QString &queryText) const;
 
+    bool execQuery(QSqlQuery &query);
+
+    void recordQueryRows(const QSqlQuery &query, int rowsCount) const;
+
+    void recordTransaction(const QString &name, const QElapsedTimer &timer, int tracksCount) const;
+
     void updateAlbumArtist(qulonglong albumId, const QString &title, const QString &albumPath,
                            const QString &artistName);
 
     void updateTrackStatistics(qulonglong databaseId, const QDateTime &time);
 
+    void updateAlbumLoudness(qulonglong albumId);
+
     std::unique_ptr<DatabaseInterfacePrivate> d;
 
+    DatabaseStatistics *mStatistics = nullptr;
+
 };
 
 Q_DECLARE_METATYPE(DatabaseInterface::TrackDataType)
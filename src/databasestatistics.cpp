@@ -0,0 +1,193 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "databasestatistics.h"
+
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QAtomicInt>
+#include <QJsonArray>
+
+#include <array>
+#include <algorithm>
+
+class LatencyHistogram
+{
+public:
+
+    // bucket i counts the samples whose duration is below 2^i microseconds
+    std::array<quint64, 24> mBuckets = {};
+
+    quint64 mCount = 0;
+
+    qint64 mTotalNanoSeconds = 0;
+
+    qint64 mMaximumNanoSeconds = 0;
+
+    quint64 mRowsCount = 0;
+
+    void record(qint64 elapsedNanoSeconds)
+    {
+        auto microSeconds = elapsedNanoSeconds / 1000;
+        auto bucket = size_t(0);
+        while (bucket < mBuckets.size() - 1 && microSeconds >= (qint64(1) << bucket)) {
+            ++bucket;
+        }
+
+        ++mBuckets[bucket];
+        ++mCount;
+        mTotalNanoSeconds += elapsedNanoSeconds;
+        mMaximumNanoSeconds = std::max(mMaximumNanoSeconds, elapsedNanoSeconds);
+    }
+
+    QJsonObject toJson() const
+    {
+        QJsonObject result;
+
+        result[QStringLiteral("count")] = static_cast<qint64>(mCount);
+        result[QStringLiteral("totalMicroSeconds")] = mTotalNanoSeconds / 1000;
+        result[QStringLiteral("maximumMicroSeconds")] = mMaximumNanoSeconds / 1000;
+        result[QStringLiteral("averageMicroSeconds")] = (mCount ? static_cast<qint64>(mTotalNanoSeconds / 1000 / static_cast<qint64>(mCount)) : 0);
+
+        if (mRowsCount) {
+            result[QStringLiteral("rows")] = static_cast<qint64>(mRowsCount);
+        }
+
+        QJsonObject histogram;
+        for (size_t bucket = 0; bucket < mBuckets.size(); ++bucket) {
+            if (mBuckets[bucket] == 0) {
+                continue;
+            }
+
+            histogram[QStringLiteral("<") + QString::number(qint64(1) << bucket) + QStringLiteral("us")] = static_cast<qint64>(mBuckets[bucket]);
+        }
+        result[QStringLiteral("histogram")] = histogram;
+
+        return result;
+    }
+};
+
+class DatabaseStatisticsPrivate
+{
+public:
+
+    mutable QMutex mLock;
+
+    QHash<QString, LatencyHistogram> mQueries;
+
+    QHash<QString, LatencyHistogram> mTransactions;
+
+    LatencyHistogram mQueueLatency;
+
+    QAtomicInt mSlowQueryThreshold = DatabaseStatistics::defaultSlowQueryThreshold;
+
+};
+
+DatabaseStatistics::DatabaseStatistics() : d(std::make_unique<DatabaseStatisticsPrivate>())
+{
+}
+
+DatabaseStatistics::~DatabaseStatistics()
+= default;
+
+void DatabaseStatistics::recordQuery(const QString &queryText, qint64 elapsedNanoSeconds)
+{
+    QMutexLocker locker(&d->mLock);
+
+    d->mQueries[queryText].record(elapsedNanoSeconds);
+}
+
+void DatabaseStatistics::recordRows(const QString &queryText, int rowsCount)
+{
+    QMutexLocker locker(&d->mLock);
+
+    d->mQueries[queryText].mRowsCount += static_cast<quint64>(rowsCount);
+}
+
+void DatabaseStatistics::recordTransaction(const QString &name, qint64 elapsedNanoSeconds, int tracksCount)
+{
+    QMutexLocker locker(&d->mLock);
+
+    auto &transactionStatistics = d->mTransactions[name];
+    transactionStatistics.record(elapsedNanoSeconds);
+    transactionStatistics.mRowsCount += static_cast<quint64>(tracksCount);
+}
+
+void DatabaseStatistics::recordQueueLatency(qint64 elapsedNanoSeconds)
+{
+    QMutexLocker locker(&d->mLock);
+
+    d->mQueueLatency.record(elapsedNanoSeconds);
+}
+
+void DatabaseStatistics::setSlowQueryThreshold(int milliSeconds)
+{
+    d->mSlowQueryThreshold = std::max(1, milliSeconds);
+}
+
+int DatabaseStatistics::slowQueryThreshold() const
+{
+    return d->mSlowQueryThreshold;
+}
+
+void DatabaseStatistics::clear()
+{
+    QMutexLocker locker(&d->mLock);
+
+    d->mQueries.clear();
+    d->mTransactions.clear();
+    d->mQueueLatency = {};
+}
+
+QJsonObject DatabaseStatistics::toJson() const
+{
+    QMutexLocker locker(&d->mLock);
+
+    auto sortedQueries = QList<QPair<QString, const LatencyHistogram*>>{};
+    for (auto itQuery = d->mQueries.cbegin(); itQuery != d->mQueries.cend(); ++itQuery) {
+        sortedQueries.push_back({itQuery.key(), &itQuery.value()});
+    }
+
+    std::sort(sortedQueries.begin(), sortedQueries.end(), [](const auto &left, const auto &right) {
+        return left.second->mTotalNanoSeconds > right.second->mTotalNanoSeconds;
+    });
+
+    QJsonArray allQueries;
+    for (const auto &oneQuery : qAsConst(sortedQueries)) {
+        auto queryData = oneQuery.second->toJson();
+        queryData[QStringLiteral("query")] = oneQuery.first.simplified();
+        allQueries.push_back(queryData);
+    }
+
+    QJsonObject allTransactions;
+    for (auto itTransaction = d->mTransactions.cbegin(); itTransaction != d->mTransactions.cend(); ++itTransaction) {
+        auto transactionData = itTransaction.value().toJson();
+        transactionData[QStringLiteral("tracks")] = transactionData.take(QStringLiteral("rows"));
+        allTransactions[itTransaction.key()] = transactionData;
+    }
+
+    QJsonObject result;
+
+    result[QStringLiteral("queries")] = allQueries;
+    result[QStringLiteral("transactions")] = allTransactions;
+    result[QStringLiteral("databaseThreadQueueLatency")] = d->mQueueLatency.toJson();
+
+    return result;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATABASESTATISTICS_H
+#define DATABASESTATISTICS_H
+
+#include "elisaLib_export.h"
+
+#include <QString>
+#include <QJsonObject>
+
+#include <memory>
+
+class DatabaseStatisticsPrivate;
+
+class ELISALIB_EXPORT DatabaseStatistics
+{
+
+public:
+
+    DatabaseStatistics();
+
+    ~DatabaseStatistics();
+
+    void recordQuery(const QString &queryText, qint64 elapsedNanoSeconds);
+
+    void recordRows(const QString &queryText, int rowsCount);
+
+    void recordTransaction(const QString &name, qint64 elapsedNanoSeconds, int tracksCount);
+
+    void recordQueueLatency(qint64 elapsedNanoSeconds);
+
+    /* queries running longer are logged as they happen */
+    void setSlowQueryThreshold(int milliSeconds);
+
+    int slowQueryThreshold() const;
+
+    static const int defaultSlowQueryThreshold = 50;
+
+    void clear();
+
+    QJsonObject toJson() const;
+
+private:
+
+    std::unique_ptr<DatabaseStatisticsPrivate> d;
+
+};
+
+#endif // DATABASESTATISTICS_H
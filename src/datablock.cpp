@@ -0,0 +1,167 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "datablock.h"
+
+#include <utility>
+
+DataBlock::DataBlock(ElisaUtils::PlayListEntryType elementType, QVector<DatabaseInterface::ColumnsRoles> roles)
+    : mElementType(elementType), mRoles(std::move(roles)), mColumns(mRoles.size()),
+      mColumnFromRole(DatabaseInterface::ElementTypeRole - DatabaseInterface::TitleRole + 1, -1)
+{
+    for (int column = 0; column < mRoles.size(); ++column) {
+        mColumnFromRole[mRoles[column] - DatabaseInterface::TitleRole] = column;
+    }
+}
+
+ElisaUtils::PlayListEntryType DataBlock::elementType() const
+{
+    return mElementType;
+}
+
+const QVector<DatabaseInterface::ColumnsRoles> &DataBlock::roles() const
+{
+    return mRoles;
+}
+
+int DataBlock::rowCount() const
+{
+    if (mColumns.isEmpty()) {
+        return 0;
+    }
+
+    return mColumns.first().size();
+}
+
+bool DataBlock::isEmpty() const
+{
+    return rowCount() == 0;
+}
+
+void DataBlock::reserve(int rowCount)
+{
+    for (auto &oneColumn : mColumns) {
+        oneColumn.reserve(rowCount);
+    }
+}
+
+void DataBlock::appendRow(const QVector<QVariant> &rowValues)
+{
+    Q_ASSERT(rowValues.size() == mColumns.size());
+
+    for (int column = 0; column < mColumns.size(); ++column) {
+        mColumns[column].push_back(rowValues[column]);
+    }
+}
+
+QVariant DataBlock::value(int row, int role) const
+{
+    if (role == DatabaseInterface::ElementTypeRole) {
+        return mElementType;
+    }
+
+    const auto column = columnFromRole(role);
+
+    if (column == -1) {
+        return {};
+    }
+
+    return mColumns[column][row];
+}
+
+qulonglong DataBlock::databaseId(int row) const
+{
+    return value(row, DatabaseInterface::DatabaseIdRole).toULongLong();
+}
+
+int DataBlock::columnFromRole(int role) const
+{
+    const auto roleIndex = role - DatabaseInterface::TitleRole;
+
+    if (roleIndex < 0 || roleIndex >= mColumnFromRole.size()) {
+        return -1;
+    }
+
+    return mColumnFromRole[roleIndex];
+}
+
+DataBlockStream::DataBlockStream() = default;
+
+DataBlockStream::DataBlockStream(int chunkSize, Consumer consumer)
+    : mChunkSize(chunkSize), mConsumer(std::move(consumer))
+{
+}
+
+void DataBlockStream::start(ElisaUtils::PlayListEntryType elementType, const QVector<DatabaseInterface::ColumnsRoles> &roles)
+{
+    mElementType = elementType;
+    mRoles = roles;
+    mCurrentBlock = QSharedPointer<DataBlock>::create(mElementType, mRoles);
+    mLastBlock.clear();
+    mRowCount = 0;
+    mHasFlushed = false;
+
+    if (mChunkSize > 0) {
+        mCurrentBlock->reserve(mChunkSize);
+    }
+}
+
+void DataBlockStream::appendRow(const QVector<QVariant> &rowValues)
+{
+    mCurrentBlock->appendRow(rowValues);
+    ++mRowCount;
+
+    if (mChunkSize > 0 && mCurrentBlock->rowCount() >= mChunkSize) {
+        flush();
+
+        mCurrentBlock = QSharedPointer<DataBlock>::create(mElementType, mRoles);
+        mCurrentBlock->reserve(mChunkSize);
+    }
+}
+
+int DataBlockStream::rowCount() const
+{
+    return mRowCount;
+}
+
+void DataBlockStream::finish()
+{
+    if (!mCurrentBlock) {
+        return;
+    }
+
+    if (!mCurrentBlock->isEmpty() || !mHasFlushed) {
+        flush();
+    }
+
+    mCurrentBlock.clear();
+}
+
+DataBlockPointer DataBlockStream::result() const
+{
+    return mLastBlock;
+}
+
+void DataBlockStream::flush()
+{
+    mLastBlock = mCurrentBlock;
+    mHasFlushed = true;
+
+    if (mConsumer) {
+        mConsumer(mLastBlock);
+    }
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATABLOCK_H
+#define DATABLOCK_H
+
+#include "elisaLib_export.h"
+
+#include "elisautils.h"
+#include "databaseinterface.h"
+
+#include <QSharedPointer>
+#include <QVector>
+#include <QVariant>
+
+#include <functional>
+
+class ELISALIB_EXPORT DataBlock
+{
+
+public:
+
+    DataBlock(ElisaUtils::PlayListEntryType elementType, QVector<DatabaseInterface::ColumnsRoles> roles);
+
+    ElisaUtils::PlayListEntryType elementType() const;
+
+    const QVector<DatabaseInterface::ColumnsRoles>& roles() const;
+
+    int rowCount() const;
+
+    bool isEmpty() const;
+
+    void reserve(int rowCount);
+
+    void appendRow(const QVector<QVariant> &rowValues);
+
+    QVariant value(int row, int role) const;
+
+    qulonglong databaseId(int row) const;
+
+    template <typename ResultDataType>
+    ResultDataType rowData(int row) const
+    {
+        auto result = ResultDataType{};
+
+        for (int column = 0; column < mRoles.size(); ++column) {
+            result[mRoles[column]] = mColumns[column][row];
+        }
+        result[DatabaseInterface::ElementTypeRole] = mElementType;
+
+        return result;
+    }
+
+    template <typename ResultListDataType>
+    ResultListDataType toList() const
+    {
+        auto result = ResultListDataType{};
+
+        result.reserve(rowCount());
+        for (int row = 0; row < rowCount(); ++row) {
+            result.push_back(rowData<typename ResultListDataType::value_type>(row));
+        }
+
+        return result;
+    }
+
+private:
+
+    int columnFromRole(int role) const;
+
+    ElisaUtils::PlayListEntryType mElementType = ElisaUtils::Unknown;
+
+    QVector<DatabaseInterface::ColumnsRoles> mRoles;
+
+    QVector<QVector<QVariant>> mColumns;
+
+    QVector<int> mColumnFromRole;
+
+};
+
+using DataBlockPointer = QSharedPointer<const DataBlock>;
+
+class ELISALIB_EXPORT DataBlockStream
+{
+
+public:
+
+    using Consumer = std::function<void(const DataBlockPointer &)>;
+
+    DataBlockStream();
+
+    DataBlockStream(int chunkSize, Consumer consumer);
+
+    void start(ElisaUtils::PlayListEntryType elementType, const QVector<DatabaseInterface::ColumnsRoles> &roles);
+
+    void appendRow(const QVector<QVariant> &rowValues);
+
+    int rowCount() const;
+
+    void finish();
+
+    DataBlockPointer result() const;
+
+private:
+
+    void flush();
+
+    int mChunkSize = 0;
+
+    Consumer mConsumer;
+
+    ElisaUtils::PlayListEntryType mElementType = ElisaUtils::Unknown;
+
+    QVector<DatabaseInterface::ColumnsRoles> mRoles;
+
+    QSharedPointer<DataBlock> mCurrentBlock;
+
+    DataBlockPointer mLastBlock;
+
+    int mRowCount = 0;
+
+    bool mHasFlushed = false;
+
+};
+
+Q_DECLARE_METATYPE(DataBlockPointer)
+
+#endif // DATABLOCK_H
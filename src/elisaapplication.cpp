@@ -347,6 +347,8 @@ void ElisaApplication::initializePlayer()
     d->mAudioControl->setTitleRole(MediaPlayList::TitleRole);
     d->mAudioControl->setUrlRole(MediaPlayList::ResourceRole);
     d->mAudioControl->setIsPlayingRole(MediaPlayList::IsPlayingRole);
+
+    configChanged();
     d->mAudioControl->setPlayListModel(d->mMediaPlayList.get());
 
     QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::playerPlay, d->mAudioWrapper.get(), &AudioWrapper::play);
@@ -356,13 +358,17 @@ void ElisaApplication::initializePlayer()
     QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::skipNextTrack, d->mMediaPlayList.get(), &MediaPlayList::skipNextTrack);
     QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::sourceInError, d->mMediaPlayList.get(), &MediaPlayList::trackInError);
     QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::sourceInError, d->mMusicManager.get(), &MusicListenersManager::playBackError);
-    QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::playerSourceChanged, d->mAudioWrapper.get(), &AudioWrapper::setSource);
+    QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::playerBufferingChanged, d->mMusicManager.get(), &MusicListenersManager::playerBufferingChanged);
+    QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::playerLoadSource, d->mAudioWrapper.get(), &AudioWrapper::loadSource);
+    QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::playerNextSourceChanged, d->mAudioWrapper.get(), &AudioWrapper::setNextSource);
+    QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::playerReplayGainChanged, d->mAudioWrapper.get(), &AudioWrapper::setReplayGain);
     QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::startedPlayingTrack,
                      d->mMusicManager->viewDatabase(), &DatabaseInterface::trackHasStartedPlaying);
 
     QObject::connect(d->mMediaPlayList.get(), &MediaPlayList::ensurePlay, d->mAudioControl.get(), &ManageAudioPlayer::ensurePlay);
     QObject::connect(d->mMediaPlayList.get(), &MediaPlayList::playListFinished, d->mAudioControl.get(), &ManageAudioPlayer::playListFinished);
     QObject::connect(d->mMediaPlayList.get(), &MediaPlayList::currentTrackChanged, d->mAudioControl.get(), &ManageAudioPlayer::setCurrentTrack);
+    QObject::connect(d->mMediaPlayList.get(), &MediaPlayList::nextTrackChanged, d->mAudioControl.get(), &ManageAudioPlayer::setNextTrack);
 
     QObject::connect(d->mAudioWrapper.get(), &AudioWrapper::playbackStateChanged,
                      d->mAudioControl.get(), &ManageAudioPlayer::setPlayerPlaybackState);
@@ -371,6 +377,7 @@ void ElisaApplication::initializePlayer()
     QObject::connect(d->mAudioWrapper.get(), &AudioWrapper::durationChanged, d->mAudioControl.get(), &ManageAudioPlayer::setAudioDuration);
     QObject::connect(d->mAudioWrapper.get(), &AudioWrapper::seekableChanged, d->mAudioControl.get(), &ManageAudioPlayer::setPlayerIsSeekable);
     QObject::connect(d->mAudioWrapper.get(), &AudioWrapper::positionChanged, d->mAudioControl.get(), &ManageAudioPlayer::setPlayerPosition);
+    QObject::connect(d->mAudioWrapper.get(), &AudioWrapper::nextSourceStarted, d->mAudioControl.get(), &ManageAudioPlayer::playerNextSourceStarted);
 
     d->mPlayerControl->setPlayListModel(d->mMediaPlayList.get());
     QObject::connect(d->mMediaPlayList.get(), &MediaPlayList::currentTrackChanged, d->mPlayerControl.get(), &ManageMediaPlayerControl::setCurrentTrack);
@@ -394,6 +401,29 @@ void ElisaApplication::initializePlayer()
     }
 }
 
+void ElisaApplication::configChanged()
+{
+    if (!d->mAudioControl) {
+        return;
+    }
+
+    switch (Elisa::ElisaConfiguration::replayGainMode())
+    {
+    case Elisa::ElisaConfiguration::EnumReplayGainMode::TrackGain:
+        d->mAudioControl->setReplayGainRole(MediaPlayList::TrackGainRole);
+        d->mAudioControl->setReplayPeakRole(MediaPlayList::TrackPeakRole);
+        break;
+    case Elisa::ElisaConfiguration::EnumReplayGainMode::AlbumGain:
+        d->mAudioControl->setReplayGainRole(MediaPlayList::AlbumGainRole);
+        d->mAudioControl->setReplayPeakRole(MediaPlayList::AlbumPeakRole);
+        break;
+    default:
+        d->mAudioControl->setReplayGainRole(-1);
+        d->mAudioControl->setReplayPeakRole(-1);
+        break;
+    }
+}
+
 QAction * ElisaApplication::action(const QString& name)
 {
 #if defined KF5XmlGui_FOUND && KF5XmlGui_FOUND
@@ -145,6 +145,8 @@ public Q_SLOTS:
 
     void initialize();
 
+    void configChanged();
+
 private Q_SLOTS:
 
     void goBack();
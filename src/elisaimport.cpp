@@ -15,10 +15,8 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include "config-upnp-qt.h"
-
-#include "musiclistenersmanager.h"
 #include "elisaimportapplication.h"
+#include "databaseinterface.h"
 #include "elisa_settings.h"
 #include "musicaudiotrack.h"
 
@@ -26,37 +24,96 @@
 #include <QCommandLineParser>
 #include <QtGlobal>
 #include <QStandardPaths>
+#include <QTimer>
+#include <QDir>
+#include <QDebug>
 
 int main(int argc, char *argv[])
 {
     QCoreApplication app(argc, argv);
 
     qRegisterMetaType<QHash<QString,QUrl>>("QHash<QString,QUrl>");
+    qRegisterMetaType<QHash<QUrl,QUrl>>("QHash<QUrl,QUrl>");
+    qRegisterMetaType<QHash<QUrl,qint64>>("QHash<QUrl,qint64>");
     qRegisterMetaType<QList<MusicAudioTrack>>("QList<MusicAudioTrack>");
     qRegisterMetaType<QList<MusicAudioTrack>>("QVector<MusicAudioTrack>");
     qRegisterMetaType<QVector<qulonglong>>("QVector<qulonglong>");
     qRegisterMetaType<QHash<qulonglong,int>>("QHash<qulonglong,int>");
     qRegisterMetaType<QMap<QString, int>>();
-    qRegisterMetaType<NotificationItem>("NotificationItem");
     qRegisterMetaType<QMap<QString,int>>("QMap<QString,int>");
+    qRegisterMetaType<DatabaseInterface::ListTrackDataType>("DatabaseInterface::ListTrackDataType");
 
     QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Import music folders into an Elisa database and report the indexing throughput."));
     parser.addHelpOption();
     parser.addVersionOption();
+    parser.addPositionalArgument(QStringLiteral("roots"), QStringLiteral("Music folders to import, the configured ones by default."),
+                                 QStringLiteral("[roots...]"));
+
+    QCommandLineOption databaseOption({QStringLiteral("d"), QStringLiteral("database")},
+                                      QStringLiteral("Database file to fill, the Elisa one by default."), QStringLiteral("file"));
+    parser.addOption(databaseOption);
+
+    QCommandLineOption workersOption({QStringLiteral("w"), QStringLiteral("workers")},
+                                     QStringLiteral("Count of parallel metadata extraction workers."), QStringLiteral("count"));
+    parser.addOption(workersOption);
+
+    QCommandLineOption reportOption({QStringLiteral("r"), QStringLiteral("report")},
+                                    QStringLiteral("Write a JSON throughput report to this file, - for the standard output."), QStringLiteral("file"));
+    parser.addOption(reportOption);
+
+    QCommandLineOption fastTagsOption({QStringLiteral("f"), QStringLiteral("fast-tags")},
+                                      QStringLiteral("Read FLAC, Ogg, ID3v2 and MP4 tags with the built-in reader before the KFileMetaData extractors."));
+    parser.addOption(fastTagsOption);
+
     parser.process(app);
 
-    auto configurationFileName = QStandardPaths::writableLocation(QStandardPaths::ConfigLocation);
-    configurationFileName += QStringLiteral("/elisarc");
-    Elisa::ElisaConfiguration::instance(configurationFileName);
-    Elisa::ElisaConfiguration::self()->load();
-    Elisa::ElisaConfiguration::self()->save();
+    auto rootPaths = parser.positionalArguments();
+    for (auto &oneRootPath : rootPaths) {
+        oneRootPath = QDir(oneRootPath).absolutePath();
+    }
+
+    if (rootPaths.isEmpty()) {
+        auto configurationFileName = QStandardPaths::writableLocation(QStandardPaths::ConfigLocation);
+        configurationFileName += QStringLiteral("/elisarc");
+        Elisa::ElisaConfiguration::instance(configurationFileName);
+        Elisa::ElisaConfiguration::self()->load();
+
+        rootPaths = Elisa::ElisaConfiguration::rootPath();
+    }
+
+    if (rootPaths.isEmpty()) {
+        rootPaths = QStandardPaths::standardLocations(QStandardPaths::MusicLocation);
+    }
+
+    auto databaseFileName = parser.value(databaseOption);
+    if (databaseFileName.isEmpty()) {
+        databaseFileName = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + QStringLiteral("/elisaDatabase.db");
+    }
+
+    auto workersCount = 0;
+    if (parser.isSet(workersOption)) {
+        auto isNumber = false;
+        workersCount = parser.value(workersOption).toInt(&isNumber);
+
+        if (!isNumber || workersCount < 1) {
+            qCritical() << "invalid workers count" << parser.value(workersOption);
+            return 1;
+        }
+    }
 
-    MusicListenersManager myMusicManager;
     ElisaImportApplication myApplication;
 
-    QObject::connect(&myMusicManager, &MusicListenersManager::indexingRunningChanged,
-            &myApplication, &ElisaImportApplication::indexingChanged);
+    myApplication.setRootPaths(rootPaths);
+    myApplication.setDatabaseFileName(databaseFileName);
+    myApplication.setWorkersCount(workersCount);
+    myApplication.setReportFileName(parser.value(reportOption));
+    myApplication.setFastTagReader(parser.isSet(fastTagsOption));
+
+    QObject::connect(&myApplication, &ElisaImportApplication::importFinished,
+                     &app, &QCoreApplication::quit, Qt::QueuedConnection);
+
+    QTimer::singleShot(0, &myApplication, &ElisaImportApplication::start);
 
     return app.exec();
 }
-
@@ -17,21 +17,256 @@
 
 #include "elisaimportapplication.h"
 
+#include "databaseinterface.h"
+#include "databasestatistics.h"
+#include "abstractfile/scanscheduler.h"
+#include "file/filelistener.h"
+
 #include <QCoreApplication>
+#include <QThread>
+#include <QThreadPool>
+#include <QElapsedTimer>
+#include <QAtomicInt>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QSet>
+#include <QDebug>
+
+#if defined Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+
+#include <list>
+
+class ElisaImportApplicationPrivate
+{
+public:
+
+    QThread mDatabaseThread;
+
+    DatabaseInterface mDatabaseInterface;
+
+    DatabaseStatistics mDatabaseStatistics;
+
+    ScanScheduler mScanScheduler;
+
+    std::list<std::unique_ptr<FileListener>> mFileListeners;
+
+    QStringList mRootPaths;
+
+    QString mDatabaseFileName;
+
+    QString mReportFileName;
+
+    QElapsedTimer mImportTimer;
+
+    qint64 mImportTime = 0;
+
+    QAtomicInt mImportedTracksCount = 0;
+
+    int mDatabaseTracksCount = 0;
+
+    int mWorkersCount = 0;
+
+    QSet<const FileListener*> mFinishedListeners;
+
+    bool mIsFinished = false;
+
+};
+
+ElisaImportApplication::ElisaImportApplication(QObject *parent) : QObject(parent), d(std::make_unique<ElisaImportApplicationPrivate>())
+{
+}
 
-ElisaImportApplication::ElisaImportApplication(QObject *parent) : QObject(parent)
+ElisaImportApplication::~ElisaImportApplication()
 {
+    d->mFileListeners.clear();
+
+    d->mDatabaseThread.quit();
+    d->mDatabaseThread.wait();
+}
+
+void ElisaImportApplication::setRootPaths(const QStringList &rootPaths)
+{
+    d->mRootPaths = rootPaths;
+}
+
+void ElisaImportApplication::setDatabaseFileName(const QString &databaseFileName)
+{
+    d->mDatabaseFileName = databaseFileName;
+}
+
+void ElisaImportApplication::setWorkersCount(int workersCount)
+{
+    d->mWorkersCount = workersCount;
+}
+
+void ElisaImportApplication::setReportFileName(const QString &reportFileName)
+{
+    d->mReportFileName = reportFileName;
+}
+
+void ElisaImportApplication::setFastTagReader(bool fastTagReader)
+{
+    d->mScanScheduler.setFastTagReader(fastTagReader);
 }
 
-void ElisaImportApplication::indexingChanged()
+void ElisaImportApplication::start()
 {
-    static bool firstCall = true;
+    d->mImportTimer.start();
+
+    if (d->mWorkersCount > 0) {
+        d->mScanScheduler.threadPool().setMaxThreadCount(d->mWorkersCount);
+    }
 
-    if (firstCall) {
-        firstCall = false;
+    if (!d->mDatabaseFileName.isEmpty()) {
+        QDir().mkpath(QFileInfo(d->mDatabaseFileName).absolutePath());
+    }
+
+    d->mDatabaseInterface.setStatistics(&d->mDatabaseStatistics);
+    d->mDatabaseInterface.moveToThread(&d->mDatabaseThread);
+    d->mDatabaseThread.start();
+
+    connect(&d->mDatabaseInterface, &DatabaseInterface::requestsInitDone,
+            this, &ElisaImportApplication::databaseReady);
+
+    // counted in the database thread: the count is complete as soon as this thread is idle
+    connect(&d->mDatabaseInterface, &DatabaseInterface::tracksAdded, &d->mDatabaseInterface,
+            [this](const DatabaseInterface::ListTrackDataType &allTracks) {d->mImportedTracksCount.fetchAndAddRelaxed(allTracks.size());},
+            Qt::DirectConnection);
+
+    QMetaObject::invokeMethod(&d->mDatabaseInterface, "init", Qt::QueuedConnection,
+                              Q_ARG(QString, QStringLiteral("listeners")), Q_ARG(QString, d->mDatabaseFileName));
+}
+
+QJsonObject ElisaImportApplication::report() const
+{
+    QJsonObject result;
+
+    const auto extractedFilesCount = d->mScanScheduler.extractedFilesCount();
+    const auto elapsedSeconds = static_cast<double>(d->mImportTime) / 1000.;
+
+    const auto allTransactions = d->mDatabaseStatistics.toJson()[QStringLiteral("transactions")].toObject();
+    const auto insertTransactions = allTransactions[QStringLiteral("insertTracksList")].toObject();
+
+    result[QStringLiteral("roots")] = QJsonArray::fromStringList(d->mRootPaths);
+    result[QStringLiteral("database")] = d->mDatabaseFileName;
+    result[QStringLiteral("workers")] = d->mScanScheduler.threadPool().maxThreadCount();
+    result[QStringLiteral("fastTagReader")] = d->mScanScheduler.fastTagReader();
+    result[QStringLiteral("elapsedMilliSeconds")] = d->mImportTime;
+    result[QStringLiteral("extractedFiles")] = extractedFilesCount;
+    result[QStringLiteral("importedTracks")] = d->mImportedTracksCount.load();
+    result[QStringLiteral("databaseTracks")] = d->mDatabaseTracksCount;
+    result[QStringLiteral("filesPerSecond")] = (elapsedSeconds > 0 ? extractedFilesCount / elapsedSeconds : 0.);
+    result[QStringLiteral("extractionMilliSeconds")] = d->mScanScheduler.extractionTime() / 1000000;
+    result[QStringLiteral("databaseInsertMilliSeconds")] = insertTransactions[QStringLiteral("totalMicroSeconds")].toDouble() / 1000.;
+    result[QStringLiteral("databaseTransactions")] = allTransactions;
+    result[QStringLiteral("peakResidentSetKiB")] = peakResidentSetSize();
+
+    return result;
+}
+
+void ElisaImportApplication::databaseReady()
+{
+    for (const auto &oneRootPath : qAsConst(d->mRootPaths)) {
+        auto newFileIndexer = std::make_unique<FileListener>();
+
+        if (d->mWorkersCount > 0) {
+            d->mScanScheduler.setDeviceConcurrency(d->mScanScheduler.deviceId(oneRootPath), d->mWorkersCount);
+        }
+
+        // a listener also reports the end of the rescan of each directory changed while the import runs
+        connect(newFileIndexer.get(), &FileListener::indexingFinished,
+                this, [this, listener = newFileIndexer.get()]() {indexingFinished(listener);});
+
+        newFileIndexer->setScanScheduler(&d->mScanScheduler);
+        newFileIndexer->setDatabaseInterface(&d->mDatabaseInterface);
+        newFileIndexer->setRootPath(oneRootPath);
+
+        d->mFileListeners.emplace_back(std::move(newFileIndexer));
+    }
+
+    if (d->mFileListeners.empty()) {
+        finishImport();
+    }
+}
+
+void ElisaImportApplication::indexingFinished(const FileListener *listener)
+{
+    d->mFinishedListeners.insert(listener);
+
+    if (d->mFinishedListeners.size() == static_cast<int>(d->mFileListeners.size())) {
+        finishImport();
+    }
+}
+
+void ElisaImportApplication::finishImport()
+{
+    if (d->mIsFinished) {
+        return;
+    }
+
+    d->mIsFinished = true;
+
+    // queued after all the tracks the listeners have sent: returns once they are in the database
+    QMetaObject::invokeMethod(&d->mDatabaseInterface, [this]() {
+        d->mDatabaseTracksCount = d->mDatabaseInterface.allTracksData().count();
+    }, Qt::BlockingQueuedConnection);
+
+    d->mImportTime = d->mImportTimer.elapsed();
+
+    writeReport();
+
+    Q_EMIT importFinished();
+}
+
+void ElisaImportApplication::writeReport() const
+{
+    const auto currentReport = report();
+
+    qInfo() << "ElisaImportApplication::writeReport" << currentReport[QStringLiteral("importedTracks")].toInt() << "tracks imported in"
+            << currentReport[QStringLiteral("elapsedMilliSeconds")].toDouble() << "ms";
+
+    if (d->mReportFileName.isEmpty()) {
+        return;
+    }
+
+    QFile reportFile;
+
+    auto isOpen = false;
+    if (d->mReportFileName == QStringLiteral("-")) {
+        isOpen = reportFile.open(stdout, QIODevice::WriteOnly);
     } else {
-        QCoreApplication::quit();
+        reportFile.setFileName(d->mReportFileName);
+        isOpen = reportFile.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    }
+
+    if (!isOpen) {
+        qWarning() << "ElisaImportApplication::writeReport" << "cannot write" << d->mReportFileName;
+        return;
     }
+
+    reportFile.write(QJsonDocument(currentReport).toJson());
+}
+
+qint64 ElisaImportApplication::peakResidentSetSize()
+{
+#if defined Q_OS_UNIX
+    struct rusage resourcesUsage;
+
+    if (::getrusage(RUSAGE_SELF, &resourcesUsage) == 0) {
+#if defined Q_OS_MACOS
+        return static_cast<qint64>(resourcesUsage.ru_maxrss) / 1024;
+#else
+        return static_cast<qint64>(resourcesUsage.ru_maxrss);
+#endif
+    }
+#endif
+
+    return 0;
 }
 
 
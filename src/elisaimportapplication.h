@@ -19,6 +19,14 @@
 #define ELISAIMPORTAPPLICATION_H
 
 #include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QJsonObject>
+
+#include <memory>
+
+class ElisaImportApplicationPrivate;
+class FileListener;
 
 class ElisaImportApplication : public QObject
 {
@@ -26,11 +34,43 @@ class ElisaImportApplication : public QObject
 public:
     explicit ElisaImportApplication(QObject *parent = nullptr);
 
+    ~ElisaImportApplication() override;
+
+    void setRootPaths(const QStringList &rootPaths);
+
+    void setDatabaseFileName(const QString &databaseFileName);
+
+    void setWorkersCount(int workersCount);
+
+    void setReportFileName(const QString &reportFileName);
+
+    void setFastTagReader(bool fastTagReader);
+
+    QJsonObject report() const;
+
 Q_SIGNALS:
 
+    void importFinished();
+
 public Q_SLOTS:
 
-    void indexingChanged();
+    void start();
+
+private Q_SLOTS:
+
+    void databaseReady();
+
+private:
+
+    void indexingFinished(const FileListener *listener);
+
+    void finishImport();
+
+    void writeReport() const;
+
+    static qint64 peakResidentSetSize();
+
+    std::unique_ptr<ElisaImportApplicationPrivate> d;
 
 };
 
@@ -45,6 +45,7 @@
 #include "trackslistener.h"
 #include "viewmanager.h"
 #include "databaseinterface.h"
+#include "datablock.h"
 #include "models/datamodel.h"
 #include "models/trackmetadatamodel.h"
 #include "models/viewsmodel.h"
@@ -52,9 +53,7 @@
 #include "models/alltracksproxymodel.h"
 #include "models/singlealbumproxymodel.h"
 
-#if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
 #include "embeddedcoverageimageprovider.h"
-#endif
 
 #if defined KF5KIO_FOUND && KF5KIO_FOUND
 #include "models/filebrowsermodel.h"
@@ -84,9 +83,7 @@
 void ElisaQmlTestPlugin::initializeEngine(QQmlEngine *engine, const char *uri)
 {
     QQmlExtensionPlugin::initializeEngine(engine, uri);
-#if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
     engine->addImageProvider(QStringLiteral("cover"), new EmbeddedCoverageImageProvider);
-#endif
 }
 
 void ElisaQmlTestPlugin::registerTypes(const char *uri)
@@ -145,7 +142,9 @@ void ElisaQmlTestPlugin::registerTypes(const char *uri)
 
     qRegisterMetaType<AbstractMediaProxyModel*>();
     qRegisterMetaType<QHash<QString,QUrl>>("QHash<QString,QUrl>");
+    qRegisterMetaType<QHash<QUrl,QUrl>>("QHash<QUrl,QUrl>");
     qRegisterMetaType<QHash<QUrl,QDateTime>>("QHash<QUrl,QDateTime>");
+    qRegisterMetaType<QHash<QUrl,qint64>>("QHash<QUrl,qint64>");
     qRegisterMetaType<QList<MusicAudioTrack>>("QList<MusicAudioTrack>");
     qRegisterMetaType<QList<MusicAudioTrack>>("QVector<MusicAudioTrack>");
     qRegisterMetaType<QVector<qulonglong>>("QVector<qulonglong>");
@@ -158,6 +157,7 @@ void ElisaQmlTestPlugin::registerTypes(const char *uri)
     qRegisterMetaType<ModelDataLoader::ListAlbumDataType>("ModelDataLoader::ListAlbumDataType");
     qRegisterMetaType<ModelDataLoader::ListArtistDataType>("ModelDataLoader::ListArtistDataType");
     qRegisterMetaType<ModelDataLoader::ListGenreDataType>("ModelDataLoader::ListGenreDataType");
+    qRegisterMetaType<DataBlockPointer>("DataBlockPointer");
     qRegisterMetaType<TracksListener::ListTrackDataType>("TracksListener::ListTrackDataType");
     qRegisterMetaType<QMap<QString, int>>();
     qRegisterMetaType<QAction*>();
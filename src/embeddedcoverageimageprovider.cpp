@@ -17,17 +17,27 @@
 
 #include "embeddedcoverageimageprovider.h"
 
-#include <KFileMetaData/EmbeddedImageData>
+#include "coverthumbnailcache.h"
+
 #include <QUrl>
 #include <QImage>
+#include <QCache>
+#include <QHash>
+#include <QVector>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadPool>
+#include <QThread>
+
+class EmbeddedCoverageImageProviderPrivate;
 
-class AsyncImageResponse : public QQuickImageResponse, public QRunnable
+class AsyncImageResponse : public QQuickImageResponse
 {
 public:
-    AsyncImageResponse(QString id, QSize requestedSize)
-        : mId(std::move(id)), mRequestedSize(requestedSize)
+
+    AsyncImageResponse(EmbeddedCoverageImageProviderPrivate *provider, QString cacheKey)
+        : mProvider(provider), mCacheKey(std::move(cacheKey))
     {
-        setAutoDelete(false);
     }
 
     QQuickTextureFactory *textureFactory() const override
@@ -35,32 +45,202 @@ public:
         return QQuickTextureFactory::textureFactoryForImage(mCoverImage);
     }
 
+    void cancel() override;
+
+    void setCoverImage(const QImage &coverImage)
+    {
+        mCoverImage = coverImage;
+
+        Q_EMIT finished();
+    }
+
+    void setCoverImageLater(const QImage &coverImage)
+    {
+        mCoverImage = coverImage;
+
+        QMetaObject::invokeMethod(this, [this]() {Q_EMIT finished();}, Qt::QueuedConnection);
+    }
+
+private:
+
+    EmbeddedCoverageImageProviderPrivate *mProvider;
+
+    QString mCacheKey;
+
+    QImage mCoverImage;
+
+};
+
+class EmbeddedCoverDecoder;
+
+class EmbeddedCoverageImageProviderPrivate
+{
+public:
+
+    void cancelResponse(AsyncImageResponse *response, const QString &cacheKey);
+
+    static const int mCoverCacheMaximumCost = 64 * 1024 * 1024;
+
+    QMutex mCoversMutex;
+
+    QCache<QString, QImage> mCoverCache{mCoverCacheMaximumCost};
+
+    QHash<QString, QVector<AsyncImageResponse*>> mPendingResponses;
+
+    QHash<QString, EmbeddedCoverDecoder*> mQueuedDecoders;
+
+    CoverThumbnailCache mThumbnailCache;
+
+    int mRequestSequence = 0;
+
+    QThreadPool mPool;
+
+};
+
+class EmbeddedCoverDecoder : public QRunnable
+{
+public:
+
+    EmbeddedCoverDecoder(EmbeddedCoverageImageProviderPrivate *provider, QString fileName,
+                         QSize requestedSize, QString cacheKey)
+        : mProvider(provider), mFileName(std::move(fileName)),
+          mRequestedSize(requestedSize), mCacheKey(std::move(cacheKey))
+    {
+    }
+
     void run() override
     {
-        KFileMetaData::EmbeddedImageData embeddedImage;
+        {
+            QMutexLocker locker(&mProvider->mCoversMutex);
 
-        auto imageData = embeddedImage.imageData(mId);
+            if (mProvider->mQueuedDecoders.value(mCacheKey) == this) {
+                mProvider->mQueuedDecoders.remove(mCacheKey);
+            }
 
-        if (imageData.contains(KFileMetaData::EmbeddedImageData::FrontCover)) {
-            mCoverImage = QImage::fromData(imageData[KFileMetaData::EmbeddedImageData::FrontCover]);
+            if (!mProvider->mPendingResponses.contains(mCacheKey)) {
+                return;
+            }
         }
 
-        emit finished();
+        auto coverImage = mProvider->mThumbnailCache.thumbnail(mFileName, mRequestedSize);
+
+        // embedded covers are only extracted once, on their first request, the scan does not create their thumbnails
+        const auto requestedDimension = qMax(mRequestedSize.width(), mRequestedSize.height());
+        if (coverImage.isNull() && requestedDimension > 0 && requestedDimension <= CoverThumbnailCache::thumbnailSizes().last() &&
+                mProvider->mThumbnailCache.createThumbnails(mFileName)) {
+            coverImage = mProvider->mThumbnailCache.thumbnail(mFileName, mRequestedSize);
+        }
+
+        if (coverImage.isNull()) {
+            coverImage = CoverThumbnailCache::readCover(mFileName, mRequestedSize);
+        }
+
+        auto waitingResponses = QVector<AsyncImageResponse*>{};
+
+        {
+            QMutexLocker locker(&mProvider->mCoversMutex);
+
+            mProvider->mCoverCache.insert(mCacheKey, new QImage(coverImage),
+                                          qMax(1, static_cast<int>(coverImage.sizeInBytes())));
+
+            waitingResponses = mProvider->mPendingResponses.take(mCacheKey);
+        }
+
+        for (auto response : waitingResponses) {
+            response->setCoverImage(coverImage);
+        }
     }
 
-    QString mId;
+private:
+
+    EmbeddedCoverageImageProviderPrivate *mProvider;
+
+    QString mFileName;
+
     QSize mRequestedSize;
-    QImage mCoverImage;
+
+    QString mCacheKey;
+
 };
 
+void EmbeddedCoverageImageProviderPrivate::cancelResponse(AsyncImageResponse *response, const QString &cacheKey)
+{
+    QMutexLocker locker(&mCoversMutex);
+
+    auto itPending = mPendingResponses.find(cacheKey);
+    if (itPending == mPendingResponses.end() || !itPending->removeOne(response)) {
+        return;
+    }
+
+    if (itPending->isEmpty()) {
+        mPendingResponses.erase(itPending);
+
+        auto itDecoder = mQueuedDecoders.find(cacheKey);
+        if (itDecoder != mQueuedDecoders.end()) {
+            if (mPool.tryTake(*itDecoder)) {
+                delete *itDecoder;
+            }
+            mQueuedDecoders.erase(itDecoder);
+        }
+    }
+
+    response->setCoverImageLater({});
+}
+
+/* the id is the percent encoded URL of the cover or track file, a bare local path is still accepted */
+static QString coverFileName(const QString &id)
+{
+    if (id.startsWith(QStringLiteral("file:"))) {
+        return QUrl(id).toLocalFile();
+    }
+
+    return id;
+}
+
+void AsyncImageResponse::cancel()
+{
+    mProvider->cancelResponse(this, mCacheKey);
+}
+
 EmbeddedCoverageImageProvider::EmbeddedCoverageImageProvider()
-    : QQuickAsyncImageProvider()
+    : QQuickAsyncImageProvider(), d(std::make_unique<EmbeddedCoverageImageProviderPrivate>())
 {
+    d->mPool.setMaxThreadCount(qBound(1, QThread::idealThreadCount() / 2, 4));
+}
+
+EmbeddedCoverageImageProvider::~EmbeddedCoverageImageProvider()
+{
+    d->mPool.clear();
+    d->mPool.waitForDone();
 }
 
 QQuickImageResponse *EmbeddedCoverageImageProvider::requestImageResponse(const QString &id, const QSize &requestedSize)
 {
-    auto response = std::make_unique<AsyncImageResponse>(id, requestedSize);
-    pool.start(response.get());
-    return response.release();
+    const auto cacheKey = QStringLiteral("%1@%2x%3").arg(id).arg(qMax(0, requestedSize.width())).arg(qMax(0, requestedSize.height()));
+
+    auto response = new AsyncImageResponse(d.get(), cacheKey);
+
+    QMutexLocker locker(&d->mCoversMutex);
+
+    auto cachedCover = d->mCoverCache.object(cacheKey);
+    if (cachedCover) {
+        response->setCoverImageLater(*cachedCover);
+        return response;
+    }
+
+    auto &pendingResponses = d->mPendingResponses[cacheKey];
+    pendingResponses.push_back(response);
+
+    auto itDecoder = d->mQueuedDecoders.find(cacheKey);
+    if (itDecoder == d->mQueuedDecoders.end()) {
+        if (pendingResponses.size() == 1) {
+            auto decoder = new EmbeddedCoverDecoder(d.get(), coverFileName(id), requestedSize, cacheKey);
+            d->mQueuedDecoders[cacheKey] = decoder;
+            d->mPool.start(decoder, ++d->mRequestSequence);
+        }
+    } else if (d->mPool.tryTake(*itDecoder)) {
+        d->mPool.start(*itDecoder, ++d->mRequestSequence);
+    }
+
+    return response;
 }
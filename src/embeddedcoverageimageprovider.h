@@ -19,7 +19,10 @@
 #define EMBEDDEDCOVERAGEIMAGEPROVIDER_H
 
 #include <QQuickAsyncImageProvider>
-#include <QThreadPool>
+
+#include <memory>
+
+class EmbeddedCoverageImageProviderPrivate;
 
 class EmbeddedCoverageImageProvider : public QQuickAsyncImageProvider
 {
@@ -27,11 +30,13 @@ public:
 
     EmbeddedCoverageImageProvider();
 
+    ~EmbeddedCoverageImageProvider() override;
+
     QQuickImageResponse *requestImageResponse(const QString &id, const QSize &requestedSize) override;
 
 private:
 
-    QThreadPool pool;
+    std::unique_ptr<EmbeddedCoverageImageProviderPrivate> d;
 
 };
 
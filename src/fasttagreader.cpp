@@ -0,0 +1,1321 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "fasttagreader.h"
+
+#include "musicaudiotrack.h"
+#include "tagparsing.h"
+
+#include <QFile>
+#include <QByteArray>
+#include <QStringList>
+#include <QTime>
+#include <QDateTime>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+/* first mapping of a file: enough for the tags of most files, the pages are only read when touched */
+static const qint64 minimumMappedSize = 64 * 1024;
+
+/* the last Ogg page, holding the stream length, is looked for in this tail of the file */
+static const qint64 oggTailSize = 64 * 1024;
+
+/* an MPEG audio frame may follow the tag padding */
+static const qint64 mpegSyncSearchSize = 4096;
+
+/* in seconds, files modified more recently may still be written and are left to the extractors */
+static const qint64 minimumFileAge = 60;
+
+using TagParsing::bigEndian16;
+using TagParsing::bigEndian24;
+using TagParsing::bigEndian32;
+using TagParsing::littleEndian32;
+using TagParsing::syncSafe32;
+using TagParsing::Mp4Atom;
+using TagParsing::readMp4Atom;
+using TagParsing::findMp4Atom;
+using TagParsing::frontCoverPictureType;
+
+static bool isKey(const char *key, qint64 keyLength, const char *expectedKey)
+{
+    return keyLength == static_cast<qint64>(qstrlen(expectedKey)) && qstrnicmp(key, expectedKey, static_cast<uint>(keyLength)) == 0;
+}
+
+/* track and disc numbers may be followed by a total, dates by a month and a day */
+static int leadingNumber(const QString &value)
+{
+    auto result = 0;
+
+    for (const auto &oneCharacter : value) {
+        if (!oneCharacter.isDigit() || result > 100000) {
+            break;
+        }
+
+        result = result * 10 + oneCharacter.digitValue();
+    }
+
+    return result;
+}
+
+/* bit rates are rounded to kilobits per second like the extractors do */
+static int roundedBitRate(qint64 streamSize, qint64 durationMilliSeconds)
+{
+    if (durationMilliSeconds <= 0 || streamSize <= 0) {
+        return 0;
+    }
+
+    const auto bitRate = (streamSize * 8 + durationMilliSeconds / 2) / durationMilliSeconds;
+
+    return static_cast<int>(std::min<qint64>(bitRate, std::numeric_limits<int>::max() / 1000)) * 1000;
+}
+
+/* durations are rounded to milliseconds like the extractors do, a length that does not fit a QTime is refused */
+static bool roundedDuration(double durationMilliSeconds, qint64 &duration)
+{
+    if (!(durationMilliSeconds >= 0 && durationMilliSeconds < std::numeric_limits<int>::max())) {
+        return false;
+    }
+
+    duration = static_cast<qint64>(durationMilliSeconds + 0.5);
+
+    return true;
+}
+
+/* the fields are only copied into the track once the whole file has been accepted */
+class FastTagFields
+{
+public:
+
+    void apply(MusicAudioTrack &trackData) const
+    {
+        if (!mAlbum.isEmpty()) {
+            trackData.setAlbumName(mAlbum);
+        }
+
+        if (!mArtists.isEmpty()) {
+            trackData.setArtist(mArtists.join(QStringLiteral(", ")));
+        }
+
+        // the extractors only give whole seconds
+        if (mDuration >= 0 && mDuration <= std::numeric_limits<int>::max()) {
+            trackData.setDuration(QTime::fromMSecsSinceStartOfDay(static_cast<int>(mDuration / 1000 * 1000)));
+        }
+
+        if (!mTitle.isEmpty()) {
+            trackData.setTitle(mTitle);
+        }
+
+        if (mTrackNumber > 0) {
+            trackData.setTrackNumber(mTrackNumber);
+        }
+
+        trackData.setDiscNumber(mDiscNumber > 0 ? mDiscNumber : 1);
+
+        if (!mAlbumArtists.isEmpty()) {
+            trackData.setAlbumArtist(mAlbumArtists.join(QStringLiteral(", ")));
+        }
+
+        if (mYear > 0) {
+            trackData.setYear(mYear);
+        }
+
+        if (mChannels > 0) {
+            trackData.setChannels(mChannels);
+        }
+
+        if (mBitRate > 0) {
+            trackData.setBitRate(mBitRate);
+        }
+
+        if (mSampleRate > 0) {
+            trackData.setSampleRate(mSampleRate);
+        }
+
+        if (!mGenres.isEmpty()) {
+            trackData.setGenre(mGenres.join(QStringLiteral(", ")));
+        }
+
+        if (!mComposers.isEmpty()) {
+            trackData.setComposer(mComposers.join(QStringLiteral(", ")));
+        }
+
+        if (!mLyricists.isEmpty()) {
+            trackData.setLyricist(mLyricists.join(QStringLiteral(", ")));
+        }
+
+        if (trackData.artist().isEmpty()) {
+            trackData.setArtist(trackData.albumArtist());
+        }
+
+        if (!mComment.isEmpty()) {
+            trackData.setComment(mComment);
+        }
+
+        trackData.setRating(0);
+
+        trackData.setHasEmbeddedCover(mHasFrontCover);
+    }
+
+    void addValue(QStringList &values, const QString &value)
+    {
+        if (!value.isEmpty()) {
+            values.push_back(value);
+        }
+    }
+
+    void setValue(QString &field, const QString &value)
+    {
+        if (field.isEmpty()) {
+            field = value;
+        }
+    }
+
+    QString mTitle;
+
+    QStringList mArtists;
+
+    QString mAlbum;
+
+    QStringList mAlbumArtists;
+
+    QStringList mGenres;
+
+    QStringList mComposers;
+
+    QStringList mLyricists;
+
+    QString mComment;
+
+    bool mCommentHasDescription = false;
+
+    bool mHasFrontCover = false;
+
+    int mTrackNumber = 0;
+
+    int mDiscNumber = 0;
+
+    int mYear = 0;
+
+    qint64 mDuration = -1;
+
+    int mChannels = 0;
+
+    int mBitRate = 0;
+
+    int mSampleRate = 0;
+
+};
+
+/* maps the beginning of a file, a later request for more bytes replaces the mapping with a larger one */
+class MappedHeader
+{
+public:
+
+    explicit MappedHeader(QFile &file) : mFile(file), mFileSize(file.size())
+    {
+    }
+
+    ~MappedHeader()
+    {
+        if (mData) {
+            mFile.unmap(mData);
+        }
+    }
+
+    MappedHeader(const MappedHeader &other) = delete;
+
+    MappedHeader& operator=(const MappedHeader &other) = delete;
+
+    /* pointers returned by at() before a call to ensure() are not valid anymore */
+    bool ensure(qint64 end)
+    {
+        if (end <= mSize) {
+            return true;
+        }
+
+        if (end > mFileSize) {
+            return false;
+        }
+
+        const auto newSize = std::min(mFileSize, std::max({end, mSize * 2, minimumMappedSize}));
+
+        if (mData) {
+            mFile.unmap(mData);
+            mData = nullptr;
+            mSize = 0;
+        }
+
+        mData = mFile.map(0, newSize);
+        if (!mData) {
+            return false;
+        }
+
+        mSize = newSize;
+
+        return true;
+    }
+
+    const uchar* at(qint64 position) const
+    {
+        return mData + position;
+    }
+
+    qint64 fileSize() const
+    {
+        return mFileSize;
+    }
+
+private:
+
+    QFile &mFile;
+
+    qint64 mFileSize = 0;
+
+    uchar *mData = nullptr;
+
+    qint64 mSize = 0;
+
+};
+
+static bool addVorbisComment(const char *key, qint64 keyLength, const char *value, int valueLength, FastTagFields &fields)
+{
+    if (isKey(key, keyLength, "RATING") || isKey(key, keyLength, "FMPS_RATING")) {
+        return false;
+    }
+
+    if (isKey(key, keyLength, "METADATA_BLOCK_PICTURE")) {
+        // the first base64 quartets of the value hold the picture type
+        const auto pictureStart = QByteArray::fromBase64(QByteArray::fromRawData(value, std::min(valueLength, 8)));
+
+        if (pictureStart.size() >= 4 && bigEndian32(reinterpret_cast<const uchar*>(pictureStart.constData())) == frontCoverPictureType) {
+            fields.mHasFrontCover = true;
+        }
+
+        return true;
+    }
+
+    const auto isTitle = isKey(key, keyLength, "TITLE");
+    const auto isArtist = isKey(key, keyLength, "ARTIST");
+    const auto isAlbum = isKey(key, keyLength, "ALBUM");
+    const auto isAlbumArtist = isKey(key, keyLength, "ALBUMARTIST");
+    const auto isTrackNumber = isKey(key, keyLength, "TRACKNUMBER");
+    const auto isDiscNumber = isKey(key, keyLength, "DISCNUMBER");
+    const auto isDate = isKey(key, keyLength, "DATE");
+    const auto isGenre = isKey(key, keyLength, "GENRE");
+    const auto isComposer = isKey(key, keyLength, "COMPOSER");
+    const auto isLyricist = isKey(key, keyLength, "LYRICIST");
+    const auto isComment = isKey(key, keyLength, "DESCRIPTION") || isKey(key, keyLength, "COMMENT");
+
+    // unknown fields are skipped without being decoded
+    if (!isTitle && !isArtist && !isAlbum && !isAlbumArtist && !isTrackNumber && !isDiscNumber &&
+            !isDate && !isGenre && !isComposer && !isLyricist && !isComment) {
+        return true;
+    }
+
+    const auto decodedValue = QString::fromUtf8(value, valueLength);
+
+    if (isTitle) {
+        fields.setValue(fields.mTitle, decodedValue);
+    } else if (isArtist) {
+        fields.addValue(fields.mArtists, decodedValue);
+    } else if (isAlbum) {
+        fields.setValue(fields.mAlbum, decodedValue);
+    } else if (isAlbumArtist) {
+        fields.addValue(fields.mAlbumArtists, decodedValue);
+    } else if (isTrackNumber) {
+        fields.mTrackNumber = leadingNumber(decodedValue);
+    } else if (isDiscNumber) {
+        fields.mDiscNumber = leadingNumber(decodedValue);
+    } else if (isDate) {
+        fields.mYear = leadingNumber(decodedValue);
+    } else if (isGenre) {
+        fields.addValue(fields.mGenres, decodedValue);
+    } else if (isComposer) {
+        fields.addValue(fields.mComposers, decodedValue);
+    } else if (isLyricist) {
+        fields.addValue(fields.mLyricists, decodedValue);
+    } else if (isComment) {
+        fields.setValue(fields.mComment, decodedValue);
+    }
+
+    return true;
+}
+
+/* the comment block shared by FLAC and Ogg: a vendor string followed by KEY=value UTF-8 fields */
+static bool readVorbisComments(const uchar *data, qint64 size, FastTagFields &fields)
+{
+    if (size < 8) {
+        return false;
+    }
+
+    auto position = 4 + static_cast<qint64>(littleEndian32(data));
+    if (position > size - 4) {
+        return false;
+    }
+
+    const auto commentsCount = littleEndian32(data + position);
+    position += 4;
+
+    for (quint32 commentIndex = 0; commentIndex < commentsCount; ++commentIndex) {
+        if (position > size - 4) {
+            return false;
+        }
+
+        const auto commentLength = static_cast<qint64>(littleEndian32(data + position));
+        position += 4;
+
+        if (commentLength > size - position) {
+            return false;
+        }
+
+        const auto comment = reinterpret_cast<const char*>(data + position);
+        position += commentLength;
+
+        const auto separator = static_cast<const char*>(std::memchr(comment, '=', static_cast<size_t>(commentLength)));
+        if (!separator) {
+            continue;
+        }
+
+        const auto keyLength = static_cast<qint64>(separator - comment);
+        if (!addVorbisComment(comment, keyLength, separator + 1, static_cast<int>(commentLength - keyLength - 1), fields)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool readFlac(MappedHeader &header, FastTagFields &fields)
+{
+    auto blockPosition = qint64(4);
+    auto totalSamples = qint64(0);
+    auto isLastBlock = false;
+
+    while (!isLastBlock) {
+        if (!header.ensure(blockPosition + 4)) {
+            return false;
+        }
+
+        const auto blockHeader = header.at(blockPosition);
+        isLastBlock = (blockHeader[0] & 0x80) != 0;
+        const auto blockType = blockHeader[0] & 0x7f;
+        const auto blockSize = static_cast<qint64>(bigEndian24(blockHeader + 1));
+        const auto bodyPosition = blockPosition + 4;
+
+        blockPosition = bodyPosition + blockSize;
+
+        // only the type of the pictures is read: their data and the seek tables are never touched
+        if (blockType == 6 && blockSize >= 4) {
+            if (!header.ensure(bodyPosition + 4)) {
+                return false;
+            }
+
+            if (bigEndian32(header.at(bodyPosition)) == frontCoverPictureType) {
+                fields.mHasFrontCover = true;
+            }
+
+            continue;
+        }
+
+        if (blockType != 0 && blockType != 4) {
+            continue;
+        }
+
+        if (!header.ensure(bodyPosition + blockSize)) {
+            return false;
+        }
+
+        const auto blockBody = header.at(bodyPosition);
+
+        if (blockType == 0) {
+            if (blockSize < 34) {
+                return false;
+            }
+
+            fields.mSampleRate = static_cast<int>((static_cast<quint32>(blockBody[10]) << 12) | (static_cast<quint32>(blockBody[11]) << 4) |
+                    (static_cast<quint32>(blockBody[12]) >> 4));
+            fields.mChannels = ((blockBody[12] >> 1) & 0x07) + 1;
+            totalSamples = (static_cast<qint64>(blockBody[13] & 0x0f) << 32) | static_cast<qint64>(bigEndian32(blockBody + 14));
+        } else if (!readVorbisComments(blockBody, blockSize, fields)) {
+            return false;
+        }
+    }
+
+    // the last block goes past the end of a truncated file
+    if (fields.mSampleRate <= 0 || blockPosition > header.fileSize()) {
+        return false;
+    }
+
+    if (!roundedDuration(static_cast<double>(totalSamples) * 1000. / fields.mSampleRate, fields.mDuration)) {
+        return false;
+    }
+
+    fields.mBitRate = roundedBitRate(header.fileSize() - blockPosition, fields.mDuration);
+
+    return true;
+}
+
+static bool readOgg(QFile &audioFile, MappedHeader &header, FastTagFields &fields)
+{
+    auto pagePosition = qint64(0);
+    auto streamSerial = quint32(0);
+    auto packetIndex = 0;
+    auto isOpus = false;
+    auto preSkip = qint64(0);
+    QByteArray packet;
+
+    // the identification and comment headers, a packet only gets copied when it spans several pages
+    auto readPacket = [&](const QByteArray &onePacket) {
+        const auto packetData = reinterpret_cast<const uchar*>(onePacket.constData());
+
+        if (packetIndex == 0) {
+            if (onePacket.size() >= 30 && onePacket.startsWith("\x01vorbis")) {
+                fields.mChannels = packetData[11];
+                fields.mSampleRate = static_cast<int>(littleEndian32(packetData + 12));
+                return true;
+            }
+
+            if (onePacket.size() >= 19 && onePacket.startsWith("OpusHead")) {
+                isOpus = true;
+                fields.mChannels = packetData[9];
+                fields.mSampleRate = 48000;
+                preSkip = qFromLittleEndian<quint16>(packetData + 10);
+                return true;
+            }
+
+            return false;
+        }
+
+        const auto commentStart = (isOpus ? 8 : 7);
+        if (onePacket.size() < commentStart || !onePacket.startsWith(isOpus ? "OpusTags" : "\x03vorbis")) {
+            return false;
+        }
+
+        return readVorbisComments(packetData + commentStart, onePacket.size() - commentStart, fields);
+    };
+
+    while (packetIndex < 2) {
+        if (!header.ensure(pagePosition + TagParsing::oggPageFixedHeaderSize)) {
+            return false;
+        }
+
+        const auto pageHeaderSize = TagParsing::oggPageFixedHeaderSize + header.at(pagePosition)[26];
+
+        TagParsing::OggPageHeader pageHeader;
+        if (!header.ensure(pagePosition + pageHeaderSize) || !TagParsing::readOggPageHeader(header.at(pagePosition), pageHeaderSize, pageHeader)) {
+            return false;
+        }
+
+        const auto segmentsCount = pageHeaderSize - TagParsing::oggPageFixedHeaderSize;
+        const auto bodyPosition = pagePosition + pageHeaderSize;
+        const auto bodySize = pageHeader.mBodySize;
+
+        if (!header.ensure(bodyPosition + bodySize)) {
+            return false;
+        }
+
+        const auto page = header.at(pagePosition);
+
+        if (pagePosition == 0) {
+            streamSerial = pageHeader.mSerialNumber;
+        } else if (pageHeader.mSerialNumber != streamSerial) {
+            // multiplexed streams are left to the extractors
+            return false;
+        }
+
+        auto pieceStart = bodyPosition;
+        auto pieceSize = qint64(0);
+
+        for (qint64 segmentIndex = 0; segmentIndex < segmentsCount && packetIndex < 2; ++segmentIndex) {
+            const auto segmentSize = page[27 + segmentIndex];
+            pieceSize += segmentSize;
+
+            if (segmentSize == 255) {
+                continue;
+            }
+
+            const auto piece = reinterpret_cast<const char*>(header.at(pieceStart));
+            if (packet.isEmpty()) {
+                packet = QByteArray::fromRawData(piece, static_cast<int>(pieceSize));
+            } else {
+                packet.append(piece, static_cast<int>(pieceSize));
+            }
+
+            if (!readPacket(packet)) {
+                return false;
+            }
+
+            packet.clear();
+            ++packetIndex;
+            pieceStart += pieceSize;
+            pieceSize = 0;
+        }
+
+        if (packetIndex < 2 && pieceSize > 0) {
+            packet.append(reinterpret_cast<const char*>(header.at(pieceStart)), static_cast<int>(pieceSize));
+        }
+
+        pagePosition = bodyPosition + bodySize;
+    }
+
+    if (fields.mSampleRate <= 0) {
+        return false;
+    }
+
+    const auto fileSize = header.fileSize();
+    const auto tailSize = std::min(fileSize, oggTailSize);
+    const auto tail = audioFile.map(fileSize - tailSize, tailSize);
+
+    if (!tail) {
+        return false;
+    }
+
+    // the header pages do not give the length: only the pages after them are looked at
+    const auto firstAudioPosition = std::max(qint64(0), pagePosition - (fileSize - tailSize));
+
+    auto lastGranule = qint64(-1);
+    for (auto position = tailSize - 27; position >= firstAudioPosition && lastGranule < 0; --position) {
+        TagParsing::OggPageHeader tailPage;
+        if (tail[position] == 'O' && TagParsing::readOggPageHeader(tail + position, tailSize - position, tailPage) &&
+                tailPage.mSerialNumber == streamSerial) {
+            lastGranule = tailPage.mGranulePosition;
+        }
+    }
+
+    audioFile.unmap(tail);
+
+    if (lastGranule < 0) {
+        return false;
+    }
+
+    if (!roundedDuration(static_cast<double>(std::max(qint64(0), lastGranule - preSkip)) * 1000. / fields.mSampleRate, fields.mDuration)) {
+        return false;
+    }
+
+    fields.mBitRate = roundedBitRate(fileSize - pagePosition, fields.mDuration);
+
+    return true;
+}
+
+static qint64 id3v2StringEnd(const uchar *data, qint64 size, uchar encoding)
+{
+    const auto isWide = (encoding == 1 || encoding == 2);
+    const auto unitSize = qint64(isWide ? 2 : 1);
+
+    auto position = qint64(0);
+    while (position + unitSize <= size && !(data[position] == 0 && (!isWide || data[position + 1] == 0))) {
+        position += unitSize;
+    }
+
+    return std::min(position, size);
+}
+
+static QString id3v2String(const uchar *data, qint64 size, uchar encoding)
+{
+    switch (encoding)
+    {
+    case 0:
+        return QString::fromLatin1(reinterpret_cast<const char*>(data), static_cast<int>(size));
+    case 3:
+        return QString::fromUtf8(reinterpret_cast<const char*>(data), static_cast<int>(size));
+    case 1:
+    case 2:
+    {
+        auto isBigEndian = (encoding == 2);
+
+        if (encoding == 1 && size >= 2 && (data[0] == 0xfe || data[0] == 0xff) && data[0] != data[1]) {
+            isBigEndian = (data[0] == 0xfe);
+            data += 2;
+            size -= 2;
+        }
+
+        QString result(static_cast<int>(size / 2), Qt::Uninitialized);
+        auto characters = result.data();
+
+        for (int characterIndex = 0; characterIndex < result.size(); ++characterIndex) {
+            const auto oneCharacter = data + 2 * characterIndex;
+            characters[characterIndex] = QChar(isBigEndian ? qFromBigEndian<quint16>(oneCharacter) : qFromLittleEndian<quint16>(oneCharacter));
+        }
+
+        return result;
+    }
+    }
+
+    return {};
+}
+
+/* ID3v2.4 separates the values of a text frame with a terminator */
+static QStringList id3v2Strings(const uchar *data, qint64 size, uchar encoding)
+{
+    QStringList result;
+
+    const auto terminatorSize = qint64(encoding == 1 || encoding == 2 ? 2 : 1);
+
+    auto position = qint64(0);
+    while (position < size) {
+        const auto valueSize = id3v2StringEnd(data + position, size - position, encoding);
+        const auto oneValue = id3v2String(data + position, valueSize, encoding);
+
+        if (!oneValue.isEmpty()) {
+            result.push_back(oneValue);
+        }
+
+        position += valueSize + terminatorSize;
+    }
+
+    return result;
+}
+
+static bool addId3v2Frame(const uchar *frameId, const uchar *body, qint64 size, FastTagFields &fields)
+{
+    auto isFrame = [frameId](const char *expectedId) {
+        return std::memcmp(frameId, expectedId, 4) == 0;
+    };
+
+    // the rating lives in popularimeter frames
+    if (isFrame("POPM")) {
+        return false;
+    }
+
+    if (size < 1) {
+        return true;
+    }
+
+    const auto encoding = body[0];
+    if (encoding > 3) {
+        return false;
+    }
+
+    if (isFrame("APIC")) {
+        // a nul terminated MIME type comes before the picture type
+        const auto mimeTypeEnd = static_cast<const uchar*>(std::memchr(body + 1, 0, static_cast<size_t>(size - 1)));
+
+        if (mimeTypeEnd && mimeTypeEnd + 1 < body + size && mimeTypeEnd[1] == frontCoverPictureType) {
+            fields.mHasFrontCover = true;
+        }
+
+        return true;
+    }
+
+    if (isFrame("COMM")) {
+        if (size < 4) {
+            return true;
+        }
+
+        const auto descriptionSize = id3v2StringEnd(body + 4, size - 4, encoding);
+        const auto textPosition = std::min(size, 4 + descriptionSize + (encoding == 1 || encoding == 2 ? 2 : 1));
+        const auto hasDescription = (descriptionSize > 0 && !id3v2String(body + 4, descriptionSize, encoding).isEmpty());
+
+        // a comment without description is preferred over the other ones
+        if (fields.mComment.isEmpty() || (fields.mCommentHasDescription && !hasDescription)) {
+            fields.mComment = id3v2String(body + textPosition, id3v2StringEnd(body + textPosition, size - textPosition, encoding), encoding);
+            fields.mCommentHasDescription = hasDescription;
+        }
+
+        return true;
+    }
+
+    if (frameId[0] != 'T' || isFrame("TXXX")) {
+        return true;
+    }
+
+    const auto isTitle = isFrame("TIT2");
+    const auto isArtist = isFrame("TPE1");
+    const auto isAlbum = isFrame("TALB");
+    const auto isAlbumArtist = isFrame("TPE2");
+    const auto isTrackNumber = isFrame("TRCK");
+    const auto isDiscNumber = isFrame("TPOS");
+    const auto isYear = isFrame("TYER") || isFrame("TDRC");
+    const auto isGenre = isFrame("TCON");
+    const auto isComposer = isFrame("TCOM");
+    const auto isLyricist = isFrame("TEXT");
+
+    if (!isTitle && !isArtist && !isAlbum && !isAlbumArtist && !isTrackNumber && !isDiscNumber &&
+            !isYear && !isGenre && !isComposer && !isLyricist) {
+        return true;
+    }
+
+    const auto values = id3v2Strings(body + 1, size - 1, encoding);
+    if (values.isEmpty()) {
+        return true;
+    }
+
+    if (isTitle) {
+        fields.setValue(fields.mTitle, values.first());
+    } else if (isArtist) {
+        fields.mArtists += values;
+    } else if (isAlbum) {
+        fields.setValue(fields.mAlbum, values.first());
+    } else if (isAlbumArtist) {
+        fields.mAlbumArtists += values;
+    } else if (isTrackNumber) {
+        fields.mTrackNumber = leadingNumber(values.first());
+    } else if (isDiscNumber) {
+        fields.mDiscNumber = leadingNumber(values.first());
+    } else if (isYear) {
+        fields.mYear = leadingNumber(values.first());
+    } else if (isGenre) {
+        // numeric ID3v1 genres need the genre table of the extractors
+        for (const auto &oneGenre : values) {
+            auto isNumber = false;
+            oneGenre.toInt(&isNumber);
+
+            if (isNumber || oneGenre.startsWith(QLatin1Char('('))) {
+                return false;
+            }
+        }
+
+        fields.mGenres += values;
+    } else if (isComposer) {
+        fields.mComposers += values;
+    } else if (isLyricist) {
+        fields.mLyricists += values;
+    }
+
+    return true;
+}
+
+static bool readId3v2(MappedHeader &header, qint64 &tagEnd, FastTagFields &fields)
+{
+    if (!header.ensure(10)) {
+        return false;
+    }
+
+    const auto majorVersion = header.at(0)[3];
+    const auto tagFlags = header.at(0)[5];
+    const auto framesEnd = 10 + static_cast<qint64>(syncSafe32(header.at(6)));
+
+    tagEnd = framesEnd + ((majorVersion == 4 && (tagFlags & 0x10)) ? 10 : 0);
+
+    // ID3v2.2 and unsynchronised tags are left to the extractors
+    if ((majorVersion != 3 && majorVersion != 4) || (tagFlags & 0x80)) {
+        return false;
+    }
+
+    if (!header.ensure(framesEnd)) {
+        return false;
+    }
+
+    auto framePosition = qint64(10);
+
+    if (tagFlags & 0x40) {
+        if (framesEnd < 14) {
+            return false;
+        }
+
+        framePosition += (majorVersion == 4 ? static_cast<qint64>(syncSafe32(header.at(10))) :
+                                              static_cast<qint64>(bigEndian32(header.at(10))) + 4);
+
+        if (framePosition > framesEnd) {
+            return false;
+        }
+    }
+
+    while (framePosition + 10 <= framesEnd) {
+        const auto frameHeader = header.at(framePosition);
+
+        // padding
+        if (frameHeader[0] == 0) {
+            break;
+        }
+
+        for (int idIndex = 0; idIndex < 4; ++idIndex) {
+            if (!((frameHeader[idIndex] >= 'A' && frameHeader[idIndex] <= 'Z') || (frameHeader[idIndex] >= '0' && frameHeader[idIndex] <= '9'))) {
+                return false;
+            }
+        }
+
+        const auto frameSize = static_cast<qint64>(majorVersion == 4 ? syncSafe32(frameHeader + 4) : bigEndian32(frameHeader + 4));
+        const auto formatFlags = frameHeader[9];
+        const auto bodyPosition = framePosition + 10;
+
+        if (frameSize > framesEnd - bodyPosition) {
+            return false;
+        }
+
+        framePosition = bodyPosition + frameSize;
+
+        // compressed, encrypted, grouped or unsynchronised frames
+        if (formatFlags & (majorVersion == 4 ? 0x4f : 0xe0)) {
+            return false;
+        }
+
+        if (!addId3v2Frame(frameHeader, header.at(bodyPosition), frameSize, fields)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool readMpegAudio(QFile &audioFile, MappedHeader &header, qint64 streamStart, FastTagFields &fields)
+{
+    static const int bitRates[2][3][15] = {
+        {
+            {0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448},
+            {0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384},
+            {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320},
+        },
+        {
+            {0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256},
+            {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160},
+            {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160},
+        },
+    };
+    static const int sampleRates[3] = {44100, 48000, 32000};
+
+    const auto fileSize = header.fileSize();
+
+    // ID3v1 and APE tags at the end of the file are merged by the extractors
+    if (fileSize >= streamStart + 128) {
+        const auto tail = audioFile.map(fileSize - 128, 128);
+        if (!tail) {
+            return false;
+        }
+
+        const auto hasTrailingTag = (std::memcmp(tail, "TAG", 3) == 0 || std::memcmp(tail + 96, "APETAGEX", 8) == 0);
+        audioFile.unmap(tail);
+
+        if (hasTrailingTag) {
+            return false;
+        }
+    }
+
+    const auto searchEnd = std::min(fileSize, streamStart + mpegSyncSearchSize + 64);
+    if (!header.ensure(searchEnd)) {
+        return false;
+    }
+
+    // FLAC files starting with an ID3v2 tag
+    if (searchEnd - streamStart >= 4 && std::memcmp(header.at(streamStart), "fLaC", 4) == 0) {
+        return false;
+    }
+
+    for (auto framePosition = streamStart; framePosition + 4 <= searchEnd; ++framePosition) {
+        const auto frame = header.at(framePosition);
+        if (frame[0] != 0xff || (frame[1] & 0xe0) != 0xe0) {
+            continue;
+        }
+
+        const auto frameHeader = bigEndian32(frame);
+        const auto versionBits = (frameHeader >> 19) & 0x03;
+        const auto layerBits = (frameHeader >> 17) & 0x03;
+        const auto bitRateIndex = (frameHeader >> 12) & 0x0f;
+        const auto sampleRateIndex = (frameHeader >> 10) & 0x03;
+        const auto isMono = ((frameHeader >> 6) & 0x03) == 0x03;
+
+        if (versionBits == 1 || layerBits == 0 || bitRateIndex == 0 || bitRateIndex == 15 || sampleRateIndex == 3) {
+            continue;
+        }
+
+        const auto isMpeg1 = (versionBits == 3);
+        const auto layerIndex = 3 - static_cast<int>(layerBits);
+        const auto sampleRate = sampleRates[sampleRateIndex] >> (isMpeg1 ? 0 : (versionBits == 2 ? 1 : 2));
+        const auto samplesPerFrame = qint64(layerIndex == 0 ? 384 : (layerIndex == 2 && !isMpeg1 ? 576 : 1152));
+        const auto streamSize = fileSize - framePosition;
+
+        fields.mSampleRate = sampleRate;
+        fields.mChannels = (isMono ? 1 : 2);
+
+        // a Xing or VBRI header in the first frame gives the length of variable bit rate streams
+        auto framesCount = qint64(0);
+        auto framesSize = qint64(0);
+        const auto xingPosition = framePosition + 4 + (isMpeg1 ? (isMono ? 17 : 32) : (isMono ? 9 : 17));
+        const auto vbriPosition = framePosition + 36;
+
+        if (xingPosition + 16 <= searchEnd && (std::memcmp(header.at(xingPosition), "Xing", 4) == 0 || std::memcmp(header.at(xingPosition), "Info", 4) == 0)) {
+            const auto xingFlags = bigEndian32(header.at(xingPosition + 4));
+            auto fieldPosition = xingPosition + 8;
+
+            if (xingFlags & 0x01) {
+                framesCount = bigEndian32(header.at(fieldPosition));
+                fieldPosition += 4;
+            }
+
+            if (xingFlags & 0x02) {
+                framesSize = bigEndian32(header.at(fieldPosition));
+            }
+        } else if (vbriPosition + 18 <= searchEnd && std::memcmp(header.at(vbriPosition), "VBRI", 4) == 0) {
+            framesSize = bigEndian32(header.at(vbriPosition + 10));
+            framesCount = bigEndian32(header.at(vbriPosition + 14));
+        }
+
+        if (framesCount > 0) {
+            fields.mDuration = (framesCount * samplesPerFrame * 1000 + sampleRate / 2) / sampleRate;
+            fields.mBitRate = roundedBitRate(framesSize > 0 ? framesSize : streamSize, fields.mDuration);
+        } else {
+            const auto bitRate = bitRates[isMpeg1 ? 0 : 1][layerIndex][bitRateIndex];
+
+            fields.mDuration = (streamSize * 8 + bitRate / 2) / bitRate;
+            fields.mBitRate = bitRate * 1000;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+/* the average bit rate of the decoder configuration, inside the elementary stream descriptor */
+static quint32 mp4AverageBitRate(const uchar *data, qint64 begin, qint64 end)
+{
+    auto position = begin + 4;
+
+    auto readDescriptor = [&](uchar expectedTag) {
+        if (position >= end || data[position] != expectedTag) {
+            return false;
+        }
+
+        ++position;
+
+        // the length is coded on up to four bytes
+        for (int lengthIndex = 0; lengthIndex < 4 && position < end; ++lengthIndex) {
+            if (!(data[position++] & 0x80)) {
+                break;
+            }
+        }
+
+        return true;
+    };
+
+    if (!readDescriptor(0x03) || end - position < 3) {
+        return 0;
+    }
+
+    const auto streamFlags = data[position + 2];
+    position += 3;
+
+    if (streamFlags & 0x80) {
+        position += 2;
+    }
+
+    if ((streamFlags & 0x40) && position < end) {
+        position += 1 + data[position];
+    }
+
+    if (streamFlags & 0x20) {
+        position += 2;
+    }
+
+    if (!readDescriptor(0x04) || end - position < 13) {
+        return 0;
+    }
+
+    return bigEndian32(data + position + 9);
+}
+
+/* the media header of the audio track gives its length, like the extractors read it */
+static bool readMp4Duration(const uchar *data, const Mp4Atom &mdhd, qint64 &duration)
+{
+    auto durationScale = quint32(0);
+    auto mediaDuration = quint64(0);
+
+    const auto bodySize = mdhd.mEnd - mdhd.mBodyBegin;
+    const auto isVersion1 = (bodySize > 0 && data[mdhd.mBodyBegin] == 1);
+
+    if (bodySize < (isVersion1 ? 32 : 20)) {
+        return false;
+    }
+
+    if (isVersion1) {
+        durationScale = bigEndian32(data + mdhd.mBodyBegin + 20);
+        mediaDuration = qFromBigEndian<quint64>(data + mdhd.mBodyBegin + 24);
+    } else {
+        durationScale = bigEndian32(data + mdhd.mBodyBegin + 12);
+        mediaDuration = bigEndian32(data + mdhd.mBodyBegin + 16);
+    }
+
+    if (durationScale == 0) {
+        return false;
+    }
+
+    return roundedDuration(static_cast<double>(mediaDuration) * 1000. / durationScale, duration);
+}
+
+static bool readMp4AudioTrack(const uchar *data, const Mp4Atom &moov, qint64 mediaSize, FastTagFields &fields)
+{
+    Mp4Atom trak;
+    for (auto position = moov.mBodyBegin; readMp4Atom(data, position, moov.mEnd, trak); position = trak.mEnd) {
+        if (std::memcmp(trak.mType, "trak", 4) != 0) {
+            continue;
+        }
+
+        Mp4Atom mdia, mdhd, minf, stbl, stsd, sampleEntry;
+        if (!findMp4Atom(data, trak.mBodyBegin, trak.mEnd, "mdia", mdia) ||
+                !findMp4Atom(data, mdia.mBodyBegin, mdia.mEnd, "minf", minf) ||
+                !findMp4Atom(data, minf.mBodyBegin, minf.mEnd, "stbl", stbl) ||
+                !findMp4Atom(data, stbl.mBodyBegin, stbl.mEnd, "stsd", stsd) ||
+                !readMp4Atom(data, stsd.mBodyBegin + 8, stsd.mEnd, sampleEntry)) {
+            continue;
+        }
+
+        // other codecs, like ALAC, are left to the extractors
+        if (std::memcmp(sampleEntry.mType, "mp4a", 4) != 0) {
+            continue;
+        }
+
+        const auto entryBody = data + sampleEntry.mBodyBegin;
+        if (sampleEntry.mEnd - sampleEntry.mBodyBegin < 28 || bigEndian16(entryBody + 8) != 0) {
+            return false;
+        }
+
+        if (!findMp4Atom(data, mdia.mBodyBegin, mdia.mEnd, "mdhd", mdhd) || !readMp4Duration(data, mdhd, fields.mDuration)) {
+            return false;
+        }
+
+        fields.mChannels = bigEndian16(entryBody + 16);
+        fields.mSampleRate = static_cast<int>(bigEndian32(entryBody + 24) >> 16);
+
+        Mp4Atom esds;
+        const auto averageBitRate = (findMp4Atom(data, sampleEntry.mBodyBegin + 28, sampleEntry.mEnd, "esds", esds) ?
+                                         mp4AverageBitRate(data, esds.mBodyBegin, esds.mEnd) : 0);
+
+        fields.mBitRate = (averageBitRate > 0 ? static_cast<int>((averageBitRate + 500) / 1000) * 1000 :
+                                                roundedBitRate(mediaSize, fields.mDuration));
+
+        return true;
+    }
+
+    return false;
+}
+
+static bool readMp4Items(const uchar *data, const Mp4Atom &moov, FastTagFields &fields)
+{
+    Mp4Atom udta, meta, ilst;
+    if (!findMp4Atom(data, moov.mBodyBegin, moov.mEnd, "udta", udta) ||
+            !findMp4Atom(data, udta.mBodyBegin, udta.mEnd, "meta", meta)) {
+        return true;
+    }
+
+    // meta is a full atom: its children come after a version and flags
+    if (!findMp4Atom(data, meta.mBodyBegin + 4, meta.mEnd, "ilst", ilst)) {
+        return true;
+    }
+
+    Mp4Atom item;
+    for (auto itemPosition = ilst.mBodyBegin; readMp4Atom(data, itemPosition, ilst.mEnd, item); itemPosition = item.mEnd) {
+        auto isItem = [&item](const char *expectedType) {
+            return std::memcmp(item.mType, expectedType, 4) == 0;
+        };
+
+        if (isItem("gnre") || isItem("rate")) {
+            return false;
+        }
+
+        // type and locale come before the picture
+        if (isItem("covr")) {
+            Mp4Atom coverData;
+            if (findMp4Atom(data, item.mBodyBegin, item.mEnd, "data", coverData) && coverData.mEnd - coverData.mBodyBegin > 8) {
+                fields.mHasFrontCover = true;
+            }
+
+            continue;
+        }
+
+        auto isLyricist = false;
+        if (isItem("----")) {
+            Mp4Atom name;
+            if (!findMp4Atom(data, item.mBodyBegin, item.mEnd, "name", name) || name.mEnd - name.mBodyBegin < 4) {
+                continue;
+            }
+
+            const auto nameText = reinterpret_cast<const char*>(data + name.mBodyBegin + 4);
+            const auto nameLength = name.mEnd - name.mBodyBegin - 4;
+
+            if (isKey(nameText, nameLength, "RATING")) {
+                return false;
+            }
+
+            isLyricist = isKey(nameText, nameLength, "LYRICIST");
+            if (!isLyricist) {
+                continue;
+            }
+        }
+
+        const auto isTitle = isItem("\xa9nam");
+        const auto isArtist = isItem("\xa9" "ART");
+        const auto isAlbum = isItem("\xa9" "alb");
+        const auto isAlbumArtist = isItem("aART");
+        const auto isGenre = isItem("\xa9gen");
+        const auto isYear = isItem("\xa9" "day");
+        const auto isComposer = isItem("\xa9wrt");
+        const auto isComment = isItem("\xa9" "cmt");
+        const auto isTrackNumber = isItem("trkn");
+        const auto isDiscNumber = isItem("disk");
+
+        if (!isTitle && !isArtist && !isAlbum && !isAlbumArtist && !isGenre && !isYear && !isComposer &&
+                !isComment && !isTrackNumber && !isDiscNumber && !isLyricist) {
+            continue;
+        }
+
+        Mp4Atom itemData;
+        for (auto dataPosition = item.mBodyBegin; readMp4Atom(data, dataPosition, item.mEnd, itemData); dataPosition = itemData.mEnd) {
+            // type and locale come before the value
+            if (std::memcmp(itemData.mType, "data", 4) != 0 || itemData.mEnd - itemData.mBodyBegin < 8) {
+                continue;
+            }
+
+            const auto value = data + itemData.mBodyBegin + 8;
+            const auto valueSize = itemData.mEnd - itemData.mBodyBegin - 8;
+
+            if (isTrackNumber || isDiscNumber) {
+                if (valueSize >= 4) {
+                    (isTrackNumber ? fields.mTrackNumber : fields.mDiscNumber) = bigEndian16(value + 2);
+                }
+
+                continue;
+            }
+
+            const auto text = QString::fromUtf8(reinterpret_cast<const char*>(value), static_cast<int>(valueSize));
+
+            if (isTitle) {
+                fields.setValue(fields.mTitle, text);
+            } else if (isArtist) {
+                fields.addValue(fields.mArtists, text);
+            } else if (isAlbum) {
+                fields.setValue(fields.mAlbum, text);
+            } else if (isAlbumArtist) {
+                fields.addValue(fields.mAlbumArtists, text);
+            } else if (isGenre) {
+                fields.addValue(fields.mGenres, text);
+            } else if (isYear) {
+                fields.mYear = leadingNumber(text);
+            } else if (isComposer) {
+                fields.addValue(fields.mComposers, text);
+            } else if (isComment) {
+                fields.setValue(fields.mComment, text);
+            } else if (isLyricist) {
+                fields.addValue(fields.mLyricists, text);
+            }
+        }
+    }
+
+    return true;
+}
+
+static bool readMp4(QFile &audioFile, FastTagFields &fields)
+{
+    const auto fileSize = audioFile.size();
+
+    auto moovPosition = qint64(-1);
+    auto moovSize = qint64(0);
+    auto mediaSize = qint64(0);
+
+    // the top level atoms are walked with small reads: the media data is never mapped
+    Mp4Atom atom;
+    for (auto position = qint64(0); position < fileSize; position += atom.mEnd) {
+        if (!audioFile.seek(position)) {
+            return false;
+        }
+
+        const auto atomHeader = audioFile.read(16);
+        if (atomHeader.size() < 8) {
+            break;
+        }
+
+        // an atom going past the end of the file is either truncated or corrupted
+        if (!readMp4Atom(reinterpret_cast<const uchar*>(atomHeader.constData()), 0, fileSize - position, atom)) {
+            return false;
+        }
+
+        if (std::memcmp(atom.mType, "moov", 4) == 0) {
+            moovPosition = position;
+            moovSize = atom.mEnd;
+        } else if (std::memcmp(atom.mType, "mdat", 4) == 0) {
+            mediaSize += atom.mEnd - atom.mBodyBegin;
+        }
+    }
+
+    if (moovPosition < 0) {
+        return false;
+    }
+
+    const auto moovData = audioFile.map(moovPosition, moovSize);
+    if (!moovData) {
+        return false;
+    }
+
+    auto result = false;
+
+    Mp4Atom moov;
+    if (readMp4Atom(moovData, 0, moovSize, moov)) {
+        result = readMp4AudioTrack(moovData, moov, mediaSize, fields) && readMp4Items(moovData, moov, fields);
+    }
+
+    audioFile.unmap(moovData);
+
+    return result;
+}
+
+bool FastTagReader::readTags(const QString &localFileName, MusicAudioTrack &trackData)
+{
+    QFile audioFile(localFileName);
+
+    // the few bytes read outside of the mappings do not need buffering
+    if (!audioFile.open(QIODevice::ReadOnly | QIODevice::Unbuffered)) {
+        return false;
+    }
+
+    return readTags(audioFile, trackData);
+}
+
+bool FastTagReader::readTags(QFile &audioFile, MusicAudioTrack &trackData)
+{
+    // reading a mapped page past the end of a file truncated meanwhile, by a download or a tag editor, raises SIGBUS
+    if (audioFile.fileTime(QFileDevice::FileModificationTime).secsTo(QDateTime::currentDateTimeUtc()) < minimumFileAge) {
+        return false;
+    }
+
+    if (!audioFile.seek(0)) {
+        return false;
+    }
+
+    const auto fileHeader = audioFile.read(12);
+    if (fileHeader.size() < 12) {
+        return false;
+    }
+
+    FastTagFields fields;
+    auto isRead = false;
+
+    if (fileHeader.mid(4, 4) == "ftyp") {
+        isRead = readMp4(audioFile, fields);
+    } else {
+        MappedHeader header(audioFile);
+
+        if (fileHeader.startsWith("fLaC")) {
+            isRead = readFlac(header, fields);
+        } else if (fileHeader.startsWith("OggS")) {
+            isRead = readOgg(audioFile, header, fields);
+        } else if (fileHeader.startsWith("ID3")) {
+            // MPEG files with only an ID3v1 tag are left to the extractors
+            auto tagEnd = qint64(0);
+            isRead = readId3v2(header, tagEnd, fields) && readMpegAudio(audioFile, header, tagEnd, fields);
+        }
+    }
+
+    if (!isRead) {
+        return false;
+    }
+
+    fields.apply(trackData);
+
+    return true;
+}
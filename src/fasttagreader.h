@@ -0,0 +1,43 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FASTTAGREADER_H
+#define FASTTAGREADER_H
+
+#include "elisaLib_export.h"
+
+#include <QString>
+
+class QFile;
+class MusicAudioTrack;
+
+class ELISALIB_EXPORT FastTagReader
+{
+
+public:
+
+    /* parses FLAC, Ogg Vorbis and Opus, ID3v2 tagged MPEG and MP4 files in place from a memory mapping of their headers,
+       returns false without modifying trackData when the file needs the KFileMetaData extractors;
+       the presence of an embedded front cover is set from the picture headers, without reading the pictures;
+       files modified during the last minute are always refused: truncating a mapped file raises SIGBUS */
+    static bool readTags(const QString &localFileName, MusicAudioTrack &trackData);
+
+    static bool readTags(QFile &audioFile, MusicAudioTrack &trackData);
+
+};
+
+#endif // FASTTAGREADER_H
@@ -18,6 +18,8 @@
 #ifndef FILELISTENER_H
 #define FILELISTENER_H
 
+#include "elisaLib_export.h"
+
 #include "../abstractfile/abstractfilelistener.h"
 
 #include <QObject>
@@ -27,7 +29,7 @@
 class FileListenerPrivate;
 class LocalFileListing;
 
-class FileListener : public AbstractFileListener
+class ELISALIB_EXPORT FileListener : public AbstractFileListener
 {
     Q_OBJECT
 
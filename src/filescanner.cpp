@@ -17,6 +17,8 @@
 
 #include "filescanner.h"
 
+#include "fasttagreader.h"
+
 #include "config-upnp-qt.h"
 
 #if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
@@ -47,6 +49,10 @@ public:
     KFileMetaData::PropertyMap mAllProperties;
 #endif
 
+    bool mUseFastTagReader = false;
+
+    bool mEmbeddedCoverIsKnown = false;
+
 };
 
 FileScanner::FileScanner() : d(std::make_unique<FileScannerPrivate>())
@@ -57,20 +63,49 @@ FileScanner::~FileScanner() = default;
 
 MusicAudioTrack FileScanner::scanOneFile(const QUrl &scanFile, const QMimeDatabase &mimeDatabase)
 {
-#if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
     MusicAudioTrack newTrack;
 
+    d->mEmbeddedCoverIsKnown = false;
+
     auto localFileName = scanFile.toLocalFile();
 
     QFileInfo scanFileInfo(localFileName);
     newTrack.setFileModificationTime(scanFileInfo.fileTime(QFile::FileModificationTime));
     newTrack.setResourceURI(scanFile);
 
-    const auto &fileMimeType = mimeDatabase.mimeTypeForFile(localFileName);
+    // the callers already filtered the audio files: only an unknown extension needs the content to be read
+    auto fileMimeType = mimeDatabase.mimeTypeForFile(localFileName, QMimeDatabase::MatchExtension);
+    if (fileMimeType.isDefault()) {
+        fileMimeType = mimeDatabase.mimeTypeForFile(localFileName);
+    }
+
     if (!fileMimeType.name().startsWith(QStringLiteral("audio/"))) {
         return newTrack;
     }
 
+    // the built-in reader does not need KFileMetaData, only the extended attributes do
+    if (d->mUseFastTagReader && FastTagReader::readTags(localFileName, newTrack)) {
+#if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND && !defined Q_OS_ANDROID
+        auto fileData = KFileMetaData::UserMetaData(localFileName);
+
+        QString comment = fileData.userComment();
+        if (!comment.isEmpty()) {
+            newTrack.setComment(comment);
+        }
+
+        int rating = fileData.rating();
+        if (rating > 0) {
+            newTrack.setRating(rating);
+        }
+#endif
+
+        newTrack.setValid(newTrack.duration().isValid());
+        d->mEmbeddedCoverIsKnown = true;
+
+        return newTrack;
+    }
+
+#if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
     QString mimetype = fileMimeType.name();
 
     QList<KFileMetaData::Extractor*> exList = d->mAllExtractors.fetchExtractors(mimetype);
@@ -88,14 +123,24 @@ MusicAudioTrack FileScanner::scanOneFile(const QUrl &scanFile, const QMimeDataba
     d->mAllProperties = result.properties();
 
     scanProperties(localFileName, newTrack);
+#endif
 
     return newTrack;
-#else
-    Q_UNUSED(scanFile)
-    Q_UNUSED(mimeDatabase)
+}
 
-    return {};
-#endif
+void FileScanner::setUseFastTagReader(bool useFastTagReader)
+{
+    d->mUseFastTagReader = useFastTagReader;
+}
+
+bool FileScanner::useFastTagReader() const
+{
+    return d->mUseFastTagReader;
+}
+
+bool FileScanner::embeddedCoverIsKnown() const
+{
+    return d->mEmbeddedCoverIsKnown;
 }
 
 void FileScanner::scanProperties(const Baloo::File &match, MusicAudioTrack &trackData)
@@ -54,6 +54,14 @@ public:
 
     void scanProperties(const QString &localFileName, MusicAudioTrack &trackData);
 
+    /* tries the built-in reader of common tag formats before the KFileMetaData extractors */
+    void setUseFastTagReader(bool useFastTagReader);
+
+    bool useFastTagReader() const;
+
+    /* true when the built-in reader read the last scanned file: the track already tells if it embeds a front cover */
+    bool embeddedCoverIsKnown() const;
+
 private:
 
     std::unique_ptr<FileScannerPrivate> d;
@@ -0,0 +1,287 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "loudnessanalyzer.h"
+
+#include <QtMath>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+/* gain values follow ReplayGain 2.0 which uses EBU R128 loudness with a -18 LUFS reference */
+static const qreal referenceLoudness = -18.;
+
+static const qreal absoluteGate = -70.;
+
+static const qreal relativeGate = -10.;
+
+class BiquadFilter
+{
+public:
+
+    qreal mB0 = 1.;
+
+    qreal mB1 = 0.;
+
+    qreal mB2 = 0.;
+
+    qreal mA1 = 0.;
+
+    qreal mA2 = 0.;
+
+    qreal mState1 = 0.;
+
+    qreal mState2 = 0.;
+
+    qreal process(qreal input)
+    {
+        const auto output = mB0 * input + mState1;
+
+        mState1 = mB1 * input - mA1 * output + mState2;
+        mState2 = mB2 * input - mA2 * output;
+
+        return output;
+    }
+
+};
+
+class LoudnessAnalyzerPrivate
+{
+public:
+
+    int mSampleRate = 0;
+
+    int mChannelsCount = 0;
+
+    qint64 mSubBlockFramesCount = 0;
+
+    qint64 mCurrentFramesCount = 0;
+
+    QVector<BiquadFilter> mShelvingFilters;
+
+    QVector<BiquadFilter> mHighPassFilters;
+
+    QVector<qreal> mChannelsWeight;
+
+    QVector<qreal> mCurrentChannelsEnergy;
+
+    QVector<qreal> mSubBlocksEnergy;
+
+    QVector<qreal> mBlocksEnergy;
+
+    qreal mPeak = 0.;
+
+    void finishSubBlock()
+    {
+        auto subBlockEnergy = qreal{0.};
+
+        for (int channel = 0; channel < mChannelsCount; ++channel) {
+            subBlockEnergy += mChannelsWeight[channel] * mCurrentChannelsEnergy[channel];
+            mCurrentChannelsEnergy[channel] = 0.;
+        }
+
+        mSubBlocksEnergy.push_back(subBlockEnergy / mSubBlockFramesCount);
+        mCurrentFramesCount = 0;
+
+        if (mSubBlocksEnergy.size() > 4) {
+            mSubBlocksEnergy.removeFirst();
+        }
+
+        if (mSubBlocksEnergy.size() == 4) {
+            mBlocksEnergy.push_back(std::accumulate(mSubBlocksEnergy.begin(), mSubBlocksEnergy.end(), qreal{0.}) / 4.);
+        }
+    }
+
+};
+
+static qreal loudnessFromEnergy(qreal energy)
+{
+    return -0.691 + 10. * std::log10(energy);
+}
+
+static qreal energyFromLoudness(qreal loudness)
+{
+    return std::pow(10., (loudness + 0.691) / 10.);
+}
+
+LoudnessAnalyzer::LoudnessAnalyzer(int sampleRate, int channelsCount) : d(std::make_unique<LoudnessAnalyzerPrivate>())
+{
+    d->mSampleRate = sampleRate;
+    d->mChannelsCount = channelsCount;
+    d->mSubBlockFramesCount = std::max(1, sampleRate / 10);
+
+    /* K-weighting filter coefficients from ITU-R BS.1770 recomputed for the actual sample rate */
+    auto shelvingFilter = BiquadFilter{};
+    {
+        const auto f0 = 1681.974450955533;
+        const auto gain = 3.999843853973347;
+        const auto q = 0.7071752369554196;
+
+        const auto k = std::tan(M_PI * f0 / sampleRate);
+        const auto vh = std::pow(10., gain / 20.);
+        const auto vb = std::pow(vh, 0.4996667741545416);
+        const auto a0 = 1. + k / q + k * k;
+
+        shelvingFilter.mB0 = (vh + vb * k / q + k * k) / a0;
+        shelvingFilter.mB1 = 2. * (k * k - vh) / a0;
+        shelvingFilter.mB2 = (vh - vb * k / q + k * k) / a0;
+        shelvingFilter.mA1 = 2. * (k * k - 1.) / a0;
+        shelvingFilter.mA2 = (1. - k / q + k * k) / a0;
+    }
+
+    auto highPassFilter = BiquadFilter{};
+    {
+        const auto f0 = 38.13547087602444;
+        const auto q = 0.5003270373238773;
+
+        const auto k = std::tan(M_PI * f0 / sampleRate);
+        const auto a0 = 1. + k / q + k * k;
+
+        highPassFilter.mB0 = 1.;
+        highPassFilter.mB1 = -2.;
+        highPassFilter.mB2 = 1.;
+        highPassFilter.mA1 = 2. * (k * k - 1.) / a0;
+        highPassFilter.mA2 = (1. - k / q + k * k) / a0;
+    }
+
+    d->mShelvingFilters = QVector<BiquadFilter>(channelsCount, shelvingFilter);
+    d->mHighPassFilters = QVector<BiquadFilter>(channelsCount, highPassFilter);
+    d->mCurrentChannelsEnergy = QVector<qreal>(channelsCount, 0.);
+    d->mChannelsWeight = QVector<qreal>(channelsCount, 1.);
+
+    if (channelsCount == 6) {
+        d->mChannelsWeight = {1., 1., 1., 0., 1.41, 1.41};
+    } else if (channelsCount == 5) {
+        d->mChannelsWeight = {1., 1., 1., 1.41, 1.41};
+    }
+}
+
+LoudnessAnalyzer::~LoudnessAnalyzer()
+= default;
+
+void LoudnessAnalyzer::addSamples(const float *samples, qint64 framesCount)
+{
+    if (d->mChannelsCount <= 0 || d->mSampleRate <= 0) {
+        return;
+    }
+
+    for (qint64 frame = 0; frame < framesCount; ++frame) {
+        for (int channel = 0; channel < d->mChannelsCount; ++channel) {
+            const auto sample = static_cast<qreal>(samples[frame * d->mChannelsCount + channel]);
+
+            d->mPeak = std::max(d->mPeak, std::abs(sample));
+
+            const auto filteredSample = d->mHighPassFilters[channel].process(d->mShelvingFilters[channel].process(sample));
+
+            d->mCurrentChannelsEnergy[channel] += filteredSample * filteredSample;
+        }
+
+        ++d->mCurrentFramesCount;
+
+        if (d->mCurrentFramesCount == d->mSubBlockFramesCount) {
+            d->finishSubBlock();
+        }
+    }
+}
+
+bool LoudnessAnalyzer::isValid() const
+{
+    return !std::isinf(integratedLoudness());
+}
+
+qreal LoudnessAnalyzer::integratedLoudness() const
+{
+    const auto absoluteGateEnergy = energyFromLoudness(absoluteGate);
+
+    auto gatedEnergy = qreal{0.};
+    auto gatedBlocksCount = 0;
+
+    for (auto oneBlockEnergy : qAsConst(d->mBlocksEnergy)) {
+        if (oneBlockEnergy > absoluteGateEnergy) {
+            gatedEnergy += oneBlockEnergy;
+            ++gatedBlocksCount;
+        }
+    }
+
+    if (gatedBlocksCount == 0) {
+        return -std::numeric_limits<qreal>::infinity();
+    }
+
+    const auto relativeGateEnergy = energyFromLoudness(loudnessFromEnergy(gatedEnergy / gatedBlocksCount) + relativeGate);
+
+    gatedEnergy = 0.;
+    gatedBlocksCount = 0;
+
+    for (auto oneBlockEnergy : qAsConst(d->mBlocksEnergy)) {
+        if (oneBlockEnergy > absoluteGateEnergy && oneBlockEnergy > relativeGateEnergy) {
+            gatedEnergy += oneBlockEnergy;
+            ++gatedBlocksCount;
+        }
+    }
+
+    if (gatedBlocksCount == 0) {
+        return -std::numeric_limits<qreal>::infinity();
+    }
+
+    return loudnessFromEnergy(gatedEnergy / gatedBlocksCount);
+}
+
+qreal LoudnessAnalyzer::peak() const
+{
+    return d->mPeak;
+}
+
+qreal LoudnessAnalyzer::gain() const
+{
+    return gainFromLoudness(integratedLoudness());
+}
+
+qreal LoudnessAnalyzer::gainFromLoudness(qreal loudness)
+{
+    return referenceLoudness - loudness;
+}
+
+qreal LoudnessAnalyzer::loudnessFromGain(qreal gain)
+{
+    return referenceLoudness - gain;
+}
+
+qreal LoudnessAnalyzer::failedAnalysisPeak()
+{
+    return -1.;
+}
+
+qreal LoudnessAnalyzer::combinedLoudness(const QVector<qreal> &tracksLoudness, const QVector<qreal> &tracksWeight)
+{
+    auto totalEnergy = qreal{0.};
+    auto totalWeight = qreal{0.};
+
+    for (int i = 0; i < tracksLoudness.size(); ++i) {
+        const auto weight = (i < tracksWeight.size() && tracksWeight[i] > 0.) ? tracksWeight[i] : 1.;
+
+        totalEnergy += weight * energyFromLoudness(tracksLoudness[i]);
+        totalWeight += weight;
+    }
+
+    if (totalWeight <= 0.) {
+        return -std::numeric_limits<qreal>::infinity();
+    }
+
+    return loudnessFromEnergy(totalEnergy / totalWeight);
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOUDNESSANALYZER_H
+#define LOUDNESSANALYZER_H
+
+#include "elisaLib_export.h"
+
+#include <QVector>
+
+#include <memory>
+
+class LoudnessAnalyzerPrivate;
+
+class ELISALIB_EXPORT LoudnessAnalyzer
+{
+
+public:
+
+    LoudnessAnalyzer(int sampleRate, int channelsCount);
+
+    ~LoudnessAnalyzer();
+
+    void addSamples(const float *samples, qint64 framesCount);
+
+    bool isValid() const;
+
+    qreal integratedLoudness() const;
+
+    qreal peak() const;
+
+    qreal gain() const;
+
+    static qreal gainFromLoudness(qreal loudness);
+
+    static qreal loudnessFromGain(qreal gain);
+
+    static qreal combinedLoudness(const QVector<qreal> &tracksLoudness, const QVector<qreal> &tracksWeight);
+
+    /* stored as the peak of a track that could not be decoded, its gain stays empty until the file changes */
+    static qreal failedAnalysisPeak();
+
+private:
+
+    std::unique_ptr<LoudnessAnalyzerPrivate> d;
+
+};
+
+#endif // LOUDNESSANALYZER_H
@@ -0,0 +1,293 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "loudnessscanner.h"
+
+#include "loudnessanalyzer.h"
+#include "abstractfile/scanscheduler.h"
+
+#include <QAudioDecoder>
+#include <QAudioBuffer>
+#include <QEventLoop>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrentRun>
+#include <QTimer>
+#include <QSet>
+#include <QAtomicInt>
+#include <QDebug>
+
+#include <algorithm>
+#include <vector>
+
+class LoudnessScannerPrivate
+{
+public:
+
+    QThreadPool mPool;
+
+    ScanScheduler *mScanScheduler = nullptr;
+
+    QSet<qulonglong> mPendingTracks;
+
+    DatabaseInterface::ListTrackDataType mAnalyzedTracks;
+
+    QTimer mAnalyzedTracksTimer;
+
+    QAtomicInt mStopRequest = 0;
+
+};
+
+template <typename SampleType>
+static void convertSamples(const QAudioBuffer &buffer, qreal offset, qreal scale, std::vector<float> &samples)
+{
+    const auto data = buffer.constData<SampleType>();
+
+    for (int i = 0; i < buffer.sampleCount(); ++i) {
+        samples[static_cast<size_t>(i)] = static_cast<float>((data[i] - offset) / scale);
+    }
+}
+
+static bool samplesFromBuffer(const QAudioBuffer &buffer, std::vector<float> &samples)
+{
+    const auto &format = buffer.format();
+
+    samples.resize(static_cast<size_t>(buffer.sampleCount()));
+
+    switch (format.sampleType())
+    {
+    case QAudioFormat::Float:
+        if (format.sampleSize() != 32) {
+            return false;
+        }
+        convertSamples<float>(buffer, 0., 1., samples);
+        return true;
+    case QAudioFormat::SignedInt:
+        if (format.sampleSize() == 16) {
+            convertSamples<qint16>(buffer, 0., 32768., samples);
+            return true;
+        }
+        if (format.sampleSize() == 32) {
+            convertSamples<qint32>(buffer, 0., 2147483648., samples);
+            return true;
+        }
+        return false;
+    case QAudioFormat::UnSignedInt:
+        if (format.sampleSize() == 8) {
+            convertSamples<quint8>(buffer, 128., 128., samples);
+            return true;
+        }
+        return false;
+    case QAudioFormat::Unknown:
+        return false;
+    }
+
+    return false;
+}
+
+LoudnessScanner::LoudnessScanner(QObject *parent) : QObject(parent), d(std::make_unique<LoudnessScannerPrivate>())
+{
+    d->mPool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
+
+    d->mAnalyzedTracksTimer.setSingleShot(true);
+    d->mAnalyzedTracksTimer.setInterval(1000);
+
+    connect(&d->mAnalyzedTracksTimer, &QTimer::timeout,
+            this, &LoudnessScanner::emitAnalyzedTracks);
+}
+
+LoudnessScanner::~LoudnessScanner()
+{
+    applicationAboutToQuit();
+}
+
+void LoudnessScanner::setScanScheduler(ScanScheduler *scheduler)
+{
+    d->mScanScheduler = scheduler;
+}
+
+DatabaseInterface::TrackDataType LoudnessScanner::analyzeTrack(const DatabaseInterface::TrackDataType &track, const QAtomicInt &stopRequest,
+                                                               ScanScheduler *scheduler)
+{
+    auto result = DatabaseInterface::TrackDataType{};
+
+    result[DatabaseInterface::DatabaseIdRole] = track[DatabaseInterface::DatabaseIdRole];
+    result[DatabaseInterface::AlbumIdRole] = track[DatabaseInterface::AlbumIdRole];
+    result[DatabaseInterface::TrackGainRole] = QVariant{};
+    result[DatabaseInterface::TrackPeakRole] = LoudnessAnalyzer::failedAnalysisPeak();
+
+    const auto trackUrl = track[DatabaseInterface::ResourceRole].toUrl();
+
+    if (!trackUrl.isLocalFile()) {
+        return result;
+    }
+
+    QAudioDecoder decoder;
+    QEventLoop decoderLoop;
+    std::unique_ptr<LoudnessAnalyzer> analyzer;
+    std::vector<float> samples;
+    auto hasFailed = false;
+
+    QObject::connect(&decoder, &QAudioDecoder::bufferReady, &decoderLoop, [&]() {
+        // a long track must not keep decoding while playback is buffering
+        if (scheduler) {
+            scheduler->waitWhilePaused(stopRequest);
+        }
+
+        while (decoder.bufferAvailable()) {
+            const auto buffer = decoder.read();
+
+            if (!buffer.isValid() || buffer.format().channelCount() <= 0) {
+                continue;
+            }
+
+            if (!analyzer) {
+                analyzer = std::make_unique<LoudnessAnalyzer>(buffer.format().sampleRate(), buffer.format().channelCount());
+            }
+
+            if (!samplesFromBuffer(buffer, samples)) {
+                hasFailed = true;
+                break;
+            }
+
+            analyzer->addSamples(samples.data(), buffer.frameCount());
+        }
+
+        if (hasFailed || stopRequest == 1) {
+            decoder.stop();
+            decoderLoop.quit();
+        }
+    });
+    QObject::connect(&decoder, &QAudioDecoder::finished, &decoderLoop, &QEventLoop::quit);
+    QObject::connect(&decoder, QOverload<QAudioDecoder::Error>::of(&QAudioDecoder::error), &decoderLoop, [&](QAudioDecoder::Error error) {
+        qDebug() << "LoudnessScanner::analyzeTrack" << trackUrl << error << decoder.errorString();
+
+        hasFailed = true;
+        decoderLoop.quit();
+    });
+
+    decoder.setSourceFilename(trackUrl.toLocalFile());
+    decoder.start();
+
+    decoderLoop.exec();
+
+    if (stopRequest == 1) {
+        return {};
+    }
+
+    if (hasFailed || !analyzer || !analyzer->isValid()) {
+        return result;
+    }
+
+    result[DatabaseInterface::TrackGainRole] = analyzer->gain();
+    result[DatabaseInterface::TrackPeakRole] = analyzer->peak();
+
+    return result;
+}
+
+void LoudnessScanner::analyzeTracks(const DatabaseInterface::ListTrackDataType &tracks)
+{
+    for (const auto &oneTrack : tracks) {
+        analyzeModifiedTrack(oneTrack);
+    }
+}
+
+void LoudnessScanner::analyzeModifiedTrack(const DatabaseInterface::TrackDataType &track)
+{
+    if (d->mStopRequest == 1) {
+        return;
+    }
+
+    const auto &trackPeak = track[DatabaseInterface::TrackPeakRole];
+    const auto hasFailedBefore = !trackPeak.isNull() && trackPeak.toDouble() < 0.;
+
+    if (!track[DatabaseInterface::TrackGainRole].isNull() || hasFailedBefore || d->mPendingTracks.contains(track.databaseId())) {
+        return;
+    }
+
+    d->mPendingTracks.insert(track.databaseId());
+
+    QtConcurrent::run(&d->mPool, [this, track] () {
+        QThread::currentThread()->setPriority(QThread::IdlePriority);
+
+        if (d->mStopRequest == 1) {
+            return;
+        }
+
+        if (d->mScanScheduler) {
+            d->mScanScheduler->waitWhilePaused(d->mStopRequest);
+        }
+
+        // reading the track takes one worker of its device, shared with the indexer
+        ScanScheduler::DeviceSlot deviceSlot(d->mScanScheduler, track[DatabaseInterface::ResourceRole].toUrl().toLocalFile());
+
+        QElapsedTimer analyzeTimer;
+        analyzeTimer.start();
+
+        auto analyzedTrack = analyzeTrack(track, d->mStopRequest, d->mScanScheduler);
+        analyzedTrack[DatabaseInterface::DatabaseIdRole] = track[DatabaseInterface::DatabaseIdRole];
+
+        deviceSlot.release();
+
+        if (d->mScanScheduler) {
+            d->mScanScheduler->waitForBudget(analyzeTimer.nsecsElapsed(), d->mStopRequest);
+        }
+
+        QMetaObject::invokeMethod(this, [this, analyzedTrack] () {
+            trackAnalyzed(analyzedTrack);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void LoudnessScanner::applicationAboutToQuit()
+{
+    d->mStopRequest = 1;
+
+    d->mPool.clear();
+    d->mPool.waitForDone();
+}
+
+void LoudnessScanner::trackAnalyzed(const DatabaseInterface::TrackDataType &track)
+{
+    d->mPendingTracks.remove(track.databaseId());
+
+    if (!track.contains(DatabaseInterface::TrackGainRole)) {
+        return;
+    }
+
+    d->mAnalyzedTracks.push_back(track);
+
+    if (!d->mAnalyzedTracksTimer.isActive()) {
+        d->mAnalyzedTracksTimer.start();
+    }
+}
+
+void LoudnessScanner::emitAnalyzedTracks()
+{
+    if (d->mAnalyzedTracks.isEmpty()) {
+        return;
+    }
+
+    auto analyzedTracks = DatabaseInterface::ListTrackDataType{};
+    analyzedTracks.swap(d->mAnalyzedTracks);
+
+    Q_EMIT tracksLoudnessAnalyzed(analyzedTracks);
+}
+
+
+#include "moc_loudnessscanner.cpp"
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOUDNESSSCANNER_H
+#define LOUDNESSSCANNER_H
+
+#include "elisaLib_export.h"
+
+#include "databaseinterface.h"
+
+#include <QObject>
+
+#include <memory>
+
+class LoudnessScannerPrivate;
+class ScanScheduler;
+
+class ELISALIB_EXPORT LoudnessScanner : public QObject
+{
+
+    Q_OBJECT
+
+public:
+
+    explicit LoudnessScanner(QObject *parent = nullptr);
+
+    ~LoudnessScanner() override;
+
+    /* the analysis shares the indexer workers and budget, and pauses with it while playback is buffering */
+    void setScanScheduler(ScanScheduler *scheduler);
+
+    static DatabaseInterface::TrackDataType analyzeTrack(const DatabaseInterface::TrackDataType &track, const QAtomicInt &stopRequest,
+                                                         ScanScheduler *scheduler = nullptr);
+
+Q_SIGNALS:
+
+    void tracksLoudnessAnalyzed(const DatabaseInterface::ListTrackDataType &tracks);
+
+public Q_SLOTS:
+
+    void analyzeTracks(const DatabaseInterface::ListTrackDataType &tracks);
+
+    void analyzeModifiedTrack(const DatabaseInterface::TrackDataType &track);
+
+    void applicationAboutToQuit();
+
+private Q_SLOTS:
+
+    void trackAnalyzed(const DatabaseInterface::TrackDataType &track);
+
+    void emitAnalyzedTracks();
+
+private:
+
+    std::unique_ptr<LoudnessScannerPrivate> d;
+
+};
+
+#endif // LOUDNESSSCANNER_H
@@ -22,6 +22,9 @@
 #include <QTimer>
 #include <QDateTime>
 
+#include <algorithm>
+#include <cmath>
+
 ManageAudioPlayer::ManageAudioPlayer(QObject *parent) : QObject(parent)
 {
 
@@ -32,6 +35,11 @@ QPersistentModelIndex ManageAudioPlayer::currentTrack() const
     return mCurrentTrack;
 }
 
+QPersistentModelIndex ManageAudioPlayer::nextTrack() const
+{
+    return mNextTrack;
+}
+
 QAbstractItemModel *ManageAudioPlayer::playListModel() const
 {
     return mPlayListModel;
@@ -47,6 +55,16 @@ int ManageAudioPlayer::isPlayingRole() const
     return mIsPlayingRole;
 }
 
+int ManageAudioPlayer::replayGainRole() const
+{
+    return mReplayGainRole;
+}
+
+int ManageAudioPlayer::replayPeakRole() const
+{
+    return mReplayPeakRole;
+}
+
 QUrl ManageAudioPlayer::playerSource() const
 {
     if (!mCurrentTrack.isValid()) {
@@ -61,6 +79,12 @@ QMediaPlayer::MediaStatus ManageAudioPlayer::playerStatus() const
     return mPlayerStatus;
 }
 
+bool ManageAudioPlayer::playerIsBuffering() const
+{
+    // a stalled media can stay stalled forever, do not hold the indexer for it
+    return mPlayerStatus == QMediaPlayer::LoadingMedia || mPlayerStatus == QMediaPlayer::BufferingMedia;
+}
+
 QMediaPlayer::State ManageAudioPlayer::playerPlaybackState() const
 {
     return mPlayerPlaybackState;
@@ -137,6 +161,20 @@ int ManageAudioPlayer::albumNameRole() const
 
 void ManageAudioPlayer::setCurrentTrack(const QPersistentModelIndex &currentTrack)
 {
+    if (!mGaplessSource.isEmpty()) {
+        auto gaplessSource = mGaplessSource;
+        mGaplessSource.clear();
+
+        if (currentTrack.isValid() && currentTrack.data(mUrlRole).toUrl() == gaplessSource) {
+            mOldCurrentTrack = mCurrentTrack;
+            mCurrentTrack = currentTrack;
+
+            switchToPreloadedTrack();
+
+            return;
+        }
+    }
+
     mOldCurrentTrack = mCurrentTrack;
 
     mCurrentTrack = currentTrack;
@@ -166,6 +204,26 @@ void ManageAudioPlayer::setCurrentTrack(const QPersistentModelIndex &currentTrac
     }
 }
 
+void ManageAudioPlayer::setNextTrack(const QPersistentModelIndex &nextTrack)
+{
+    if (mNextTrack == nextTrack) {
+        return;
+    }
+
+    mNextTrack = nextTrack;
+    Q_EMIT nextTrackChanged();
+
+    notifyPlayerNextSourceProperty();
+}
+
+void ManageAudioPlayer::playerNextSourceStarted(const QUrl &source)
+{
+    mGaplessSource = source;
+    mPlayerNextSource.clear();
+
+    triggerSkipNextTrack();
+}
+
 void ManageAudioPlayer::setPlayListModel(QAbstractItemModel *aPlayListModel)
 {
     if (mPlayListModel == aPlayListModel) {
@@ -203,15 +261,45 @@ void ManageAudioPlayer::setIsPlayingRole(int value)
     Q_EMIT isPlayingRoleChanged();
 }
 
+void ManageAudioPlayer::setReplayGainRole(int value)
+{
+    if (mReplayGainRole == value) {
+        return;
+    }
+
+    mReplayGainRole = value;
+    Q_EMIT replayGainRoleChanged();
+
+    notifyPlayerReplayGain();
+}
+
+void ManageAudioPlayer::setReplayPeakRole(int value)
+{
+    if (mReplayPeakRole == value) {
+        return;
+    }
+
+    mReplayPeakRole = value;
+    Q_EMIT replayPeakRoleChanged();
+
+    notifyPlayerReplayGain();
+}
+
 void ManageAudioPlayer::setPlayerStatus(QMediaPlayer::MediaStatus playerStatus)
 {
     if (mPlayerStatus == playerStatus) {
         return;
     }
 
+    const auto wasBuffering = playerIsBuffering();
+
     mPlayerStatus = playerStatus;
     Q_EMIT playerStatusChanged();
 
+    if (wasBuffering != playerIsBuffering()) {
+        Q_EMIT playerBufferingChanged(playerIsBuffering());
+    }
+
     switch (mPlayerStatus) {
     case QMediaPlayer::NoMedia:
         break;
@@ -430,6 +518,11 @@ void ManageAudioPlayer::playListFinished()
 
 void ManageAudioPlayer::tracksDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
 {
+    if (mNextTrack.isValid() && mNextTrack.row() >= topLeft.row() && mNextTrack.row() <= bottomRight.row() &&
+            (roles.isEmpty() || roles.contains(mUrlRole))) {
+        notifyPlayerNextSourceProperty();
+    }
+
     if (!mCurrentTrack.isValid()) {
         return;
     }
@@ -450,6 +543,8 @@ void ManageAudioPlayer::tracksDataChanged(const QModelIndex &topLeft, const QMod
             if (oneRole == mUrlRole) {
                 notifyPlayerSourceProperty();
                 restorePreviousState();
+            } else if (oneRole == mReplayGainRole || oneRole == mReplayPeakRole) {
+                notifyPlayerReplayGain();
             }
         }
     }
@@ -499,14 +594,72 @@ void ManageAudioPlayer::setAlbumNameRole(int albumNameRole)
 
 void ManageAudioPlayer::notifyPlayerSourceProperty()
 {
+    notifyPlayerReplayGain();
+
     auto newUrlValue = mCurrentTrack.data(mUrlRole);
     if (mSkippingCurrentTrack || mOldPlayerSource != newUrlValue) {
         Q_EMIT playerSourceChanged(mCurrentTrack.data(mUrlRole).toUrl());
 
+        // a skip must restart the player even when both tracks share the same url
+        Q_EMIT playerLoadSource(mCurrentTrack.data(mUrlRole).toUrl(), mSkippingCurrentTrack);
+
         mOldPlayerSource = newUrlValue;
     }
 }
 
+void ManageAudioPlayer::notifyPlayerNextSourceProperty()
+{
+    auto newUrlValue = (mNextTrack.isValid() ? mNextTrack.data(mUrlRole).toUrl() : QUrl());
+    if (mPlayerNextSource != newUrlValue) {
+        mPlayerNextSource = newUrlValue;
+
+        Q_EMIT playerNextSourceChanged(mPlayerNextSource);
+    }
+}
+
+void ManageAudioPlayer::notifyPlayerReplayGain()
+{
+    auto newReplayGain = qreal{0.};
+
+    if (mCurrentTrack.isValid() && mReplayGainRole != -1) {
+        const auto gainValue = mCurrentTrack.data(mReplayGainRole);
+
+        if (!gainValue.isNull()) {
+            newReplayGain = gainValue.toDouble();
+
+            const auto peakValue = (mReplayPeakRole != -1 ? mCurrentTrack.data(mReplayPeakRole).toDouble() : 0.);
+            if (peakValue > 0.) {
+                newReplayGain = std::min(newReplayGain, -20. * std::log10(peakValue));
+            }
+        }
+    }
+
+    if (!qFuzzyCompare(1. + newReplayGain, 1. + mPlayerReplayGain)) {
+        mPlayerReplayGain = newReplayGain;
+
+        Q_EMIT playerReplayGainChanged(mPlayerReplayGain);
+    }
+}
+
+void ManageAudioPlayer::switchToPreloadedTrack()
+{
+    mPlayerError = QMediaPlayer::NoError;
+    mSkippingCurrentTrack = false;
+
+    Q_EMIT currentTrackChanged();
+
+    if (mPlayListModel) {
+        if (mOldCurrentTrack.isValid()) {
+            mPlayListModel->setData(mOldCurrentTrack, MediaPlayList::NotPlaying, mIsPlayingRole);
+        }
+        mPlayListModel->setData(mCurrentTrack, MediaPlayList::IsPlaying, mIsPlayingRole);
+    }
+
+    Q_EMIT startedPlayingTrack(mCurrentTrack.data(mUrlRole).toUrl(), QDateTime::currentDateTime());
+
+    notifyPlayerSourceProperty();
+}
+
 void ManageAudioPlayer::triggerPlay()
 {
     QTimer::singleShot(0, [this]() {Q_EMIT playerPlay();});
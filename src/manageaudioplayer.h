@@ -37,6 +37,11 @@ class ELISALIB_EXPORT ManageAudioPlayer : public QObject
                WRITE setCurrentTrack
                NOTIFY currentTrackChanged)
 
+    Q_PROPERTY(QPersistentModelIndex nextTrack
+               READ nextTrack
+               WRITE setNextTrack
+               NOTIFY nextTrackChanged)
+
     Q_PROPERTY(QAbstractItemModel* playListModel
                READ playListModel
                WRITE setPlayListModel
@@ -71,6 +76,16 @@ class ELISALIB_EXPORT ManageAudioPlayer : public QObject
                WRITE setIsPlayingRole
                NOTIFY isPlayingRoleChanged)
 
+    Q_PROPERTY(int replayGainRole
+               READ replayGainRole
+               WRITE setReplayGainRole
+               NOTIFY replayGainRoleChanged)
+
+    Q_PROPERTY(int replayPeakRole
+               READ replayPeakRole
+               WRITE setReplayPeakRole
+               NOTIFY replayPeakRoleChanged)
+
     Q_PROPERTY(QMediaPlayer::MediaStatus playerStatus
                READ playerStatus
                WRITE setPlayerStatus
@@ -117,16 +132,24 @@ public:
 
     QPersistentModelIndex currentTrack() const;
 
+    QPersistentModelIndex nextTrack() const;
+
     QAbstractItemModel* playListModel() const;
 
     int urlRole() const;
 
     int isPlayingRole() const;
 
+    int replayGainRole() const;
+
+    int replayPeakRole() const;
+
     QUrl playerSource() const;
 
     QMediaPlayer::MediaStatus playerStatus() const;
 
+    bool playerIsBuffering() const;
+
     QMediaPlayer::State playerPlaybackState() const;
 
     QMediaPlayer::Error playerError() const;
@@ -153,14 +176,26 @@ Q_SIGNALS:
 
     void currentTrackChanged();
 
+    void nextTrackChanged();
+
     void playListModelChanged();
 
     void playerSourceChanged(QUrl url);
 
+    void playerLoadSource(QUrl url, bool forceReload);
+
+    void playerNextSourceChanged(QUrl url);
+
     void urlRoleChanged();
 
     void isPlayingRoleChanged();
 
+    void replayGainRoleChanged();
+
+    void replayPeakRoleChanged();
+
+    void playerReplayGainChanged(qreal gain);
+
     void playerStatusChanged();
 
     void playerPlaybackStateChanged();
@@ -199,16 +234,26 @@ Q_SIGNALS:
 
     void startedPlayingTrack(const QUrl &fileName, const QDateTime &time);
 
+    void playerBufferingChanged(bool isBuffering);
+
 public Q_SLOTS:
 
     void setCurrentTrack(const QPersistentModelIndex &currentTrack);
 
+    void setNextTrack(const QPersistentModelIndex &nextTrack);
+
+    void playerNextSourceStarted(const QUrl &source);
+
     void setPlayListModel(QAbstractItemModel* aPlayListModel);
 
     void setUrlRole(int value);
 
     void setIsPlayingRole(int value);
 
+    void setReplayGainRole(int value);
+
+    void setReplayPeakRole(int value);
+
     void setPlayerStatus(QMediaPlayer::MediaStatus playerStatus);
 
     void setPlayerPlaybackState(QMediaPlayer::State playerPlaybackState);
@@ -249,6 +294,12 @@ private:
 
     void notifyPlayerSourceProperty();
 
+    void notifyPlayerNextSourceProperty();
+
+    void notifyPlayerReplayGain();
+
+    void switchToPreloadedTrack();
+
     void triggerPlay();
 
     void triggerPause();
@@ -263,6 +314,8 @@ private:
 
     QPersistentModelIndex mOldCurrentTrack;
 
+    QPersistentModelIndex mNextTrack;
+
     QAbstractItemModel *mPlayListModel = nullptr;
 
     int mTitleRole = Qt::DisplayRole;
@@ -275,8 +328,18 @@ private:
 
     int mIsPlayingRole = Qt::DisplayRole;
 
+    int mReplayGainRole = -1;
+
+    int mReplayPeakRole = -1;
+
+    qreal mPlayerReplayGain = 0.;
+
     QVariant mOldPlayerSource;
 
+    QUrl mPlayerNextSource;
+
+    QUrl mGaplessSource;
+
     QMediaPlayer::MediaStatus mPlayerStatus = QMediaPlayer::NoMedia;
 
     QMediaPlayer::State mPlayerPlaybackState = QMediaPlayer::StoppedState;
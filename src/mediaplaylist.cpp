@@ -41,6 +41,8 @@ public:
 
     QPersistentModelIndex mCurrentTrack;
 
+    QPersistentModelIndex mNextTrack;
+
     QVariantMap mPersistentState;
 
     QMediaPlaylist mLoadPlaylist;
@@ -58,6 +60,12 @@ MediaPlayList::MediaPlayList(QObject *parent) : QAbstractListModel(parent), d(ne
     connect(&d->mLoadPlaylist, &QMediaPlaylist::loaded, this, &MediaPlayList::loadPlayListLoaded);
     connect(&d->mLoadPlaylist, &QMediaPlaylist::loadFailed, this, &MediaPlayList::loadPlayListLoadFailed);
 
+    connect(this, &MediaPlayList::rowsInserted, this, &MediaPlayList::notifyNextTrackChanged);
+    connect(this, &MediaPlayList::rowsRemoved, this, &MediaPlayList::notifyNextTrackChanged);
+    connect(this, &MediaPlayList::rowsMoved, this, &MediaPlayList::notifyNextTrackChanged);
+    connect(this, &MediaPlayList::modelReset, this, &MediaPlayList::notifyNextTrackChanged);
+    connect(this, &MediaPlayList::dataChanged, this, &MediaPlayList::nextTrackDataChanged);
+
     auto currentMsecTime = QTime::currentTime().msec();
 
     if (currentMsecTime != -1) {
@@ -139,6 +147,18 @@ QVariant MediaPlayList::data(const QModelIndex &index, int role) const
             }
             break;
         }
+        case ColumnsRoles::AlbumGainRole:
+            result = d->mTrackData[index.row()][TrackDataType::key_type::AlbumGainRole];
+            if (result.isNull()) {
+                result = d->mTrackData[index.row()][TrackDataType::key_type::TrackGainRole];
+            }
+            break;
+        case ColumnsRoles::AlbumPeakRole:
+            result = d->mTrackData[index.row()][TrackDataType::key_type::AlbumPeakRole];
+            if (result.isNull()) {
+                result = d->mTrackData[index.row()][TrackDataType::key_type::TrackPeakRole];
+            }
+            break;
         default:
             result = d->mTrackData[index.row()][static_cast<TrackDataType::key_type>(role)];
         }
@@ -701,6 +721,34 @@ int MediaPlayList::currentTrackRow() const
     return d->mCurrentTrack.row();
 }
 
+QPersistentModelIndex MediaPlayList::nextTrack() const
+{
+    if (!d->mCurrentTrack.isValid() || d->mRandomPlay) {
+        return {};
+    }
+
+    auto candidateTrack = QModelIndex{};
+
+    if (d->mCurrentTrack.row() < rowCount() - 1) {
+        candidateTrack = index(d->mCurrentTrack.row() + 1, 0);
+    } else if (d->mRepeatPlay && rowCount() > 1) {
+        for(int row = 0; row < rowCount(); ++row) {
+            auto oneTrack = index(row, 0);
+
+            if (oneTrack.data(ColumnsRoles::IsValidRole).toBool()) {
+                candidateTrack = oneTrack;
+                break;
+            }
+        }
+    }
+
+    if (!candidateTrack.isValid() || !candidateTrack.data(ColumnsRoles::IsValidRole).toBool()) {
+        return {};
+    }
+
+    return candidateTrack;
+}
+
 bool MediaPlayList::randomPlay() const
 {
     return d->mRandomPlay;
@@ -937,12 +985,16 @@ void MediaPlayList::setRandomPlay(bool value)
 {
     d->mRandomPlay = value;
     Q_EMIT randomPlayChanged();
+
+    notifyNextTrackChanged();
 }
 
 void MediaPlayList::setRepeatPlay(bool value)
 {
     d->mRepeatPlay = value;
     Q_EMIT repeatPlayChanged();
+
+    notifyNextTrackChanged();
 }
 
 void MediaPlayList::skipNextTrack()
@@ -1124,6 +1176,36 @@ void MediaPlayList::notifyCurrentTrackChanged()
     if (currentTrackIsValid) {
         d->mCurrentPlayListPosition = d->mCurrentTrack.row();
     }
+
+    notifyNextTrackChanged();
+}
+
+void MediaPlayList::notifyNextTrackChanged()
+{
+    auto newNextTrack = nextTrack();
+
+    if (newNextTrack != d->mNextTrack) {
+        d->mNextTrack = newNextTrack;
+        Q_EMIT nextTrackChanged(d->mNextTrack);
+    }
+}
+
+void MediaPlayList::nextTrackDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+    if (!d->mCurrentTrack.isValid() || d->mRandomPlay) {
+        return;
+    }
+
+    // only the row after the current one can become the next track, or the first valid rows when repeating from the last one
+    const auto candidateRow = d->mCurrentTrack.row() + 1;
+    const auto firstCandidateRow = (candidateRow < rowCount() ? candidateRow : 0);
+    const auto lastCandidateRow = (candidateRow < rowCount() ? candidateRow : d->mCurrentTrack.row());
+
+    if (bottomRight.row() < firstCandidateRow || topLeft.row() > lastCandidateRow) {
+        return;
+    }
+
+    notifyNextTrackChanged();
 }
 
 void MediaPlayList::restorePlayListPosition()
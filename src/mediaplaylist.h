@@ -58,6 +58,10 @@ class ELISALIB_EXPORT MediaPlayList : public QAbstractListModel
                READ currentTrack
                NOTIFY currentTrackChanged)
 
+    Q_PROPERTY(QPersistentModelIndex nextTrack
+               READ nextTrack
+               NOTIFY nextTrackChanged)
+
     Q_PROPERTY(int currentTrackRow
                READ currentTrackRow
                NOTIFY currentTrackRowChanged)
@@ -112,6 +116,10 @@ public:
         LastPlayDate,
         PlayCounter,
         PlayFrequency,
+        TrackGainRole,
+        TrackPeakRole,
+        AlbumGainRole,
+        AlbumPeakRole,
         ElementTypeRole,
         IsValidRole,
         TrackDataRole,
@@ -166,6 +174,8 @@ public:
 
     int currentTrackRow() const;
 
+    QPersistentModelIndex nextTrack() const;
+
     bool randomPlay() const;
 
     bool repeatPlay() const;
@@ -188,6 +198,8 @@ Q_SIGNALS:
 
     void currentTrackRowChanged();
 
+    void nextTrackChanged(QPersistentModelIndex nextTrack);
+
     void randomPlayChanged();
 
     void repeatPlayChanged();
@@ -270,6 +282,10 @@ private:
 
     void notifyCurrentTrackChanged();
 
+    void notifyNextTrackChanged();
+
+    void nextTrackDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+
     void restorePlayListPosition();
 
     void restoreRandomPlay();
@@ -31,6 +31,8 @@ public:
 
     FileScanner mFileScanner;
 
+    static const int mDataBlockChunkSize = 200;
+
 };
 
 ModelDataLoader::ModelDataLoader(QObject *parent) : QObject(parent), d(std::make_unique<ModelDataLoaderPrivate>())
@@ -50,23 +52,27 @@ void ModelDataLoader::loadData(ElisaUtils::PlayListEntryType dataType)
         return;
     }
 
+    auto stream = DataBlockStream{ModelDataLoaderPrivate::mDataBlockChunkSize, [this](const DataBlockPointer &dataBlock) {
+        Q_EMIT allDataBlock(dataBlock);
+    }};
+
     switch (dataType)
     {
     case ElisaUtils::Album:
-        Q_EMIT allAlbumsData(d->mDatabase->allAlbumsData());
+        d->mDatabase->allAlbumsDataBlock(stream);
         break;
     case ElisaUtils::Artist:
-        Q_EMIT allArtistsData(d->mDatabase->allArtistsData());
+        d->mDatabase->allArtistsDataBlock(stream);
         break;
     case ElisaUtils::Composer:
         break;
     case ElisaUtils::Genre:
-        Q_EMIT allGenresData(d->mDatabase->allGenresData());
+        d->mDatabase->allGenresDataBlock(stream);
         break;
     case ElisaUtils::Lyricist:
         break;
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->allTracksData());
+        d->mDatabase->allTracksDataBlock(stream);
         break;
     case ElisaUtils::FileName:
     case ElisaUtils::Unknown:
@@ -22,6 +22,7 @@
 
 #include "elisautils.h"
 #include "databaseinterface.h"
+#include "datablock.h"
 
 #include <QObject>
 
@@ -60,6 +61,8 @@ Q_SIGNALS:
 
     void allTrackData(const ModelDataLoader::TrackDataType &allData);
 
+    void allDataBlock(const DataBlockPointer &dataBlock);
+
 public Q_SLOTS:
 
     void loadData(ElisaUtils::PlayListEntryType dataType);
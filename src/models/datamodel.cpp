@@ -40,6 +40,10 @@ public:
 
     DataModel::ListGenreDataType mAllGenreData;
 
+    QVector<DataBlockPointer> mDataBlocks;
+
+    QVector<int> mDataBlocksEnd;
+
     ModelDataLoader mDataLoader;
 
     ElisaUtils::PlayListEntryType mModelType = ElisaUtils::Unknown;
@@ -71,6 +75,10 @@ int DataModel::rowCount(const QModelIndex &parent) const
 
     dataCount = d->mAllTrackData.size() + d->mAllAlbumData.size() + d->mAllArtistData.size() + d->mAllGenreData.size();
 
+    if (!d->mDataBlocksEnd.isEmpty()) {
+        dataCount += d->mDataBlocksEnd.last();
+    }
+
     return dataCount;
 }
 
@@ -113,7 +121,7 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
 {
     auto result = QVariant();
 
-    const auto dataCount = d->mAllTrackData.size() + d->mAllAlbumData.size() + d->mAllArtistData.size() + d->mAllGenreData.size();
+    const auto dataCount = rowCount();
 
     Q_ASSERT(index.isValid());
     Q_ASSERT(index.column() == 0);
@@ -122,6 +130,36 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
     Q_ASSERT(index.model() == this);
     Q_ASSERT(index.internalId() == 0);
 
+    if (!d->mDataBlocks.isEmpty()) {
+        const auto blockEnd = std::upper_bound(d->mDataBlocksEnd.cbegin(), d->mDataBlocksEnd.cend(), index.row());
+        const auto blockIndex = static_cast<int>(blockEnd - d->mDataBlocksEnd.cbegin());
+        const auto &dataBlock = d->mDataBlocks[blockIndex];
+        const auto blockRow = index.row() - (blockIndex > 0 ? d->mDataBlocksEnd[blockIndex - 1] : 0);
+
+        switch(role)
+        {
+        case Qt::DisplayRole:
+            result = dataBlock->value(blockRow, DatabaseInterface::ColumnsRoles::TitleRole);
+            break;
+        case DatabaseInterface::ColumnsRoles::DurationRole:
+        {
+            if (d->mModelType == ElisaUtils::Track) {
+                auto trackDuration = dataBlock->value(blockRow, role).toTime();
+                if (trackDuration.hour() == 0) {
+                    result = trackDuration.toString(QStringLiteral("mm:ss"));
+                } else {
+                    result = trackDuration.toString();
+                }
+            }
+            break;
+        }
+        default:
+            result = dataBlock->value(blockRow, role);
+        }
+
+        return result;
+    }
+
     switch(role)
     {
     case Qt::DisplayRole:
@@ -382,6 +420,39 @@ void DataModel::setBusy(bool value)
     Q_EMIT isBusyChanged();
 }
 
+void DataModel::detachDataBlock()
+{
+    if (d->mDataBlocks.isEmpty()) {
+        return;
+    }
+
+    for (const auto &dataBlock : qAsConst(d->mDataBlocks)) {
+        switch (dataBlock->elementType())
+        {
+        case ElisaUtils::Track:
+            d->mAllTrackData.append(dataBlock->toList<ListTrackDataType>());
+            break;
+        case ElisaUtils::Album:
+            d->mAllAlbumData.append(dataBlock->toList<ListAlbumDataType>());
+            break;
+        case ElisaUtils::Artist:
+            d->mAllArtistData.append(dataBlock->toList<ListArtistDataType>());
+            break;
+        case ElisaUtils::Genre:
+            d->mAllGenreData.append(dataBlock->toList<ListGenreDataType>());
+            break;
+        case ElisaUtils::Lyricist:
+        case ElisaUtils::Composer:
+        case ElisaUtils::FileName:
+        case ElisaUtils::Unknown:
+            break;
+        }
+    }
+
+    d->mDataBlocks.clear();
+    d->mDataBlocksEnd.clear();
+}
+
 int DataModel::trackIndexFromId(qulonglong id) const
 {
     int result;
@@ -426,6 +497,8 @@ void DataModel::connectModel(MusicListenersManager *manager)
             this, &DataModel::artistsAdded);
     connect(&d->mDataLoader, &ModelDataLoader::allGenresData,
             this, &DataModel::genresAdded);
+    connect(&d->mDataLoader, &ModelDataLoader::allDataBlock,
+            this, &DataModel::dataBlockAdded);
 }
 
 void DataModel::tracksAdded(ListTrackDataType newData)
@@ -438,6 +511,8 @@ void DataModel::tracksAdded(ListTrackDataType newData)
         return;
     }
 
+    detachDataBlock();
+
     if (!d->mAlbumTitle.isEmpty() && !d->mAlbumArtist.isEmpty()) {
         for (const auto &newTrack : newData) {
             if (newTrack.album() != d->mAlbumTitle) {
@@ -503,6 +578,8 @@ void DataModel::trackModified(const TrackDataType &modifiedTrack)
         return;
     }
 
+    detachDataBlock();
+
     if (!d->mAlbumTitle.isEmpty() && !d->mAlbumArtist.isEmpty()) {
         if (modifiedTrack.album() != d->mAlbumTitle) {
             return;
@@ -540,6 +617,8 @@ void DataModel::trackRemoved(qulonglong removedTrackId)
         return;
     }
 
+    detachDataBlock();
+
     if (!d->mAlbumTitle.isEmpty() && !d->mAlbumArtist.isEmpty()) {
         auto trackIndex = trackIndexFromId(removedTrackId);
 
@@ -576,6 +655,8 @@ void DataModel::genresAdded(DataModel::ListGenreDataType newData)
         return;
     }
 
+    detachDataBlock();
+
     if (d->mAllGenreData.isEmpty()) {
         beginInsertRows({}, d->mAllGenreData.size(), newData.size() - 1);
         d->mAllGenreData.swap(newData);
@@ -599,6 +680,8 @@ void DataModel::artistsAdded(DataModel::ListArtistDataType newData)
         return;
     }
 
+    detachDataBlock();
+
     if (d->mAllArtistData.isEmpty()) {
         beginInsertRows({}, d->mAllArtistData.size(), newData.size() - 1);
         d->mAllArtistData.swap(newData);
@@ -618,6 +701,8 @@ void DataModel::artistRemoved(qulonglong removedDatabaseId)
         return;
     }
 
+    detachDataBlock();
+
     auto removedDataIterator = d->mAllArtistData.end();
 
     removedDataIterator = std::find_if(d->mAllArtistData.begin(), d->mAllArtistData.end(),
@@ -646,6 +731,8 @@ void DataModel::albumsAdded(DataModel::ListAlbumDataType newData)
         return;
     }
 
+    detachDataBlock();
+
     if (d->mAllAlbumData.isEmpty()) {
         beginInsertRows({}, d->mAllAlbumData.size(), newData.size() - 1);
         d->mAllAlbumData.swap(newData);
@@ -665,6 +752,8 @@ void DataModel::albumRemoved(qulonglong removedDatabaseId)
         return;
     }
 
+    detachDataBlock();
+
     auto removedDataIterator = d->mAllAlbumData.end();
 
     removedDataIterator = std::find_if(d->mAllAlbumData.begin(), d->mAllAlbumData.end(),
@@ -689,6 +778,8 @@ void DataModel::albumModified(const DataModel::AlbumDataType &modifiedAlbum)
         return;
     }
 
+    detachDataBlock();
+
     auto modifiedAlbumIterator = std::find_if(d->mAllAlbumData.begin(), d->mAllAlbumData.end(),
                                               [modifiedAlbum](auto album) {
         return album.databaseId() == modifiedAlbum.databaseId();
@@ -703,4 +794,53 @@ void DataModel::albumModified(const DataModel::AlbumDataType &modifiedAlbum)
     Q_EMIT dataChanged(index(albumIndex, 0), index(albumIndex, 0));
 }
 
+void DataModel::dataBlockAdded(const DataBlockPointer &dataBlock)
+{
+    if (!dataBlock || dataBlock->elementType() != d->mModelType) {
+        return;
+    }
+
+    if (dataBlock->isEmpty()) {
+        setBusy(false);
+        return;
+    }
+
+    const auto isFilteredTracksModel = (d->mModelType == ElisaUtils::Track &&
+                                        !d->mAlbumTitle.isEmpty() && !d->mAlbumArtist.isEmpty());
+
+    if (!isFilteredTracksModel && (!d->mDataBlocks.isEmpty() || rowCount() == 0)) {
+        const auto firstRow = rowCount();
+
+        beginInsertRows({}, firstRow, firstRow + dataBlock->rowCount() - 1);
+        d->mDataBlocks.push_back(dataBlock);
+        d->mDataBlocksEnd.push_back(firstRow + dataBlock->rowCount());
+        endInsertRows();
+
+        setBusy(false);
+
+        return;
+    }
+
+    switch (d->mModelType)
+    {
+    case ElisaUtils::Track:
+        tracksAdded(dataBlock->toList<ListTrackDataType>());
+        break;
+    case ElisaUtils::Album:
+        albumsAdded(dataBlock->toList<ListAlbumDataType>());
+        break;
+    case ElisaUtils::Artist:
+        artistsAdded(dataBlock->toList<ListArtistDataType>());
+        break;
+    case ElisaUtils::Genre:
+        genresAdded(dataBlock->toList<ListGenreDataType>());
+        break;
+    case ElisaUtils::Lyricist:
+    case ElisaUtils::Composer:
+    case ElisaUtils::FileName:
+    case ElisaUtils::Unknown:
+        break;
+    }
+}
+
 #include "moc_datamodel.cpp"
@@ -22,6 +22,7 @@
 
 #include "elisautils.h"
 #include "databaseinterface.h"
+#include "datablock.h"
 
 #include <QAbstractListModel>
 #include <QVector>
@@ -128,6 +129,8 @@ public Q_SLOTS:
 
     void albumModified(const DataModel::AlbumDataType &modifiedAlbum);
 
+    void dataBlockAdded(const DataBlockPointer &dataBlock);
+
     void initialize(MusicListenersManager *manager, ElisaUtils::PlayListEntryType modelType);
 
     void initializeByAlbumTitleAndArtist(MusicListenersManager *manager, ElisaUtils::PlayListEntryType modelType,
@@ -154,6 +157,8 @@ private:
 
     void setBusy(bool value);
 
+    void detachDataBlock();
+
     std::unique_ptr<DataModelPrivate> d;
 
 };
@@ -122,6 +122,10 @@ QVariant TrackMetadataModel::data(const QModelIndex &index, int role) const
         case DatabaseInterface::FileModificationTime:
         case DatabaseInterface::FirstPlayDate:
         case DatabaseInterface::PlayFrequency:
+        case DatabaseInterface::TrackGainRole:
+        case DatabaseInterface::TrackPeakRole:
+        case DatabaseInterface::AlbumGainRole:
+        case DatabaseInterface::AlbumPeakRole:
         case DatabaseInterface::ElementTypeRole:
             break;
         }
@@ -194,6 +198,10 @@ QVariant TrackMetadataModel::data(const QModelIndex &index, int role) const
         case DatabaseInterface::FileModificationTime:
         case DatabaseInterface::FirstPlayDate:
         case DatabaseInterface::PlayFrequency:
+        case DatabaseInterface::TrackGainRole:
+        case DatabaseInterface::TrackPeakRole:
+        case DatabaseInterface::AlbumGainRole:
+        case DatabaseInterface::AlbumPeakRole:
         case DatabaseInterface::ElementTypeRole:
             break;
         }
@@ -298,7 +298,7 @@ QUrl MusicAudioTrack::albumCover() const
     if (d->mAlbumCover.isValid() || !hasEmbeddedCover()) {
         return d->mAlbumCover;
     } else {
-        return QUrl(QStringLiteral("image://cover/") + d->mResourceURI.toLocalFile());
+        return QUrl(QStringLiteral("image://cover/") + d->mResourceURI.toString(QUrl::FullyEncoded));
     }
 }
 
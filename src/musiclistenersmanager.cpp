@@ -32,15 +32,20 @@
 #endif
 
 #include "databaseinterface.h"
+#include "databasestatistics.h"
 #include "mediaplaylist.h"
 #include "file/filelistener.h"
 #include "file/localfilelisting.h"
+#include "abstractfile/scanscheduler.h"
 #include "trackslistener.h"
+#include "loudnessscanner.h"
 #include "notificationitem.h"
 #include "elisaapplication.h"
 #include "elisa_settings.h"
 #include "modeldataloader.h"
 
+#include "databaseLogging.h"
+
 #include <KI18n/KLocalizedString>
 
 #include <QThread>
@@ -52,10 +57,17 @@
 #include <QScopedPointer>
 #include <QPointer>
 #include <QFileSystemWatcher>
+#include <QTimer>
+#include <QJsonDocument>
+
+#if defined Qt5DBus_FOUND && Qt5DBus_FOUND
+#include <QDBusConnection>
+#endif
 
 #include <QAction>
 
 #include <list>
+#include <chrono>
 
 class MusicListenersManagerPrivate
 {
@@ -73,6 +85,8 @@ public:
     std::unique_ptr<BalooListener> mBalooListener;
 #endif
 
+    ScanScheduler mScanScheduler;
+
     std::list<std::unique_ptr<FileListener>> mFileListener;
 
 #if defined Qt5AndroidExtras_FOUND && Qt5AndroidExtras_FOUND
@@ -81,8 +95,14 @@ public:
 
     DatabaseInterface mDatabaseInterface;
 
+    DatabaseStatistics mDatabaseStatistics;
+
+    QTimer mDatabaseQueueProbe;
+
     std::unique_ptr<TracksListener> mTracksListener;
 
+    std::unique_ptr<LoudnessScanner> mLoudnessScanner;
+
     QFileSystemWatcher mConfigFileWatcher;
 
     ElisaApplication *mElisaApplication = nullptr;
@@ -116,6 +136,20 @@ MusicListenersManager::MusicListenersManager(QObject *parent)
         databaseFileName = localDataPaths.first() + QStringLiteral("/elisaDatabase.db");
     }
 
+    if (orgKdeElisaDatabase().isDebugEnabled()) {
+        d->mDatabaseInterface.setStatistics(&d->mDatabaseStatistics);
+
+        d->mDatabaseQueueProbe.setInterval(1000);
+        connect(&d->mDatabaseQueueProbe, &QTimer::timeout,
+                this, &MusicListenersManager::probeDatabaseQueue);
+        d->mDatabaseQueueProbe.start();
+
+#if defined Qt5DBus_FOUND && Qt5DBus_FOUND
+        QDBusConnection::sessionBus().registerObject(QStringLiteral("/org/kde/elisa/DatabaseStatistics"), this,
+                                                     QDBusConnection::ExportScriptableSlots);
+#endif
+    }
+
     QMetaObject::invokeMethod(&d->mDatabaseInterface, "init", Qt::QueuedConnection,
                               Q_ARG(QString, QStringLiteral("listeners")), Q_ARG(QString, databaseFileName));
 
@@ -195,6 +229,11 @@ void MusicListenersManager::applicationAboutToQuit()
 {
     d->mDatabaseInterface.applicationAboutToQuit();
 
+    if (d->mDatabaseQueueProbe.isActive()) {
+        d->mDatabaseQueueProbe.stop();
+        qCDebug(orgKdeElisaDatabase).noquote() << databaseStatistics();
+    }
+
     Q_EMIT applicationIsTerminating();
 
     d->mDatabaseThread.exit();
@@ -242,6 +281,20 @@ void MusicListenersManager::connectModel(ModelDataLoader *dataLoader)
     dataLoader->setDatabase(&d->mDatabaseInterface);
 }
 
+void MusicListenersManager::playerBufferingChanged(bool isBuffering)
+{
+    if (isBuffering && !Elisa::ElisaConfiguration::self()->pauseWhileBuffering()) {
+        return;
+    }
+
+    d->mScanScheduler.setPaused(isBuffering);
+}
+
+QString MusicListenersManager::databaseStatistics() const
+{
+    return QString::fromUtf8(QJsonDocument(d->mDatabaseStatistics.toJson()).toJson());
+}
+
 void MusicListenersManager::configChanged()
 {
     auto currentConfiguration = Elisa::ElisaConfiguration::self();
@@ -250,9 +303,24 @@ void MusicListenersManager::configChanged()
 
     currentConfiguration->load();
 
+    d->mScanScheduler.setBackgroundPriority(currentConfiguration->backgroundPriority());
+    d->mScanScheduler.setFilesPerSecondBudget(currentConfiguration->filesPerSecond());
+    d->mScanScheduler.setCpuPercentBudget(currentConfiguration->cpuPercent());
+    d->mScanScheduler.setFastTagReader(currentConfiguration->fastTagReader());
+    d->mDatabaseStatistics.setSlowQueryThreshold(currentConfiguration->slowQueryMilliSeconds());
+
+    if (d->mElisaApplication) {
+        d->mElisaApplication->configChanged();
+    }
+
+    if (!currentConfiguration->pauseWhileBuffering()) {
+        d->mScanScheduler.setPaused(false);
+    }
+
 #if defined KF5Baloo_FOUND && KF5Baloo_FOUND
     if (currentConfiguration->balooIndexer() && !d->mBalooListener) {
         d->mBalooListener = std::make_unique<BalooListener>();
+        d->mBalooListener->setScanScheduler(&d->mScanScheduler);
         d->mBalooListener->moveToThread(&d->mListenerThread);
         d->mBalooListener->setDatabaseInterface(&d->mDatabaseInterface);
         connect(this, &MusicListenersManager::applicationIsTerminating,
@@ -320,6 +388,7 @@ void MusicListenersManager::configChanged()
             if (itPath == d->mFileListener.end()) {
                 auto newFileIndexer = std::make_unique<FileListener>();
 
+                newFileIndexer->setScanScheduler(&d->mScanScheduler);
                 newFileIndexer->setDatabaseInterface(&d->mDatabaseInterface);
                 newFileIndexer->moveToThread(&d->mListenerThread);
                 connect(this, &MusicListenersManager::applicationIsTerminating,
@@ -339,6 +408,25 @@ void MusicListenersManager::configChanged()
             }
         }
     }
+
+    if (currentConfiguration->analyzeLoudness() && !d->mLoudnessScanner) {
+        d->mLoudnessScanner = std::make_unique<LoudnessScanner>();
+        d->mLoudnessScanner->setScanScheduler(&d->mScanScheduler);
+        connect(this, &MusicListenersManager::applicationIsTerminating,
+                d->mLoudnessScanner.get(), &LoudnessScanner::applicationAboutToQuit, Qt::DirectConnection);
+        connect(&d->mDatabaseInterface, &DatabaseInterface::tracksAdded,
+                d->mLoudnessScanner.get(), &LoudnessScanner::analyzeTracks);
+        connect(&d->mDatabaseInterface, &DatabaseInterface::trackModified,
+                d->mLoudnessScanner.get(), &LoudnessScanner::analyzeModifiedTrack);
+        connect(&d->mDatabaseInterface, &DatabaseInterface::tracksWithoutLoudness,
+                d->mLoudnessScanner.get(), &LoudnessScanner::analyzeTracks);
+        connect(d->mLoudnessScanner.get(), &LoudnessScanner::tracksLoudnessAnalyzed,
+                &d->mDatabaseInterface, &DatabaseInterface::updateTracksLoudness);
+
+        QMetaObject::invokeMethod(&d->mDatabaseInterface, "askTracksWithoutLoudness", Qt::QueuedConnection);
+    } else if (!currentConfiguration->analyzeLoudness() && d->mLoudnessScanner) {
+        d->mLoudnessScanner.reset();
+    }
 }
 
 void MusicListenersManager::increaseImportedTracksCount(const DatabaseInterface::ListTrackDataType &allTracks)
@@ -402,6 +490,14 @@ void MusicListenersManager::monitorEndingListeners()
     }
 }
 
+void MusicListenersManager::probeDatabaseQueue()
+{
+    const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    QMetaObject::invokeMethod(&d->mDatabaseInterface, "measureQueueLatency", Qt::QueuedConnection,
+                              Q_ARG(qint64, now));
+}
+
 void MusicListenersManager::createTracksListener()
 {
     if (!d->mTracksListener) {
@@ -39,6 +39,8 @@ class ELISALIB_EXPORT MusicListenersManager : public QObject
 
     Q_OBJECT
 
+    Q_CLASSINFO("D-Bus Interface", "org.kde.elisa.DatabaseStatistics")
+
     Q_PROPERTY(DatabaseInterface* viewDatabase
                READ viewDatabase
                NOTIFY viewDatabaseChanged)
@@ -114,6 +116,10 @@ public Q_SLOTS:
 
     void connectModel(ModelDataLoader *dataLoader);
 
+    void playerBufferingChanged(bool isBuffering);
+
+    Q_SCRIPTABLE QString databaseStatistics() const;
+
 private Q_SLOTS:
 
     void configChanged();
@@ -126,6 +132,8 @@ private Q_SLOTS:
 
     void monitorEndingListeners();
 
+    void probeDatabaseQueue();
+
 private:
 
     std::unique_ptr<MusicListenersManagerPrivate> d;
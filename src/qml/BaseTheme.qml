@@ -24,6 +24,16 @@ Item {
         return Math.round(pixel * logicalDpi / 96);
     }
 
+    function coverImageSource(imageUrl) {
+        // local cover files go through the cover provider to use the thumbnail cache,
+        // the URL stays encoded and the provider decodes it with QUrl::toLocalFile()
+        var imageUrlText = imageUrl.toString()
+        if (imageUrlText.indexOf('file://') === 0) {
+            return 'image://cover/' + imageUrlText
+        }
+        return imageUrl
+    }
+
     property string defaultAlbumImage: 'image://icon/media-optical-audio'
     property string defaultArtistImage: 'image://icon/view-media-artist'
     property string defaultBackgroundImage: 'qrc:///background.png'
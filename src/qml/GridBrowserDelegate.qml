@@ -180,7 +180,7 @@ FocusScope {
                             fillMode: Image.PreserveAspectFit
                             smooth: true
 
-                            source: (gridEntry.imageUrl !== undefined ? gridEntry.imageUrl : "")
+                            source: (gridEntry.imageUrl !== undefined ? elisaTheme.coverImageSource(gridEntry.imageUrl) : "")
 
                             asynchronous: true
 
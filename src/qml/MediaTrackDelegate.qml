@@ -184,7 +184,7 @@ FocusScope {
                         fillMode: Image.PreserveAspectFit
                         smooth: true
 
-                        source: (imageUrl != '' ? imageUrl : Qt.resolvedUrl(elisaTheme.defaultAlbumImage))
+                        source: (imageUrl != '' ? elisaTheme.coverImageSource(imageUrl) : Qt.resolvedUrl(elisaTheme.defaultAlbumImage))
 
                         asynchronous: true
 
@@ -157,7 +157,7 @@ FocusScope {
                         Image {
                             id: mainIcon
 
-                            source: (isValid ? (imageUrl != '' ? imageUrl : Qt.resolvedUrl(elisaTheme.defaultAlbumImage)) : Qt.resolvedUrl(elisaTheme.errorIcon))
+                            source: (isValid ? (imageUrl != '' ? elisaTheme.coverImageSource(imageUrl) : Qt.resolvedUrl(elisaTheme.defaultAlbumImage)) : Qt.resolvedUrl(elisaTheme.errorIcon))
 
                             Layout.minimumWidth: headerRow.height
                             Layout.maximumWidth: headerRow.height
@@ -0,0 +1,157 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TAGPARSING_H
+#define TAGPARSING_H
+
+#include <QtGlobal>
+#include <QtEndian>
+
+#include <cstring>
+
+/* the parsing primitives shared by the built-in tag reader and the embedded cover probe */
+namespace TagParsing {
+
+/* ID3v2, FLAC and Vorbis comment picture types, only the front cover is used as the track cover */
+const quint32 frontCoverPictureType = 3;
+
+/* the fixed part of an Ogg page header, the segment table follows it */
+const qint64 oggPageFixedHeaderSize = 27;
+
+inline quint16 bigEndian16(const uchar *data)
+{
+    return qFromBigEndian<quint16>(data);
+}
+
+inline quint32 bigEndian24(const uchar *data)
+{
+    return (static_cast<quint32>(data[0]) << 16) | (static_cast<quint32>(data[1]) << 8) | static_cast<quint32>(data[2]);
+}
+
+inline quint32 bigEndian32(const uchar *data)
+{
+    return qFromBigEndian<quint32>(data);
+}
+
+inline quint32 littleEndian32(const uchar *data)
+{
+    return qFromLittleEndian<quint32>(data);
+}
+
+inline quint32 syncSafe32(const uchar *data)
+{
+    return ((static_cast<quint32>(data[0]) & 0x7f) << 21) | ((static_cast<quint32>(data[1]) & 0x7f) << 14) |
+            ((static_cast<quint32>(data[2]) & 0x7f) << 7) | (static_cast<quint32>(data[3]) & 0x7f);
+}
+
+class Mp4Atom
+{
+public:
+
+    const uchar *mType = nullptr;
+
+    qint64 mBodyBegin = 0;
+
+    qint64 mEnd = 0;
+
+};
+
+/* positions are relative to data, the atom must end before end */
+inline bool readMp4Atom(const uchar *data, qint64 position, qint64 end, Mp4Atom &atom)
+{
+    if (end - position < 8) {
+        return false;
+    }
+
+    auto atomSize = static_cast<qint64>(bigEndian32(data + position));
+    auto headerSize = qint64(8);
+
+    if (atomSize == 1) {
+        if (end - position < 16) {
+            return false;
+        }
+
+        atomSize = static_cast<qint64>(qFromBigEndian<quint64>(data + position + 8));
+        headerSize = 16;
+    }
+
+    // a null size extends the atom to the end of the file, it is only written by streaming muxers and left to the extractors;
+    // a 64 bits size with its top bit set reads as negative
+    if (atomSize < headerSize || atomSize > end - position) {
+        return false;
+    }
+
+    atom.mType = data + position + 4;
+    atom.mBodyBegin = position + headerSize;
+    atom.mEnd = position + atomSize;
+
+    return true;
+}
+
+inline bool findMp4Atom(const uchar *data, qint64 begin, qint64 end, const char *atomType, Mp4Atom &atom)
+{
+    for (auto position = begin; readMp4Atom(data, position, end, atom); position = atom.mEnd) {
+        if (std::memcmp(atom.mType, atomType, 4) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+class OggPageHeader
+{
+public:
+
+    quint32 mSerialNumber = 0;
+
+    qint64 mGranulePosition = 0;
+
+    qint64 mHeaderSize = 0;
+
+    qint64 mBodySize = 0;
+
+};
+
+/* size bytes are available from data, the whole segment table must be among them */
+inline bool readOggPageHeader(const uchar *data, qint64 size, OggPageHeader &page)
+{
+    if (size < oggPageFixedHeaderSize || std::memcmp(data, "OggS", 4) != 0) {
+        return false;
+    }
+
+    const auto segmentsCount = static_cast<qint64>(data[26]);
+
+    if (size < oggPageFixedHeaderSize + segmentsCount) {
+        return false;
+    }
+
+    page.mSerialNumber = littleEndian32(data + 14);
+    page.mGranulePosition = qFromLittleEndian<qint64>(data + 6);
+    page.mHeaderSize = oggPageFixedHeaderSize + segmentsCount;
+    page.mBodySize = 0;
+
+    for (qint64 segmentIndex = 0; segmentIndex < segmentsCount; ++segmentIndex) {
+        page.mBodySize += data[oggPageFixedHeaderSize + segmentIndex];
+    }
+
+    return true;
+}
+
+}
+
+#endif // TAGPARSING_H
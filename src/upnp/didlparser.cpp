@@ -18,6 +18,8 @@
  */
 
 #include "didlparser.h"
+#include "didlstreamdecoder.h"
+#include "upnppagingscheduler.h"
 
 #include "upnpcontrolcontentdirectory.h"
 #include "upnpcontrolabstractservicereply.h"
@@ -26,9 +28,7 @@
 
 #include <QVector>
 #include <QString>
-
-#include <QDomDocument>
-#include <QDomNode>
+#include <QElapsedTimer>
 
 class DidlParserPrivate
 {
@@ -52,15 +52,21 @@ public:
 
     QHash<QString, MusicAlbum> mNewAlbums;
 
-    QVector<QString> mNewMusicTrackIds;
-
-    QHash<QString, MusicAudioTrack> mNewMusicTracks;
+    DidlStreamDecoder mDidlDecoder;
 
     QHash<QString, QVector<MusicAudioTrack>> mNewTracksByAlbums;
 
     QList<MusicAudioTrack> mNewTracksList;
 
-    QHash<QString, QUrl> mCovers;
+    UpnpPagingScheduler mPagingScheduler;
+
+    bool mIsSearch = false;
+
+    int mPagingGeneration = 0;
+
+    QList<MusicAudioTrack> mTracksBatch;
+
+    int mTracksBatchSize = 500;
 
 };
 
@@ -153,36 +159,81 @@ void DidlParser::systemUpdateIDChanged()
 
 void DidlParser::browse(int startIndex, int maximumNmberOfResults)
 {
-    auto upnpAnswer = d->mContentDirectory->browse(d->mParentId, d->mBrowseFlag, d->mFilter, startIndex, maximumNmberOfResults, d->mSortCriteria);
+    d->mIsSearch = false;
+    startPaging(startIndex, maximumNmberOfResults);
+}
+
+void DidlParser::search(int startIndex, int maximumNumberOfResults)
+{
+    d->mIsSearch = true;
+    startPaging(startIndex, maximumNumberOfResults);
+}
+
+void DidlParser::startPaging(int startIndex, int maximumNumberOfResults)
+{
+    // answers still in flight for a previous browse or search are dropped
+    ++d->mPagingGeneration;
 
     if (startIndex == 0) {
         d->mNewAlbumIds.clear();
         d->mNewAlbums.clear();
-        d->mNewMusicTracks.clear();
-        d->mNewMusicTrackIds.clear();
-        d->mCovers.clear();
+        d->mDidlDecoder.clear();
+        d->mNewTracksList.clear();
     }
 
-    connect(upnpAnswer, &UpnpControlAbstractServiceReply::finished, this, &DidlParser::browseFinished);
+    d->mTracksBatch.clear();
+
+    if (maximumNumberOfResults > 0) {
+        d->mPagingScheduler.setInitialPageSize(maximumNumberOfResults);
+    }
+
+    d->mPagingScheduler.reset(startIndex);
+
+    requestPages();
 }
 
-void DidlParser::search(int startIndex, int maximumNumberOfResults)
+void DidlParser::requestPages()
+{
+    const auto &newRequests = d->mPagingScheduler.nextRequests();
+
+    for (const auto &oneRequest : newRequests) {
+        sendPageRequest(oneRequest, d->mPagingGeneration);
+    }
+}
+
+void DidlParser::sendPageRequest(const UpnpPageRequest &request, int pagingGeneration)
 {
     if (!d->mContentDirectory) {
         return;
     }
 
-    if (startIndex == 0) {
-        d->mNewAlbumIds.clear();
-        d->mNewAlbums.clear();
-        d->mNewMusicTracks.clear();
-        d->mNewMusicTrackIds.clear();
-        d->mCovers.clear();
+    UpnpControlAbstractServiceReply *upnpAnswer = nullptr;
+
+    if (d->mIsSearch) {
+        upnpAnswer = d->mContentDirectory->search(d->mParentId, d->mSearchCriteria, d->mFilter, request.mStartIndex, request.mRequestedCount, d->mSortCriteria);
+    } else {
+        upnpAnswer = d->mContentDirectory->browse(d->mParentId, d->mBrowseFlag, d->mFilter, request.mStartIndex, request.mRequestedCount, d->mSortCriteria);
     }
 
-    auto upnpAnswer = d->mContentDirectory->search(d->mParentId, d->mSearchCriteria, d->mFilter, startIndex, maximumNumberOfResults, d->mSortCriteria);
+    QElapsedTimer roundTripTimer;
+    roundTripTimer.start();
+
+    connect(upnpAnswer, &UpnpControlAbstractServiceReply::finished, this,
+            [this, request, pagingGeneration, roundTripTimer](UpnpControlAbstractServiceReply *self) {
+        const auto &resultData = self->result();
+
+        bool success = self->success();
 
-    connect(upnpAnswer, &UpnpControlAbstractServiceReply::finished, this, &DidlParser::searchFinished);
+        bool intConvert = false;
+        auto numberReturned = resultData[QStringLiteral("NumberReturned")].toInt(&intConvert);
+        success = success && intConvert;
+
+        auto totalMatches = resultData[QStringLiteral("TotalMatches")].toInt(&intConvert);
+        success = success && intConvert;
+
+        pageAnswered(request, pagingGeneration, success, numberReturned, totalMatches,
+                     resultData[QStringLiteral("Result")].toString(), roundTripTimer.elapsed());
+    });
 }
 
 QString DidlParser::parentId() const
@@ -202,7 +253,7 @@ const QHash<QString, MusicAlbum> &DidlParser::newAlbums() const
 
 const QVector<QString> &DidlParser::newMusicTrackIds() const
 {
-    return d->mNewMusicTrackIds;
+    return d->mDidlDecoder.newMusicTrackIds();
 }
 
 const QList<MusicAudioTrack> &DidlParser::newMusicTracks() const
@@ -212,270 +263,127 @@ const QList<MusicAudioTrack> &DidlParser::newMusicTracks() const
 
 const QHash<QString, QUrl> &DidlParser::covers() const
 {
-    return d->mCovers;
+    return d->mDidlDecoder.covers();
 }
 
-void DidlParser::browseFinished(UpnpControlAbstractServiceReply *self)
+void DidlParser::pageAnswered(const UpnpPageRequest &request, int pagingGeneration, bool success, int numberReturned,
+                              int totalMatches, const QString &didlResult, qint64 roundTripTime)
 {
-    const auto &resultData = self->result();
-
-    bool success = self->success();
-
-    if (!success) {
-        d->mIsDataValid = false;
-        Q_EMIT isDataValidChanged(d->mContentDirectory->description()->deviceDescription()->UDN().mid(5), d->mParentId);
-
+    if (pagingGeneration != d->mPagingGeneration) {
         return;
     }
 
-    QString result = resultData[QStringLiteral("Result")].toString();
-
-    bool intConvert;
-    auto numberReturned = resultData[QStringLiteral("NumberReturned")].toInt(&intConvert);
+    if (!success) {
+        d->mPagingScheduler.pageFailed(request);
 
-    if (!intConvert) {
-        d->mIsDataValid = false;
-        Q_EMIT isDataValidChanged(d->mContentDirectory->description()->deviceDescription()->UDN().mid(5), d->mParentId);
+        if (d->mPagingScheduler.hasFailed()) {
+            if (d->mPagingScheduler.isFinished()) {
+                pagingFailed();
+            }
+        } else {
+            requestPages();
+        }
 
         return;
     }
 
-    auto totalMatches = resultData[QStringLiteral("TotalMatches")].toInt(&intConvert);
-
-    if (!intConvert) {
-        d->mIsDataValid = false;
-        Q_EMIT isDataValidChanged(d->mContentDirectory->description()->deviceDescription()->UDN().mid(5), d->mParentId);
-
-        return;
-    }
+    d->mPagingScheduler.pageReceived(request, numberReturned, totalMatches, roundTripTime);
 
-    if (totalMatches > numberReturned) {
-        browse(d->mNewMusicTracks.size() + numberReturned);
-    }
+    // keep the server busy while this page is decoded
+    requestPages();
 
-    QDomDocument browseDescription;
-    browseDescription.setContent(result);
+    const auto firstNewTrack = d->mDidlDecoder.newMusicTrackIds().size();
 
-    browseDescription.documentElement();
+    decodeDidlResult(didlResult);
 
-    auto containerList = browseDescription.elementsByTagName(QStringLiteral("container"));
-    for (int containerIndex = 0; containerIndex < containerList.length(); ++containerIndex) {
-        const QDomNode &containerNode(containerList.at(containerIndex));
-        if (!containerNode.isNull()) {
-            decodeContainerNode(containerNode, d->mNewAlbums, d->mNewAlbumIds);
-        }
-    }
+    const auto &allTrackIds = d->mDidlDecoder.newMusicTrackIds();
+    const auto &allTracks = d->mDidlDecoder.newMusicTracks();
+    for (auto trackIndex = firstNewTrack; trackIndex < allTrackIds.size(); ++trackIndex) {
+        const auto &newTrack = allTracks[allTrackIds[trackIndex]];
 
-    auto itemList = browseDescription.elementsByTagName(QStringLiteral("item"));
-    for (int itemIndex = 0; itemIndex < itemList.length(); ++itemIndex) {
-        const QDomNode &itemNode(itemList.at(itemIndex));
-        if (!itemNode.isNull()) {
-            decodeAudioTrackNode(itemNode, d->mNewMusicTracks, d->mNewMusicTrackIds);
-        }
+        d->mTracksBatch.push_back(newTrack);
+        d->mNewTracksList.push_back(newTrack);
     }
 
-    groupNewTracksByAlbums();
-    d->mIsDataValid = true;
-    Q_EMIT isDataValidChanged(d->mContentDirectory->description()->deviceDescription()->UDN().mid(5), d->mParentId);
-}
-
-void DidlParser::groupNewTracksByAlbums()
-{
-    d->mNewTracksByAlbums.clear();
-    for(const auto &newTrack : qAsConst(d->mNewMusicTracks)) {
-        d->mNewTracksByAlbums[newTrack.albumName()].push_back(newTrack);
+    if (d->mTracksBatch.size() >= d->mTracksBatchSize) {
+        sendTracksBatch();
     }
-}
-
-void DidlParser::searchFinished(UpnpControlAbstractServiceReply *self)
-{
-    const auto &resultData = self->result();
-
-    bool success = self->success();
-
-    if (!success) {
-        d->mIsDataValid = false;
-        Q_EMIT isDataValidChanged(d->mContentDirectory->description()->deviceDescription()->UDN().mid(5), d->mParentId);
-
-        return;
-    }
-
-    QString result = resultData[QStringLiteral("Result")].toString();
-
-    bool intConvert;
-    auto numberReturned = resultData[QStringLiteral("NumberReturned")].toInt(&intConvert);
-
-    if (!intConvert) {
-        d->mIsDataValid = false;
-        Q_EMIT isDataValidChanged(d->mContentDirectory->description()->deviceDescription()->UDN().mid(5), d->mParentId);
 
+    if (!d->mPagingScheduler.isFinished()) {
         return;
     }
 
-    auto totalMatches = resultData[QStringLiteral("TotalMatches")].toInt(&intConvert);
-
-    if (!intConvert) {
-        d->mIsDataValid = false;
-        Q_EMIT isDataValidChanged(d->mContentDirectory->description()->deviceDescription()->UDN().mid(5), d->mParentId);
-
+    if (d->mPagingScheduler.hasFailed()) {
+        pagingFailed();
         return;
     }
 
-    if (totalMatches > numberReturned) {
-        search(d->mNewMusicTracks.size() + numberReturned, numberReturned);
-    }
-
-    QDomDocument browseDescription;
-    browseDescription.setContent(result);
-
-    browseDescription.documentElement();
-
-    auto containerList = browseDescription.elementsByTagName(QStringLiteral("container"));
-    for (int containerIndex = 0; containerIndex < containerList.length(); ++containerIndex) {
-        const QDomNode &containerNode(containerList.at(containerIndex));
-        if (!containerNode.isNull()) {
-            decodeContainerNode(containerNode, d->mNewAlbums, d->mNewAlbumIds);
-        }
-    }
-
-    auto itemList = browseDescription.elementsByTagName(QStringLiteral("item"));
-    for (int itemIndex = 0; itemIndex < itemList.length(); ++itemIndex) {
-        const QDomNode &itemNode(itemList.at(itemIndex));
-        if (!itemNode.isNull()) {
-            decodeAudioTrackNode(itemNode, d->mNewMusicTracks, d->mNewMusicTrackIds);
-        }
-    }
+    sendTracksBatch();
 
     groupNewTracksByAlbums();
     d->mIsDataValid = true;
-    Q_EMIT isDataValidChanged(d->mContentDirectory->description()->deviceDescription()->UDN().mid(5), d->mParentId);
+    Q_EMIT isDataValidChanged(serverUuid(), d->mParentId);
 }
 
-void DidlParser::decodeContainerNode(const QDomNode &containerNode, QHash<QString, MusicAlbum> &newData,
-                                     QVector<QString> &newDataIds)
+void DidlParser::pagingFailed()
 {
-    auto parentID = containerNode.toElement().attribute(QStringLiteral("parentID"));
-    const auto &id = containerNode.toElement().attribute(QStringLiteral("id"));
+    sendTracksBatch();
 
-    newDataIds.push_back(id);
-    auto &chilData = newData[id];
-
-    chilData.setParentId(parentID);
-    chilData.setId(id);
-
-    const QString &childCount = containerNode.toElement().attribute(QStringLiteral("childCount"));
-    chilData.setTracksCount(childCount.toInt());
-
-    const QDomNode &titleNode = containerNode.firstChildElement(QStringLiteral("dc:title"));
-    if (!titleNode.isNull()) {
-        chilData.setTitle(titleNode.toElement().text());
-    }
-
-    const QDomNode &authorNode = containerNode.firstChildElement(QStringLiteral("upnp:artist"));
-    if (!authorNode.isNull()) {
-        chilData.setArtist(authorNode.toElement().text());
-    }
+    d->mIsDataValid = false;
+    Q_EMIT isDataValidChanged(serverUuid(), d->mParentId);
+}
 
-    const QDomNode &resourceNode = containerNode.firstChildElement(QStringLiteral("res"));
-    if (!resourceNode.isNull()) {
-        chilData.setResourceURI(QUrl::fromUserInput(resourceNode.toElement().text()));
+void DidlParser::sendTracksBatch()
+{
+    if (d->mTracksBatch.isEmpty()) {
+        return;
     }
 
-#if 0
-    const QDomNode &classNode = containerNode.firstChildElement(QStringLiteral("upnp:class"));
-    if (classNode.toElement().text().startsWith(QStringLiteral("object.container.album.musicAlbum"))) {
-        chilData[ColumnsRoles::ItemClassRole] = DidlParser::Album;
-    } else if (classNode.toElement().text().startsWith(QStringLiteral("object.container.person.musicArtist"))) {
-        chilData[ColumnsRoles::ItemClassRole] = DidlParser::Artist;
-    } else if (classNode.toElement().text().startsWith(QStringLiteral("object.container"))) {
-        chilData[ColumnsRoles::ItemClassRole] = DidlParser::Container;
-    }
-#endif
+    Q_EMIT newMusicTracksBatch(serverUuid(), d->mTracksBatch, d->mDidlDecoder.covers());
 
-    const QDomNode &albumArtNode = containerNode.firstChildElement(QStringLiteral("upnp:albumArtURI"));
-    if (!albumArtNode.isNull()) {
-        chilData.setAlbumArtURI(QUrl::fromUserInput(albumArtNode.toElement().text()));
-    }
+    d->mTracksBatch.clear();
 }
 
-void DidlParser::decodeAudioTrackNode(const QDomNode &itemNode, QHash<QString, MusicAudioTrack> &newData,
-                                      QVector<QString> &newDataIds)
+QString DidlParser::serverUuid() const
 {
-    const QString &parentID = itemNode.toElement().attribute(QStringLiteral("parentID"));
-    const QString &id = itemNode.toElement().attribute(QStringLiteral("id"));
-
-    newDataIds.push_back(id);
-    auto &chilData = newData[id];
-
-    chilData.setParentId(parentID);
-    chilData.setId(id);
-
-    const QDomNode &titleNode = itemNode.firstChildElement(QStringLiteral("dc:title"));
-    if (!titleNode.isNull()) {
-        chilData.setTitle(titleNode.toElement().text());
-    }
-
-    const QDomNode &authorNode = itemNode.firstChildElement(QStringLiteral("dc:creator"));
-    if (!authorNode.isNull()) {
-        chilData.setArtist(authorNode.toElement().text());
-    }
-
-    const QDomNode &albumAuthorNode = itemNode.firstChildElement(QStringLiteral("upnp:artist"));
-    if (!albumAuthorNode.isNull()) {
-        chilData.setAlbumArtist(albumAuthorNode.toElement().text());
+    if (!d->mContentDirectory) {
+        return {};
     }
 
-    if (chilData.albumArtist().isEmpty()) {
-        chilData.setAlbumArtist(chilData.artist());
-    }
+    return d->mContentDirectory->description()->deviceDescription()->UDN().mid(5);
+}
 
-    if (chilData.artist().isEmpty()) {
-        chilData.setArtist(chilData.albumArtist());
+void DidlParser::groupNewTracksByAlbums()
+{
+    d->mNewTracksByAlbums.clear();
+    for(const auto &newTrack : d->mDidlDecoder.newMusicTracks()) {
+        d->mNewTracksByAlbums[newTrack.albumName()].push_back(newTrack);
     }
+}
 
-    const QDomNode &albumNode = itemNode.firstChildElement(QStringLiteral("upnp:album"));
-    if (!albumNode.isNull()) {
-        chilData.setAlbumName(albumNode.toElement().text());
-    }
+void DidlParser::decodeDidlResult(const QString &didlContent)
+{
+    const auto firstNewContainer = d->mDidlDecoder.newContainerIds().size();
 
-    const QDomNode &albumArtNode = itemNode.firstChildElement(QStringLiteral("upnp:albumArtURI"));
-    if (!albumArtNode.isNull()) {
-        d->mCovers[chilData.albumName()] = QUrl::fromUserInput(albumArtNode.toElement().text());
-    }
+    d->mDidlDecoder.decode(didlContent);
 
-    const QDomNode &resourceNode = itemNode.firstChildElement(QStringLiteral("res"));
-    if (!resourceNode.isNull()) {
-        chilData.setResourceURI(QUrl::fromUserInput(resourceNode.toElement().text()));
-        if (resourceNode.attributes().contains(QStringLiteral("duration"))) {
-            const QDomNode &durationNode = resourceNode.attributes().namedItem(QStringLiteral("duration"));
-            QString durationValue = durationNode.nodeValue();
-            if (durationValue.startsWith(QStringLiteral("0:"))) {
-                durationValue = durationValue.mid(2);
-            }
-            if (durationValue.contains(uint('.'))) {
-                durationValue = durationValue.split(QStringLiteral(".")).first();
-            }
+    const auto &allContainerIds = d->mDidlDecoder.newContainerIds();
+    const auto &allContainers = d->mDidlDecoder.newContainers();
 
-            chilData.setDuration(QTime::fromString(durationValue, QStringLiteral("mm:ss")));
-            if (!chilData.duration().isValid()) {
-                chilData.setDuration(QTime::fromString(durationValue, QStringLiteral("hh:mm:ss")));
-                if (!chilData.duration().isValid()) {
-                    chilData.setDuration(QTime::fromString(durationValue, QStringLiteral("hh:mm:ss.z")));
-                }
-            }
-        }
+    for (auto containerIndex = firstNewContainer; containerIndex < allContainerIds.size(); ++containerIndex) {
+        const auto &id = allContainerIds[containerIndex];
+        const auto &oneContainer = allContainers[id];
 
-        const QDomNode &trackNumberNode = itemNode.firstChildElement(QStringLiteral("upnp:originalTrackNumber"));
-        if (!trackNumberNode.isNull()) {
-            chilData.setTrackNumber(trackNumberNode.toElement().text().toInt());
-        }
+        d->mNewAlbumIds.push_back(id);
+        auto &chilData = d->mNewAlbums[id];
 
-#if 0
-        if (resourceNode.attributes().contains(QStringLiteral("artist"))) {
-            const QDomNode &artistNode = resourceNode.attributes().namedItem(QStringLiteral("artist"));
-            //chilData[ColumnsRoles::ArtistRole] = artistNode.nodeValue();
-        }
-#endif
+        chilData.setParentId(oneContainer.mParentId);
+        chilData.setId(id);
+        chilData.setTracksCount(oneContainer.mChildCount);
+        chilData.setTitle(oneContainer.mTitle);
+        chilData.setArtist(oneContainer.mArtist);
+        chilData.setResourceURI(oneContainer.mResourceURI);
+        chilData.setAlbumArtURI(oneContainer.mAlbumArtURI);
     }
 }
 
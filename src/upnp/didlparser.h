@@ -29,8 +29,8 @@
 #include <memory>
 
 class UpnpControlAbstractServiceReply;
-class QDomNode;
 class UpnpControlContentDirectory;
+class UpnpPageRequest;
 class DidlParserPrivate;
 
 class DidlParser : public QObject
@@ -118,6 +118,8 @@ Q_SIGNALS:
 
     void isDataValidChanged(const QString &uuid, const QString &parentId);
 
+    void newMusicTracksBatch(const QString &uuid, const QList<MusicAudioTrack> &tracks, const QHash<QString, QUrl> &covers);
+
     void parentIdChanged();
 
 public Q_SLOTS:
@@ -136,17 +138,27 @@ public Q_SLOTS:
 
     void systemUpdateIDChanged();
 
-private Q_SLOTS:
+protected:
 
-    void browseFinished(UpnpControlAbstractServiceReply *self);
+    /* sends one Browse or Search page to the content directory, the answer is given back to pageAnswered */
+    virtual void sendPageRequest(const UpnpPageRequest &request, int pagingGeneration);
 
-    void searchFinished(UpnpControlAbstractServiceReply *self);
+    void pageAnswered(const UpnpPageRequest &request, int pagingGeneration, bool success, int numberReturned,
+                      int totalMatches, const QString &didlResult, qint64 roundTripTime);
 
 private:
 
-    void decodeContainerNode(const QDomNode &containerNode, QHash<QString, MusicAudioTrack> &newData, QVector<QString> &newDataIds);
+    void startPaging(int startIndex, int maximumNumberOfResults);
+
+    void requestPages();
+
+    void pagingFailed();
+
+    QString serverUuid() const;
+
+    void sendTracksBatch();
 
-    void decodeAudioTrackNode(const QDomNode &itemNode, QHash<QString, MusicAudioTrack> &newData, QVector<QString> &newDataIds);
+    void decodeDidlResult(const QString &didlContent);
 
     void groupNewTracksByAlbums();
 
@@ -0,0 +1,249 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "didlstreamdecoder.h"
+
+#include <QXmlStreamReader>
+#include <QXmlStreamAttributes>
+#include <QStringList>
+#include <QDebug>
+
+class DidlStreamDecoderPrivate
+{
+public:
+
+    QVector<QString> mNewContainerIds;
+
+    QHash<QString, DidlContainerData> mNewContainers;
+
+    QVector<QString> mNewMusicTrackIds;
+
+    QHash<QString, MusicAudioTrack> mNewMusicTracks;
+
+    QHash<QString, QUrl> mCovers;
+
+};
+
+DidlStreamDecoder::DidlStreamDecoder() : d(std::make_unique<DidlStreamDecoderPrivate>())
+{
+}
+
+DidlStreamDecoder::~DidlStreamDecoder()
+= default;
+
+bool DidlStreamDecoder::decode(const QString &didlContent)
+{
+    QXmlStreamReader reader(didlContent);
+
+    /* DIDL-Lite answers from some servers use prefixes without declaring them */
+    reader.setNamespaceProcessing(false);
+
+    while (!reader.atEnd()) {
+        if (reader.readNext() != QXmlStreamReader::StartElement) {
+            continue;
+        }
+
+        const auto elementName = reader.qualifiedName();
+
+        if (elementName == QLatin1String("container")) {
+            decodeContainer(reader);
+        } else if (elementName == QLatin1String("item")) {
+            decodeItem(reader);
+        }
+    }
+
+    if (reader.hasError()) {
+        qDebug() << "DidlStreamDecoder::decode" << reader.lineNumber() << reader.columnNumber() << reader.errorString();
+
+        return false;
+    }
+
+    return true;
+}
+
+void DidlStreamDecoder::clear()
+{
+    d->mNewContainerIds.clear();
+    d->mNewContainers.clear();
+    d->mNewMusicTrackIds.clear();
+    d->mNewMusicTracks.clear();
+    d->mCovers.clear();
+}
+
+const QVector<QString> &DidlStreamDecoder::newContainerIds() const
+{
+    return d->mNewContainerIds;
+}
+
+const QHash<QString, DidlContainerData> &DidlStreamDecoder::newContainers() const
+{
+    return d->mNewContainers;
+}
+
+const QVector<QString> &DidlStreamDecoder::newMusicTrackIds() const
+{
+    return d->mNewMusicTrackIds;
+}
+
+const QHash<QString, MusicAudioTrack> &DidlStreamDecoder::newMusicTracks() const
+{
+    return d->mNewMusicTracks;
+}
+
+const QHash<QString, QUrl> &DidlStreamDecoder::covers() const
+{
+    return d->mCovers;
+}
+
+QTime DidlStreamDecoder::decodeDuration(QString durationValue)
+{
+    if (durationValue.startsWith(QStringLiteral("0:"))) {
+        durationValue = durationValue.mid(2);
+    }
+    if (durationValue.contains(uint('.'))) {
+        durationValue = durationValue.split(QStringLiteral(".")).first();
+    }
+
+    auto result = QTime::fromString(durationValue, QStringLiteral("mm:ss"));
+    if (!result.isValid()) {
+        result = QTime::fromString(durationValue, QStringLiteral("hh:mm:ss"));
+        if (!result.isValid()) {
+            result = QTime::fromString(durationValue, QStringLiteral("hh:mm:ss.z"));
+        }
+    }
+
+    return result;
+}
+
+void DidlStreamDecoder::decodeContainer(QXmlStreamReader &reader)
+{
+    const auto &attributes = reader.attributes();
+    const auto id = attributes.value(QLatin1String("id")).toString();
+
+    d->mNewContainerIds.push_back(id);
+    auto &chilData = d->mNewContainers[id];
+
+    chilData.mId = id;
+    chilData.mParentId = attributes.value(QLatin1String("parentID")).toString();
+    chilData.mChildCount = attributes.value(QLatin1String("childCount")).toInt();
+
+    auto hasTitle = false;
+    auto hasArtist = false;
+    auto hasResource = false;
+    auto hasAlbumArt = false;
+
+    while (reader.readNextStartElement()) {
+        const auto elementName = reader.qualifiedName();
+
+        if (!hasTitle && elementName == QLatin1String("dc:title")) {
+            chilData.mTitle = reader.readElementText(QXmlStreamReader::SkipChildElements);
+            hasTitle = true;
+        } else if (!hasArtist && elementName == QLatin1String("upnp:artist")) {
+            chilData.mArtist = reader.readElementText(QXmlStreamReader::SkipChildElements);
+            hasArtist = true;
+        } else if (!hasResource && elementName == QLatin1String("res")) {
+            chilData.mResourceURI = QUrl::fromUserInput(reader.readElementText(QXmlStreamReader::SkipChildElements));
+            hasResource = true;
+        } else if (!hasAlbumArt && elementName == QLatin1String("upnp:albumArtURI")) {
+            chilData.mAlbumArtURI = QUrl::fromUserInput(reader.readElementText(QXmlStreamReader::SkipChildElements));
+            hasAlbumArt = true;
+        } else {
+            reader.skipCurrentElement();
+        }
+    }
+}
+
+void DidlStreamDecoder::decodeItem(QXmlStreamReader &reader)
+{
+    const auto &attributes = reader.attributes();
+    const auto id = attributes.value(QLatin1String("id")).toString();
+
+    d->mNewMusicTrackIds.push_back(id);
+    auto &chilData = d->mNewMusicTracks[id];
+
+    chilData.setParentId(attributes.value(QLatin1String("parentID")).toString());
+    chilData.setId(id);
+
+    auto hasTitle = false;
+    auto hasArtist = false;
+    auto hasAlbumArtist = false;
+    auto hasAlbum = false;
+    auto hasAlbumArt = false;
+    auto hasResource = false;
+    auto hasTrackNumber = false;
+    auto albumArt = QString{};
+    auto duration = QString{};
+    auto hasDuration = false;
+    auto trackNumber = 0;
+
+    while (reader.readNextStartElement()) {
+        const auto elementName = reader.qualifiedName();
+
+        if (!hasTitle && elementName == QLatin1String("dc:title")) {
+            chilData.setTitle(reader.readElementText(QXmlStreamReader::SkipChildElements));
+            hasTitle = true;
+        } else if (!hasArtist && elementName == QLatin1String("dc:creator")) {
+            chilData.setArtist(reader.readElementText(QXmlStreamReader::SkipChildElements));
+            hasArtist = true;
+        } else if (!hasAlbumArtist && elementName == QLatin1String("upnp:artist")) {
+            chilData.setAlbumArtist(reader.readElementText(QXmlStreamReader::SkipChildElements));
+            hasAlbumArtist = true;
+        } else if (!hasAlbum && elementName == QLatin1String("upnp:album")) {
+            chilData.setAlbumName(reader.readElementText(QXmlStreamReader::SkipChildElements));
+            hasAlbum = true;
+        } else if (!hasAlbumArt && elementName == QLatin1String("upnp:albumArtURI")) {
+            albumArt = reader.readElementText(QXmlStreamReader::SkipChildElements);
+            hasAlbumArt = true;
+        } else if (!hasResource && elementName == QLatin1String("res")) {
+            const auto &resourceAttributes = reader.attributes();
+            hasDuration = resourceAttributes.hasAttribute(QLatin1String("duration"));
+            if (hasDuration) {
+                duration = resourceAttributes.value(QLatin1String("duration")).toString();
+            }
+
+            chilData.setResourceURI(QUrl::fromUserInput(reader.readElementText(QXmlStreamReader::SkipChildElements)));
+            hasResource = true;
+        } else if (!hasTrackNumber && elementName == QLatin1String("upnp:originalTrackNumber")) {
+            trackNumber = reader.readElementText(QXmlStreamReader::SkipChildElements).toInt();
+            hasTrackNumber = true;
+        } else {
+            reader.skipCurrentElement();
+        }
+    }
+
+    if (chilData.albumArtist().isEmpty()) {
+        chilData.setAlbumArtist(chilData.artist());
+    }
+
+    if (chilData.artist().isEmpty()) {
+        chilData.setArtist(chilData.albumArtist());
+    }
+
+    if (hasAlbumArt) {
+        d->mCovers[chilData.albumName()] = QUrl::fromUserInput(albumArt);
+    }
+
+    if (hasResource) {
+        if (hasDuration) {
+            chilData.setDuration(decodeDuration(duration));
+        }
+
+        if (hasTrackNumber) {
+            chilData.setTrackNumber(trackNumber);
+        }
+    }
+}
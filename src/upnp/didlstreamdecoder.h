@@ -0,0 +1,88 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DIDLSTREAMDECODER_H
+#define DIDLSTREAMDECODER_H
+
+#include "musicaudiotrack.h"
+
+#include <QString>
+#include <QUrl>
+#include <QHash>
+#include <QVector>
+
+#include <memory>
+
+class QXmlStreamReader;
+class DidlStreamDecoderPrivate;
+
+class DidlContainerData
+{
+public:
+
+    QString mId;
+
+    QString mParentId;
+
+    QString mTitle;
+
+    QString mArtist;
+
+    QUrl mResourceURI;
+
+    QUrl mAlbumArtURI;
+
+    int mChildCount = 0;
+
+};
+
+class DidlStreamDecoder
+{
+
+public:
+
+    DidlStreamDecoder();
+
+    ~DidlStreamDecoder();
+
+    bool decode(const QString &didlContent);
+
+    void clear();
+
+    const QVector<QString> &newContainerIds() const;
+
+    const QHash<QString, DidlContainerData> &newContainers() const;
+
+    const QVector<QString> &newMusicTrackIds() const;
+
+    const QHash<QString, MusicAudioTrack> &newMusicTracks() const;
+
+    const QHash<QString, QUrl> &covers() const;
+
+    static QTime decodeDuration(QString durationValue);
+
+private:
+
+    void decodeContainer(QXmlStreamReader &reader);
+
+    void decodeItem(QXmlStreamReader &reader);
+
+    std::unique_ptr<DidlStreamDecoderPrivate> d;
+
+};
+
+#endif // DIDLSTREAMDECODER_H
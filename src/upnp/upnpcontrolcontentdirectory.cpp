@@ -40,6 +40,8 @@ public:
 
     int mSystemUpdateID;
 
+    QString mContainerUpdateIDs;
+
 };
 
 UpnpControlContentDirectory::UpnpControlContentDirectory(QObject *parent) : UpnpControlAbstractService(parent), d(new UpnpControlContentDirectoryPrivate)
@@ -74,6 +76,11 @@ int UpnpControlContentDirectory::systemUpdateID() const
     return d->mSystemUpdateID;
 }
 
+const QString &UpnpControlContentDirectory::containerUpdateIDs() const
+{
+    return d->mContainerUpdateIDs;
+}
+
 UpnpControlAbstractServiceReply *UpnpControlContentDirectory::getSearchCapabilities()
 {
     auto pendingAnswer = callAction(QStringLiteral("GetSearchCapabilities"), {});
@@ -260,6 +267,10 @@ void UpnpControlContentDirectory::parseEventNotification(const QString &eventNam
         d->mSystemUpdateID = eventValue.toInt();
         Q_EMIT systemUpdateIDChanged(d->mSystemUpdateID);
     }
+    if (eventName == QStringLiteral("ContainerUpdateIDs")) {
+        d->mContainerUpdateIDs = eventValue;
+        Q_EMIT containerUpdateIDsChanged(d->mContainerUpdateIDs);
+    }
 }
 
 #include "moc_upnpcontrolcontentdirectory.cpp"
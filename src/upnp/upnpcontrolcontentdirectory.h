@@ -50,6 +50,10 @@ class UpnpControlContentDirectory : public UpnpControlAbstractService
                READ systemUpdateID
                NOTIFY systemUpdateIDChanged)
 
+    Q_PROPERTY(QString containerUpdateIDs
+               READ containerUpdateIDs
+               NOTIFY containerUpdateIDsChanged)
+
 public:
 
     explicit UpnpControlContentDirectory(QObject *parent = nullptr);
@@ -66,6 +70,8 @@ public:
 
     int systemUpdateID() const;
 
+    const QString& containerUpdateIDs() const;
+
 public Q_SLOTS:
 
     UpnpControlAbstractServiceReply* getSearchCapabilities();
@@ -94,6 +100,8 @@ Q_SIGNALS:
 
     void systemUpdateIDChanged(int id);
 
+    void containerUpdateIDsChanged(const QString &ids);
+
 private Q_SLOTS:
 
 protected:
@@ -28,7 +28,9 @@
 #include "upnpdiscoveryresult.h"
 #include "upnpdevicedescriptionparser.h"
 #include "upnpcontrolcontentdirectory.h"
+#include "upnpcontrolabstractservicereply.h"
 #include "didlparser.h"
+#include "upnpsyncstate.h"
 
 #include "databaseinterface.h"
 
@@ -36,6 +38,15 @@
 #include <QHash>
 #include <QString>
 #include <QSharedPointer>
+#include <QSet>
+#include <QStandardPaths>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTimer>
+#include <QDebug>
+
+#include <algorithm>
 
 class UpnpDiscoverAllMusicPrivate
 {
@@ -51,6 +62,20 @@ public:
 
     QHash<QString, QSharedPointer<DidlParser>> mDidlParsers;
 
+    QHash<QString, QSharedPointer<UpnpSyncState>> mSyncStates;
+
+    QHash<QString, QHash<QString, DidlParser*>> mContainerParsers;
+
+    QHash<QString, int> mResyncSystemUpdateIds;
+
+    QHash<QString, int> mPendingSystemUpdateIds;
+
+    QSet<QString> mFailedResyncs;
+
+    QSet<QString> mUncheckedSyncStates;
+
+    int mEventsCoalescingDelay = 1000;
+
     QList<QString> mAllHostsUUID;
 
     QNetworkAccessManager mNetworkAccess;
@@ -164,7 +189,18 @@ void UpnpDiscoverAllMusic::setAlbumDatabase(DatabaseInterface *albumDatabase)
     if (d->mAlbumDatabase == albumDatabase)
         return;
 
+    if (d->mAlbumDatabase) {
+        disconnect(d->mAlbumDatabase, nullptr, this, nullptr);
+        disconnect(this, nullptr, d->mAlbumDatabase, nullptr);
+    }
+
     d->mAlbumDatabase = albumDatabase;
+
+    if (d->mAlbumDatabase) {
+        connect(this, &UpnpDiscoverAllMusic::askRestoredTracks, d->mAlbumDatabase, &DatabaseInterface::askRestoredTracks);
+        connect(d->mAlbumDatabase, &DatabaseInterface::restoredTracks, this, &UpnpDiscoverAllMusic::restoredTracks);
+    }
+
     Q_EMIT albumDatabaseChanged();
 }
 
@@ -191,26 +227,270 @@ void UpnpDiscoverAllMusic::descriptionParsed(const QString &UDN)
     currentDidlParser->setParentId(QStringLiteral("0"));
     currentDidlParser->setContentDirectory(d->mControlContentDirectory[uuid].data());
 
-    connect(currentDidlParser, &DidlParser::isDataValidChanged, this, &UpnpDiscoverAllMusic::contentChanged);
+    connect(currentDidlParser, &DidlParser::newMusicTracksBatch, this, &UpnpDiscoverAllMusic::newMusicTracksBatch);
+    connect(currentDidlParser, &DidlParser::isDataValidChanged, this, [this, uuid]() {
+        fullResyncFinished(uuid);
+    });
+
+    loadSyncState(uuid);
+
+    auto currentContentDirectory = d->mControlContentDirectory[uuid].data();
+
+    connect(currentContentDirectory, &UpnpControlContentDirectory::containerUpdateIDsChanged, this, [this, uuid](const QString &ids) {
+        d->mSyncStates[uuid]->containerUpdateIdsChanged(ids);
+    });
+
+    connect(currentContentDirectory, &UpnpControlContentDirectory::systemUpdateIDChanged, this, [this, uuid](int id) {
+        // ContainerUpdateIDs can be notified after SystemUpdateID
+        QTimer::singleShot(d->mEventsCoalescingDelay, this, [this, uuid, id]() {
+            startResync(uuid, id);
+        });
+    });
 
-    currentDidlParser->search(0, 0);
+    checkSyncState(uuid);
 }
 
-void UpnpDiscoverAllMusic::contentChanged(const QString &uuid, const QString &parentId)
+void UpnpDiscoverAllMusic::checkSyncState(const QString &uuid)
 {
-    if (!d->mAlbumDatabase) {
+    if (!d->mAlbumDatabase || d->mSyncStates[uuid]->isEmpty()) {
+        requestSystemUpdateId(uuid);
+        return;
+    }
+
+    // the database may have been reset or restored since the state was saved
+    d->mUncheckedSyncStates.insert(uuid);
+    Q_EMIT askRestoredTracks(QStringLiteral("upnp"));
+}
+
+void UpnpDiscoverAllMusic::restoredTracks(const QString &musicSource, QHash<QUrl, QDateTime> allFiles)
+{
+    if (musicSource != QStringLiteral("upnp")) {
         return;
     }
 
-    if (parentId == QStringLiteral("0")) {
-        auto currentDidlParser = d->mDidlParsers[uuid];
-        if (!currentDidlParser) {
-            return;
+    const auto uncheckedSyncStates = d->mUncheckedSyncStates;
+    d->mUncheckedSyncStates.clear();
+
+    for (const auto &uuid : uncheckedSyncStates) {
+        auto &syncState = d->mSyncStates[uuid];
+
+        const auto &knownTracks = syncState->knownTracks();
+        auto isStored = std::all_of(knownTracks.begin(), knownTracks.end(), [&allFiles](const QUrl &oneTrack) {
+            return allFiles.contains(oneTrack);
+        });
+
+        if (!isStored) {
+            qDebug() << "UpnpDiscoverAllMusic::restoredTracks" << "tracks missing from the database for" << uuid;
+
+            syncState.reset(new UpnpSyncState);
+            QFile::remove(syncStateFileName(uuid));
         }
 
-        const auto &allNewTracks = currentDidlParser->newMusicTracks();
+        requestSystemUpdateId(uuid);
+    }
+}
+
+void UpnpDiscoverAllMusic::requestSystemUpdateId(const QString &uuid)
+{
+    auto systemUpdateIdReply = d->mControlContentDirectory[uuid]->getSystemUpdateID();
+
+    connect(systemUpdateIdReply, &UpnpControlAbstractServiceReply::finished, this, [this, uuid](UpnpControlAbstractServiceReply *self) {
+        bool intConvert = false;
+        auto systemUpdateId = self->result()[QStringLiteral("Id")].toInt(&intConvert);
+
+        startResync(uuid, (self->success() && intConvert) ? systemUpdateId : -1);
+    });
+}
+
+void UpnpDiscoverAllMusic::startResync(const QString &uuid, int systemUpdateId)
+{
+    auto syncState = d->mSyncStates.value(uuid);
+
+    if (!syncState) {
+        return;
+    }
+
+    if (syncState->isResyncRunning()) {
+        d->mPendingSystemUpdateIds[uuid] = systemUpdateId;
+        return;
+    }
+
+    switch (syncState->resyncKind(systemUpdateId))
+    {
+    case UpnpSyncState::ResyncKind::NoResync:
+        break;
+    case UpnpSyncState::ResyncKind::ContainersResync:
+    {
+        const auto &changedContainers = syncState->changedContainers();
+
+        if (changedContainers.isEmpty()) {
+            syncState->endResync(systemUpdateId);
+            saveSyncState(uuid);
+            break;
+        }
+
+        d->mResyncSystemUpdateIds[uuid] = systemUpdateId;
+        syncState->beginResync(changedContainers);
+
+        for (const auto &oneContainer : changedContainers) {
+            auto containerParser = new DidlParser(this);
+
+            containerParser->setBrowseFlag(QStringLiteral("BrowseDirectChildren"));
+            containerParser->setFilter(QStringLiteral("*"));
+            containerParser->setParentId(oneContainer);
+            containerParser->setContentDirectory(d->mControlContentDirectory[uuid].data());
+
+            connect(containerParser, &DidlParser::newMusicTracksBatch, this, &UpnpDiscoverAllMusic::newMusicTracksBatch);
+            connect(containerParser, &DidlParser::isDataValidChanged, this, [this, uuid, oneContainer]() {
+                containerResyncFinished(uuid, oneContainer);
+            });
+
+            d->mContainerParsers[uuid][oneContainer] = containerParser;
+        }
+
+        for (auto oneContainerParser : d->mContainerParsers[uuid]) {
+            oneContainerParser->browse(0, 0);
+        }
+
+        break;
+    }
+    case UpnpSyncState::ResyncKind::FullResync:
+        d->mResyncSystemUpdateIds[uuid] = systemUpdateId;
+        syncState->beginResync({});
+
+        d->mDidlParsers[uuid]->search(0, 0);
+        break;
+    }
+}
+
+void UpnpDiscoverAllMusic::fullResyncFinished(const QString &uuid)
+{
+    auto syncState = d->mSyncStates.value(uuid);
+
+    if (!syncState || !syncState->isResyncRunning()) {
+        return;
+    }
+
+    if (!d->mDidlParsers[uuid]->isDataValid()) {
+        d->mFailedResyncs.insert(uuid);
+    }
+
+    finishResync(uuid);
+}
+
+void UpnpDiscoverAllMusic::containerResyncFinished(const QString &uuid, const QString &containerId)
+{
+    auto &containerParsers = d->mContainerParsers[uuid];
+    auto containerParser = containerParsers.take(containerId);
+
+    if (!containerParser) {
+        return;
+    }
+
+    if (!containerParser->isDataValid()) {
+        d->mFailedResyncs.insert(uuid);
+    }
+
+    containerParser->deleteLater();
+
+    if (!containerParsers.isEmpty()) {
+        return;
+    }
+
+    finishResync(uuid);
+}
+
+void UpnpDiscoverAllMusic::finishResync(const QString &uuid)
+{
+    auto syncState = d->mSyncStates.value(uuid);
+    auto systemUpdateId = d->mResyncSystemUpdateIds.take(uuid);
+
+    if (d->mFailedResyncs.remove(uuid)) {
+        // removing tracks not seen during an incomplete resync would be wrong
+        syncState->abortResync();
+    } else {
+        const auto &tracksDelta = syncState->endResync(systemUpdateId);
+
+        if (d->mAlbumDatabase && !tracksDelta.mRemovedTracks.isEmpty()) {
+            d->mAlbumDatabase->removeTracksList(tracksDelta.mRemovedTracks);
+        }
+
+        saveSyncState(uuid);
+    }
+
+    if (d->mPendingSystemUpdateIds.contains(uuid)) {
+        startResync(uuid, d->mPendingSystemUpdateIds.take(uuid));
+    }
+}
+
+QString UpnpDiscoverAllMusic::syncStateFileName(const QString &uuid) const
+{
+    const auto &localDataPaths = QStandardPaths::standardLocations(QStandardPaths::AppDataLocation);
+
+    if (localDataPaths.isEmpty()) {
+        return {};
+    }
+
+    return localDataPaths.first() + QStringLiteral("/upnp/") + uuid + QStringLiteral(".state");
+}
+
+void UpnpDiscoverAllMusic::loadSyncState(const QString &uuid)
+{
+    auto &syncState = d->mSyncStates[uuid];
+    syncState.reset(new UpnpSyncState);
+
+    QFile stateFile(syncStateFileName(uuid));
+
+    if (!stateFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    if (!syncState->load(stateFile.readAll())) {
+        qDebug() << "UpnpDiscoverAllMusic::loadSyncState" << "invalid state for" << uuid;
+        syncState.reset(new UpnpSyncState);
+    }
+}
+
+void UpnpDiscoverAllMusic::saveSyncState(const QString &uuid)
+{
+    const auto &fileName = syncStateFileName(uuid);
+
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    QDir().mkpath(QFileInfo(fileName).absolutePath());
+
+    QFile stateFile(fileName);
+
+    if (!stateFile.open(QIODevice::WriteOnly)) {
+        qDebug() << "UpnpDiscoverAllMusic::saveSyncState" << "cannot write" << fileName;
+        return;
+    }
+
+    stateFile.write(d->mSyncStates[uuid]->save());
+}
+
+void UpnpDiscoverAllMusic::newMusicTracksBatch(const QString &uuid, const QList<MusicAudioTrack> &tracks, const QHash<QString, QUrl> &covers)
+{
+    if (!d->mAlbumDatabase) {
+        return;
+    }
+
+    auto syncState = d->mSyncStates.value(uuid);
+
+    if (!syncState || !syncState->isResyncRunning()) {
+        return;
+    }
+
+    const auto &tracksDelta = syncState->tracksDecoded(tracks);
+
+    if (!tracksDelta.mNewTracks.isEmpty()) {
+        d->mAlbumDatabase->insertTracksList(tracksDelta.mNewTracks, covers, QStringLiteral("upnp"));
+    }
 
-        d->mAlbumDatabase->insertTracksList(allNewTracks, currentDidlParser->covers(), QStringLiteral("upnp"));
+    if (!tracksDelta.mModifiedTracks.isEmpty()) {
+        d->mAlbumDatabase->modifyTracksList(tracksDelta.mModifiedTracks, covers, QStringLiteral("upnp"));
     }
 }
 
@@ -18,8 +18,14 @@
 #ifndef UPNPDISCOVERALLMUSIC_H
 #define UPNPDISCOVERALLMUSIC_H
 
+#include "musicaudiotrack.h"
+
 #include <QObject>
 #include <QSharedPointer>
+#include <QList>
+#include <QHash>
+#include <QUrl>
+#include <QDateTime>
 
 #include <memory>
 
@@ -85,6 +91,8 @@ Q_SIGNALS:
 
     void albumDatabaseChanged();
 
+    void askRestoredTracks(const QString &musicSource);
+
 public Q_SLOTS:
 
     void newDevice(QSharedPointer<UpnpDiscoveryResult> serviceDiscovery);
@@ -107,10 +115,30 @@ private Q_SLOTS:
 
     void descriptionParsed(const QString &UDN);
 
-    void contentChanged(const QString &uuid, const QString &parentId);
+    void newMusicTracksBatch(const QString &uuid, const QList<MusicAudioTrack> &tracks, const QHash<QString, QUrl> &covers);
+
+    void restoredTracks(const QString &musicSource, QHash<QUrl, QDateTime> allFiles);
 
 private:
 
+    void checkSyncState(const QString &uuid);
+
+    void requestSystemUpdateId(const QString &uuid);
+
+    void startResync(const QString &uuid, int systemUpdateId);
+
+    void fullResyncFinished(const QString &uuid);
+
+    void containerResyncFinished(const QString &uuid, const QString &containerId);
+
+    void finishResync(const QString &uuid);
+
+    QString syncStateFileName(const QString &uuid) const;
+
+    void loadSyncState(const QString &uuid);
+
+    void saveSyncState(const QString &uuid);
+
     std::unique_ptr<UpnpDiscoverAllMusicPrivate> d;
 
 };
@@ -0,0 +1,235 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "upnppagingscheduler.h"
+
+#include <QHash>
+#include <QQueue>
+
+#include <algorithm>
+
+class UpnpPagingSchedulerPrivate
+{
+public:
+
+    int mMaximumOutstandingRequests = 4;
+
+    int mInitialPageSize = 100;
+
+    int mMaximumPageSize = 2000;
+
+    int mMinimumPageSize = 10;
+
+    qint64 mTargetRoundTripTime = 1000;
+
+    int mPageSize = 100;
+
+    int mTotalMatches = -1;
+
+    int mNextStartIndex = 0;
+
+    int mOutstandingRequests = 0;
+
+    bool mEndReached = false;
+
+    bool mFailed = false;
+
+    QQueue<UpnpPageRequest> mPendingRequests;
+
+    QHash<int, int> mRetriesCount;
+
+    int mMaximumRetries = 2;
+
+};
+
+UpnpPagingScheduler::UpnpPagingScheduler(int maximumOutstandingRequests, int initialPageSize, int maximumPageSize)
+    : d(new UpnpPagingSchedulerPrivate)
+{
+    d->mMaximumOutstandingRequests = std::max(1, maximumOutstandingRequests);
+    d->mMaximumPageSize = std::max(1, maximumPageSize);
+    d->mInitialPageSize = std::max(1, std::min(initialPageSize, d->mMaximumPageSize));
+    d->mMinimumPageSize = std::min(d->mMinimumPageSize, d->mInitialPageSize);
+    d->mPageSize = d->mInitialPageSize;
+}
+
+UpnpPagingScheduler::~UpnpPagingScheduler()
+= default;
+
+void UpnpPagingScheduler::reset(int firstIndex)
+{
+    d->mPageSize = d->mInitialPageSize;
+    d->mTotalMatches = -1;
+    d->mNextStartIndex = firstIndex;
+    d->mOutstandingRequests = 0;
+    d->mEndReached = false;
+    d->mFailed = false;
+    d->mPendingRequests.clear();
+    d->mRetriesCount.clear();
+}
+
+void UpnpPagingScheduler::setInitialPageSize(int initialPageSize)
+{
+    d->mInitialPageSize = std::max(1, std::min(initialPageSize, d->mMaximumPageSize));
+    d->mMinimumPageSize = std::min(d->mMinimumPageSize, d->mInitialPageSize);
+}
+
+QVector<UpnpPageRequest> UpnpPagingScheduler::nextRequests()
+{
+    QVector<UpnpPageRequest> result;
+
+    if (d->mFailed) {
+        return result;
+    }
+
+    while (d->mOutstandingRequests < d->mMaximumOutstandingRequests) {
+        UpnpPageRequest newRequest;
+
+        if (!d->mPendingRequests.isEmpty()) {
+            newRequest = d->mPendingRequests.dequeue();
+        } else if (d->mTotalMatches < 0) {
+            if (d->mOutstandingRequests > 0 || d->mEndReached) {
+                break;
+            }
+
+            newRequest.mStartIndex = d->mNextStartIndex;
+            newRequest.mRequestedCount = d->mPageSize;
+        } else {
+            if (d->mNextStartIndex >= d->mTotalMatches) {
+                break;
+            }
+
+            newRequest.mStartIndex = d->mNextStartIndex;
+            newRequest.mRequestedCount = std::min(d->mPageSize, d->mTotalMatches - d->mNextStartIndex);
+            d->mNextStartIndex += newRequest.mRequestedCount;
+        }
+
+        ++d->mOutstandingRequests;
+        result.push_back(newRequest);
+    }
+
+    return result;
+}
+
+void UpnpPagingScheduler::pageReceived(const UpnpPageRequest &request, int numberReturned, int totalMatches, qint64 roundTripTime)
+{
+    d->mOutstandingRequests = std::max(0, d->mOutstandingRequests - 1);
+    d->mRetriesCount.remove(request.mStartIndex);
+
+    numberReturned = std::max(0, std::min(numberReturned, request.mRequestedCount));
+
+    if (totalMatches > 0) {
+        if (d->mTotalMatches < 0) {
+            d->mNextStartIndex = request.mStartIndex + request.mRequestedCount;
+        }
+
+        d->mTotalMatches = totalMatches;
+    } else if (d->mTotalMatches < 0) {
+        // the server cannot compute TotalMatches: walk the pages one after the other
+        if (numberReturned == 0) {
+            d->mEndReached = true;
+        } else {
+            d->mNextStartIndex = request.mStartIndex + numberReturned;
+        }
+
+        return;
+    }
+
+    if (numberReturned == 0) {
+        // the server has less objects than announced, nothing more to get at this offset
+        return;
+    }
+
+    const auto remainingStartIndex = request.mStartIndex + numberReturned;
+    const auto requestEndIndex = std::min(request.mStartIndex + request.mRequestedCount, d->mTotalMatches);
+
+    if (remainingStartIndex < requestEndIndex) {
+        // the server caps the page size: never ask more than what it answers
+        d->mMaximumPageSize = std::max(1, numberReturned);
+        d->mMinimumPageSize = std::min(d->mMinimumPageSize, d->mMaximumPageSize);
+        d->mPageSize = std::min(d->mPageSize, d->mMaximumPageSize);
+
+        for (auto startIndex = remainingStartIndex; startIndex < requestEndIndex; startIndex += d->mPageSize) {
+            UpnpPageRequest remainingRequest;
+            remainingRequest.mStartIndex = startIndex;
+            remainingRequest.mRequestedCount = std::min(d->mPageSize, requestEndIndex - startIndex);
+
+            d->mPendingRequests.enqueue(remainingRequest);
+        }
+
+        return;
+    }
+
+    if (roundTripTime < d->mTargetRoundTripTime / 2) {
+        d->mPageSize = std::min(d->mPageSize * 2, d->mMaximumPageSize);
+    } else if (roundTripTime > d->mTargetRoundTripTime * 2) {
+        d->mPageSize = std::max(d->mPageSize / 2, d->mMinimumPageSize);
+    }
+}
+
+void UpnpPagingScheduler::pageFailed(const UpnpPageRequest &request)
+{
+    d->mOutstandingRequests = std::max(0, d->mOutstandingRequests - 1);
+
+    auto &retriesCount = d->mRetriesCount[request.mStartIndex];
+    ++retriesCount;
+
+    if (retriesCount > d->mMaximumRetries) {
+        d->mFailed = true;
+        d->mPendingRequests.clear();
+        return;
+    }
+
+    d->mPendingRequests.enqueue(request);
+}
+
+bool UpnpPagingScheduler::isFinished() const
+{
+    if (d->mOutstandingRequests > 0) {
+        return false;
+    }
+
+    if (d->mFailed || d->mEndReached) {
+        return true;
+    }
+
+    return d->mTotalMatches >= 0 && d->mPendingRequests.isEmpty() && d->mNextStartIndex >= d->mTotalMatches;
+}
+
+bool UpnpPagingScheduler::hasFailed() const
+{
+    return d->mFailed;
+}
+
+int UpnpPagingScheduler::outstandingRequestsCount() const
+{
+    return d->mOutstandingRequests;
+}
+
+int UpnpPagingScheduler::maximumOutstandingRequests() const
+{
+    return d->mMaximumOutstandingRequests;
+}
+
+int UpnpPagingScheduler::pageSize() const
+{
+    return d->mPageSize;
+}
+
+int UpnpPagingScheduler::totalMatches() const
+{
+    return d->mTotalMatches;
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef UPNPPAGINGSCHEDULER_H
+#define UPNPPAGINGSCHEDULER_H
+
+#include <QVector>
+#include <QtGlobal>
+
+#include <memory>
+
+class UpnpPagingSchedulerPrivate;
+
+class UpnpPageRequest
+{
+public:
+
+    int mStartIndex = 0;
+
+    int mRequestedCount = 0;
+
+};
+
+class UpnpPagingScheduler
+{
+
+public:
+
+    explicit UpnpPagingScheduler(int maximumOutstandingRequests = 4, int initialPageSize = 100, int maximumPageSize = 2000);
+
+    ~UpnpPagingScheduler();
+
+    void reset(int firstIndex = 0);
+
+    void setInitialPageSize(int initialPageSize);
+
+    /* the requests to send now, the first page is requested alone until TotalMatches is known */
+    QVector<UpnpPageRequest> nextRequests();
+
+    void pageReceived(const UpnpPageRequest &request, int numberReturned, int totalMatches, qint64 roundTripTime);
+
+    void pageFailed(const UpnpPageRequest &request);
+
+    bool isFinished() const;
+
+    bool hasFailed() const;
+
+    int outstandingRequestsCount() const;
+
+    int maximumOutstandingRequests() const;
+
+    int pageSize() const;
+
+    int totalMatches() const;
+
+private:
+
+    std::unique_ptr<UpnpPagingSchedulerPrivate> d;
+
+};
+
+#endif // UPNPPAGINGSCHEDULER_H
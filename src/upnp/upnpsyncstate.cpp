@@ -0,0 +1,377 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "upnpsyncstate.h"
+
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+#include <QDataStream>
+
+class UpnpContainerState
+{
+public:
+
+    int mUpdateId = -1;
+
+    QSet<QUrl> mTracks;
+
+};
+
+class UpnpTrackState
+{
+public:
+
+    uint mFingerprint = 0;
+
+    QSet<QString> mContainers;
+
+};
+
+class UpnpSyncStatePrivate
+{
+public:
+
+    static const quint32 mFormatVersion = 1;
+
+    int mSystemUpdateId = -1;
+
+    QHash<QString, UpnpContainerState> mContainers;
+
+    QHash<QUrl, UpnpTrackState> mTracks;
+
+    QHash<QString, int> mPendingContainerUpdateIds;
+
+    bool mResyncRunning = false;
+
+    bool mFullResync = false;
+
+    QSet<QString> mResyncContainers;
+
+    QHash<QString, int> mResyncContainerUpdateIds;
+
+    QHash<QString, QSet<QUrl>> mSeenContainerTracks;
+
+};
+
+UpnpSyncState::UpnpSyncState() : d(new UpnpSyncStatePrivate)
+{
+}
+
+UpnpSyncState::~UpnpSyncState()
+= default;
+
+bool UpnpSyncState::isEmpty() const
+{
+    return d->mSystemUpdateId == -1 && d->mTracks.isEmpty();
+}
+
+int UpnpSyncState::systemUpdateId() const
+{
+    return d->mSystemUpdateId;
+}
+
+QList<QUrl> UpnpSyncState::knownTracks() const
+{
+    return d->mTracks.keys();
+}
+
+void UpnpSyncState::containerUpdateIdsChanged(const QString &containerUpdateIds)
+{
+    const auto &allValues = containerUpdateIds.split(QLatin1Char(','));
+
+    for (int valueIndex = 0; valueIndex + 1 < allValues.size(); valueIndex += 2) {
+        bool intConvert = false;
+        auto updateId = allValues[valueIndex + 1].toInt(&intConvert);
+
+        if (!intConvert || allValues[valueIndex].isEmpty()) {
+            continue;
+        }
+
+        d->mPendingContainerUpdateIds[allValues[valueIndex]] = updateId;
+    }
+}
+
+UpnpSyncState::ResyncKind UpnpSyncState::resyncKind(int systemUpdateId) const
+{
+    if (d->mSystemUpdateId == -1) {
+        return ResyncKind::FullResync;
+    }
+
+    if (systemUpdateId == d->mSystemUpdateId) {
+        return ResyncKind::NoResync;
+    }
+
+    // the changes happened while we were not listening or the server does not send ContainerUpdateIDs
+    if (d->mPendingContainerUpdateIds.isEmpty()) {
+        return ResyncKind::FullResync;
+    }
+
+    // a container without known tracks may hold new tracks anywhere below it
+    for (auto itContainer = d->mPendingContainerUpdateIds.cbegin(); itContainer != d->mPendingContainerUpdateIds.cend(); ++itContainer) {
+        if (!d->mContainers.contains(itContainer.key())) {
+            return ResyncKind::FullResync;
+        }
+    }
+
+    return ResyncKind::ContainersResync;
+}
+
+QVector<QString> UpnpSyncState::changedContainers() const
+{
+    QVector<QString> result;
+
+    for (auto itContainer = d->mPendingContainerUpdateIds.cbegin(); itContainer != d->mPendingContainerUpdateIds.cend(); ++itContainer) {
+        auto itKnownContainer = d->mContainers.constFind(itContainer.key());
+
+        if (itKnownContainer != d->mContainers.cend() && itKnownContainer->mUpdateId == itContainer.value()) {
+            continue;
+        }
+
+        result.push_back(itContainer.key());
+    }
+
+    return result;
+}
+
+void UpnpSyncState::beginResync(const QVector<QString> &containerIds)
+{
+    d->mResyncRunning = true;
+    d->mFullResync = containerIds.isEmpty();
+    d->mResyncContainers.clear();
+    d->mResyncContainerUpdateIds.clear();
+    d->mSeenContainerTracks.clear();
+
+    if (d->mFullResync) {
+        d->mResyncContainerUpdateIds = d->mPendingContainerUpdateIds;
+        return;
+    }
+
+    for (const auto &oneContainer : containerIds) {
+        d->mResyncContainers.insert(oneContainer);
+
+        auto itPending = d->mPendingContainerUpdateIds.constFind(oneContainer);
+        if (itPending != d->mPendingContainerUpdateIds.cend()) {
+            d->mResyncContainerUpdateIds[oneContainer] = itPending.value();
+        }
+    }
+}
+
+bool UpnpSyncState::isResyncRunning() const
+{
+    return d->mResyncRunning;
+}
+
+UpnpTracksDelta UpnpSyncState::tracksDecoded(const QList<MusicAudioTrack> &tracks)
+{
+    UpnpTracksDelta result;
+
+    for (const auto &oneTrack : tracks) {
+        const auto &trackUrl = oneTrack.resourceURI();
+
+        if (trackUrl.isEmpty()) {
+            continue;
+        }
+
+        const auto &containerId = oneTrack.parentId();
+        const auto fingerprint = trackFingerprint(oneTrack);
+
+        d->mSeenContainerTracks[containerId].insert(trackUrl);
+        d->mContainers[containerId].mTracks.insert(trackUrl);
+
+        auto itTrack = d->mTracks.find(trackUrl);
+
+        if (itTrack == d->mTracks.end()) {
+            auto &newTrack = d->mTracks[trackUrl];
+            newTrack.mFingerprint = fingerprint;
+            newTrack.mContainers.insert(containerId);
+
+            result.mNewTracks.push_back(oneTrack);
+
+            continue;
+        }
+
+        itTrack->mContainers.insert(containerId);
+
+        if (itTrack->mFingerprint != fingerprint) {
+            itTrack->mFingerprint = fingerprint;
+
+            result.mModifiedTracks.push_back(oneTrack);
+        }
+    }
+
+    return result;
+}
+
+UpnpTracksDelta UpnpSyncState::endResync(int systemUpdateId)
+{
+    UpnpTracksDelta result;
+
+    const auto &resyncContainers = (d->mFullResync ? d->mContainers.keys().toSet() : d->mResyncContainers);
+
+    for (const auto &oneContainer : resyncContainers) {
+        auto itContainer = d->mContainers.find(oneContainer);
+
+        if (itContainer == d->mContainers.end()) {
+            continue;
+        }
+
+        const auto &seenTracks = d->mSeenContainerTracks.value(oneContainer);
+        const auto knownTracks = itContainer->mTracks;
+
+        for (const auto &oneTrack : knownTracks) {
+            if (seenTracks.contains(oneTrack)) {
+                continue;
+            }
+
+            itContainer->mTracks.remove(oneTrack);
+
+            auto itTrack = d->mTracks.find(oneTrack);
+            if (itTrack == d->mTracks.end()) {
+                continue;
+            }
+
+            itTrack->mContainers.remove(oneContainer);
+
+            // the same track can be listed below several containers
+            if (itTrack->mContainers.isEmpty()) {
+                d->mTracks.erase(itTrack);
+                result.mRemovedTracks.push_back(oneTrack);
+            }
+        }
+
+        if (itContainer->mTracks.isEmpty()) {
+            d->mContainers.erase(itContainer);
+        }
+    }
+
+    for (auto itUpdateId = d->mResyncContainerUpdateIds.cbegin(); itUpdateId != d->mResyncContainerUpdateIds.cend(); ++itUpdateId) {
+        auto itContainer = d->mContainers.find(itUpdateId.key());
+        if (itContainer != d->mContainers.end()) {
+            itContainer->mUpdateId = itUpdateId.value();
+        }
+
+        // a newer event received during the resync still needs to be handled
+        auto itPending = d->mPendingContainerUpdateIds.find(itUpdateId.key());
+        if (itPending != d->mPendingContainerUpdateIds.end() && itPending.value() == itUpdateId.value()) {
+            d->mPendingContainerUpdateIds.erase(itPending);
+        }
+    }
+
+    d->mSystemUpdateId = systemUpdateId;
+
+    abortResync();
+
+    return result;
+}
+
+void UpnpSyncState::abortResync()
+{
+    d->mResyncRunning = false;
+    d->mFullResync = false;
+    d->mResyncContainers.clear();
+    d->mResyncContainerUpdateIds.clear();
+    d->mSeenContainerTracks.clear();
+}
+
+QByteArray UpnpSyncState::save() const
+{
+    QByteArray result;
+    QDataStream outputStream(&result, QIODevice::WriteOnly);
+    outputStream.setVersion(QDataStream::Qt_5_9);
+
+    outputStream << UpnpSyncStatePrivate::mFormatVersion << static_cast<qint32>(d->mSystemUpdateId);
+
+    outputStream << static_cast<quint32>(d->mContainers.size());
+    for (auto itContainer = d->mContainers.cbegin(); itContainer != d->mContainers.cend(); ++itContainer) {
+        outputStream << itContainer.key() << static_cast<qint32>(itContainer->mUpdateId);
+    }
+
+    outputStream << static_cast<quint32>(d->mTracks.size());
+    for (auto itTrack = d->mTracks.cbegin(); itTrack != d->mTracks.cend(); ++itTrack) {
+        outputStream << itTrack.key() << static_cast<quint32>(itTrack->mFingerprint) << itTrack->mContainers;
+    }
+
+    return result;
+}
+
+bool UpnpSyncState::load(const QByteArray &data)
+{
+    QDataStream inputStream(data);
+    inputStream.setVersion(QDataStream::Qt_5_9);
+
+    quint32 formatVersion = 0;
+    qint32 systemUpdateId = -1;
+
+    inputStream >> formatVersion >> systemUpdateId;
+
+    if (inputStream.status() != QDataStream::Ok || formatVersion != UpnpSyncStatePrivate::mFormatVersion) {
+        return false;
+    }
+
+    QHash<QString, UpnpContainerState> allContainers;
+    QHash<QUrl, UpnpTrackState> allTracks;
+
+    quint32 containersCount = 0;
+    inputStream >> containersCount;
+    for (quint32 containerIndex = 0; containerIndex < containersCount && inputStream.status() == QDataStream::Ok; ++containerIndex) {
+        QString containerId;
+        qint32 updateId = -1;
+
+        inputStream >> containerId >> updateId;
+
+        allContainers[containerId].mUpdateId = updateId;
+    }
+
+    quint32 tracksCount = 0;
+    inputStream >> tracksCount;
+    for (quint32 trackIndex = 0; trackIndex < tracksCount && inputStream.status() == QDataStream::Ok; ++trackIndex) {
+        QUrl trackUrl;
+        quint32 fingerprint = 0;
+        QSet<QString> containers;
+
+        inputStream >> trackUrl >> fingerprint >> containers;
+
+        auto &oneTrack = allTracks[trackUrl];
+        oneTrack.mFingerprint = fingerprint;
+        oneTrack.mContainers = containers;
+
+        for (const auto &oneContainer : containers) {
+            allContainers[oneContainer].mTracks.insert(trackUrl);
+        }
+    }
+
+    if (inputStream.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    d->mSystemUpdateId = systemUpdateId;
+    d->mContainers = allContainers;
+    d->mTracks = allTracks;
+    d->mPendingContainerUpdateIds.clear();
+    abortResync();
+
+    return true;
+}
+
+uint UpnpSyncState::trackFingerprint(const MusicAudioTrack &track)
+{
+    return qHash(QStringList{track.title(), track.artist(), track.albumName(), track.albumArtist(), track.genre(),
+                             QString::number(track.trackNumber()), QString::number(track.discNumber()),
+                             QString::number(track.duration().msecsSinceStartOfDay()), track.albumCover().toString()}
+                 .join(QLatin1Char('\n')));
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2018 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef UPNPSYNCSTATE_H
+#define UPNPSYNCSTATE_H
+
+#include "musicaudiotrack.h"
+
+#include <QList>
+#include <QUrl>
+#include <QVector>
+#include <QString>
+#include <QByteArray>
+
+#include <memory>
+
+class UpnpSyncStatePrivate;
+
+class UpnpTracksDelta
+{
+public:
+
+    QList<MusicAudioTrack> mNewTracks;
+
+    QList<MusicAudioTrack> mModifiedTracks;
+
+    QList<QUrl> mRemovedTracks;
+
+};
+
+class UpnpSyncState
+{
+
+public:
+
+    enum class ResyncKind {
+        NoResync,
+        ContainersResync,
+        FullResync,
+    };
+
+    UpnpSyncState();
+
+    ~UpnpSyncState();
+
+    bool isEmpty() const;
+
+    int systemUpdateId() const;
+
+    QList<QUrl> knownTracks() const;
+
+    /* records a ContainerUpdateIDs event: comma separated pairs of container id and update id */
+    void containerUpdateIdsChanged(const QString &containerUpdateIds);
+
+    ResyncKind resyncKind(int systemUpdateId) const;
+
+    QVector<QString> changedContainers() const;
+
+    /* an empty list of containers starts a resync of the whole server */
+    void beginResync(const QVector<QString> &containerIds);
+
+    bool isResyncRunning() const;
+
+    UpnpTracksDelta tracksDecoded(const QList<MusicAudioTrack> &tracks);
+
+    UpnpTracksDelta endResync(int systemUpdateId);
+
+    void abortResync();
+
+    QByteArray save() const;
+
+    bool load(const QByteArray &data);
+
+    static uint trackFingerprint(const MusicAudioTrack &track);
+
+private:
+
+    std::unique_ptr<UpnpSyncStatePrivate> d;
+
+};
+
+#endif // UPNPSYNCSTATE_H